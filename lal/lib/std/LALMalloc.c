@@ -27,6 +27,7 @@
 #include <lal/LALMalloc.h>
 #include <lal/LALStdio.h>
 #include <lal/LALError.h>
+#include <lal/XLALError.h>
 
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
@@ -67,6 +68,10 @@ size_t lalMallocTotalPeak = 0;	/**< peak amount of memory allocated so far */
     }                                                                     \
     else (void)(0)
 
+/* memory arenas: return nonzero if the pointer was drawn from an arena */
+static int ArenaFree(void *p, const char *file, int line);
+static int ArenaRealloc(void **p, size_t n, int aligned, const char *file, int line);
+
 void *(XLALMalloc) (size_t n) {
     void *p;
     p = LALMallocShort(n);
@@ -184,6 +189,8 @@ void *XLALReallocAlignedLong(void *ptr, size_t size, const char *file, int line)
 		XLALFreeAligned(ptr);
 		return NULL;
 	}
+	if (ArenaRealloc(&ptr, size, 1, file, line))
+		return ptr;
 	p = realloc(ptr, size); /* use ordinary realloc */
 	if (XLALIsMemoryAligned(p))
 		return p;
@@ -203,6 +210,8 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 		XLALFreeAligned(ptr);
 		return NULL;
 	}
+	if (ArenaRealloc(&ptr, size, 1, "unknown", -1))
+		return ptr;
 	p = realloc(ptr, size); /* use ordinary realloc */
 	if (XLALIsMemoryAligned(p))
 		return p;
@@ -215,6 +224,8 @@ void *(XLALReallocAligned)(void *ptr, size_t size)
 
 void XLALFreeAligned(void *ptr)
 {
+	if (ArenaFree(ptr, "unknown", -1))
+		return;
 	free(ptr); /* use ordinary free */
 }
 
@@ -613,6 +624,644 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
 }
 
 
+/*
+ * Memory arenas.
+ *
+ * An arena is a list of large blocks from which allocations are carved by
+ * advancing an offset.  Each allocation is preceded by a header recording
+ * its block and its extent within the block, and by room for the prefix
+ * written by PadAlloc(), so that the padding and tracking routines above
+ * apply to arena allocations unchanged.  Each thread keeps a stack of
+ * scopes; a scope records the position of its arena when pushed, and the
+ * arena is returned to that position when the scope is popped.  Blocks
+ * released in this way are kept for reuse until the arena is destroyed.
+ *
+ * Every block is entered in a process-wide table sorted by address, so
+ * that LALFree() and LALRealloc() recognise arena memory whichever thread
+ * frees it, and after its scope has been popped, without dereferencing
+ * pointers which were not drawn from an arena; pointers outside the range
+ * spanned by the table are rejected, and those in the arena of the calling
+ * thread's innermost scope are found, without taking a lock.
+ */
+
+#define ARENA_ALIGNMENT 0x40
+#define ARENA_DEFAULT_BLOCK_SIZE ((size_t) 1 << 20)
+#define ARENA_ALIGN(x) (((x) + ARENA_ALIGNMENT - 1) & ~((size_t) ARENA_ALIGNMENT - 1))
+#define ARENA_TAG ((size_t) 0xA7E4A7E4)
+
+/* offset of the user memory of an allocation starting at offset x */
+#define ARENA_USER(x) ARENA_ALIGN((x) + sizeof(struct arenaHeader) + prefix)
+
+/* header of the allocation with user memory at p */
+#define ARENA_HEADER(p) (((struct arenaHeader *) ((char *) (p) - prefix)) - 1)
+
+enum { ARENA_LIVE = 1, ARENA_DEBUG = 2, ARENA_POPPED = 4 };
+
+struct arenaHeader {
+    struct arenaBlock *block;   /* block holding the allocation */
+    size_t start;               /* offset of the allocation in its block */
+    size_t end;                 /* offset of the end of the allocation */
+    size_t size;                /* requested size */
+    size_t flags;               /* ARENA_LIVE until freed; ARENA_DEBUG if tracked;
+                                   ARENA_POPPED once its scope is popped */
+    size_t tag;                 /* ARENA_TAG ^ address of the header */
+};
+
+struct arenaBlock {
+    struct arenaBlock *next;    /* next older block */
+    LALMallocArena *arena;      /* arena owning the block */
+    char *base;                 /* aligned start of usable memory */
+    size_t size;                /* size of usable memory */
+    size_t used;                /* offset of first free byte */
+};
+
+struct arenaScope {
+    LALMallocArena *arena;      /* arena of this scope, or NULL */
+    int factories;              /* whether the factories draw from the arena */
+    struct arenaBlock *block;   /* newest block of the arena when pushed */
+    size_t used;                /* and its offset */
+    struct arenaScope *prev;    /* enclosing scope */
+    struct arenaScope *prevTop; /* previous innermost scope of the arena */
+};
+
+struct tagLALMallocArena {
+    size_t blockSize;           /* minimum size of new blocks */
+    int depth;                  /* number of scopes using the arena */
+    struct arenaScope *top;     /* innermost scope using the arena */
+    struct arenaBlock *head;    /* blocks in use, newest first */
+    struct arenaBlock *spare;   /* blocks released by popped scopes */
+};
+
+/* The scope stack is per-thread; malloc() and free() are used for the
+ * scopes for the same reason as in XLALError.c */
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t arenaMut = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t arenaScopeKey;
+static pthread_once_t arenaScopeKeyOnce = PTHREAD_ONCE_INIT;
+static void ArenaCreateScopeKey(void)
+{
+    pthread_key_create(&arenaScopeKey, NULL);
+}
+static struct arenaScope *ArenaGetScope(void)
+{
+    pthread_once(&arenaScopeKeyOnce, ArenaCreateScopeKey);
+    return pthread_getspecific(arenaScopeKey);
+}
+static void ArenaSetScope(struct arenaScope *scope)
+{
+    pthread_once(&arenaScopeKeyOnce, ArenaCreateScopeKey);
+    pthread_setspecific(arenaScopeKey, scope);
+}
+#else
+static struct arenaScope *arenaScopeTop = NULL;
+static struct arenaScope *ArenaGetScope(void)
+{
+    return arenaScopeTop;
+}
+static void ArenaSetScope(struct arenaScope *scope)
+{
+    arenaScopeTop = scope;
+}
+#endif
+
+/* Table of all arena blocks, sorted by address, and the range they span.
+ * The range is read without arenaMut, so each bound is stored atomically
+ * and only ever widened while any block is registered: a thread holding a
+ * pointer into a block then sees a range containing that block, whatever
+ * registrations or unregistrations of other blocks are in progress. */
+static struct arenaBlock **arenaBlocks = NULL;
+static size_t arenaNumBlocks = 0;
+static char *arenaLow = NULL;
+static char *arenaHigh = NULL;
+
+#if defined(__GNUC__)
+#define ARENA_LOAD_BOUND(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define ARENA_STORE_BOUND(x, v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#else
+#define ARENA_LOAD_BOUND(x) (x)
+#define ARENA_STORE_BOUND(x, v) ((x) = (v))
+#endif
+
+/* Widen the range to include block b; call with arenaMut held */
+static void ArenaWidenRange(const struct arenaBlock *b)
+{
+    char *end = b->base + b->size;
+    if (!arenaLow || b->base < arenaLow) {
+        ARENA_STORE_BOUND(arenaLow, b->base);
+    }
+    if (end > arenaHigh) {
+        ARENA_STORE_BOUND(arenaHigh, end);
+    }
+    return;
+}
+
+static int ArenaRegisterBlock(struct arenaBlock *b)
+{
+    struct arenaBlock **blocks;
+    size_t i;
+    pthread_mutex_lock(&arenaMut);
+    if (!(blocks = realloc(arenaBlocks, (arenaNumBlocks + 1) * sizeof(*blocks)))) {
+        pthread_mutex_unlock(&arenaMut);
+        return 0;
+    }
+    arenaBlocks = blocks;
+    for (i = arenaNumBlocks; i > 0 && arenaBlocks[i - 1]->base > b->base; --i) {
+        arenaBlocks[i] = arenaBlocks[i - 1];
+    }
+    arenaBlocks[i] = b;
+    ++arenaNumBlocks;
+    ArenaWidenRange(b);
+    pthread_mutex_unlock(&arenaMut);
+    return 1;
+}
+
+static void ArenaUnregisterBlock(struct arenaBlock *b)
+{
+    size_t i;
+    pthread_mutex_lock(&arenaMut);
+    for (i = 0; i < arenaNumBlocks && arenaBlocks[i] != b; ++i) ;
+    if (i < arenaNumBlocks) {
+        memmove(arenaBlocks + i, arenaBlocks + i + 1, (arenaNumBlocks - i - 1) * sizeof(*arenaBlocks));
+        --arenaNumBlocks;
+    }
+    /* the range is not narrowed while other blocks remain, and no pointer
+     * into an arena can be live once none do */
+    if (arenaNumBlocks == 0) {
+        free(arenaBlocks);
+        arenaBlocks = NULL;
+        ARENA_STORE_BOUND(arenaLow, NULL);
+        ARENA_STORE_BOUND(arenaHigh, NULL);
+    }
+    pthread_mutex_unlock(&arenaMut);
+    return;
+}
+
+/* Make a block with at least n bytes available the newest block of arena */
+static struct arenaBlock *ArenaNewBlock(LALMallocArena *arena, size_t n)
+{
+    struct arenaBlock **prev = &arena->spare;
+    struct arenaBlock *b;
+    while ((b = *prev) != NULL && b->size < n) {
+        prev = &b->next;
+    }
+    if (b) {
+        *prev = b->next;
+    } else {
+        size_t size = n > arena->blockSize ? n : arena->blockSize;
+        if (!(b = malloc(sizeof(*b) + ARENA_ALIGNMENT + size))) {
+            return NULL;
+        }
+        b->arena = arena;
+        b->base = (char *) ARENA_ALIGN((size_t) (b + 1));
+        b->size = size;
+        if (!ArenaRegisterBlock(b)) {
+            free(b);
+            return NULL;
+        }
+    }
+    b->used = 0;
+    b->next = arena->head;
+    arena->head = b;
+    return b;
+}
+
+static void *ArenaAlloc(LALMallocArena *arena, size_t n, const char *file, int line)
+{
+    const int debug = (lalDebugLevel & LALMEMDBGBIT) ? 1 : 0;
+    const int padded = debug && (lalDebugLevel & LALMEMPADBIT);
+    const size_t extent = padded ? allocsz(n) - prefix : n;
+    struct arenaBlock *b = arena->head;
+    struct arenaHeader *hdr;
+    char *p;
+    void *q;
+
+    if (!b || ARENA_USER(b->used) + extent > b->size) {
+        if (!(b = ArenaNewBlock(arena, ARENA_USER(0) + extent))) {
+            XLALPrintError("LALMalloc: failed to allocate arena block for %zu bytes\n", n);
+            return NULL;
+        }
+    }
+
+    p = b->base + ARENA_USER(b->used);
+    hdr = ARENA_HEADER(p);
+    hdr->block = b;
+    hdr->start = b->used;
+    hdr->end = ARENA_USER(b->used) + extent;
+    hdr->size = n;
+    hdr->flags = ARENA_LIVE | (debug ? ARENA_DEBUG : 0);
+    hdr->tag = ARENA_TAG ^ (size_t) hdr;
+
+    if (debug) {
+        q = PushAlloc(PadAlloc((size_t *) (padded ? p - prefix : p), n, 0, "XLALArenaMalloc", file, line), n, file, line);
+        lalMemDbgPtr = lalMemDbgRetPtr = q;
+        lalIsMemDbgPtr = lalIsMemDbgRetPtr = (lalMemDbgRetPtr == lalMemDbgUsrPtr);
+        if (!q) {
+            return NULL;
+        }
+    }
+
+    b->used = hdr->end;
+    return p;
+}
+
+/* The block of the arena used by the innermost scope of the calling thread
+ * which holds p, if any; only the calling thread allocates from that arena
+ * while the scope is open, so its blocks can be searched without arenaMut */
+static struct arenaBlock *ArenaFindCurrent(void *p)
+{
+    struct arenaScope *scope = ArenaGetScope();
+    struct arenaBlock *b;
+    if (!scope || !scope->arena) {
+        return NULL;
+    }
+    for (b = scope->arena->head; b; b = b->next) {
+        if ((char *) p >= b->base && (char *) p < b->base + b->size) {
+            return b;
+        }
+    }
+    return NULL;
+}
+
+/* Returns nonzero if p is in an arena block, setting *hdr to the header of
+ * the allocation p, or to NULL (after raising an error) if p is not one */
+static int ArenaFind(void *p, struct arenaHeader **hdr, const char *func, const char *file, int line)
+{
+    struct arenaBlock *b = NULL;
+    size_t lo, hi;
+
+    /* pointers outside the range are not arena memory; those inside it are
+     * looked for first in the calling thread's own arena, and only then in
+     * the table under the lock, so that threads freeing memory of their
+     * own arenas do not contend */
+    *hdr = NULL;
+    if ((char *) p < ARENA_LOAD_BOUND(arenaLow) || (char *) p >= ARENA_LOAD_BOUND(arenaHigh)) {
+        return 0;
+    }
+    if (!(b = ArenaFindCurrent(p))) {
+        pthread_mutex_lock(&arenaMut);
+        for (lo = 0, hi = arenaNumBlocks; hi > lo; ) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (arenaBlocks[mid]->base <= (char *) p) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo > 0 && (char *) p < arenaBlocks[lo - 1]->base + arenaBlocks[lo - 1]->size) {
+            b = arenaBlocks[lo - 1];
+        }
+        pthread_mutex_unlock(&arenaMut);
+        if (!b) {
+            return 0;
+        }
+    }
+
+    *hdr = ARENA_HEADER(p);
+    if ((char *) *hdr < (char *) (b + 1) || (*hdr)->tag != (ARENA_TAG ^ (size_t) *hdr) || (*hdr)->block != b) {
+        lalRaiseHook(SIGSEGV, "%s error: %p is inside an arena but was not returned by XLALArenaMalloc() in %s:%d\n",
+                     func, p, file, line);
+        *hdr = NULL;
+    }
+    return 1;
+}
+
+/* Release the tracking information of a live allocation */
+static int ArenaUntrack(void *p, struct arenaHeader *hdr, const char *func, const char *file, int line)
+{
+    if (hdr->flags & ARENA_DEBUG) {
+        lalMemDbgPtr = lalMemDbgArgPtr = p;
+        lalIsMemDbgPtr = lalIsMemDbgArgPtr = (lalMemDbgArgPtr == lalMemDbgUsrPtr);
+        if (!UnPadAlloc(PopAlloc(p, func, file, line), 0, func, file, line)) {
+            return 0;
+        }
+    }
+    hdr->flags &= ARENA_POPPED;
+    return 1;
+}
+
+/* Whether arena memory p, with header hdr, may be freed */
+static int ArenaCheckLive(void *p, struct arenaHeader *hdr, const char *func, const char *file, int line)
+{
+    if (hdr->flags & ARENA_POPPED) {
+        lalRaiseHook(SIGSEGV, "%s error: tried to free arena pointer %p after its scope was popped in %s:%d\n",
+                     func, p, file, line);
+        return 0;
+    }
+    if (!(hdr->flags & ARENA_LIVE)) {
+        lalRaiseHook(SIGSEGV, "%s error: tried to free a freed arena pointer at address %p in %s:%d\n",
+                     func, p, file, line);
+        return 0;
+    }
+    return 1;
+}
+
+/* Whether arena is in use by the innermost scope of the calling thread */
+static int ArenaIsCurrent(const LALMallocArena *arena)
+{
+    return arena->top && arena->top == ArenaGetScope();
+}
+
+/* Returns nonzero if p is in an arena, in which case it has been freed */
+static int ArenaFree(void *p, const char *file, int line)
+{
+    struct arenaHeader *hdr;
+    struct arenaBlock *b;
+    LALMallocArena *arena;
+    size_t floor = 0;
+
+    if (!p || !ArenaFind(p, &hdr, "LALFree", file, line)) {
+        return 0;
+    }
+    if (!hdr || !ArenaCheckLive(p, hdr, "LALFree", file, line) || !ArenaUntrack(p, hdr, "LALFree", file, line)) {
+        return 1;
+    }
+
+    /* the most recent allocation since the innermost scope of the arena
+     * was pushed can be reclaimed immediately by the thread using it */
+    b = hdr->block;
+    arena = b->arena;
+    if (ArenaIsCurrent(arena)) {
+        if (arena->top->block == b) {
+            floor = arena->top->used;
+        }
+        if (b == arena->head && hdr->end == b->used && hdr->start >= floor) {
+            b->used = hdr->start;
+        }
+    }
+    return 1;
+}
+
+/* Returns nonzero if *p is in an arena, in which case it has been reallocated */
+static int ArenaRealloc(void **p, size_t n, int aligned, const char *file, int line)
+{
+    struct arenaHeader *hdr;
+    LALMallocArena *arena;
+    void *q;
+
+    if (!*p || !ArenaFind(*p, &hdr, "LALRealloc", file, line)) {
+        return 0;
+    }
+    if (!hdr || !ArenaCheckLive(*p, hdr, "LALRealloc", file, line)) {
+        *p = NULL;
+        return 1;
+    }
+    if (n == 0) {
+        ArenaFree(*p, file, line);
+        *p = NULL;
+        return 1;
+    }
+
+    /* stay in the same arena while it is in use on this thread */
+    arena = hdr->block->arena;
+    if (ArenaIsCurrent(arena)) {
+        q = ArenaAlloc(arena, n, file, line);
+    }
+#if LAL_FFTW3_MEMALIGN_ENABLED
+    else if (aligned) {
+        q = XLALMallocAlignedLong(n, file, line);
+    }
+#endif
+    else {
+        q = LALMallocLong(n, file, line);
+    }
+    (void) aligned;
+    if (q) {
+        memcpy(q, *p, hdr->size < n ? hdr->size : n);
+        ArenaFree(*p, file, line);
+    }
+    *p = q;
+    return 1;
+}
+
+/* Return arena to the given position, releasing newer blocks */
+static void ArenaRelease(LALMallocArena *arena, struct arenaBlock *block, size_t used)
+{
+    for (;;) {
+        struct arenaBlock *b = arena->head;
+        size_t pos = (b == block) ? used : 0;
+        if (!b) {
+            break;
+        }
+        /* abandoned allocations are untracked one by one, and all are
+         * marked so that later attempts to free them are caught */
+        while (pos < b->used) {
+            char *p = b->base + ARENA_USER(pos);
+            struct arenaHeader *hdr = ARENA_HEADER(p);
+            if (hdr->flags & ARENA_LIVE) {
+                ArenaUntrack(p, hdr, "XLALPopMallocArena", "unknown", -1);
+            }
+            hdr->flags = ARENA_POPPED;
+            pos = hdr->end;
+        }
+        if (b == block) {
+            b->used = used;
+            break;
+        }
+        arena->head = b->next;
+        b->next = arena->spare;
+        arena->spare = b;
+    }
+    return;
+}
+
+/**
+ * Create an arena from which XLALArenaMalloc() draws memory while the arena
+ * is pushed with XLALPushMallocArena().  Memory is obtained from the system
+ * in blocks of at least \c blockSize bytes; if zero, a default of 1 MiB is
+ * used.
+ */
+LALMallocArena *XLALCreateMallocArena(size_t blockSize)
+{
+    LALMallocArena *arena = XLALCalloc(1, sizeof(*arena));
+    if (!arena) {
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    arena->blockSize = blockSize ? blockSize : ARENA_DEFAULT_BLOCK_SIZE;
+    return arena;
+}
+
+/**
+ * Destroy an arena and return its memory to the system.  The arena must not
+ * be pushed in any scope.
+ */
+void XLALDestroyMallocArena(LALMallocArena *arena)
+{
+    struct arenaBlock *b;
+    if (!arena) {
+        return;
+    }
+    if (arena->depth > 0) {
+        XLAL_ERROR_VOID(XLAL_EINVAL, "Arena is still pushed in %d scope(s)", arena->depth);
+    }
+    ArenaRelease(arena, NULL, 0);
+    while ((b = arena->spare) != NULL) {
+        arena->spare = b->next;
+        ArenaUnregisterBlock(b);
+        free(b);
+    }
+    XLALFree(arena);
+    return;
+}
+
+static int ArenaPush(LALMallocArena *arena, int factories)
+{
+    struct arenaScope *scope = malloc(sizeof(*scope));
+    if (!scope) {
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    scope->arena = arena;
+    scope->factories = factories;
+    scope->block = arena ? arena->head : NULL;
+    scope->used = scope->block ? scope->block->used : 0;
+    scope->prev = ArenaGetScope();
+    scope->prevTop = arena ? arena->top : NULL;
+    ArenaSetScope(scope);
+    if (arena) {
+        arena->top = scope;
+        ++arena->depth;
+    }
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Open a scope, on the calling thread, in which XLALArenaMalloc() draws
+ * memory from \c arena.  If \c arena is NULL, XLALArenaMalloc() reverts to
+ * XLALMalloc() until the scope is popped; this allows code which must
+ * retain memory beyond an enclosing scope to opt out of it.  Scopes may be
+ * nested, including several scopes on the same arena.  Other allocations,
+ * including those of the sequence, vector and series factories, are not
+ * drawn from the arena.
+ */
+int XLALPushMallocArena(LALMallocArena *arena)
+{
+    return ArenaPush(arena, 0);
+}
+
+/**
+ * As XLALPushMallocArena(), but the sequence, vector and time/frequency
+ * series factories also draw from \c arena within the scope.  Everything
+ * these create in the scope, including by library routines called in it,
+ * is reclaimed when the scope is popped, so the caller must ensure that
+ * none of it is kept.
+ */
+int XLALPushMallocArenaFactories(LALMallocArena *arena)
+{
+    return ArenaPush(arena, 1);
+}
+
+/**
+ * Close the innermost scope opened on the calling thread by
+ * XLALPushMallocArena() or XLALPushMallocArenaFactories().  All memory
+ * drawn from the arena within the scope is reclaimed, whether or not it has
+ * been freed; pointers to it must not be used, or passed to XLALFree(),
+ * afterwards.
+ */
+int XLALPopMallocArena(void)
+{
+    struct arenaScope *scope = ArenaGetScope();
+    if (!scope) {
+        XLAL_ERROR(XLAL_EFAILED, "No arena scope to pop");
+    }
+    if (scope->arena) {
+        ArenaRelease(scope->arena, scope->block, scope->used);
+        scope->arena->top = scope->prevTop;
+        --scope->arena->depth;
+    }
+    ArenaSetScope(scope->prev);
+    free(scope);
+    return XLAL_SUCCESS;
+}
+
+/* The arena from which the calling thread draws memory, if any */
+static LALMallocArena *ArenaCurrent(int factory)
+{
+    struct arenaScope *scope = ArenaGetScope();
+    if (!scope || (factory && !scope->factories)) {
+        return NULL;
+    }
+    return scope->arena;
+}
+
+void *(XLALArenaMalloc)(size_t n)
+{
+    return XLALArenaMallocLong(n, "unknown", -1);
+}
+
+/**
+ * Allocate memory from the arena of the innermost scope opened on the
+ * calling thread, or with XLALMalloc() if there is none.  Memory from an
+ * arena is aligned to 64 bytes, and is freed or reallocated in the usual
+ * way with XLALFree() and XLALRealloc(), from any thread.
+ */
+void *XLALArenaMallocLong(size_t n, const char *file, int line)
+{
+    LALMallocArena *arena = ArenaCurrent(0);
+    void *p;
+    if (!arena) {
+        return XLALMallocLong(n, file, line);
+    }
+    p = ArenaAlloc(arena, n, file, line);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return p;
+}
+
+/**
+ * As XLALArenaMallocLong(), but only draws from an arena pushed with
+ * XLALPushMallocArenaFactories(); for use by the factories.
+ */
+void *XLALFactoryMallocLong(size_t n, const char *file, int line)
+{
+    LALMallocArena *arena = ArenaCurrent(1);
+    void *p;
+    if (!arena) {
+        return XLALMallocLong(n, file, line);
+    }
+    p = ArenaAlloc(arena, n, file, line);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return p;
+}
+
+#if LAL_FFTW3_MEMALIGN_ENABLED
+
+void *(XLALArenaMallocAligned)(size_t n)
+{
+    return XLALArenaMallocAlignedLong(n, "unknown", -1);
+}
+
+/**
+ * As XLALArenaMallocLong(), but falling back to XLALMallocAligned(); memory
+ * may be freed with XLALFreeAligned() in either case.
+ */
+void *XLALArenaMallocAlignedLong(size_t n, const char *file, int line)
+{
+    LALMallocArena *arena = ArenaCurrent(0);
+    void *p;
+    if (!arena) {
+        return XLALMallocAlignedLong(n, file, line);
+    }
+    p = ArenaAlloc(arena, n, file, line);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return p;
+}
+
+/**
+ * As XLALFactoryMallocLong(), but falling back to XLALMallocAligned().
+ */
+void *XLALFactoryMallocAlignedLong(size_t n, const char *file, int line)
+{
+    LALMallocArena *arena = ArenaCurrent(1);
+    void *p;
+    if (!arena) {
+        return XLALMallocAlignedLong(n, file, line);
+    }
+    p = ArenaAlloc(arena, n, file, line);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return p;
+}
+
+#endif /* LAL_FFTW3_MEMALIGN_ENABLED */
+
+
 
 void *LALMallocShort(size_t n)
 {
@@ -689,7 +1338,7 @@ void *LALCallocLong(size_t m, size_t n, const char *file, int line)
 
 void *LALReallocShort(void *p, size_t n)
 {
-    return (lalDebugLevel & LALMEMDBGBIT) ? LALReallocLong(p, n, "unknown", -1): realloc(p, n);
+    return LALReallocLong(p, n, "unknown", -1);
 }
 
 
@@ -697,6 +1346,9 @@ void *LALReallocShort(void *p, size_t n)
 void *LALReallocLong(void *q, size_t n, const char *file, const int line)
 {
     void *p;
+    if (q && ArenaRealloc(&q, n, 0, file, line)) {
+        return q;
+    }
     if (!(lalDebugLevel & LALMEMDBGBIT)) {
         return realloc(q, n);
     }
@@ -766,6 +1418,8 @@ void LALFreeLong(void *q, const char *file, const int line)
     void *p;
     if (q == NULL)
         return;
+    if (ArenaFree(q, file, line))
+        return;
     if (!(lalDebugLevel & LALMEMDBGBIT)) {
         free(q);
         return;
@@ -821,4 +1475,84 @@ void LALCheckMemoryLeaks(void)
 
 void (LALCheckMemoryLeaks)(void) { return; }
 
+/* Memory arenas are not used when the memory functions are disabled, since
+ * LALFree() is then free(); the arena functions revert to XLALMalloc() */
+
+struct tagLALMallocArena {
+    int unused;
+};
+
+static int ArenaFree(void UNUSED *p, const char UNUSED *file, int UNUSED line)
+{
+    return 0;
+}
+
+static int ArenaRealloc(void UNUSED **p, size_t UNUSED n, int UNUSED aligned, const char UNUSED *file, int UNUSED line)
+{
+    return 0;
+}
+
+LALMallocArena *XLALCreateMallocArena(size_t UNUSED blockSize)
+{
+    LALMallocArena *arena = XLALCalloc(1, sizeof(*arena));
+    if (!arena) {
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    return arena;
+}
+
+void XLALDestroyMallocArena(LALMallocArena *arena)
+{
+    XLALFree(arena);
+}
+
+int XLALPushMallocArena(LALMallocArena UNUSED *arena)
+{
+    return XLAL_SUCCESS;
+}
+
+int XLALPushMallocArenaFactories(LALMallocArena UNUSED *arena)
+{
+    return XLAL_SUCCESS;
+}
+
+int XLALPopMallocArena(void)
+{
+    return XLAL_SUCCESS;
+}
+
+void *(XLALArenaMalloc)(size_t n)
+{
+    return XLALMallocLong(n, "unknown", -1);
+}
+
+void *XLALArenaMallocLong(size_t n, const char *file, int line)
+{
+    return XLALMallocLong(n, file, line);
+}
+
+void *XLALFactoryMallocLong(size_t n, const char *file, int line)
+{
+    return XLALMallocLong(n, file, line);
+}
+
+#if LAL_FFTW3_MEMALIGN_ENABLED
+
+void *(XLALArenaMallocAligned)(size_t n)
+{
+    return XLALMallocAlignedLong(n, "unknown", -1);
+}
+
+void *XLALArenaMallocAlignedLong(size_t n, const char *file, int line)
+{
+    return XLALMallocAlignedLong(n, file, line);
+}
+
+void *XLALFactoryMallocAlignedLong(size_t n, const char *file, int line)
+{
+    return XLALMallocAlignedLong(n, file, line);
+}
+
+#endif /* LAL_FFTW3_MEMALIGN_ENABLED */
+
 #endif /* !LAL_MEMORY_FUNCTIONS_DISABLED */
@@ -69,6 +69,30 @@ void XLALFreeAligned(void *ptr);
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 /** @} */
 
+#ifndef SWIG    /* exclude from SWIG interface */
+/** \addtogroup LALMalloc_h */ /** @{ */
+/** Opaque type of a scoped memory arena; see \ref LALMalloc_h for details */
+typedef struct tagLALMallocArena LALMallocArena;
+LALMallocArena *XLALCreateMallocArena(size_t blockSize);
+void XLALDestroyMallocArena(LALMallocArena *arena);
+int XLALPushMallocArena(LALMallocArena *arena);
+int XLALPushMallocArenaFactories(LALMallocArena *arena);
+int XLALPopMallocArena(void);
+void *XLALArenaMalloc(size_t n);
+void *XLALArenaMallocLong(size_t n, const char *file, int line);
+#define XLALArenaMalloc( n )   XLALArenaMallocLong( n, __FILE__, __LINE__ )
+void *XLALFactoryMallocLong(size_t n, const char *file, int line);
+#define XLALFactoryMalloc( n )   XLALFactoryMallocLong( n, __FILE__, __LINE__ )
+#ifdef LAL_FFTW3_MEMALIGN_ENABLED
+void *XLALArenaMallocAligned(size_t n);
+void *XLALArenaMallocAlignedLong(size_t n, const char *file, int line);
+#define XLALArenaMallocAligned( n )   XLALArenaMallocAlignedLong( n, __FILE__, __LINE__ )
+void *XLALFactoryMallocAlignedLong(size_t n, const char *file, int line);
+#define XLALFactoryMallocAligned( n )   XLALFactoryMallocAlignedLong( n, __FILE__, __LINE__ )
+#endif /* LAL_FFTW3_MEMALIGN_ENABLED */
+/** @} */
+#endif /* SWIG */
+
 #ifdef LAL_MEMORY_FUNCTIONS_DISABLED
 
 #ifndef SWIG    /* exclude from SWIG interface */
@@ -185,6 +185,7 @@ int XLALH5AttributeQueryEnumName(char *name, size_t size, const LALH5Generic obj
 int XLALH5AttributeQueryEnumValue(const LALH5Generic object, const char *key, int pos);
 
 LALH5Dataset * XLALH5TableAlloc(LALH5File *file, const char *name, size_t ncols, const char **cols, const LALTYPECODE *types, const size_t *offsets, size_t rowsz);
+LALH5Dataset * XLALH5TableAllocChunked(LALH5File *file, const char *name, size_t ncols, const char **cols, const LALTYPECODE *types, const size_t *offsets, size_t rowsz, size_t chunk_size, int compress);
 int XLALH5TableAppend(LALH5Dataset *dset, const size_t *offsets, const size_t *colsz, size_t nrows, size_t rowsz, const void *data);
 
 int XLALH5TableRead(void *data, const LALH5Dataset *dset, const size_t *offsets, const size_t *colsz, size_t rowsz);
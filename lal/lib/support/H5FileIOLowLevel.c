@@ -33,6 +33,7 @@
 
 #define LAL_H5_FILE_MODE_READ  H5F_ACC_RDONLY
 #define LAL_H5_FILE_MODE_WRITE H5F_ACC_TRUNC
+#define LAL_H5_FILE_MODE_APPEND H5F_ACC_RDWR
 
 struct tagLALH5Object {
 	hid_t object_id; /* this object's id must be first */
@@ -340,6 +341,44 @@ static LALH5File * XLALH5FileOpenRead(const char *path)
 	return file;
 }
 
+/* checks quietly whether each group along a path exists */
+static int XLALH5GroupPathExists(hid_t loc_id, const char *name)
+{
+	char path[FILENAME_MAX];
+	char *s;
+	if (XLALStringCopy(path, name, sizeof(path)) >= sizeof(path))
+		XLAL_ERROR(XLAL_EINVAL, "Group name `%s' is too long", name);
+	for (s = strchr(path + (path[0] == '/'), '/'); s; s = strchr(s + 1, '/')) {
+		*s = '\0';
+		if (threadsafe_H5Lexists(loc_id, path, H5P_DEFAULT) <= 0)
+			return 0;
+		*s = '/';
+	}
+	return threadsafe_H5Lexists(loc_id, path, H5P_DEFAULT) > 0;
+}
+
+/* opens a HDF5 file for appending, creating it if it does not exist */
+static LALH5File * XLALH5FileOpenAppend(const char *path)
+{
+	LALH5File *file;
+	FILE *fp;
+	file = LALCalloc(1, sizeof(*file));
+	if (!file)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	XLALStringCopy(file->fname, path, sizeof(file->fname));
+	if ((fp = fopen(path, "r"))) {
+		fclose(fp);
+		file->file_id = threadsafe_H5Fopen(path, H5F_ACC_RDWR, H5P_DEFAULT);
+	} else
+		file->file_id = threadsafe_H5Fcreate(path, H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+	if (file->file_id < 0) {
+		LALFree(file);
+		XLAL_ERROR_NULL(XLAL_EIO, "Could not open HDF5 file `%s' for appending", path);
+	}
+	file->mode = LAL_H5_FILE_MODE_APPEND;
+	return file;
+}
+
 #if 0
 static hid_t XLALGetObjectIdentifier(const void *ptr)
 {
@@ -380,6 +419,8 @@ static hid_t XLALGetObjectIdentifier(const void *ptr)
  * This routine closes a ::LALH5File and deallocates resources
  * associated with it.  If the file was opened for writing, this
  * routine also renames the temporary file as the actual file.
+ * If the file was opened for appending, any buffered data is
+ * flushed to the file.
  *
  * @param file A pointer to a ::LALH5File structure to close.
  */
@@ -408,7 +449,8 @@ void XLALH5FileClose(LALH5File UNUSED *file)
 					LALFree(file);
 					XLAL_ERROR_VOID(XLAL_EIO, "Failed to move temporary file");
 				}
-			}
+			} else if (file->mode == LAL_H5_FILE_MODE_APPEND)
+				threadsafe_H5Fflush(file->file_id, H5F_SCOPE_GLOBAL);
 			threadsafe_H5Fclose(file->file_id);
 		}
 		LALFree(file);
@@ -429,14 +471,18 @@ void XLALH5FileClose(LALH5File UNUSED *file)
  * <dl>
  * <dt>r</dt><dd>Open file for reading.</dd>
  * <dt>w</dt><dd>Truncate to zero length or create file for writing.</dd>
+ * <dt>a</dt><dd>Open file for reading and writing, creating it if it does
+ * not exist.</dd>
  * </dl>
  *
  * If a file is opened for writing then data is initially written to a
  * temporary file, and this file is renamed once the ::LALH5File structure
- * is closed with XLALH5FileClose().
+ * is closed with XLALH5FileClose().  A file opened for appending is
+ * modified in place, so that new rows can be added to existing tables
+ * with XLALH5TableAppend() without rewriting the rest of the file.
  *
  * @param path Pointer to a string containing the path of the file to open.
- * @param mode Mode to open the file, either "r" or "w".
+ * @param mode Mode to open the file, either "r", "w" or "a".
  * @returns A pointer to a ::LALH5File structure associated with the
  * specified HDF5 file.
  * @retval NULL An error occurred opening the file.
@@ -452,7 +498,9 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
 		return XLALH5FileOpenRead(path);
 	else if (strcmp(mode, "w") == 0)
 		return XLALH5FileCreate(path);
-	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\" or \"w\"", mode);
+	else if (strcmp(mode, "a") == 0)
+		return XLALH5FileOpenAppend(path);
+	XLAL_ERROR_NULL(XLAL_EINVAL, "Invalid mode \"%s\": must be either \"r\", \"w\" or \"a\"", mode);
 #endif
 }
 
@@ -463,7 +511,8 @@ LALH5File * XLALH5FileOpen(const char UNUSED *path, const char UNUSED *mode)
  * associated with the ::LALH5File @p file.  If the HDF5 file is
  * being read, the specified group must exist in that file.  If
  * the HDF5 file is being written, the specified group is created
- * within the file.
+ * within the file.  If the HDF5 file is being appended to, the
+ * specified group is opened if it exists and is created otherwise.
  *
  * @param file Pointer to a ::LALH5File structure in which to open the group.
  * @param name Pointer to a string with the name of the group to open.
@@ -486,9 +535,10 @@ LALH5File * XLALH5GroupOpen(LALH5File UNUSED *file, const char UNUSED *name)
 	group->mode = file->mode;
 	if (!name) /* this is the same as the file */
 		group->file_id = file->file_id;
-	else if (group->mode == LAL_H5_FILE_MODE_READ)
+	else if (group->mode == LAL_H5_FILE_MODE_READ
+		|| (group->mode == LAL_H5_FILE_MODE_APPEND && XLALH5GroupPathExists(file->file_id, name) > 0))
 		group->file_id = threadsafe_H5Gopen2(file->file_id, name, H5P_DEFAULT);
-	else if (group->mode == LAL_H5_FILE_MODE_WRITE) {
+	else if (group->mode == LAL_H5_FILE_MODE_WRITE || group->mode == LAL_H5_FILE_MODE_APPEND) {
 		hid_t gcpl; /* property list to allow intermediate groups to be created */
 		gcpl = threadsafe_H5Pcreate(H5P_LINK_CREATE);
 		if (gcpl < 0 || threadsafe_H5Pset_create_intermediate_group(gcpl, 1) < 0) {
@@ -941,7 +991,7 @@ void XLALH5DatasetFree(LALH5Dataset UNUSED *dset)
  * the UINT4Vector @p dimLength.
  *
  * The ::LALH5File @p file passed to this routine must be a file
- * opened for writing.
+ * opened for writing or appending.
  *
  * @param file Pointer to a ::LALH5File structure in which to create the dataset.
  * @param name Pointer to a string with the name of the dataset to create.
@@ -964,7 +1014,7 @@ LALH5Dataset * XLALH5DatasetAlloc(LALH5File UNUSED *file, const char UNUSED *nam
 
 	if (name == NULL || file == NULL || dimLength == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1026,7 +1076,7 @@ LALH5Dataset * XLALH5DatasetAlloc(LALH5File UNUSED *file, const char UNUSED *nam
  * the @p length parameter.
  *
  * The ::LALH5File @p file passed to this routine must be a file
- * opened for writing.
+ * opened for writing or appending.
  *
  * @param file Pointer to a ::LALH5File structure in which to create the dataset.
  * @param name Pointer to a string with the name of the dataset to create.
@@ -1047,7 +1097,7 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
 
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1098,7 +1148,7 @@ LALH5Dataset * XLALH5DatasetAlloc1D(LALH5File UNUSED *file, const char UNUSED *n
  * parameter.
  *
  * The ::LALH5File @p file passed to this routine must be a file
- * opened for writing.
+ * opened for writing or appending.
  *
  * @param file Pointer to a ::LALH5File structure in which to create the dataset.
  * @param name Pointer to a string with the name of the dataset to create.
@@ -1118,7 +1168,7 @@ LALH5Dataset * XLALH5DatasetAllocStringData(LALH5File UNUSED *file, const char U
 
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	namelen = strlen(name);
@@ -1194,7 +1244,7 @@ int XLALH5DatasetWrite(LALH5Dataset UNUSED *dset, void UNUSED *data)
  * ::LALH5Dataset structure associated with the dataset.
  *
  * The ::LALH5File @p file passed to this routine must be a file
- * opened for reading.
+ * opened for reading or appending.
  *
  * @param file Pointer to a ::LALH5File structure containing the dataset
  * to be opened.
@@ -1213,7 +1263,7 @@ LALH5Dataset * XLALH5DatasetRead(LALH5File UNUSED *file, const char UNUSED *name
 	size_t namelen;
 	if (name == NULL || file == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
-	if (file->mode != LAL_H5_FILE_MODE_READ)
+	if (file->mode == LAL_H5_FILE_MODE_WRITE)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to read a write-only HDF5 file");
 
 	namelen = strlen(name);
@@ -3223,11 +3273,43 @@ LIGOTimeGPS * XLALH5DatasetQueryLIGOTimeGPSAttributeValue(LIGOTimeGPS UNUSED *va
  * @retval NULL An error occurred creating the dataset.
  */
 LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name, size_t UNUSED ncols, const char UNUSED **cols, const LALTYPECODE UNUSED *types, const size_t UNUSED *offsets, size_t UNUSED rowsz)
+{
+	LALH5Dataset *dset = XLALH5TableAllocChunked(file, name, ncols, cols, types, offsets, rowsz, 32, 0);
+	if (!dset)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return dset;
+}
+
+/**
+ * @brief Allocates a ::LALH5Dataset dataset to hold a table with a given
+ * chunk size and optional compression.
+ * @details
+ * This routine is the same as XLALH5TableAlloc() except that the table is
+ * stored in chunks of @p chunk_size rows, and that the chunks are compressed
+ * with the deflate filter if @p compress is non-zero.  Tables that are
+ * filled incrementally with XLALH5TableAppend() should use a chunk size
+ * comparable to the number of rows appended at a time.
+ *
+ * @param file Pointer to a ::LALH5File in which to create the dataset.
+ * @param name Pointer to a string with the name of the dataset to create (also
+ * the table name).
+ * @param ncols Number of columns in each row.
+ * @param cols Pointer to an array of strings giving the column names.
+ * @param types Pointer to an array of \c LALTYPECODE values specifying the data
+ * type of each column.
+ * @param offsets Pointer to an array of offsets for each column.
+ * @param rowsz Size of each row of data.
+ * @param chunk_size Number of rows in each chunk of the dataset.
+ * @param compress Compress the chunks if non-zero.
+ * @returns A pointer to a ::LALH5Dataset structure associated with the specified
+ * dataset within a HDF5 file.
+ * @retval NULL An error occurred creating the dataset.
+ */
+LALH5Dataset * XLALH5TableAllocChunked(LALH5File UNUSED *file, const char UNUSED *name, size_t UNUSED ncols, const char UNUSED **cols, const LALTYPECODE UNUSED *types, const size_t UNUSED *offsets, size_t UNUSED rowsz, size_t UNUSED chunk_size, int UNUSED compress)
 {
 #ifndef HAVE_HDF5
 	XLAL_ERROR_NULL(XLAL_EFAILED, "HDF5 support not implemented");
 #else
-	const size_t chunk_size = 32;
 	hid_t dtype_id[ncols];
 	hid_t tdtype_id;
 	size_t col;
@@ -3238,7 +3320,10 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 	if (file == NULL || cols == NULL || types == NULL || offsets == NULL)
 		XLAL_ERROR_NULL(XLAL_EFAULT);
 
-	if (file->mode != LAL_H5_FILE_MODE_WRITE)
+	if (chunk_size == 0)
+		XLAL_ERROR_NULL(XLAL_EINVAL, "Chunk size must be positive");
+
+	if (file->mode == LAL_H5_FILE_MODE_READ)
 		XLAL_ERROR_NULL(XLAL_EINVAL, "Attempting to write to a read-only HDF5 file");
 
 	/* map the LAL types to HDF5 types */
@@ -3250,7 +3335,7 @@ LALH5Dataset * XLALH5TableAlloc(LALH5File UNUSED *file, const char UNUSED *name,
 
 	/* make empty table */
 	/* note: table title and dataset name are the same */
-	status = threadsafe_H5TBmake_table(name, file->file_id, name, ncols, 0, rowsz, cols, offsets, dtype_id, chunk_size, NULL, 0, NULL);
+	status = threadsafe_H5TBmake_table(name, file->file_id, name, ncols, 0, rowsz, cols, offsets, dtype_id, chunk_size, NULL, compress ? 1 : 0, NULL);
 	for (col = 0; col < ncols; ++col)
 		threadsafe_H5Tclose(dtype_id[col]);
 
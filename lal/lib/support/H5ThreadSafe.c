@@ -275,6 +275,14 @@ static inline ssize_t threadsafe_H5Iget_name(hid_t id, char *name , size_t size)
 	return retval;
 }
 
+static inline htri_t threadsafe_H5Lexists(hid_t loc_id, const char *name, hid_t lapl_id)
+{
+	LAL_HDF5_MUTEX_LOCK
+	htri_t retval = H5Lexists(loc_id, name, lapl_id);
+	LAL_HDF5_MUTEX_UNLOCK
+	return retval;
+}
+
 static inline herr_t threadsafe_H5Oclose(hid_t object_id)
 {
 	LAL_HDF5_MUTEX_LOCK
@@ -675,6 +683,7 @@ static inline herr_t threadsafe_H5open(void)
 #define threadsafe_H5Gget_objtype_by_idx H5Gget_objtype_by_idx
 #define threadsafe_H5Gopen2 H5Gopen2
 #define threadsafe_H5Iget_name H5Iget_name
+#define threadsafe_H5Lexists H5Lexists
 #define threadsafe_H5Oclose H5Oclose
 #define threadsafe_H5Oget_info H5Oget_info
 #define threadsafe_H5Oget_info_by_idx H5Oget_info_by_idx
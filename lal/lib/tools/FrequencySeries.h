@@ -84,6 +84,51 @@ UINT4FrequencySeries *XLALCreateUINT4FrequencySeries ( const CHAR *name, const L
 UINT8FrequencySeries *XLALCreateUINT8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
 /** @} */
 
+/**
+ * \name Reuse Functions
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/FrequencySeries.h>
+ *
+ * XLALCreate<frequencyseriestype>Into()
+ * \endcode
+ *
+ * ### Description ###
+ *
+ * These functions are equivalent to the creation functions, but recycle
+ * the frequency series \c series, which is returned with its metadata set from
+ * the remaining arguments and its data resized to \c length samples.  The
+ * number of samples the data can hold is kept by the caller in
+ * <tt>*capacity</tt>, which is set on return.  The data are only
+ * reallocated if \c length exceeds it; when the series shrinks only the
+ * length is changed and the storage is kept, so a series may be shrunk and
+ * regrown in a loop at the cost of at most one allocation per new maximum
+ * length.  <tt>*capacity</tt> must be the value returned by the previous
+ * call for the same series, or zero for a series not made by these
+ * functions or resized by other means since; if \c capacity is \c NULL the
+ * current length is taken as the capacity.  The contents of the data are
+ * unspecified, as for a new series.  If \c series is \c NULL, a new series
+ * is created.  On failure, \c NULL is returned and \c series is left valid,
+ * to be destroyed by the caller.
+ */
+/** @{ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(INOUT_SCALARS(size_t*, capacity));
+#endif
+COMPLEX8FrequencySeries *XLALCreateCOMPLEX8FrequencySeriesInto ( COMPLEX8FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+COMPLEX16FrequencySeries *XLALCreateCOMPLEX16FrequencySeriesInto ( COMPLEX16FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+REAL4FrequencySeries *XLALCreateREAL4FrequencySeriesInto ( REAL4FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+REAL8FrequencySeries *XLALCreateREAL8FrequencySeriesInto ( REAL8FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT2FrequencySeries *XLALCreateINT2FrequencySeriesInto ( INT2FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT4FrequencySeries *XLALCreateINT4FrequencySeriesInto ( INT4FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT8FrequencySeries *XLALCreateINT8FrequencySeriesInto ( INT8FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT2FrequencySeries *XLALCreateUINT2FrequencySeriesInto ( UINT2FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT4FrequencySeries *XLALCreateUINT4FrequencySeriesInto ( UINT4FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT8FrequencySeries *XLALCreateUINT8FrequencySeriesInto ( UINT8FrequencySeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+/** @} */
+
 /**
  * \name Destruction Functions
  *
@@ -18,12 +18,16 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALStdio.h>
 #include <lal/AVFactories.h>
 #include <lal/LALConstants.h>
 #include <lal/IIRFilter.h>
 #include <lal/BandPassTimeSeries.h>
+#include <lal/RealFFT.h>
+#include <lal/Sequence.h>
+#include <lal/Window.h>
 #include <lal/ResampleTimeSeries.h>
 
 #if __GNUC__
@@ -118,9 +122,53 @@
  * LDAS. See the LDAS dataconditioning API documentation for more information.
  * </ol>
  *
+ * ### Polyphase FIR resampling ###
+ *
+ * The routines XLALResampleREAL4TimeSeriesRational() and
+ * XLALResampleREAL8TimeSeriesRational() resample a time series in place to
+ * any sample interval \c dt for which the ratio <tt>dt / deltaT</tt> is a
+ * rational number \f$M/L\f$ with \f$L, M \le 4096\f$ (see
+ * XLALResamplerRationalRatio()).  Both upsampling and downsampling are
+ * supported.  Conceptually the input is upsampled by \f$L\f$ by inserting
+ * zeros, low-pass filtered, and decimated by \f$M\f$; the filter is applied
+ * in polyphase form so that only the products that contribute to retained
+ * output samples are computed.  The filter is a Kaiser-windowed sinc with
+ * its cutoff at 90% of the lower of the two Nyquist frequencies, and it
+ * spans \c halfWidth samples of the lower of the two sample rates on
+ * either side of each output sample (default 16).  Each polyphase branch is
+ * normalised to unit DC gain.  When downsampling by an integer factor with
+ * a long filter, the filter is instead applied by FFT overlap-save
+ * convolution, which is cheaper than direct evaluation for long filters.
+ *
+ * The filter is linear phase and is applied without delay:  the output
+ * sample \f$m\f$ is at time <tt>epoch + m * dt</tt>, and the output
+ * contains one sample for each such time not later than the last input
+ * sample.  Input before the start and after the end of the series is taken
+ * to be zero, so \c halfWidth output samples at either end are affected by
+ * the edges.
+ *
+ * The same filter is available as a streaming object for chunked input.
+ * XLALCreateREAL8Resampler() creates a resampler from the input and output
+ * sample intervals, XLALREAL8ResamplerApply() accepts the next chunk of
+ * input and returns as many output samples as can be computed from the
+ * input seen so far, and XLALREAL8ResamplerFlush() returns the remaining
+ * output samples at the end of the stream.  Concatenating the outputs of
+ * successive calls gives the same result as resampling the concatenated
+ * input in one go.  After flushing, XLALREAL8ResamplerReset() must be
+ * called before the resampler is used for a new stream.  The \c REAL4
+ * variants are identical but compute in single precision.
+ *
  */
 /** @{ */
 
+/* defaults and limits of the polyphase FIR resampler */
+#define RESAMPLER_DEFAULT_HALFWIDTH 16
+#define RESAMPLER_MAX_FACTOR 4096
+#define RESAMPLER_KAISER_BETA 8.0
+#define RESAMPLER_ROLLOFF 0.9
+#define RESAMPLER_FFT_MIN_TAPS 96
+#define RESAMPLER_CHUNK_LENGTH 65536
+
 /** \see See \ref ResampleTimeSeries_c for documentation */
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
 {
@@ -218,6 +266,130 @@ int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
 }
 
 
+/**
+ * Express the ratio of two sample intervals as a rational number.  On
+ * success \c up and \c down are set to the smallest positive integers,
+ * neither greater than 4096, such that <tt>deltaTOut / deltaTIn</tt>
+ * equals <tt>down / up</tt> to a relative accuracy of \f$10^{-10}\f$.
+ * Fails with \c XLAL_EINVAL if no such pair exists.
+ */
+int XLALResamplerRationalRatio( UINT4 *up, UINT4 *down, REAL8 deltaTIn, REAL8 deltaTOut )
+{
+  const REAL8 ratio = deltaTOut / deltaTIn;
+  REAL8 x = ratio;
+  /* continued fraction convergents h / k of ratio */
+  REAL8 h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+
+  if ( ! up || ! down )
+    XLAL_ERROR( XLAL_EFAULT );
+  if ( ! ( deltaTIn > 0 ) || ! ( deltaTOut > 0 ) || ! isfinite( ratio ) )
+    XLAL_ERROR( XLAL_EINVAL, "Invalid sample intervals %g, %g", deltaTIn, deltaTOut );
+
+  while ( 1 )
+  {
+    REAL8 a = floor( x );
+    REAL8 h2 = a * h1 + h0;
+    REAL8 k2 = a * k1 + k0;
+    if ( h2 > RESAMPLER_MAX_FACTOR || k2 > RESAMPLER_MAX_FACTOR )
+      break;
+    h0 = h1; h1 = h2;
+    k0 = k1; k1 = k2;
+    if ( fabs( h1 / k1 - ratio ) <= 1e-10 * ratio || x == a )
+    {
+      *down = h1;
+      *up = k1;
+      return 0;
+    }
+    x = 1.0 / ( x - a );
+  }
+
+  XLAL_ERROR( XLAL_EINVAL, "Resampling ratio %.17g is not a ratio of integers <= %d", ratio, RESAMPLER_MAX_FACTOR );
+}
+
+
+/*
+ * Design the polyphase anti-aliasing filter for resampling by up / down.
+ * Returns an up x nTaps table (freed with XLALFree()) whose row p holds
+ * the taps applied to input samples jhi - nTaps + 1, ..., jhi for the
+ * output samples at upsampled index n with (n + halfLength) mod up = p.
+ */
+static REAL8 *resampler_design( UINT4 up, UINT4 down, UINT4 halfWidth, UINT4 *halfLength, UINT4 *nTaps )
+{
+  const UINT4 factor = up > down ? up : down;
+  /* cutoff frequency in cycles per upsampled sample */
+  const REAL8 fc = RESAMPLER_ROLLOFF * 0.5 / factor;
+  const UINT4 D = halfWidth * factor;
+  const UINT4 K = 2 * D / up + 1;
+  REAL8Window *window;
+  REAL8 *taps;
+  UINT4 p, i;
+
+  window = XLALCreateKaiserREAL8Window( 2 * D + 1, RESAMPLER_KAISER_BETA );
+  taps = XLALCalloc( (size_t) up * K, sizeof( *taps ) );
+  if ( ! window || ! taps )
+  {
+    XLALDestroyREAL8Window( window );
+    XLALFree( taps );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  for ( p = 0; p < up; ++p )
+  {
+    REAL8 *row = taps + (size_t) p * K;
+    REAL8 sum = 0;
+    for ( i = 0; i < K; ++i )
+    {
+      UINT4 k = p + ( K - 1 - i ) * up;
+      REAL8 x;
+      if ( k > 2 * D )
+        continue;
+      x = LAL_PI * 2.0 * fc * ( (INT4) k - (INT4) D );
+      row[i] = 2.0 * fc * ( x == 0 ? 1.0 : sin( x ) / x ) * window->data->data[k];
+      sum += row[i];
+    }
+    /* normalise each branch to unit DC gain */
+    if ( sum != 0 )
+      for ( i = 0; i < K; ++i )
+        row[i] /= sum;
+  }
+
+  XLALDestroyREAL8Window( window );
+  *halfLength = D;
+  *nTaps = K;
+  return taps;
+}
+
+
+/* index of the first input sample used by output sample m */
+static INT8 resampler_first_input( INT8 m, UINT4 up, UINT4 down, UINT4 halfLength, UINT4 nTaps )
+{
+  return ( m * down + halfLength ) / up - nTaps + 1;
+}
+
+
+/* number of outputs from nextOut onwards that can be computed once nInput
+ * input samples have been received */
+static size_t resampler_output_count( INT8 nInput, UINT4 up, UINT4 down, UINT4 halfLength, INT8 nextOut )
+{
+  INT8 last = nInput * up - halfLength - 1;
+  INT8 end = last < 0 ? 0 : last / down + 1;
+  return end > nextOut ? end - nextOut : 0;
+}
+
+
+#define DATATYPE REAL4
+#define COMPLEXTYPE COMPLEX8
+#include "ResampleTimeSeries_source.c"
+#undef COMPLEXTYPE
+#undef DATATYPE
+
+#define DATATYPE REAL8
+#define COMPLEXTYPE COMPLEX16
+#include "ResampleTimeSeries_source.c"
+#undef COMPLEXTYPE
+#undef DATATYPE
+
+
 /**
  * \deprecated Use XLALResampleREAL4TimeSeries() instead.
  */
@@ -36,7 +36,11 @@ extern "C" {
  *
  * \brief Provides routines to resample a time series.
  *
- * At present only integer downsampling of \c REAL4TimeSeries by a power of two is supported.
+ * The original routines support only integer downsampling by a power of two,
+ * using an IIR Butterworth low-pass filter.  A polyphase FIR resampler,
+ * which supports arbitrary rational resampling ratios and chunked
+ * (streaming) input, is provided by the \c LALREAL4Resampler and
+ * \c LALREAL8Resampler objects.
  *
  * ### Synopsis ###
  *
@@ -129,6 +133,18 @@ tagResampleTSParams
 }
 ResampleTSParams;
 
+/**
+ * Opaque polyphase FIR resampler state for \c REAL4 data.
+ * See \ref ResampleTimeSeries_c for documentation.
+ */
+typedef struct tagLALREAL4Resampler LALREAL4Resampler;
+
+/**
+ * Opaque polyphase FIR resampler state for \c REAL8 data.
+ * See \ref ResampleTimeSeries_c for documentation.
+ */
+typedef struct tagLALREAL8Resampler LALREAL8Resampler;
+
 /** @} */
 
 /* ---------- Function prototypes ---------- */
@@ -136,6 +152,22 @@ ResampleTSParams;
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
 
+int XLALResamplerRationalRatio( UINT4 *up, UINT4 *down, REAL8 deltaTIn, REAL8 deltaTOut );
+
+LALREAL4Resampler *XLALCreateREAL4Resampler( REAL8 deltaTIn, REAL8 deltaTOut, UINT4 halfWidth );
+void XLALDestroyREAL4Resampler( LALREAL4Resampler *resampler );
+int XLALREAL4ResamplerReset( LALREAL4Resampler *resampler );
+REAL4Sequence *XLALREAL4ResamplerApply( LALREAL4Resampler *resampler, const REAL4Sequence *input );
+REAL4Sequence *XLALREAL4ResamplerFlush( LALREAL4Resampler *resampler );
+int XLALResampleREAL4TimeSeriesRational( REAL4TimeSeries *series, REAL8 dt );
+
+LALREAL8Resampler *XLALCreateREAL8Resampler( REAL8 deltaTIn, REAL8 deltaTOut, UINT4 halfWidth );
+void XLALDestroyREAL8Resampler( LALREAL8Resampler *resampler );
+int XLALREAL8ResamplerReset( LALREAL8Resampler *resampler );
+REAL8Sequence *XLALREAL8ResamplerApply( LALREAL8Resampler *resampler, const REAL8Sequence *input );
+REAL8Sequence *XLALREAL8ResamplerFlush( LALREAL8Resampler *resampler );
+int XLALResampleREAL8TimeSeriesRational( REAL8TimeSeries *series, REAL8 dt );
+
 void
 LALResampleREAL4TimeSeries(
     LALStatus          *status,
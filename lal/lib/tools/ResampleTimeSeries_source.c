@@ -0,0 +1,466 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+
+#define RESAMPLERTYPE CONCAT3(LAL,DATATYPE,Resampler)
+#define RESAMPLERTAG CONCAT3(tagLAL,DATATYPE,Resampler)
+#define SEQUENCETYPE CONCAT2(DATATYPE,Sequence)
+#define SERIESTYPE CONCAT2(DATATYPE,TimeSeries)
+#define VECTORTYPE CONCAT2(DATATYPE,Vector)
+#define COMPLEXVECTORTYPE CONCAT2(COMPLEXTYPE,Vector)
+#define FFTPLANTYPE CONCAT2(DATATYPE,FFTPlan)
+
+#define CREATEFUNC CONCAT3(XLALCreate,DATATYPE,Resampler)
+#define DESTROYFUNC CONCAT3(XLALDestroy,DATATYPE,Resampler)
+#define RESETFUNC CONCAT3(XLAL,DATATYPE,ResamplerReset)
+#define APPLYFUNC CONCAT3(XLAL,DATATYPE,ResamplerApply)
+#define FLUSHFUNC CONCAT3(XLAL,DATATYPE,ResamplerFlush)
+#define SERIESFUNC CONCAT3(XLALResample,DATATYPE,TimeSeriesRational)
+
+#define CSEQUENCE CONCAT3(XLALCreate,DATATYPE,Sequence)
+#define DSEQUENCE CONCAT3(XLALDestroy,DATATYPE,Sequence)
+#define CVECTOR CONCAT3(XLALCreate,DATATYPE,Vector)
+#define DVECTOR CONCAT3(XLALDestroy,DATATYPE,Vector)
+#define CCVECTOR CONCAT3(XLALCreate,COMPLEXTYPE,Vector)
+#define DCVECTOR CONCAT3(XLALDestroy,COMPLEXTYPE,Vector)
+#define CFWDPLAN CONCAT3(XLALCreateForward,DATATYPE,FFTPlan)
+#define CREVPLAN CONCAT3(XLALCreateReverse,DATATYPE,FFTPlan)
+#define DPLAN CONCAT3(XLALDestroy,DATATYPE,FFTPlan)
+#define FWDFFT CONCAT3(XLAL,DATATYPE,ForwardFFT)
+#define REVFFT CONCAT3(XLAL,DATATYPE,ReverseFFT)
+#define RSEQUENCE CONCAT3(XLALResize,DATATYPE,Sequence)
+
+#define DOTFUNC CONCAT2(resampler_dot_,DATATYPE)
+#define APPENDFUNC CONCAT2(resampler_append_,DATATYPE)
+#define DISCARDFUNC CONCAT2(resampler_discard_,DATATYPE)
+#define DIRECTFUNC CONCAT2(resampler_direct_,DATATYPE)
+#define BLOCKFUNC CONCAT2(resampler_fft_block_,DATATYPE)
+#define RUNFUNC CONCAT2(resampler_run_,DATATYPE)
+
+
+struct RESAMPLERTAG
+{
+  UINT4 up;               /* upsampling factor */
+  UINT4 down;             /* downsampling factor */
+  UINT4 halfLength;       /* half-length of the filter at the upsampled rate */
+  UINT4 nTaps;            /* number of taps in each polyphase branch */
+  DATATYPE *taps;         /* up x nTaps polyphase coefficient table */
+  DATATYPE *buf;          /* input history */
+  size_t bufLength;       /* number of samples held in buf */
+  size_t bufSize;         /* allocated size of buf */
+  INT8 bufStart;          /* input sample index of buf[0] */
+  INT8 nextOut;           /* output sample index of next output */
+  INT8 nInput;            /* number of input samples received */
+  /* overlap-save workspace, only used when up == 1 and nTaps is large */
+  FFTPLANTYPE *fwdplan;
+  FFTPLANTYPE *revplan;
+  VECTORTYPE *block;
+  COMPLEXVECTORTYPE *blockFD;
+  COMPLEXVECTORTYPE *filterFD;
+};
+
+
+/* inner product of one polyphase branch with the input history; the
+ * independent partial sums let the compiler keep them in separate vector
+ * registers */
+static DATATYPE DOTFUNC( const DATATYPE *restrict a, const DATATYPE *restrict b, UINT4 n )
+{
+  DATATYPE s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  UINT4 i;
+  for ( i = 0; i + 4 <= n; i += 4 )
+  {
+    s0 += a[i] * b[i];
+    s1 += a[i + 1] * b[i + 1];
+    s2 += a[i + 2] * b[i + 2];
+    s3 += a[i + 3] * b[i + 3];
+  }
+  for ( ; i < n; ++i )
+    s0 += a[i] * b[i];
+  return ( s0 + s1 ) + ( s2 + s3 );
+}
+
+
+static int APPENDFUNC( RESAMPLERTYPE *r, const DATATYPE *data, size_t length )
+{
+  if ( r->bufLength + length > r->bufSize )
+  {
+    size_t size = r->bufSize ? r->bufSize : 1024;
+    DATATYPE *buf;
+    while ( size < r->bufLength + length )
+      size *= 2;
+    buf = XLALRealloc( r->buf, size * sizeof( *buf ) );
+    if ( ! buf )
+      XLAL_ERROR( XLAL_ENOMEM );
+    r->buf = buf;
+    r->bufSize = size;
+  }
+  if ( data )
+    memcpy( r->buf + r->bufLength, data, length * sizeof( *data ) );
+  else
+    memset( r->buf + r->bufLength, 0, length * sizeof( *r->buf ) );
+  r->bufLength += length;
+  return 0;
+}
+
+
+/* drop input history that is no longer needed by any future output */
+static void DISCARDFUNC( RESAMPLERTYPE *r )
+{
+  INT8 first = resampler_first_input( r->nextOut, r->up, r->down, r->halfLength, r->nTaps );
+  size_t ndrop;
+  if ( first <= r->bufStart )
+    return;
+  ndrop = first - r->bufStart;
+  if ( ndrop > r->bufLength )
+    ndrop = r->bufLength;
+  memmove( r->buf, r->buf + ndrop, ( r->bufLength - ndrop ) * sizeof( *r->buf ) );
+  r->bufLength -= ndrop;
+  r->bufStart += ndrop;
+}
+
+
+/* compute outputs [r->nextOut, r->nextOut + count) by polyphase filtering */
+static void DIRECTFUNC( RESAMPLERTYPE *r, DATATYPE *out, size_t count )
+{
+  const UINT4 up = r->up;
+  const UINT4 nTaps = r->nTaps;
+  INT8 n = r->nextOut * r->down + r->halfLength;
+  size_t m;
+  for ( m = 0; m < count; ++m, n += r->down )
+  {
+    INT8 jhi = n / up;
+    UINT4 phase = n - jhi * up;
+    INT8 jlo = jhi - nTaps + 1;
+    out[m] = DOTFUNC( r->taps + (size_t) phase * nTaps, r->buf + ( jlo - r->bufStart ), nTaps );
+  }
+  r->nextOut += count;
+}
+
+
+/* compute up to count outputs starting at r->nextOut by overlap-save
+ * convolution of one block of input; the number computed is returned in
+ * *done */
+static int BLOCKFUNC( RESAMPLERTYPE *r, DATATYPE *out, size_t count, size_t *done )
+{
+  const size_t blen = r->block->length;
+  const INT8 start = r->nextOut * r->down - r->halfLength;
+  const size_t offset = start - r->bufStart;
+  size_t navail = r->bufLength - offset;
+  size_t nvalid = ( blen - 1 - 2 * r->halfLength ) / r->down + 1;
+  size_t k;
+
+  if ( navail > blen )
+    navail = blen;
+  memcpy( r->block->data, r->buf + offset, navail * sizeof( *r->block->data ) );
+  memset( r->block->data + navail, 0, ( blen - navail ) * sizeof( *r->block->data ) );
+
+  if ( FWDFFT( r->blockFD, r->block, r->fwdplan ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  for ( k = 0; k < r->blockFD->length; ++k )
+    r->blockFD->data[k] *= r->filterFD->data[k];
+  if ( REVFFT( r->block, r->blockFD, r->revplan ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  if ( nvalid > count )
+    nvalid = count;
+  for ( k = 0; k < nvalid; ++k )
+    out[k] = r->block->data[2 * r->halfLength + k * r->down];
+  r->nextOut += nvalid;
+  *done = nvalid;
+  return 0;
+}
+
+
+/* compute all outputs that the current input history allows */
+static int RUNFUNC( RESAMPLERTYPE *r, DATATYPE *out, size_t count )
+{
+  while ( count )
+  {
+    size_t done;
+    if ( r->block && count * r->down >= ( r->block->length - 2 * r->halfLength ) / 2 )
+    {
+      if ( BLOCKFUNC( r, out, count, &done ) < 0 )
+        XLAL_ERROR( XLAL_EFUNC );
+    }
+    else
+    {
+      DIRECTFUNC( r, out, count );
+      done = count;
+    }
+    out += done;
+    count -= done;
+  }
+  DISCARDFUNC( r );
+  return 0;
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+RESAMPLERTYPE *CREATEFUNC( REAL8 deltaTIn, REAL8 deltaTOut, UINT4 halfWidth )
+{
+  RESAMPLERTYPE *r;
+  REAL8 *taps;
+  UINT4 up, down, halfLength, nTaps;
+  size_t i;
+
+  if ( ! ( deltaTIn > 0 ) || ! ( deltaTOut > 0 ) )
+    XLAL_ERROR_NULL( XLAL_EINVAL, "Sample intervals must be positive" );
+  if ( XLALResamplerRationalRatio( &up, &down, deltaTIn, deltaTOut ) < 0 )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  if ( halfWidth == 0 )
+    halfWidth = RESAMPLER_DEFAULT_HALFWIDTH;
+
+  taps = resampler_design( up, down, halfWidth, &halfLength, &nTaps );
+  if ( ! taps )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+
+  r = XLALCalloc( 1, sizeof( *r ) );
+  if ( ! r )
+  {
+    XLALFree( taps );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  r->up = up;
+  r->down = down;
+  r->halfLength = halfLength;
+  r->nTaps = nTaps;
+  r->taps = XLALMalloc( (size_t) up * nTaps * sizeof( *r->taps ) );
+  if ( ! r->taps )
+  {
+    XLALFree( taps );
+    DESTROYFUNC( r );
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  }
+  for ( i = 0; i < (size_t) up * nTaps; ++i )
+    r->taps[i] = taps[i];
+
+  /* long single-branch filters are cheaper to apply by FFT */
+  if ( up == 1 && nTaps >= RESAMPLER_FFT_MIN_TAPS )
+  {
+    UINT4 blen = 1;
+    while ( blen < 4 * nTaps )
+      blen *= 2;
+    r->fwdplan = CFWDPLAN( blen, 0 );
+    r->revplan = CREVPLAN( blen, 0 );
+    r->block = CVECTOR( blen );
+    r->blockFD = CCVECTOR( blen / 2 + 1 );
+    r->filterFD = CCVECTOR( blen / 2 + 1 );
+    if ( ! r->fwdplan || ! r->revplan || ! r->block || ! r->blockFD || ! r->filterFD )
+    {
+      XLALFree( taps );
+      DESTROYFUNC( r );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    /* convolution kernel is the time-reversed branch, normalised for the
+     * unnormalised reverse transform */
+    memset( r->block->data, 0, blen * sizeof( *r->block->data ) );
+    for ( i = 0; i < nTaps; ++i )
+      r->block->data[i] = taps[nTaps - 1 - i] / blen;
+    if ( FWDFFT( r->filterFD, r->block, r->fwdplan ) < 0 )
+    {
+      XLALFree( taps );
+      DESTROYFUNC( r );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+  XLALFree( taps );
+
+  if ( RESETFUNC( r ) < 0 )
+  {
+    DESTROYFUNC( r );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return r;
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+void DESTROYFUNC( RESAMPLERTYPE *r )
+{
+  if ( r )
+  {
+    XLALFree( r->taps );
+    XLALFree( r->buf );
+    DPLAN( r->fwdplan );
+    DPLAN( r->revplan );
+    DVECTOR( r->block );
+    DCVECTOR( r->blockFD );
+    DCVECTOR( r->filterFD );
+  }
+  XLALFree( r );
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+int RESETFUNC( RESAMPLERTYPE *r )
+{
+  INT8 first;
+  if ( ! r )
+    XLAL_ERROR( XLAL_EFAULT );
+  /* the input before the start of the stream is taken to be zero */
+  first = resampler_first_input( 0, r->up, r->down, r->halfLength, r->nTaps );
+  r->bufLength = 0;
+  r->bufStart = first;
+  r->nextOut = 0;
+  r->nInput = 0;
+  if ( APPENDFUNC( r, NULL, -first ) < 0 )
+    XLAL_ERROR( XLAL_EFUNC );
+  return 0;
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+SEQUENCETYPE *APPLYFUNC( RESAMPLERTYPE *r, const SEQUENCETYPE *input )
+{
+  SEQUENCETYPE *output;
+  size_t nout, done = 0, i;
+
+  if ( ! r || ! input )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+
+  nout = resampler_output_count( r->nInput + input->length, r->up, r->down, r->halfLength, r->nextOut );
+  output = CSEQUENCE( nout );
+  if ( ! output )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+
+  /* feed the input in chunks so the history buffer stays small */
+  for ( i = 0; i < input->length; i += RESAMPLER_CHUNK_LENGTH )
+  {
+    size_t n = input->length - i < RESAMPLER_CHUNK_LENGTH ? input->length - i : RESAMPLER_CHUNK_LENGTH;
+    size_t count;
+    if ( APPENDFUNC( r, input->data + i, n ) < 0 )
+    {
+      DSEQUENCE( output );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    r->nInput += n;
+    count = resampler_output_count( r->nInput, r->up, r->down, r->halfLength, r->nextOut );
+    if ( RUNFUNC( r, output->data + done, count ) < 0 )
+    {
+      DSEQUENCE( output );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    done += count;
+  }
+
+  return output;
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+SEQUENCETYPE *FLUSHFUNC( RESAMPLERTYPE *r )
+{
+  SEQUENCETYPE *output;
+  INT8 total, needed;
+  size_t nout;
+
+  if ( ! r )
+    XLAL_ERROR_NULL( XLAL_EFAULT );
+
+  /* one output for every output sample time not later than the last
+   * input sample time */
+  total = r->nInput > 0 ? ( ( r->nInput - 1 ) * r->up ) / r->down + 1 : 0;
+  nout = total > r->nextOut ? total - r->nextOut : 0;
+  output = CSEQUENCE( nout );
+  if ( ! output )
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  if ( ! nout )
+    return output;
+
+  /* pad the history with zeros up to the last input needed */
+  needed = ( ( total - 1 ) * r->down + r->halfLength ) / r->up + 1;
+  if ( needed > r->bufStart + (INT8) r->bufLength )
+    if ( APPENDFUNC( r, NULL, needed - r->bufStart - r->bufLength ) < 0 )
+    {
+      DSEQUENCE( output );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  if ( RUNFUNC( r, output->data, nout ) < 0 )
+  {
+    DSEQUENCE( output );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  return output;
+}
+
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+int SERIESFUNC( SERIESTYPE *series, REAL8 dt )
+{
+  RESAMPLERTYPE *r;
+  SEQUENCETYPE *head;
+  SEQUENCETYPE *tail;
+
+  if ( ! series || ! series->data )
+    XLAL_ERROR( XLAL_EFAULT );
+
+  r = CREATEFUNC( series->deltaT, dt, 0 );
+  if ( ! r )
+    XLAL_ERROR( XLAL_EFUNC );
+
+  /* just return if no resampling is required */
+  if ( r->up == 1 && r->down == 1 )
+  {
+    XLALPrintInfo( "XLAL Info - %s: No resampling required", __func__ );
+    DESTROYFUNC( r );
+    return 0;
+  }
+
+  head = APPLYFUNC( r, series->data );
+  tail = FLUSHFUNC( r );
+  if ( ! head || ! tail || ! RSEQUENCE( series->data, 0, head->length + tail->length ) )
+  {
+    DSEQUENCE( head );
+    DSEQUENCE( tail );
+    DESTROYFUNC( r );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  memcpy( series->data->data, head->data, head->length * sizeof( *head->data ) );
+  memcpy( series->data->data + head->length, tail->data, tail->length * sizeof( *tail->data ) );
+  series->deltaT = dt;
+
+  DSEQUENCE( head );
+  DSEQUENCE( tail );
+  DESTROYFUNC( r );
+  return 0;
+}
+
+
+#undef CONCAT2x
+#undef CONCAT2
+#undef CONCAT3x
+#undef CONCAT3
+#undef RESAMPLERTYPE
+#undef RESAMPLERTAG
+#undef SEQUENCETYPE
+#undef SERIESTYPE
+#undef VECTORTYPE
+#undef COMPLEXVECTORTYPE
+#undef FFTPLANTYPE
+#undef CREATEFUNC
+#undef DESTROYFUNC
+#undef RESETFUNC
+#undef APPLYFUNC
+#undef FLUSHFUNC
+#undef SERIESFUNC
+#undef CSEQUENCE
+#undef DSEQUENCE
+#undef CVECTOR
+#undef DVECTOR
+#undef CCVECTOR
+#undef DCVECTOR
+#undef CFWDPLAN
+#undef CREVPLAN
+#undef DPLAN
+#undef FWDFFT
+#undef REVFFT
+#undef RSEQUENCE
+#undef DOTFUNC
+#undef APPENDFUNC
+#undef DISCARDFUNC
+#undef DIRECTFUNC
+#undef BLOCKFUNC
+#undef RUNFUNC
@@ -73,6 +73,131 @@
  */
 
 
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Endpoint index used to search segment lists which are not disjoint.  The
+ * segments are ordered by start time, and maxEnd[i] holds the latest end
+ * time of entries 0..i, so a search for the segments containing a time can
+ * stop as soon as maxEnd drops to or below that time.
+ */
+struct tagLALSegListIndex
+{
+  UINT4 length;
+  INT8 *start;   /* start times (ns) in ascending order */
+  INT8 *end;     /* end times (ns) */
+  INT8 *maxEnd;  /* running maximum of end times (ns) */
+  UINT4 *order;  /* position in the segs array of each entry */
+};
+
+static void
+seglist_index_free( LALSegList *seglist )
+{
+  if ( seglist->index ) {
+    XLALFree( seglist->index->start );
+    XLALFree( seglist->index->end );
+    XLALFree( seglist->index->maxEnd );
+    XLALFree( seglist->index->order );
+    XLALFree( seglist->index );
+    seglist->index = NULL;
+  }
+}
+
+struct seglist_index_entry
+{
+  INT8 start;
+  INT8 end;
+  UINT4 pos;
+};
+
+static int
+seglist_index_cmp( const void *p0, const void *p1 )
+{
+  const struct seglist_index_entry *e0 = p0;
+  const struct seglist_index_entry *e1 = p1;
+  if ( e0->start != e1->start ) {
+    return e0->start < e1->start ? -1 : 1;
+  }
+  if ( e0->end != e1->end ) {
+    return e0->end < e1->end ? -1 : 1;
+  }
+  return ( e0->pos > e1->pos ) - ( e0->pos < e1->pos );
+}
+
+static int
+seglist_index_build( LALSegList *seglist )
+{
+  struct tagLALSegListIndex *index;
+  struct seglist_index_entry *entries;
+  UINT4 i;
+
+  if ( seglist->index ) {
+    return XLAL_SUCCESS;
+  }
+
+  entries = XLALMalloc( seglist->length * sizeof( *entries ) );
+  index = XLALCalloc( 1, sizeof( *index ) );
+  if ( ! index || ( seglist->length && ! entries ) ) {
+    XLALFree( entries );
+    XLALFree( index );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  index->length = seglist->length;
+  index->start = XLALMalloc( seglist->length * sizeof( *index->start ) );
+  index->end = XLALMalloc( seglist->length * sizeof( *index->end ) );
+  index->maxEnd = XLALMalloc( seglist->length * sizeof( *index->maxEnd ) );
+  index->order = XLALMalloc( seglist->length * sizeof( *index->order ) );
+  seglist->index = index;
+  if ( seglist->length && ( ! index->start || ! index->end || ! index->maxEnd || ! index->order ) ) {
+    XLALFree( entries );
+    seglist_index_free( seglist );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+
+  for ( i = 0; i < seglist->length; i++ ) {
+    entries[i].start = XLALGPSToINT8NS( &seglist->segs[i].start );
+    entries[i].end = XLALGPSToINT8NS( &seglist->segs[i].end );
+    entries[i].pos = i;
+  }
+  if ( ! seglist->sorted ) {
+    qsort( entries, seglist->length, sizeof( *entries ), seglist_index_cmp );
+  }
+
+  for ( i = 0; i < seglist->length; i++ ) {
+    index->start[i] = entries[i].start;
+    index->end[i] = entries[i].end;
+    index->order[i] = entries[i].pos;
+    index->maxEnd[i] = ( i > 0 && index->maxEnd[i-1] > entries[i].end ) ? index->maxEnd[i-1] : entries[i].end;
+  }
+
+  XLALFree( entries );
+  return XLAL_SUCCESS;
+}
+
+/* Position in the segs array of a segment containing the time t (ns), or -1 */
+static INT4
+seglist_index_stab( const struct tagLALSegListIndex *index, INT8 t )
+{
+  /* binary search for the number of entries starting at or before t */
+  UINT4 lo = 0, hi = index->length;
+  while ( lo < hi ) {
+    UINT4 mid = lo + ( hi - lo ) / 2;
+    if ( index->start[mid] <= t ) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  /* walk back through the entries which might still extend past t */
+  while ( lo-- > 0 && index->maxEnd[lo] > t ) {
+    if ( index->end[lo] > t ) {
+      return index->order[lo];
+    }
+  }
+  return -1;
+}
+
+
 /*---------------------------------------------------------------------------*/
 /**
  * This function sets the start time, the end time, and the \a id of a segment.
@@ -274,6 +399,7 @@ XLALSegListInit( LALSegList *seglist )
 
   /* No search has been performed yet */
   seglist->lastFound = NULL;
+  seglist->index = NULL;
 
   /* Store a distinctive integer value to serve as a check that initialization
      was performed */
@@ -333,6 +459,7 @@ XLALSegListClear( LALSegList *seglist )
 
   /* No search has been performed yet */
   seglist->lastFound = NULL;
+  seglist_index_free( seglist );
 
   /* Return with success status code */
   return XLAL_SUCCESS;
@@ -437,6 +564,9 @@ XLALSegListAppend( LALSegList *seglist, const LALSeg *seg )
   seglist->segs[seglist->length] = *seg ;
   seglist->length++;
 
+  /* The endpoint index no longer describes the list */
+  seglist_index_free( seglist );
+
   /* See whether more decimal places are needed to represent these times than
      were needed for segments already in the list.  Work with 0, 3, 6, or 9
      decimal places. */
@@ -518,6 +648,7 @@ XLALSegListSort( LALSegList *seglist )
 
   /* Reset the 'lastFound' value, since the array has changed */
   seglist->lastFound = NULL;
+  seglist_index_free( seglist );
 
   /* Return with success status code */
   return XLAL_SUCCESS;
@@ -608,6 +739,7 @@ XLALSegListCoalesce( LALSegList *seglist )
 
   /* Reset the 'lastFound' value, since the array has changed */
   seglist->lastFound = NULL;
+  seglist_index_free( seglist );
 
   /* Return with success status code */
   return XLAL_SUCCESS;
@@ -694,9 +826,10 @@ XLALSegListRange( const LALSegList *seglist, LIGOTimeGPS *start, LIGOTimeGPS *en
  * a segment list to XLALSegListCoalesce() before using it with
  * XLALSegListSearch(), unless segment list ordering or distinct
  * segments which touch/overlap are meaningful for what you are doing,
- * which is sometimes the case.)   Otherwise, it must use a linear search,
- * although a ``sorted'' list can still be searched slightly more efficiently than
- * an un-sorted list.  In all cases, XLALSegListSearch() first checks
+ * which is sometimes the case.)   Otherwise, it builds an index of the
+ * segment endpoints ordered by start time, which is kept until the list is
+ * next modified, and searches that, which for typical lists takes time
+ * logarithmic in the length of the list.  In all cases, XLALSegListSearch() first checks
  * whether the segment found by the last successful search contains the
  * specified time, and returns that promptly if so.
  *
@@ -716,7 +849,6 @@ XLALSegListSearch( LALSegList *seglist, const LIGOTimeGPS *gps )
   int cmp;
   LALSeg *bstart = NULL;
   size_t bcount = 0;
-  LALSeg *l1start=NULL, *l1end=NULL, *l2start=NULL, *l2end=NULL;
   LALSeg *segp;
 
   /* Make sure a non-null pointer was passed for the segment list */
@@ -809,44 +941,9 @@ XLALSegListSearch( LALSegList *seglist, const LIGOTimeGPS *gps )
 
   } else {
 
-    /* The search limits are chosen the same for sorted vs. unsorted lists,
-       but the actual search will behave differently for given limits */
-
-    if ( ! seglist->lastFound ) {
-
-      /* Do a single linear search on the whole list */
-      l1start = seglist->segs;
-      l1end = seglist->segs + seglist->length;
-      l2start = l2end = NULL;
-
-    } else {
-
-      /* Check whether the time lies within the last segment found */
-      cmp = XLALGPSInSeg( gps, seglist->lastFound );
-
-      if ( cmp == 0 ) {
-        return seglist->lastFound;
-
-      } else if ( cmp < 0 ) {
-        /* Do a linear search, starting from the beginning of the list.
-           If the list is sorted, then we already know that we only have to
-           search up to the lastFound segment, but the actual search is
-           guaranteed to bail out at that point, so we can go ahead and set
-           the search parameters as if the whole list would be searched. */
-        l1start = seglist->segs;
-        l1end = seglist->segs + seglist->length;
-        l2start = l2end = NULL;
-
-      } else {
-        /* First search from here to the end of the list, then wrap around
-           and search from the beginning of the list up to here */
-        l1start = seglist->lastFound + 1;
-        l1end = seglist->segs + seglist->length;
-        l2start = seglist->segs;
-        l2end = seglist->lastFound;
-
-      }
-
+    /* Check whether the time lies within the last segment found */
+    if ( seglist->lastFound && XLALGPSInSeg( gps, seglist->lastFound ) == 0 ) {
+      return seglist->lastFound;
     }
 
   }
@@ -871,66 +968,239 @@ XLALSegListSearch( LALSegList *seglist, const LIGOTimeGPS *gps )
       return NULL;
     }
 
-  } else if ( seglist->sorted ) {
+  } else {
 
-    /* Do a linear search, but bail out if we reach a segment whose start time
-       is later than the target time */
-    for ( segp=l1start; segp<l1end; segp++ ) {
-      cmp = XLALGPSInSeg( gps, segp );
-      if ( cmp == 0 ) {
-        seglist->lastFound = segp;
-        return segp;
-      } else if ( cmp < 0 ) {
-        /* This segment is beyond the target time, so we can bail out */
-        break;
-      }
+    /* Look the time up in the endpoint index, building it if necessary */
+    INT4 pos;
+    if ( seglist_index_build( seglist ) != XLAL_SUCCESS ) {
+      XLAL_ERROR_NULL( XLAL_EFUNC );
     }
-    /* Set the lastFound pointer to the last segment which is not beyond the
-       target time, or the last segment in the list */
-    seglist->lastFound = segp - 1;
-
-    /* If necessary, do a second linear search, starting from the beginning
-       of the list and going up to lastFound.  In this case, we know that the
-       comparison value will never be negative. */
-    for ( segp=l2start; segp<l2end; segp++ ) {
-      if ( XLALGPSInSeg(gps,segp) == 0 ) {
-        seglist->lastFound = segp;
-        return segp;
-      }
+    pos = seglist_index_stab( seglist->index, XLALGPSToINT8NS( gps ) );
+    if ( pos >= 0 ) {
+      seglist->lastFound = seglist->segs + pos;
+      return seglist->lastFound;
     }
 
-    /* If we get here, then we didn't find a match.
-       Continue to the end of the function. */
+  }
 
-  } else {
+  /* If we get here, then we didn't find a match, so return NULL */
+  return NULL;
+}
 
-    /* Do a linear search, looking for a match */
-    for ( segp=l1start; segp<l1end; segp++ ) {
-      if ( XLALGPSInSeg(gps,segp) == 0 ) {
-        seglist->lastFound = segp;
-        return segp;
-      }
+
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * The function XLALSegListSearchArray() classifies many GPS times at once.
+ * For each of the \c n times in \c gps it stores in \c indices the
+ * position in the \c segs array of a segment which contains that time, or
+ * -1 if no segment contains it.  As for XLALSegListSearch(), if several
+ * segments contain a time then one of them is reported.  The times need not
+ * be sorted.  The endpoint index of the list is built if necessary, so each
+ * lookup takes time logarithmic in the length of the list regardless of
+ * whether the list is sorted or disjoint.
+ */
+int
+XLALSegListSearchArray( LALSegList *seglist, INT4 *indices, const LIGOTimeGPS *gps, UINT4 n )
+{
+  UINT4 i;
+
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( indices != NULL || n == 0, XLAL_EFAULT );
+  XLAL_CHECK( gps != NULL || n == 0, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  XLAL_CHECK( seglist_index_build( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( i = 0; i < n; i++ ) {
+    indices[i] = seglist_index_stab( seglist->index, XLALGPSToINT8NS( gps + i ) );
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/* Sorted and coalesced copy of a segment list */
+static LALSegList *
+seglist_coalesced_copy( const LALSegList *seglist )
+{
+  LALSegList *copy;
+  UINT4 i;
+
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  copy = XLALSegListCreate();
+  XLAL_CHECK_NULL( copy != NULL, XLAL_EFUNC );
+  for ( i = 0; i < seglist->length; i++ ) {
+    if ( XLALSegListAppend( copy, seglist->segs + i ) != XLAL_SUCCESS ) {
+      XLALSegListFree( copy );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
     }
+  }
+  if ( XLALSegListCoalesce( copy ) != XLAL_SUCCESS ) {
+    XLALSegListFree( copy );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
 
-    /* If necessary, do a second linear search, starting from the beginning
-       of the list and going up to lastFound. */
-    for ( segp=l2start; segp<l2end; segp++ ) {
-      if ( XLALGPSInSeg(gps,segp) == 0 ) {
-        seglist->lastFound = segp;
-        return segp;
+  return copy;
+}
+
+
+/**
+ * The function XLALSegListIntersection() returns a new segment list,
+ * to be freed with XLALSegListFree(), containing the times which lie in
+ * both \c seglist1 and \c seglist2.  The input lists are not modified
+ * and need not be sorted or disjoint.  The result is sorted and disjoint;
+ * each of its segments is given the \c id of the segment of the
+ * (coalesced) first list from which it was cut.
+ */
+LALSegList *
+XLALSegListIntersection( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  LALSegList *a, *b, *result;
+  UINT4 i = 0, j = 0;
+
+  a = seglist_coalesced_copy( seglist1 );
+  b = seglist_coalesced_copy( seglist2 );
+  result = XLALSegListCreate();
+  if ( ! a || ! b || ! result ) {
+    XLALSegListFree( a );
+    XLALSegListFree( b );
+    XLALSegListFree( result );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  /* merge the two sorted lists */
+  while ( i < a->length && j < b->length ) {
+    const LALSeg *sa = a->segs + i;
+    const LALSeg *sb = b->segs + j;
+    const LIGOTimeGPS *start = XLALGPSCmp( &sa->start, &sb->start ) > 0 ? &sa->start : &sb->start;
+    const LIGOTimeGPS *end = XLALGPSCmp( &sa->end, &sb->end ) < 0 ? &sa->end : &sb->end;
+    if ( XLALGPSCmp( start, end ) < 0 ) {
+      LALSeg seg;
+      if ( XLALSegSet( &seg, start, end, sa->id ) != XLAL_SUCCESS || XLALSegListAppend( result, &seg ) != XLAL_SUCCESS ) {
+        XLALSegListFree( a );
+        XLALSegListFree( b );
+        XLALSegListFree( result );
+        XLAL_ERROR_NULL( XLAL_EFUNC );
       }
     }
+    if ( XLALGPSCmp( &sa->end, &sb->end ) < 0 ) {
+      i++;
+    } else {
+      j++;
+    }
+  }
+
+  XLALSegListFree( a );
+  XLALSegListFree( b );
+  return result;
+}
 
-    /* If we get here, then we didn't find a match.
-       Continue to the end of the function. */
 
+/**
+ * The function XLALSegListUnion() returns a new segment list, to be freed
+ * with XLALSegListFree(), containing the times which lie in either
+ * \c seglist1 or \c seglist2.  The input lists are not modified.  The
+ * result is coalesced, with \c id values assigned as by
+ * XLALSegListCoalesce().
+ */
+LALSegList *
+XLALSegListUnion( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  LALSegList *result;
+  UINT4 i;
+
+  XLAL_CHECK_NULL( seglist2 != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist2->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL );
+
+  result = seglist_coalesced_copy( seglist1 );
+  XLAL_CHECK_NULL( result != NULL, XLAL_EFUNC );
+  for ( i = 0; i < seglist2->length; i++ ) {
+    if ( XLALSegListAppend( result, seglist2->segs + i ) != XLAL_SUCCESS ) {
+      XLALSegListFree( result );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+  if ( XLALSegListCoalesce( result ) != XLAL_SUCCESS ) {
+    XLALSegListFree( result );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
   }
 
-  /* If we get here, then we didn't find a match, so return NULL */
-  return NULL;
+  return result;
 }
 
 
+/**
+ * The function XLALSegListDifference() returns a new segment list, to be
+ * freed with XLALSegListFree(), containing the times which lie in
+ * \c seglist1 but not in \c seglist2, for example the analysable time
+ * left after applying a list of vetoes.  The input lists are not modified
+ * and need not be sorted or disjoint.  The result is sorted and disjoint;
+ * each of its segments is given the \c id of the segment of the
+ * (coalesced) first list from which it was cut.
+ */
+LALSegList *
+XLALSegListDifference( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  LALSegList *a, *b, *result;
+  UINT4 i, j = 0;
+  int failed = 0;
+
+  a = seglist_coalesced_copy( seglist1 );
+  b = seglist_coalesced_copy( seglist2 );
+  result = XLALSegListCreate();
+  if ( ! a || ! b || ! result ) {
+    XLALSegListFree( a );
+    XLALSegListFree( b );
+    XLALSegListFree( result );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  for ( i = 0; i < a->length && ! failed; i++ ) {
+    const LALSeg *sa = a->segs + i;
+    LIGOTimeGPS cur = sa->start;
+    LALSeg seg;
+    UINT4 k;
+
+    /* skip the segments of the second list which end before this one */
+    while ( j < b->length && XLALGPSCmp( &b->segs[j].end, &sa->start ) <= 0 ) {
+      j++;
+    }
+
+    /* cut out each overlapping segment of the second list */
+    for ( k = j; k < b->length && XLALGPSCmp( &b->segs[k].start, &sa->end ) < 0; k++ ) {
+      if ( XLALGPSCmp( &b->segs[k].start, &cur ) > 0 ) {
+        if ( XLALSegSet( &seg, &cur, &b->segs[k].start, sa->id ) != XLAL_SUCCESS || XLALSegListAppend( result, &seg ) != XLAL_SUCCESS ) {
+          failed = 1;
+          break;
+        }
+      }
+      if ( XLALGPSCmp( &b->segs[k].end, &cur ) > 0 ) {
+        cur = b->segs[k].end;
+      }
+    }
+
+    if ( ! failed && XLALGPSCmp( &cur, &sa->end ) < 0 ) {
+      if ( XLALSegSet( &seg, &cur, &sa->end, sa->id ) != XLAL_SUCCESS || XLALSegListAppend( result, &seg ) != XLAL_SUCCESS ) {
+        failed = 1;
+      }
+    }
+  }
+
+  XLALSegListFree( a );
+  XLALSegListFree( b );
+  if ( failed ) {
+    XLALSegListFree( result );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  return result;
+}
+
 
 /*---------------------------------------------------------------------------*/
 /**
@@ -964,6 +1234,7 @@ XLALSegListShift(  LALSegList *seglist, const LIGOTimeGPS *shift )
     XLALGPSAddGPS( &seglist->segs[i].start, shift);
     XLALGPSAddGPS( &seglist->segs[i].end, shift);
   }
+  seglist_index_free( seglist );
 
   /* done */
   return 0;
@@ -131,6 +131,17 @@ extern "C" {
  *
  * Also all segments in a segment list can be time-shifted using \c XLALSegListShift().
  *
+ * Lists which are not disjoint are searched using an index of the segment
+ * endpoints, sorted by start time and augmented with the running maximum
+ * of the end times.  The index is built on the first search after the
+ * list is modified by one of the functions declared here; code which
+ * modifies the \c segs array directly must call \c XLALSegListSort() or
+ * \c XLALSegListClear() before searching again.  Many GPS times can be
+ * classified in one call with \c XLALSegListSearchArray(), and
+ * \c XLALSegListIntersection(), \c XLALSegListUnion() and
+ * \c XLALSegListDifference() compute set operations on two lists in time
+ * proportional to \f$N \log N + M \log M\f$.
+ *
  */
 /** @{ */
 
@@ -168,7 +179,7 @@ LALSeg;
 
 /** Struct holding a segment list */
 #ifdef SWIG /* SWIG interface directives */
-SWIGLAL(IGNORE_MEMBERS(tagLALSegList, arraySize, dplaces, sorted, disjoint, initMagic, lastFound));
+SWIGLAL(IGNORE_MEMBERS(tagLALSegList, arraySize, dplaces, sorted, disjoint, initMagic, lastFound, index));
 #endif // SWIG
 typedef struct
 tagLALSegList
@@ -184,6 +195,7 @@ tagLALSegList
   UINT4 disjoint;    /**< Flag to indicate whether segment list is disjoint */
   UINT4 initMagic;   /**< Internal value to help ensure list was initialized */
   LALSeg *lastFound; /**< Internal record of last segment found by a search */
+  struct tagLALSegListIndex *index; /**< Internal endpoint index used to search lists which are not disjoint */
 }
 LALSegList;
 
@@ -228,6 +240,14 @@ XLALSegListRange( const LALSegList *seglist, LIGOTimeGPS *start, LIGOTimeGPS *en
 
 LALSeg *
 XLALSegListSearch( LALSegList *seglist, const LIGOTimeGPS *gps );
+int
+XLALSegListSearchArray( LALSegList *seglist, INT4 *indices, const LIGOTimeGPS *gps, UINT4 n );
+LALSegList *
+XLALSegListIntersection( const LALSegList *seglist1, const LALSegList *seglist2 );
+LALSegList *
+XLALSegListUnion( const LALSegList *seglist1, const LALSegList *seglist2 );
+LALSegList *
+XLALSegListDifference( const LALSegList *seglist1, const LALSegList *seglist2 );
 
 int
 XLALSegListShift( LALSegList *seglist, const LIGOTimeGPS *shift );
@@ -83,6 +83,51 @@ UINT4TimeSeries *XLALCreateUINT4TimeSeries ( const CHAR *name, const LIGOTimeGPS
 UINT8TimeSeries *XLALCreateUINT8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
 /** @} */
 
+/**
+ * \name Reuse Functions
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/TimeSeries.h>
+ *
+ * XLALCreate<timeseriestype>Into()
+ * \endcode
+ *
+ * ### Description ###
+ *
+ * These functions are equivalent to the creation functions, but recycle
+ * the time series \c series, which is returned with its metadata set from
+ * the remaining arguments and its data resized to \c length samples.  The
+ * number of samples the data can hold is kept by the caller in
+ * <tt>*capacity</tt>, which is set on return.  The data are only
+ * reallocated if \c length exceeds it; when the series shrinks only the
+ * length is changed and the storage is kept, so a series may be shrunk and
+ * regrown in a loop at the cost of at most one allocation per new maximum
+ * length.  <tt>*capacity</tt> must be the value returned by the previous
+ * call for the same series, or zero for a series not made by these
+ * functions or resized by other means since; if \c capacity is \c NULL the
+ * current length is taken as the capacity.  The contents of the data are
+ * unspecified, as for a new series.  If \c series is \c NULL, a new series
+ * is created.  On failure, \c NULL is returned and \c series is left valid,
+ * to be destroyed by the caller.
+ */
+/** @{ */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(INOUT_SCALARS(size_t*, capacity));
+#endif
+COMPLEX8TimeSeries *XLALCreateCOMPLEX8TimeSeriesInto ( COMPLEX8TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+COMPLEX16TimeSeries *XLALCreateCOMPLEX16TimeSeriesInto ( COMPLEX16TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+REAL4TimeSeries *XLALCreateREAL4TimeSeriesInto ( REAL4TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+REAL8TimeSeries *XLALCreateREAL8TimeSeriesInto ( REAL8TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT2TimeSeries *XLALCreateINT2TimeSeriesInto ( INT2TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT4TimeSeries *XLALCreateINT4TimeSeriesInto ( INT4TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT8TimeSeries *XLALCreateINT8TimeSeriesInto ( INT8TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT2TimeSeries *XLALCreateUINT2TimeSeriesInto ( UINT2TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT4TimeSeries *XLALCreateUINT4TimeSeriesInto ( UINT4TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT8TimeSeries *XLALCreateUINT8TimeSeriesInto ( UINT8TimeSeries *series, size_t *capacity, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+/** @} */
+
 /**
  * \name Destruction Functions
  *
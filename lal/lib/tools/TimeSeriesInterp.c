@@ -19,6 +19,7 @@
 
 
 #include <math.h>
+#include <string.h>
 
 
 #include <lal/Date.h>
@@ -116,9 +117,23 @@ struct tagLALREAL8SequenceInterp {
 	/* calling-code supplied kernel generator */
 	void (*kernel)(double *, int, double, void *);
 	void *kernel_data;
+	/* kernels tabulated at oversample + 1 residuals uniformly spaced
+	 * in [-1/2, +1/2] for bulk evaluation.  built on first use, NULL
+	 * until then or if it would be too large */
+	double *kernel_table;
+	int oversample;
 };
 
 
+/*
+ * Upper limit on the number of samples in the tabulated kernel used for
+ * bulk evaluation.  Longer kernels are computed sample-by-sample instead.
+ */
+
+
+#define KERNEL_TABLE_MAX_SIZE (1 << 21)
+
+
 /**
  * Create a new REAL8Sequence interpolator associated with the given
  * REAL8Sequence object.  The kernel_length parameter sets the length of
@@ -220,6 +235,8 @@ LALREAL8SequenceInterp *XLALREAL8SequenceInterpCreate(const REAL8Sequence *s, in
 	}
 	interp->kernel = kernel;
 	interp->kernel_data = kernel_data;
+	interp->kernel_table = NULL;
+	interp->oversample = 0;
 
 	return interp;
 }
@@ -234,6 +251,7 @@ void XLALREAL8SequenceInterpDestroy(LALREAL8SequenceInterp *interp)
 {
 	if(interp) {
 		XLALFree(interp->cached_kernel);
+		XLALFree(interp->kernel_table);
 		/* unref the REAL8Sequence.  place-holder in case this code
 		 * is ported to a language where this matters */
 		interp->s = NULL;
@@ -316,6 +334,147 @@ REAL8 XLALREAL8SequenceInterpEval(LALREAL8SequenceInterp *interp, double x, int
 }
 
 
+/*
+ * Tabulate the kernel at 4 * kernel_length + 1 residuals.  Linear
+ * interpolation between adjacent table rows then reproduces the kernel
+ * with an error that is second order in the table spacing, which is much
+ * smaller than the first-order error of the kernel caching done by
+ * XLALREAL8SequenceInterpEval().  Leaves the table NULL if it would be too
+ * large.
+ */
+
+
+static int build_kernel_table(LALREAL8SequenceInterp *interp)
+{
+	int kernel_length = interp->kernel_length;
+	int oversample = 4 * kernel_length;
+	double *table;
+	int k;
+
+	if((size_t) (oversample + 1) * kernel_length > KERNEL_TABLE_MAX_SIZE)
+		return 0;
+
+	table = XLALMalloc((size_t) (oversample + 1) * kernel_length * sizeof(*table));
+	if(!table)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	for(k = 0; k <= oversample; k++) {
+		double *row = table + (size_t) k * kernel_length;
+		double residual = -0.5 + (double) k / oversample;
+		/* the default kernel relies on the no-op path for a residual
+		 * of exactly 0, so fill in that row ourselves */
+		if(residual == 0. && interp->kernel == default_kernel) {
+			memset(row, 0, kernel_length * sizeof(*row));
+			row[(kernel_length - 1) / 2] = 1.;
+		} else
+			interp->kernel(row, kernel_length, residual, interp->kernel_data);
+	}
+
+	interp->kernel_table = table;
+	interp->oversample = oversample;
+
+	return 0;
+}
+
+
+/*
+ * Evaluate at x0 + scale * x[i] for each i.  The inner products against
+ * the two bracketing table rows are accumulated together so the loop
+ * vectorizes.
+ */
+
+
+static int eval_array(LALREAL8SequenceInterp *interp, REAL8 *result, const REAL8 *x, size_t n, double x0, double scale, int bounds_check)
+{
+	const REAL8 *data = interp->s->data;
+	const int length = interp->s->length;
+	const int kernel_length = interp->kernel_length;
+	size_t i;
+
+	for(i = 0; i < n; i++) {
+		double xi = x0 + scale * x[i];
+		if(!isfinite(xi) || (bounds_check && (xi < 0 || xi >= length)))
+			XLAL_ERROR(XLAL_EDOM);
+	}
+
+	if(!interp->kernel_table && build_kernel_table(interp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* kernel too long to tabulate:  fall back to single-sample
+	 * evaluation */
+	if(!interp->kernel_table) {
+		for(i = 0; i < n; i++)
+			result[i] = XLALREAL8SequenceInterpEval(interp, x0 + scale * x[i], 0);
+		return 0;
+	}
+
+	for(i = 0; i < n; i++) {
+		double xi = x0 + scale * x[i];
+		int start = lround(xi);
+		double residual = start - xi;
+		double u, w, sa = 0., sb = 0.;
+		const double *ka, *kb;
+		int k, j, jmin, jmax;
+
+		/* same no-op case as XLALREAL8SequenceInterpEval() */
+		if(fabs(residual) < interp->noop_threshold && interp->kernel == default_kernel) {
+			result[i] = 0 <= start && start < length ? data[start] : 0.0;
+			continue;
+		}
+
+		/* bracketing table rows and interpolation weight */
+		u = (residual + 0.5) * interp->oversample;
+		k = floor(u);
+		if(k >= interp->oversample)
+			k = interp->oversample - 1;
+		else if(k < 0)
+			k = 0;
+		w = u - k;
+		ka = interp->kernel_table + (size_t) k * kernel_length;
+		kb = ka + kernel_length;
+
+		/* clip the kernel to the extent of the data */
+		start -= (kernel_length - 1) / 2;
+		jmin = start < 0 ? -start : 0;
+		jmax = start + kernel_length > length ? length - start : kernel_length;
+		for(j = jmin; j < jmax; j++) {
+			sa += ka[j] * data[start + j];
+			sb += kb[j] * data[start + j];
+		}
+		result[i] = (1. - w) * sa + w * sb;
+	}
+
+	return 0;
+}
+
+
+/**
+ * Evaluate a LALREAL8SequenceInterp at each of the real-valued indexes in
+ * x, placing the results in result, which must have the same length as x.
+ * Raises an XLAL_EDOM domain error, without writing any results, if any
+ * index fails the checks described for XLALREAL8SequenceInterpEval().
+ *
+ * Rather than caching a single kernel, this function interpolates between
+ * kernels pre-computed on a grid of 4 * kernel_length + 1 residuals, so
+ * the cost per sample is independent of how the indexes are distributed
+ * and the result has no stair-step artifacts.  The table is built on the
+ * first call and retained by the interpolator.  Kernels too long to
+ * tabulate are evaluated as by XLALREAL8SequenceInterpEval().
+ */
+
+
+int XLALREAL8SequenceInterpEvalArray(LALREAL8SequenceInterp *interp, REAL8Sequence *result, const REAL8Sequence *x, int bounds_check)
+{
+	if(!interp || !result || !x)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(result->length != x->length)
+		XLAL_ERROR(XLAL_EBADLEN);
+	if(eval_array(interp, result->data, x->data, x->length, 0., 1., bounds_check) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
 struct tagLALREAL8TimeSeriesInterp {
 	const REAL8TimeSeries *series;
 	LALREAL8SequenceInterp *seqinterp;
@@ -397,3 +556,29 @@ REAL8 XLALREAL8TimeSeriesInterpEval(LALREAL8TimeSeriesInterp *interp, const LIGO
 {
 	return XLALREAL8SequenceInterpEval(interp->seqinterp, XLALGPSDiff(t, &interp->series->epoch) / interp->series->deltaT, bounds_check);
 }
+
+
+/**
+ * Evaluate a LALREAL8TimeSeriesInterp at the times t0 + dt[i], placing the
+ * results in result, which must have the same length as dt.  Raises an
+ * XLAL_EDOM domain error, without writing any results, if any of the times
+ * fails the check described for XLALREAL8TimeSeriesInterpEval().
+ *
+ * See XLALREAL8SequenceInterpEvalArray() for information about how the
+ * interpolating kernel is computed for bulk evaluation.
+ */
+
+
+int XLALREAL8TimeSeriesInterpEvalArray(LALREAL8TimeSeriesInterp *interp, REAL8Sequence *result, const LIGOTimeGPS *t0, const REAL8Sequence *dt, int bounds_check)
+{
+	const REAL8TimeSeries *series;
+
+	if(!interp || !result || !t0 || !dt)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(result->length != dt->length)
+		XLAL_ERROR(XLAL_EBADLEN);
+	series = interp->series;
+	if(eval_array(interp->seqinterp, result->data, dt->data, dt->length, XLALGPSDiff(t0, &series->epoch) / series->deltaT, 1. / series->deltaT, bounds_check) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
@@ -9,6 +9,7 @@
 
 #define DSERIES CONCAT2(XLALDestroy,SERIESTYPE)
 #define CSERIES CONCAT2(XLALCreate,SERIESTYPE)
+#define CISERIES CONCAT3(XLALCreate,SERIESTYPE,Into)
 #define XSERIES CONCAT2(XLALCut,SERIESTYPE)
 #define RSERIES CONCAT2(XLALResize,SERIESTYPE)
 #define SSERIES CONCAT2(XLALShrink,SERIESTYPE)
@@ -41,7 +42,7 @@ SERIESTYPE *CSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
+	new = XLALFactoryMalloc(sizeof(*new));
 	sequence = CSEQUENCE (length);
 	if(!new || !sequence) {
 		XLALFree(new);
@@ -74,6 +75,72 @@ SERIESTYPE *CSERIES (
 }
 
 
+SERIESTYPE *CISERIES (
+	SERIESTYPE *series,
+	size_t *capacity,
+	const CHAR *name,
+	const LIGOTimeGPS *epoch,
+	REAL8 f0,
+	REAL8 deltaT,
+	const LALUnit *sampleUnits,
+	size_t length
+)
+{
+	size_t cap;
+
+	if(!series) {
+		series = CSERIES (name, epoch, f0, deltaT, sampleUnits, length);
+		if(!series)
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		if(capacity)
+			*capacity = length;
+		return series;
+	}
+
+	/* only reallocate if the series grows beyond its storage */
+	if(!series->data) {
+		series->data = CSEQUENCE (length);
+		if(!series->data)
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		cap = length;
+	} else {
+		cap = series->data->length;
+		if(capacity && *capacity > cap)
+			cap = *capacity;
+		if(length > cap) {
+			if(!RSEQUENCE (series->data, 0, length))
+				XLAL_ERROR_NULL(XLAL_EFUNC);
+			cap = length;
+		} else
+			series->data->length = length;
+	}
+	if(capacity)
+		*capacity = cap;
+
+	if(name) {
+		strncpy(series->name, name, LALNameLength - 1);
+		series->name[LALNameLength - 1] = '\0';
+	} else {
+		series->name[0] = '\0';
+	}
+	if(epoch) {
+		series->epoch = *epoch;
+	} else {
+		series->epoch.gpsSeconds = 0;
+		series->epoch.gpsNanoSeconds = 0;
+	}
+	series->f0 = f0;
+	series->deltaT = deltaT;
+	if(sampleUnits) {
+		series->sampleUnits = *sampleUnits;
+	} else {
+		series->sampleUnits = lalDimensionlessUnit;
+	}
+
+	return series;
+}
+
+
 SERIESTYPE *XSERIES (
 	const SERIESTYPE *series,
 	size_t first,
@@ -83,7 +150,7 @@ SERIESTYPE *XSERIES (
 	SERIESTYPE *new;
 	SEQUENCETYPE *sequence;
 
-	new = XLALMalloc(sizeof(*new));
+	new = XLALFactoryMalloc(sizeof(*new));
 	sequence = XSEQUENCE (series->data, first, length);
 	if(!new || !sequence) {
 		XLALFree(new);
@@ -178,6 +245,7 @@ SERIESTYPE *ASERIES (
 
 #undef DSERIES
 #undef CSERIES
+#undef CISERIES
 #undef XSERIES
 #undef RSERIES
 #undef SSERIES
@@ -17,6 +17,7 @@
 *  MA  02110-1301  USA
 */
 
+#include <time.h>
 #include <lal/LALAdaptiveRungeKuttaIntegrator.h>
 
 #define XLAL_BEGINGSL \
@@ -118,6 +119,9 @@ void XLALAdaptiveRungeKuttaFree(LALAdaptiveRungeKuttaIntegrator * integrator)
         XLAL_CALLGSL(gsl_odeiv_step_free(integrator->step));
 
     LALFree(integrator->sys);
+    XLALFree(integrator->denset);
+    XLALFree(integrator->densey);
+    XLALFree(integrator->densedydt);
     LALFree(integrator);
 
     return;
@@ -1524,3 +1528,273 @@ int XLALAdaptiveRungeKutta4IrregularIntervals(LALAdaptiveRungeKuttaIntegrator *
     *yout = output;
     return outputlen;
 }
+
+/**
+ * Clears the dense output and step statistics of an integrator and resets the
+ * GSL stepper, so that the integrator can be reused for a new integration.
+ * The dense output buffers are kept.
+ */
+int XLALAdaptiveRungeKuttaReset(LALAdaptiveRungeKuttaIntegrator * integrator)
+{
+    XLAL_CHECK(integrator, XLAL_EFAULT);
+
+    XLAL_CALLGSL(gsl_odeiv_step_reset(integrator->step));
+    XLAL_CALLGSL(gsl_odeiv_evolve_reset(integrator->evolve));
+    integrator->returncode = 0;
+    integrator->denselen = 0;
+    integrator->nsteps = 0;
+    integrator->nfailed = 0;
+    integrator->steptime = 0;
+
+    return XLAL_SUCCESS;
+}
+
+/* Local function to append a step to the dense output buffers, growing them if needed */
+static int storeDenseStep(LALAdaptiveRungeKuttaIntegrator * integrator, REAL8 t, const REAL8 * y, const REAL8 * dydt)
+{
+    size_t dim = integrator->sys->dimension;
+
+    if (integrator->denselen == integrator->densecap) {
+        size_t cap = integrator->densecap ? 2 * integrator->densecap : 1024;
+        REAL8 *newt = XLALRealloc(integrator->denset, cap * sizeof(REAL8));
+        if (!newt)
+            return XLAL_ENOMEM;
+        integrator->denset = newt;
+        REAL8 *newy = XLALRealloc(integrator->densey, cap * dim * sizeof(REAL8));
+        if (!newy)
+            return XLAL_ENOMEM;
+        integrator->densey = newy;
+        REAL8 *newdydt = XLALRealloc(integrator->densedydt, cap * dim * sizeof(REAL8));
+        if (!newdydt)
+            return XLAL_ENOMEM;
+        integrator->densedydt = newdydt;
+        integrator->densecap = cap;
+    }
+
+    integrator->denset[integrator->denselen] = t;
+    memcpy(&(integrator->densey[integrator->denselen * dim]), y, dim * sizeof(REAL8));
+    memcpy(&(integrator->densedydt[integrator->denselen * dim]), dydt, dim * sizeof(REAL8));
+    integrator->denselen++;
+
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Fourth-order Runge-Kutta ODE integrator with adaptive step size control and
+ * continuous output; see \ref LALAdaptiveRungeKuttaIntegrator_h.
+ *
+ * The stopping criteria are the same as for XLALAdaptiveRungeKutta4Hermite().
+ * Any output of a previous integration is discarded, but the step statistics
+ * accumulate until XLALAdaptiveRungeKuttaReset() is called.
+ *
+ * Returns the number of stored steps, including the initial point.
+ */
+int XLALAdaptiveRungeKuttaDense(LALAdaptiveRungeKuttaIntegrator * integrator,     /**< struct holding dydt, stopping test, stepper, etc. */
+    void *params,                                                       /**< params struct used to compute dydt and stopping test */
+    REAL8 * yinit,                                                      /**< pass in initial values of all variables - overwritten to final values */
+    REAL8 tinit,                                                        /**< integration start time */
+    REAL8 tend_in,                                                      /**< maximum integration time */
+    REAL8 h0                                                            /**< initial step size to be tried */
+    )
+{
+    int errnum = 0;
+    int status;
+    size_t dim, retries;
+    REAL8 t, h;
+    REAL8 tend = tend_in;
+    clock_t start = clock();
+
+    XLAL_CHECK(integrator && yinit, XLAL_EFAULT);
+    XLAL_CHECK(h0 != 0 && (tend_in - tinit) * h0 >= 0, XLAL_EINVAL,
+        "(tend_in - tinit) and h0 must have the same sign\ntend_in: %f, tinit: %f, h0: %f", tend_in, tinit, h0);
+
+    XLAL_BEGINGSL;
+
+    /* If want to stop only on test, then tend = +/-infinity; otherwise
+     * tend_in */
+    if (integrator->stopontestonly) {
+        if (tend < tinit)
+            tend = -1.0 / 0.0;
+        else
+            tend = 1.0 / 0.0;
+    }
+
+    dim = integrator->sys->dimension;
+
+    /* Setup. */
+    integrator->sys->params = params;
+    integrator->returncode = 0;
+    integrator->denselen = 0;
+    retries = integrator->retries;
+    t = tinit;
+    h = h0;
+
+    /* We are starting a fresh integration; clear GSL step and evolve
+     * objects. */
+    gsl_odeiv_step_reset(integrator->step);
+    gsl_odeiv_evolve_reset(integrator->evolve);
+
+    /* Store the initial point together with its derivative */
+    if ((status = integrator->dydt(t, yinit, integrator->evolve->dydt_out, params)) != GSL_SUCCESS) {
+        integrator->returncode = status;
+        errnum = XLAL_EFAILED;
+        goto bail_out;
+    }
+    if ((errnum = storeDenseStep(integrator, t, yinit, integrator->evolve->dydt_out)) != XLAL_SUCCESS)
+        goto bail_out;
+
+    /* Enter evolution loop.  NOTE: we *always* take at least one
+     * step. */
+    while (1) {
+        status =
+            gsl_odeiv_evolve_apply(integrator->evolve, integrator->control, integrator->step, integrator->sys, &t, tend, &h,
+            yinit);
+
+        /* Check for failure, retry if haven't retried too many times
+         * already. */
+        if (status != GSL_SUCCESS) {
+            if (retries--) {
+                /* Retries to spare; reduce h, try again. */
+                integrator->nfailed++;
+                h /= 10.0;
+                continue;
+            } else {
+                /* Out of retries, bail with status code. */
+                integrator->returncode = status;
+                break;
+            }
+        } else {
+            /* Successful step, reset retry counter. */
+            retries = integrator->retries;
+        }
+
+        /* Store the step; the evolver leaves the derivative at the new
+         * time in dydt_out. */
+        integrator->nsteps++;
+        if ((errnum = storeDenseStep(integrator, t, yinit, integrator->evolve->dydt_out)) != XLAL_SUCCESS)
+            goto bail_out;
+
+        /* Check for termination criteria. */
+        if (!integrator->stopontestonly && (tend - t) * h0 <= 0)
+            break;
+
+        /* If there is a stopping function in integrator, call it with the
+         * last value of y and dydt from the integrator. */
+        if (integrator->stop) {
+            if ((status = integrator->stop(t, yinit, integrator->evolve->dydt_out, params)) != GSL_SUCCESS) {
+                integrator->returncode = status;
+                break;
+            }
+        }
+    }
+
+  bail_out:
+
+    XLAL_ENDGSL;
+
+    integrator->steptime += (REAL8) (clock() - start) / CLOCKS_PER_SEC;
+
+    if (errnum) {
+        integrator->denselen = 0;
+        XLAL_ERROR(errnum);
+    }
+
+    return integrator->denselen;
+}
+
+/**
+ * Evaluates the dense output of the last call to XLALAdaptiveRungeKuttaDense()
+ * at time t, which must lie within the integrated range.
+ */
+int XLALAdaptiveRungeKuttaDenseEval(const LALAdaptiveRungeKuttaIntegrator * integrator,   /**< integrator holding the dense output */
+    REAL8 t,                                                            /**< time at which to evaluate the solution */
+    REAL8 * y                                                           /**< output: solution at t, dimension entries */
+    )
+{
+    XLAL_CHECK(integrator && y, XLAL_EFAULT);
+    XLAL_CHECK(integrator->denselen > 0, XLAL_EINVAL, "No dense output available");
+
+    const size_t dim = integrator->sys->dimension;
+    const size_t n = integrator->denselen;
+    const REAL8 *ts = integrator->denset;
+    const REAL8 dir = (n > 1 && ts[n - 1] < ts[0]) ? -1.0 : 1.0;
+
+    XLAL_CHECK(dir * (t - ts[0]) >= 0 && dir * (ts[n - 1] - t) >= 0, XLAL_EDOM,
+        "Time %g outside of integrated range [%g, %g]", t, ts[0], ts[n - 1]);
+
+    if (n == 1) {
+        memcpy(y, integrator->densey, dim * sizeof(REAL8));
+        return XLAL_SUCCESS;
+    }
+
+    /* find the step k with t between ts[k] and ts[k+1] */
+    size_t lo = 0, hi = n - 1;
+    while (hi - lo > 1) {
+        size_t mid = (lo + hi) / 2;
+        if (dir * (t - ts[mid]) < 0)
+            hi = mid;
+        else
+            lo = mid;
+    }
+
+    /* cubic Hermite interpolation from the solution and derivatives at both ends */
+    const REAL8 h = ts[lo + 1] - ts[lo];
+    const REAL8 s = (t - ts[lo]) / h;
+    const REAL8 s2 = s * s;
+    const REAL8 s3 = s2 * s;
+    const REAL8 h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const REAL8 h10 = (s3 - 2.0 * s2 + s) * h;
+    const REAL8 h01 = -2.0 * s3 + 3.0 * s2;
+    const REAL8 h11 = (s3 - s2) * h;
+    const REAL8 *y0 = &(integrator->densey[lo * dim]);
+    const REAL8 *y1 = y0 + dim;
+    const REAL8 *f0 = &(integrator->densedydt[lo * dim]);
+    const REAL8 *f1 = f0 + dim;
+    for (size_t i = 0; i < dim; i++)
+        y[i] = h00 * y0[i] + h10 * f0[i] + h01 * y1[i] + h11 * f1[i];
+
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Samples the dense output of the last call to XLALAdaptiveRungeKuttaDense()
+ * at times tstart + j * deltat, 0 <= j < length. The output has the layout of
+ * XLALAdaptiveRungeKutta4Hermite(): a (dimension + 1) x length array whose first
+ * row holds the times. If *yout already points to an array of that shape it is
+ * reused, otherwise it is (re)allocated.
+ */
+int XLALAdaptiveRungeKuttaDenseSample(const LALAdaptiveRungeKuttaIntegrator * integrator, /**< integrator holding the dense output */
+    REAL8 tstart,                                                       /**< first sample time */
+    REAL8 deltat,                                                       /**< sample spacing */
+    UINT4 length,                                                       /**< number of samples */
+    REAL8Array ** yout                                                  /**< output array, reused if of the right shape */
+    )
+{
+    XLAL_CHECK(integrator && yout, XLAL_EFAULT);
+    XLAL_CHECK(length > 0, XLAL_EINVAL);
+
+    const size_t dim = integrator->sys->dimension;
+    REAL8Array *out = *yout;
+    if (!out || !out->dimLength || out->dimLength->length != 2 || out->dimLength->data[0] != dim + 1 || out->dimLength->data[1] != length) {
+        if (out)
+            XLALDestroyREAL8Array(out);
+        *yout = out = XLALCreateREAL8ArrayL(2, dim + 1, length);
+        XLAL_CHECK(out, XLAL_EFUNC);
+    }
+
+    REAL8 *y = XLALMalloc(dim * sizeof(REAL8));
+    XLAL_CHECK(y, XLAL_ENOMEM);
+    for (UINT4 j = 0; j < length; j++) {
+        REAL8 t = tstart + j * deltat;
+        if (XLALAdaptiveRungeKuttaDenseEval(integrator, t, y) != XLAL_SUCCESS) {
+            XLALFree(y);
+            XLAL_ERROR(XLAL_EFUNC);
+        }
+        out->data[j] = t;
+        for (size_t i = 0; i < dim; i++)
+            out->data[(i + 1) * length + j] = y[i];
+    }
+    XLALFree(y);
+
+    return XLAL_SUCCESS;
+}
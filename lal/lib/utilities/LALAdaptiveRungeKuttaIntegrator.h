@@ -63,6 +63,19 @@ typedef struct tagLALAdaptiveRungeKuttaIntegrator
   int stopontestonly;	/* stop only on test, use tend to size buffers only */
 
   int returncode;
+
+  /* dense output of XLALAdaptiveRungeKuttaDense(); buffers are kept across calls */
+  size_t denselen;	/* number of stored steps */
+  size_t densecap;	/* capacity of the buffers, in steps */
+  REAL8 *denset;	/* times of the stored steps */
+  REAL8 *densey;	/* solution at the stored steps, dimension entries per step */
+  REAL8 *densedydt;	/* derivatives at the stored steps, dimension entries per step */
+
+  /* step statistics of XLALAdaptiveRungeKuttaDense() only, accumulated until
+   * XLALAdaptiveRungeKuttaReset(); the other integrators leave them unchanged */
+  UINT4 nsteps;		/* accepted steps */
+  UINT4 nfailed;	/* failed steps that were retried with a smaller step size */
+  REAL8 steptime;	/* CPU time spent stepping, in seconds */
 } LALAdaptiveRungeKuttaIntegrator;
 
 LALAdaptiveRungeKuttaIntegrator *XLALAdaptiveRungeKutta4Init( int dim,
@@ -152,6 +165,43 @@ int XLALAdaptiveRungeKutta4IrregularIntervals( LALAdaptiveRungeKuttaIntegrator *
                                     REAL8Array **yout                   /**< array holding the unevenly sampled output */
                                     );
 
+/**
+ * Adaptive integration with continuous (dense) output.
+ *
+ * XLALAdaptiveRungeKuttaDense() integrates like XLALAdaptiveRungeKutta4Hermite(),
+ * but instead of sampling the solution on a fixed grid it stores the solution
+ * and its derivative at every accepted step in buffers owned by the integrator.
+ * The solution can then be queried at arbitrary times within the integrated
+ * range with XLALAdaptiveRungeKuttaDenseEval() or sampled on a regular grid with
+ * XLALAdaptiveRungeKuttaDenseSample(), using cubic Hermite interpolation between
+ * steps; no separate spline interpolation of the output is needed.
+ *
+ * The buffers only grow, so an integrator can be reused for many integrations
+ * of the same system without reallocating; XLALAdaptiveRungeKuttaReset() clears
+ * the stored output and the step statistics.
+ */
+int XLALAdaptiveRungeKuttaReset( LALAdaptiveRungeKuttaIntegrator *integrator );
+
+int XLALAdaptiveRungeKuttaDense( LALAdaptiveRungeKuttaIntegrator *integrator,
+                                 void *params,
+                                 REAL8 *yinit,
+                                 REAL8 tinit,
+                                 REAL8 tend_in,
+                                 REAL8 h0
+                                 );
+
+int XLALAdaptiveRungeKuttaDenseEval( const LALAdaptiveRungeKuttaIntegrator *integrator,
+                                     REAL8 t,
+                                     REAL8 *y
+                                     );
+
+int XLALAdaptiveRungeKuttaDenseSample( const LALAdaptiveRungeKuttaIntegrator *integrator,
+                                       REAL8 tstart,
+                                       REAL8 deltat,
+                                       UINT4 length,
+                                       REAL8Array **yout
+                                       );
+
 /** @} */
 
 #if 0
@@ -54,6 +54,7 @@
 #include <signal.h>
 #include <lal/LALStdio.h>
 #include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
 
 /* never use this... never! */
 void XLALClobberDebugLevel(int);
@@ -326,6 +327,73 @@ static int stressTestRealloc( void )
 }
 
 
+/* test scoped memory arenas */
+static int testArena( void )
+{
+  int keep = lalDebugLevel;
+  LALMallocArena *arena;
+  REAL8Vector *v, *w;
+  size_t *t;
+
+  XLALClobberDebugLevel(lalDebugLevel | LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT);
+
+  trial( arena = XLALCreateMallocArena( 4096 ), 0, "" );
+  if ( ! arena ) die( arena not created );
+  trial( XLALPushMallocArena( arena ), 0, "" );
+
+  /* allocations are aligned and padded */
+  trial( p = XLALArenaMalloc( 3 * sizeof( *p ) ), 0, "" );
+  trial( q = XLALArenaMalloc( 1024 * sizeof( *q ) ), 0, "" );
+  if ( ((size_t) p) % 64 || ((size_t) q) % 64 ) die( arena memory not aligned );
+  if ( *( p - 1 ) != (size_t)0xABadCafe ) die( wrong magic );
+  if ( *( q - 2 ) != 1024 * sizeof( *q ) ) die( wrong size );
+  for ( i = 0; i < 1024; ++i ) q[i] = i;
+
+  /* the most recent allocation is reclaimed when freed */
+  trial( LALFree( q ), 0, "" );
+  trial( r = XLALArenaMalloc( 1024 * sizeof( *r ) ), 0, "" );
+  if ( r != q ) die( arena memory not reclaimed );
+  for ( i = 0; i < 1024; ++i ) r[i] = i;
+
+  /* realloc copies, and ordinary memory is unaffected */
+  trial( r = LALRealloc( r, 4096 * sizeof( *r ) ), 0, "" );
+  for ( i = 0; i < 1024; ++i ) if ( r[i] != i ) die( memory not copied );
+  trial( s = LALMalloc( 16 * sizeof( *s ) ), 0, "" );
+  trial( LALFree( s ), 0, "" );
+
+  /* a NULL arena suspends the enclosing one */
+  trial( XLALPushMallocArena( NULL ), 0, "" );
+  trial( t = XLALArenaMalloc( sizeof( *t ) ), 0, "" );
+  trial( XLALPopMallocArena(), 0, "" );
+  trial( LALFree( t ), 0, "" );
+
+  /* arena memory is recognised when its arena is not the innermost scope */
+  trial( t = XLALArenaMalloc( sizeof( *t ) ), 0, "" );
+  trial( XLALPushMallocArena( NULL ), 0, "" );
+  trial( LALFree( t ), 0, "" );
+  trial( XLALPopMallocArena(), 0, "" );
+
+  /* the factories only draw from an arena pushed for them, and freeing
+   * their output after the scope is popped is caught */
+  trial( v = XLALCreateREAL8Vector( 16 ), 0, "" );
+  trial( XLALPushMallocArenaFactories( arena ), 0, "" );
+  trial( w = XLALCreateREAL8Vector( 16 ), 0, "" );
+  trial( XLALPopMallocArena(), 0, "" );
+  trial( LALFree( w ), SIGSEGV, "after its scope was popped" );
+  trial( XLALDestroyREAL8Vector( v ), 0, "" );
+
+  /* freed and abandoned allocations are released at pop */
+  trial( LALFree( p ), 0, "" );
+  trial( LALCheckMemoryLeaks(), SIGSEGV, "LALCheckMemoryLeaks: memory leak\n" );
+  trial( XLALPopMallocArena(), 0, "" );
+  trial( XLALDestroyMallocArena( arena ), 0, "" );
+  trial( LALCheckMemoryLeaks(), 0, "" );
+
+  XLALClobberDebugLevel(keep);
+  return 0;
+}
+
+
 int main( void )
 {
   XLALGetDebugLevel();
@@ -342,6 +410,7 @@ int main( void )
   if ( testPadding() ) return 1;
   if ( testAllocList() ) return 1;
   if ( stressTestRealloc() ) return 1;
+  if ( testArena() ) return 1;
 
   trial( LALCheckMemoryLeaks(), 0, "" );
 
@@ -25,6 +25,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <lal/Date.h>
 #include <lal/LALDatatypes.h>
@@ -162,6 +163,49 @@ int main(void)
 	XLALDestroyREAL4FrequencySeries(x);
 	XLALDestroyREAL4FrequencySeries(y);
 
+	/*
+	 * Create into
+	 */
+
+	/* shrinking keeps the storage, growing beyond it reallocates */
+	{
+		size_t capacity = 0;
+		REAL4 *data;
+		LIGOTimeGPS epoch = {10, 0};
+		x = XLALCreateREAL4FrequencySeriesInto(NULL, &capacity, "blah", &gps_zero, 0.0, 1.0, &lalDimensionlessUnit, 1024);
+		data = x->data->data;
+		y = XLALCreateREAL4FrequencySeriesInto(x, &capacity, "reuse", &epoch, 1.0, 0.5, &lalStrainUnit, 512);
+		if((y != x) || (capacity != 1024) || (x->data->data != data) || (x->data->length != 512) || strcmp(x->name, "reuse") || (x->f0 != 1.0) || (x->deltaF != 0.5) || XLALGPSCmp(&x->epoch, &epoch) || XLALUnitCompare(&x->sampleUnits, &lalStrainUnit)) {
+			fprintf(stderr, "Create into test 1 failed\n");
+			exit(1);
+		}
+		for(i = 0; i < 512; i++)
+			x->data->data[i] = i;
+		/* regrowing within the capacity keeps the storage */
+		y = XLALCreateREAL4FrequencySeriesInto(x, &capacity, "reuse", &epoch, 1.0, 0.5, &lalStrainUnit, 1000);
+		if((y != x) || (capacity != 1024) || (x->data->data != data) || (x->data->length != 1000)) {
+			fprintf(stderr, "Create into test 2 failed\n");
+			exit(1);
+		}
+		y = XLALCreateREAL4FrequencySeriesInto(x, &capacity, NULL, NULL, 0.0, 1.0, NULL, 4096);
+		if((y != x) || (capacity != 4096) || (x->data->length != 4096) || (x->name[0] != '\0') || (x->epoch.gpsSeconds != 0) || XLALUnitCompare(&x->sampleUnits, &lalDimensionlessUnit)) {
+			fprintf(stderr, "Create into test 3 failed\n");
+			exit(1);
+		}
+		for(i = 0; i < 512; i++)
+			if(x->data->data[i] != i) {
+				fprintf(stderr, "Create into test 4 failed\n");
+				exit(1);
+			}
+		/* without a capacity, the current length is the limit */
+		y = XLALCreateREAL4FrequencySeriesInto(x, NULL, NULL, NULL, 0.0, 1.0, NULL, 100);
+		if((y != x) || (x->data->length != 100)) {
+			fprintf(stderr, "Create into test 5 failed\n");
+			exit(1);
+		}
+	}
+	XLALDestroyREAL4FrequencySeries(x);
+
 	/*
 	 * Success
 	 */
@@ -0,0 +1,162 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <lal/LALConstants.h>
+#include <lal/LALDatatypes.h>
+#include <lal/ResampleTimeSeries.h>
+#include <lal/Sequence.h>
+#include <lal/TimeSeries.h>
+#include <lal/Units.h>
+#include <lal/XLALError.h>
+
+static LIGOTimeGPS gps_zero = LIGOTIMEGPSZERO;
+
+#define CHECK(expr) do { if ( ! ( expr ) ) { fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr ); exit( 1 ); } } while ( 0 )
+
+static REAL8TimeSeries *make_sine( REAL8 deltaT, UINT4 length, REAL8 freq )
+{
+  REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( "sine", &gps_zero, 0.0, deltaT, &lalDimensionlessUnit, length );
+  UINT4 j;
+  for ( j = 0; j < length; ++j )
+    series->data->data[j] = sin( LAL_TWOPI * freq * j * deltaT );
+  return series;
+}
+
+/* maximum error against the analytic sine away from the edges */
+static REAL8 sine_error( const REAL8TimeSeries *series, REAL8 freq, REAL8 guard )
+{
+  REAL8 maxerr = 0;
+  UINT4 j;
+  for ( j = 0; j < series->data->length; ++j )
+  {
+    REAL8 t = j * series->deltaT;
+    if ( t < guard || t > series->data->length * series->deltaT - guard )
+      continue;
+    maxerr = fmax( maxerr, fabs( series->data->data[j] - sin( LAL_TWOPI * freq * t ) ) );
+  }
+  return maxerr;
+}
+
+static void test_ratio( void )
+{
+  UINT4 up, down;
+  CHECK( XLALResamplerRationalRatio( &up, &down, 1.0 / 16384, 1.0 / 4096 ) == 0 && up == 1 && down == 4 );
+  CHECK( XLALResamplerRationalRatio( &up, &down, 1.0 / 1024, 1.0 / 768 ) == 0 && up == 3 && down == 4 );
+  CHECK( XLALResamplerRationalRatio( &up, &down, 1.0 / 4096, 1.0 / 16384 ) == 0 && up == 4 && down == 1 );
+  {
+    int ret, errnum;
+    XLAL_TRY_SILENT( ret = XLALResamplerRationalRatio( &up, &down, 1.0, LAL_PI ), errnum );
+    CHECK( ret < 0 && errnum == XLAL_EINVAL );
+  }
+}
+
+static void test_series( REAL8 rateIn, REAL8 rateOut, REAL8 freq, REAL8 tol )
+{
+  const UINT4 length = 8 * rateIn;
+  REAL8TimeSeries *series = make_sine( 1.0 / rateIn, length, freq );
+  REAL4TimeSeries *series4 = XLALConvertREAL8TimeSeriesToREAL4( series );
+  REAL8 err;
+
+  CHECK( XLALResampleREAL8TimeSeriesRational( series, 1.0 / rateOut ) == 0 );
+  CHECK( fabs( series->deltaT * rateOut - 1.0 ) < 1e-12 );
+  CHECK( series->data->length == (UINT4) floor( ( length - 1 ) * rateOut / rateIn ) + 1 );
+  err = sine_error( series, freq, 1.0 );
+  fprintf( stderr, "REAL8 %g Hz -> %g Hz: max error %g\n", rateIn, rateOut, err );
+  CHECK( err < tol );
+
+  CHECK( XLALResampleREAL4TimeSeriesRational( series4, 1.0 / rateOut ) == 0 );
+  CHECK( series4->data->length == series->data->length );
+  {
+    REAL8TimeSeries *tmp = XLALConvertREAL4TimeSeriesToREAL8( series4 );
+    err = sine_error( tmp, freq, 1.0 );
+    fprintf( stderr, "REAL4 %g Hz -> %g Hz: max error %g\n", rateIn, rateOut, err );
+    CHECK( err < tol + 1e-5 );
+    XLALDestroyREAL8TimeSeries( tmp );
+  }
+
+  XLALDestroyREAL8TimeSeries( series );
+  XLALDestroyREAL4TimeSeries( series4 );
+}
+
+/* chunked streaming must reproduce the one-shot result */
+static void test_stream( REAL8 rateIn, REAL8 rateOut )
+{
+  const UINT4 length = 16 * rateIn + 17;
+  REAL8TimeSeries *series = make_sine( 1.0 / rateIn, length, 0.1 * rateOut );
+  REAL8TimeSeries *whole = XLALCutREAL8TimeSeries( series, 0, length );
+  LALREAL8Resampler *resampler = XLALCreateREAL8Resampler( 1.0 / rateIn, 1.0 / rateOut, 0 );
+  REAL8 maxdiff = 0;
+  UINT4 j, done = 0, nout = 0;
+
+  CHECK( resampler );
+  CHECK( XLALResampleREAL8TimeSeriesRational( whole, 1.0 / rateOut ) == 0 );
+
+  srand( 1 );
+  while ( done <= length )
+  {
+    UINT4 n = rand() % 3000;
+    REAL8Sequence *in;
+    REAL8Sequence *out;
+    if ( done + n > length )
+      n = length - done;
+    in = XLALCutREAL8Sequence( series->data, done, n );
+    out = n || done < length ? XLALREAL8ResamplerApply( resampler, in ) : XLALREAL8ResamplerFlush( resampler );
+    CHECK( in && out );
+    CHECK( nout + out->length <= whole->data->length );
+    for ( j = 0; j < out->length; ++j )
+      maxdiff = fmax( maxdiff, fabs( out->data[j] - whole->data->data[nout + j] ) );
+    nout += out->length;
+    XLALDestroyREAL8Sequence( in );
+    XLALDestroyREAL8Sequence( out );
+    if ( done == length )
+      break;
+    done += n;
+  }
+  fprintf( stderr, "stream %g Hz -> %g Hz: max difference %g\n", rateIn, rateOut, maxdiff );
+  CHECK( nout == whole->data->length );
+  CHECK( maxdiff < 1e-10 );
+
+  XLALDestroyREAL8Resampler( resampler );
+  XLALDestroyREAL8TimeSeries( series );
+  XLALDestroyREAL8TimeSeries( whole );
+}
+
+int main( void )
+{
+  XLALSetErrorHandler( XLALExitErrorHandler );
+
+  test_ratio();
+
+  /* integer downsampling, applied by FFT overlap-save */
+  test_series( 16384, 4096, 300, 1e-4 );
+  /* rational downsampling and upsampling */
+  test_series( 1024, 768, 50, 1e-4 );
+  test_series( 4096, 16384, 300, 1e-4 );
+  test_series( 2048, 1536, 500, 1e-4 );
+
+  test_stream( 16384, 2048 );
+  test_stream( 1024, 768 );
+  test_stream( 4096, 16384 );
+
+  LALCheckMemoryLeaks();
+  return 0;
+}
@@ -1230,6 +1230,107 @@ int main( int argc, char *argv[] )
   XLALPrintInfo("Passed XLALSegListRange tests\n");
 
 
+  /*-------------------------------------------------------------------------*/
+  XLALPrintInfo("\n========== Indexed search and set operation tests \n");
+  /*-------------------------------------------------------------------------*/
+
+  {
+    /* overlapping segments, appended out of order */
+    const INT4 ovl[][2] = { {100, 200}, {150, 160}, {50, 120}, {300, 400}, {110, 115}, {390, 500}, {600, 700} };
+    const INT4 nbounds = sizeof(ovl) / sizeof(ovl[0]);
+    LALSegList *a, *b, *result;
+    LIGOTimeGPS start, end, times[900];
+    INT4 indices[900];
+    INT4 i, j;
+
+    XLALPrintInfo("Check XLALSegListSearch() on a non-disjoint list ...\n");
+    XLAL_CHECK( XLALSegListClear(&seglist2) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( i = 0; i < nbounds; i++ ) {
+      XLALGPSSet( &start, ovl[i][0], 0 );
+      XLALGPSSet( &end, ovl[i][1], 0 );
+      XLAL_CHECK( XLALSegSet(&seg, &start, &end, i) == XLAL_SUCCESS, XLAL_EFUNC );
+      XLAL_CHECK( XLALSegListAppend(&seglist2, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+    XLAL_CHECK( !seglist2.sorted && !seglist2.disjoint, XLAL_EFAILED );
+    for ( i = 0; i < 900; i++ ) {
+      INT4 expect = 0;
+      XLALGPSSet( &times[i], i, 500000000 * (i % 2) );
+      for ( j = 0; j < nbounds; j++ ) {
+        expect |= XLALGPSCmp(&times[i], &seglist2.segs[j].start) >= 0 && XLALGPSCmp(&times[i], &seglist2.segs[j].end) < 0;
+      }
+      seglist2.lastFound = NULL;
+      segptr = XLALSegListSearch( &seglist2, &times[i] );
+      XLAL_CHECK( (segptr != NULL) == expect, XLAL_EFAILED, "search for %d.%09d", times[i].gpsSeconds, times[i].gpsNanoSeconds );
+      XLAL_CHECK( segptr == NULL || XLALGPSInSeg(&times[i], segptr) == 0, XLAL_EFAILED );
+    }
+
+    XLALPrintInfo("Check XLALSegListSearchArray() agrees with XLALSegListSearch() ...\n");
+    XLAL_CHECK( XLALSegListSearchArray(&seglist2, indices, times, 900) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( i = 0; i < 900; i++ ) {
+      segptr = XLALSegListSearch( &seglist2, &times[i] );
+      XLAL_CHECK( (segptr != NULL) == (indices[i] >= 0), XLAL_EFAILED );
+      XLAL_CHECK( indices[i] < 0 || XLALGPSInSeg(&times[i], &seglist2.segs[indices[i]]) == 0, XLAL_EFAILED );
+    }
+
+    XLALPrintInfo("Check the index is rebuilt after the list is modified ...\n");
+    XLALGPSSet( &start, 800, 0 );
+    XLALGPSSet( &end, 850, 0 );
+    XLAL_CHECK( XLALSegSet(&seg, &start, &end, nbounds) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListAppend(&seglist2, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListSearchArray(&seglist2, indices, times, 900) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( indices[825] == nbounds && indices[799] < 0, XLAL_EFAILED );
+
+    XLALPrintInfo("Check XLALSegListIntersection(), XLALSegListUnion() and XLALSegListDifference() ...\n");
+    /* a = [50,200) [300,500) [600,700) [800,850) once coalesced */
+    a = &seglist2;
+    b = XLALSegListCreate();
+    XLAL_CHECK( b != NULL, XLAL_EFUNC );
+    {
+      const INT4 veto[][2] = { {0, 60}, {190, 310}, {450, 460}, {650, 820}, {840, 900} };
+      for ( i = 0; i < 5; i++ ) {
+        XLALGPSSet( &start, veto[i][0], 0 );
+        XLALGPSSet( &end, veto[i][1], 0 );
+        XLAL_CHECK( XLALSegSet(&seg, &start, &end, 0) == XLAL_SUCCESS, XLAL_EFUNC );
+        XLAL_CHECK( XLALSegListAppend(b, &seg) == XLAL_SUCCESS, XLAL_EFUNC );
+      }
+    }
+
+    result = XLALSegListIntersection( a, b );
+    XLAL_CHECK( result != NULL, XLAL_EFUNC );
+    {
+      const INT4 expect[][2] = { {50, 60}, {190, 200}, {300, 310}, {450, 460}, {650, 700}, {800, 820}, {840, 850} };
+      XLAL_CHECK( result->length == 7 && result->sorted && result->disjoint, XLAL_EFAILED );
+      for ( i = 0; i < 7; i++ ) {
+        XLAL_CHECK( result->segs[i].start.gpsSeconds == expect[i][0] && result->segs[i].end.gpsSeconds == expect[i][1], XLAL_EFAILED, "intersection segment %d", i );
+      }
+    }
+    XLALSegListFree( result );
+
+    result = XLALSegListDifference( a, b );
+    XLAL_CHECK( result != NULL, XLAL_EFUNC );
+    {
+      const INT4 expect[][2] = { {60, 190}, {310, 450}, {460, 500}, {600, 650}, {820, 840} };
+      XLAL_CHECK( result->length == 5 && result->sorted && result->disjoint, XLAL_EFAILED );
+      for ( i = 0; i < 5; i++ ) {
+        XLAL_CHECK( result->segs[i].start.gpsSeconds == expect[i][0] && result->segs[i].end.gpsSeconds == expect[i][1], XLAL_EFAILED, "difference segment %d", i );
+      }
+    }
+    XLALSegListFree( result );
+
+    result = XLALSegListUnion( a, b );
+    XLAL_CHECK( result != NULL, XLAL_EFUNC );
+    XLAL_CHECK( result->length == 2 && result->sorted && result->disjoint, XLAL_EFAILED );
+    XLAL_CHECK( result->segs[0].start.gpsSeconds == 0 && result->segs[0].end.gpsSeconds == 500, XLAL_EFAILED );
+    XLAL_CHECK( result->segs[1].start.gpsSeconds == 600 && result->segs[1].end.gpsSeconds == 900, XLAL_EFAILED );
+    XLALSegListFree( result );
+
+    /* the inputs are left untouched */
+    XLAL_CHECK( a->length == nbounds + 1 && !a->sorted && b->length == 5, XLAL_EFAILED );
+    XLALSegListFree( b );
+  }
+  XLALPrintInfo("Passed indexed search and set operation tests\n");
+
+
   /*-------------------------------------------------------------------------*/
   /* Clean up leftover seg lists */
   if ( seglist1.segs ) { XLALSegListClear( &seglist1 ); }
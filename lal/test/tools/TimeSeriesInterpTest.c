@@ -24,6 +24,7 @@
 
 #include <lal/Date.h>
 #include <lal/LALDatatypes.h>
+#include <lal/Sequence.h>
 #include <lal/TimeSeries.h>
 #include <lal/TimeSeriesInterp.h>
 #include <lal/Units.h>
@@ -79,6 +80,21 @@ static void evaluate(REAL8TimeSeries *dst, LALREAL8TimeSeriesInterp *interp, int
 }
 
 
+static void evaluate_array(REAL8TimeSeries *dst, LALREAL8TimeSeriesInterp *interp, int bounds_check)
+{
+	REAL8Sequence *dt = XLALCreateREAL8Sequence(dst->data->length);
+	unsigned i;
+
+	for(i = 0; i < dt->length; i++)
+		dt->data[i] = i * dst->deltaT;
+	if(XLALREAL8TimeSeriesInterpEvalArray(interp, dst->data, &dst->epoch, dt, bounds_check)) {
+		fprintf(stderr, "error:  bulk evaluation failed\n");
+		exit(1);
+	}
+	XLALDestroyREAL8Sequence(dt);
+}
+
+
 static REAL8TimeSeries *error(const REAL8TimeSeries *s1, const REAL8TimeSeries *s0)
 {
 	REAL8TimeSeries *result = copy_series(s1);
@@ -139,6 +155,7 @@ int main(void)
 {
 	REAL8TimeSeries *src, *dst, *mdl;
 	LALREAL8TimeSeriesInterp *interp;
+	LIGOTimeGPS t_end;
 	double f;
 
 	/*
@@ -236,6 +253,14 @@ int main(void)
 
 	check_result(mdl, dst, 0.03, -0.078, +0.083);
 
+	/* same again with the tabulated kernel used for bulk evaluation */
+
+	interp = XLALREAL8TimeSeriesInterpCreate(src, 9, NULL, NULL);
+	evaluate_array(dst, interp, 1);
+	XLALREAL8TimeSeriesInterpDestroy(interp);
+
+	check_result(mdl, dst, 0.03, -0.078, +0.083);
+
 	XLALDestroyREAL8TimeSeries(src);
 	XLALDestroyREAL8TimeSeries(dst);
 	XLALDestroyREAL8TimeSeries(mdl);
@@ -252,6 +277,8 @@ int main(void)
 	src->data->data[src->data->length] = 1;	/* place a 1 beyond the end */
 
 	interp = XLALREAL8TimeSeriesInterpCreate(src, 9, NULL, NULL);
+	t_end = src->epoch;
+	XLALGPSAdd(&t_end, src->data->length * src->deltaT);
 	{
 	LIGOTimeGPS t = src->epoch;
 	double result;
@@ -277,6 +304,28 @@ int main(void)
 		exit(1);
 	}
 	}
+	{
+	REAL8Sequence *dt = XLALCreateREAL8Sequence(2);
+	REAL8Sequence *result = XLALCreateREAL8Sequence(2);
+	int ret, errnum;
+	dt->data[0] = -1e-9;
+	dt->data[1] = 0.;
+	/* bulk evaluation must fail if any time is out of bounds, and
+	 * agree with the single-sample results otherwise */
+	fprintf(stderr, "checking for out-of-bounds failure in bulk evaluation ...\n");
+	XLAL_TRY_SILENT(ret = XLALREAL8TimeSeriesInterpEvalArray(interp, result, &t_end, dt, 1), errnum);
+	if(ret == 0 || (errnum & ~XLAL_EFUNC) != XLAL_EDOM) {
+		fprintf(stderr, "error:  interpolator failed to report error beyond end of array\n");
+		exit(1);
+	} else
+		fprintf(stderr, "... passed\n");
+	if(XLALREAL8TimeSeriesInterpEvalArray(interp, result, &t_end, dt, 0) || result->data[0] != 0. || result->data[1] != 0.) {
+		fprintf(stderr, "error:  bulk interpolator failed in final sample\n");
+		exit(1);
+	}
+	XLALDestroyREAL8Sequence(dt);
+	XLALDestroyREAL8Sequence(result);
+	}
 	XLALREAL8TimeSeriesInterpDestroy(interp);
 
 	XLALDestroyREAL8TimeSeries(src);
@@ -0,0 +1,139 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+*  MA  02110-1301  USA
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALAdaptiveRungeKuttaIntegrator.h>
+#include <lal/XLALError.h>
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#define CHECK(expr) do { if ( ! ( expr ) ) { fprintf( stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr ); exit( 1 ); } } while ( 0 )
+
+/* harmonic oscillator y0' = y1, y1' = -omega^2 y0 */
+static int oscillator( double UNUSED t, const double y[], double dydt[], void *params )
+{
+  const double omega = *(double *) params;
+  dydt[0] = y[1];
+  dydt[1] = -omega * omega * y[0];
+  return GSL_SUCCESS;
+}
+
+/* stop once y0 turns positive after |t| = 5 pi / 2 */
+static int stop_on_zero( double t, const double y[], double UNUSED dydt[], void UNUSED *params )
+{
+  return ( fabs( t ) > 2.5 * LAL_PI && y[0] > 0 ) ? 1 : GSL_SUCCESS;
+}
+
+static double dense_error( const LALAdaptiveRungeKuttaIntegrator *integrator, double omega, double tend )
+{
+  double maxerr = 0;
+  for ( int j = 0; j <= 1000; ++j )
+  {
+    double t = tend * j / 1000.0;
+    double y[2];
+    CHECK( XLALAdaptiveRungeKuttaDenseEval( integrator, t, y ) == XLAL_SUCCESS );
+    maxerr = fmax( maxerr, fabs( y[0] - cos( omega * t ) ) );
+    maxerr = fmax( maxerr, fabs( y[1] + omega * sin( omega * t ) ) / omega );
+  }
+  return maxerr;
+}
+
+int main( void )
+{
+  XLALSetErrorHandler( XLALExitErrorHandler );
+
+  double omega = 2.0;
+  const double tend = 10.0;
+  LALAdaptiveRungeKuttaIntegrator *integrator = XLALAdaptiveRungeKutta4Init( 2, oscillator, NULL, 1e-10, 1e-10 );
+  CHECK( integrator );
+
+  /* integrate to tend and compare the dense output with the exact solution */
+  double y[2] = { 1.0, 0.0 };
+  int n = XLALAdaptiveRungeKuttaDense( integrator, &omega, y, 0.0, tend, 0.01 );
+  CHECK( n > 2 && (size_t) n == integrator->denselen );
+  CHECK( integrator->denset[0] == 0.0 && integrator->denset[n - 1] == tend );
+  CHECK( integrator->nsteps == (UINT4) n - 1 );
+  double err = dense_error( integrator, omega, tend );
+  fprintf( stderr, "%d steps, max dense output error %g\n", n, err );
+  CHECK( err < 1e-6 );
+  CHECK( fabs( y[0] - cos( omega * tend ) ) < 1e-6 );
+
+  /* out of range queries fail */
+  {
+    int ret, errnum;
+    XLAL_TRY_SILENT( ret = XLALAdaptiveRungeKuttaDenseEval( integrator, tend + 1.0, y ), errnum );
+    CHECK( ret < 0 && errnum == XLAL_EDOM );
+  }
+
+  /* regular sampling uses the layout of XLALAdaptiveRungeKutta4Hermite() and reuses the output */
+  REAL8Array *yout = NULL;
+  CHECK( XLALAdaptiveRungeKuttaDenseSample( integrator, 0.0, 0.5, 21, &yout ) == XLAL_SUCCESS );
+  REAL8Array *yout_first = yout;
+  CHECK( yout->dimLength->data[0] == 3 && yout->dimLength->data[1] == 21 );
+  CHECK( XLALAdaptiveRungeKuttaDenseSample( integrator, 0.0, 0.5, 21, &yout ) == XLAL_SUCCESS );
+  CHECK( yout == yout_first );
+  for ( int j = 0; j < 21; ++j )
+  {
+    CHECK( yout->data[j] == 0.5 * j );
+    CHECK( fabs( yout->data[21 + j] - cos( omega * 0.5 * j ) ) < 1e-6 );
+  }
+  XLALDestroyREAL8Array( yout );
+
+  /* reuse the integrator for a different system without reallocating */
+  const REAL8 *denset = integrator->denset;
+  const size_t densecap = integrator->densecap;
+  CHECK( XLALAdaptiveRungeKuttaReset( integrator ) == XLAL_SUCCESS );
+  CHECK( integrator->denselen == 0 && integrator->nsteps == 0 );
+  omega = 1.5;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  n = XLALAdaptiveRungeKuttaDense( integrator, &omega, y, 0.0, tend, 0.01 );
+  CHECK( n > 2 );
+  if ( (size_t) n <= densecap )
+    CHECK( integrator->denset == denset );
+  err = dense_error( integrator, omega, tend );
+  fprintf( stderr, "%d steps after reset, max dense output error %g\n", n, err );
+  CHECK( err < 1e-6 );
+
+  /* stop on test only, integrating backwards in time */
+  CHECK( XLALAdaptiveRungeKuttaReset( integrator ) == XLAL_SUCCESS );
+  integrator->stop = stop_on_zero;
+  integrator->stopontestonly = 1;
+  omega = 1.0;
+  y[0] = 1.0;
+  y[1] = 0.0;
+  n = XLALAdaptiveRungeKuttaDense( integrator, &omega, y, 0.0, -1.0, -0.01 );
+  CHECK( n > 2 && integrator->denset[n - 1] < -2.5 * LAL_PI );
+  {
+    double t = -2.0;
+    CHECK( XLALAdaptiveRungeKuttaDenseEval( integrator, t, y ) == XLAL_SUCCESS );
+    CHECK( fabs( y[0] - cos( t ) ) < 1e-6 );
+  }
+
+  XLALAdaptiveRungeKuttaFree( integrator );
+  LALCheckMemoryLeaks();
+  return 0;
+}
@@ -162,5 +162,7 @@ int main(int argc, char *argv[]){
     printf("\n");
   }
   
+  LALInferenceClearMarginalDistance(runState);
+  LALInferenceDestroyNSFamilyCache();
   return(0);
 }
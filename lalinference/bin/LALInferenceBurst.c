@@ -147,6 +147,7 @@ int main(int argc, char *argv[]){
   state->algorithm(state);
   
   /* end */
+  LALInferenceClearMarginalDistance(state);
   return(0);
 }
 
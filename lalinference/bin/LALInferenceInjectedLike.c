@@ -125,5 +125,7 @@ int main(int argc, char *argv[]){
   LALInferencePrintInjectionSample(state);
 
   /* end */
+  LALInferenceClearMarginalDistance(state);
+  LALInferenceDestroyNSFamilyCache();
   return(0);
 }
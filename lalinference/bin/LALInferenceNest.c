@@ -123,8 +123,13 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one per live point replaced in parallel */
+  INT4 nthreads=1;
+  ProcessParamsTable *ppt=NULL;
+  if(state && (ppt=LALInferenceGetProcParamVal(state->commandLine,"--Nparallel")))
+    nthreads=atoi(ppt->value);
+  if(nthreads<1) nthreads=1;
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
@@ -159,5 +164,7 @@ int main(int argc, char *argv[]){
   state->algorithm(state);
 
   /* end */
+  LALInferenceClearMarginalDistance(state);
+  LALInferenceDestroyNSFamilyCache();
   return(0);
 }
@@ -436,6 +436,7 @@ int main(int argc, char *argv[]){
         printf(" ==========  sampling complete ==========\n");
 
     /* Close down MPI parallelization and return */
+    LALInferenceClearMarginalDistance(run_state);
     MPI_Finalize();
 
     return XLAL_SUCCESS;
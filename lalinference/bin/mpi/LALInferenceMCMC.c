@@ -126,6 +126,7 @@ INT4 init_ptmcmc(LALInferenceRunState *runState) {
     (--prop-track)      Output proposal parameters\n\
     (--outfile file)    Write output files <file>.<chain_number> \n\
                             (PTMCMC.output.<random_seed>.<mpi_thread>)\n\
+    (--compress-output) Compress the sample tables in the output file\n\
     ----------------------------------------------\n\
     --- Checkpointing-----------------------------\n\
     ----------------------------------------------\n\
@@ -732,6 +733,7 @@ int main(int argc, char *argv[]){
     runState->algorithm(runState);
 
     if (mpirank == 0) printf(" ========== main(): finished. ==========\n");
+    LALInferenceClearMarginalDistance(runState);
     MPI_Finalize();
 
     return XLAL_SUCCESS;
@@ -66,6 +66,9 @@
 #define UNUSED
 #endif
 
+/* Rows per chunk of the sample tables in the output file */
+#define MCMC_OUTPUT_CHUNK_SIZE 1024
+
 static void
 thinDifferentialEvolutionPoints(LALInferenceThreadState *thread) {
     size_t i;
@@ -361,7 +364,7 @@ void PTMCMCAlgorithm(struct tagLALInferenceRunState *runState) {
 
         /* Print to file the contents of model->freqhPlus. */
         if (LALInferenceGetProcParamVal(runState->commandLine, "--data-dump"))
-            LALInferenceDataDump(runState->data, thread->model);
+            LALInferenceDataDump(runState->data, thread->model, thread->currentParams);
 
         /* Install the signal handler */
         install_resume_handler(CondorExitCode);
@@ -1295,9 +1298,13 @@ void LALInferenceResumeMCMC(LALInferenceRunState *runState) {
             access(runState->resumeOutFileName, R_OK) ==0) {
         /* Then file already exists for reading, and we're going to resume
         from it, so don't write the header. */
-        LALInferenceReadMCMCCheckpoint(runState);
+        if (LALInferenceReadMCMCCheckpoint(runState))
+            return;
     }
 
+    /* Starting a fresh run, so replace any output of an earlier one */
+    LALInferenceCreateMCMCOutput(runState);
+
     return;
 }
 
@@ -1364,8 +1371,9 @@ void LALInferenceCheckpointMCMC(LALInferenceRunState *runState) {
     return;
 }
 
-/* Read in and restore the run state from an MCMC checkpoint */
-void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
+/* Read in and restore the run state from an MCMC checkpoint.
+ * Returns 1 if the run state was restored, 0 if the run should start afresh */
+INT4 LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     //ProcessParamsTable *ppt;
     INT4 i, t, n_local_threads;
     int retcode=0;
@@ -1378,7 +1386,7 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     {
         /* One of the files is empty, just start a new run */
     	fprintf(stderr,"Resume file or chain file is zero size, starting fresh run\n");
-    	return;
+    	return 0;
     }
     LALInferencePrintCheckpointFileInfo(runState->resumeOutFileName);
     LALInferencePrintCheckpointFileInfo(runState->outFileName);
@@ -1387,7 +1395,7 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     if(retcode != XLAL_SUCCESS)
     {
         fprintf(stderr,"Unable to resume from %s, file is not valid HDF5\n",runState->resumeOutFileName);
-        return;
+        return 0;
     }
     else
     {
@@ -1396,18 +1404,19 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     if(resume_file == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
-        XLAL_ERROR_VOID(XLAL_EIO);
+        XLAL_ERROR_VAL(0, XLAL_EIO);
     }
     XLAL_TRY(output = XLALH5FileOpen(runState->outFileName, "r"), retcode);
     if(retcode != XLAL_SUCCESS)
     {
         fprintf(stderr,"Unable to resume from %s, file is not valid HDF5\n",runState->outFileName);
-        return;
+        XLALH5FileClose(resume_file);
+        return 0;
     }
     if(output == NULL){
         XLALErrorHandler = XLALExitErrorHandler;
         XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
-        XLAL_ERROR_VOID(XLAL_EIO);
+        XLAL_ERROR_VAL(0, XLAL_EIO);
     }
 
     LALH5File *li_group = XLALH5GroupOpen(resume_file, "lalinference");
@@ -1486,47 +1495,17 @@ void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState) {
     XLALH5FileClose(li_group);
     XLALH5FileClose(resume_file);
 
-    /* Read in samples collected so far */
-    
-
-    li_group = XLALH5GroupOpen(output, "lalinference");
-    group = XLALH5GroupOpen(li_group, runState->runID);
-
-    n_local_threads = runState->nthreads;
-    for (t = 0; t < n_local_threads; t++) {
-        thread = &runState->threads[t];
-
-        LALH5Dataset *chain_dataset=NULL;
-        XLAL_TRY(chain_dataset = XLALH5DatasetRead(group, thread->name), retcode);
-        if(retcode==XLAL_SUCCESS)
-        {
-            LALInferenceVariables **input_array;
-            UINT4 j, N;
-            LALInferenceH5DatasetToVariablesArray(chain_dataset, &input_array, &N);
-            for (j=0; j<N; j++){
-                LALInferenceLogSampleToArray(thread->algorithmParams, input_array[j]);
-                LALInferenceClearVariables(input_array[j]);
-            }
-            XLALFree(input_array);
-            XLALH5DatasetFree(chain_dataset);
-        }
-    }
-    XLALH5FileClose(group);
-    XLALH5FileClose(li_group);
+    /* Samples collected so far stay in the output file, and new ones are
+     * appended to them by LALInferenceWriteMCMCSamples() */
     XLALH5FileClose(output);
 
-    return;
+    return 1;
 }
 
 
-void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
-    //ProcessParamsTable *ppt;
-    INT4 MPIrank;
-    INT4 t, n_local_threads;
+/* Create the output file at the start of a run, with the run metadata */
+void LALInferenceCreateMCMCOutput(LALInferenceRunState *runState) {
     LALH5File *output = NULL;
-    LALInferenceThreadState *thread;
-
-    MPI_Comm_rank(MPI_COMM_WORLD, &MPIrank);
 
     output = XLALH5FileOpen(runState->outFileName, "w");
     if(output == NULL){
@@ -1545,6 +1524,35 @@ void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
         XLALFree(injParams);
     }
 
+    char *cl=NULL;
+    cl=LALInferencePrintCommandLine(runState->commandLine);
+    XLALH5FileAddStringAttribute(group,"CommandLine",cl);
+    XLALFree(cl);
+    XLALH5FileClose(group);
+    XLALH5FileClose(output);
+    return;
+}
+
+
+/* Append the samples collected since the last call to the output file,
+ * and release them from memory */
+void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
+    INT4 t, n_local_threads;
+    UINT4 i;
+    LALH5File *output = NULL;
+    LALInferenceThreadState *thread;
+    INT4 compress = LALInferenceGetProcParamVal(runState->commandLine, "--compress-output") ? 1 : 0;
+
+    output = XLALH5FileOpen(runState->outFileName, "a");
+    if(output == NULL){
+        XLALErrorHandler = XLALExitErrorHandler;
+        XLALPrintError("Output file error. Please check that the specified path exists. (in %s, line %d)\n",__FILE__, __LINE__);
+        XLAL_ERROR_VOID(XLAL_EIO);
+    }
+
+    LALH5File *li_group = XLALH5GroupOpen(output, "lalinference");
+    LALH5File *group = XLALH5GroupOpen(li_group, runState->runID);
+
     n_local_threads = runState->nthreads;
     for (t = 0; t < n_local_threads; t++) {
         thread = &runState->threads[t];
@@ -1555,15 +1563,43 @@ void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState) {
                 && LALInferenceCheckVariable(thread->algorithmParams, "N_outputarray") ) {
             output_array=*(LALInferenceVariables ***)LALInferenceGetVariable(thread->algorithmParams,"outputarray");
             N_output_array=*(UINT4 *)LALInferenceGetVariable(thread->algorithmParams,"N_outputarray");
+        }
+        if (N_output_array == 0)
+            continue;
+
+        LALInferenceH5TableWriter *writer = LALInferenceH5TableWriterOpen(group, thread->name, output_array[0], MCMC_OUTPUT_CHUNK_SIZE, compress);
+        if (writer == NULL
+                || LALInferenceH5TableWriterAppendArray(writer, output_array, N_output_array) != XLAL_SUCCESS) {
+            /* Nothing was appended, so the samples are kept for a retry */
+            LALInferenceH5TableWriterClose(writer);
+            XLALH5FileClose(group);
+            XLALH5FileClose(li_group);
+            XLALH5FileClose(output);
+            XLAL_ERROR_VOID(XLAL_EIO, "Failed to append samples to %s", runState->outFileName);
+        }
 
-            /* Create run identifier group */
-            LALInferenceH5VariablesArrayToDataset(group, output_array, N_output_array, thread->name);
+        /* The samples are in the table, so start collecting afresh before
+         * closing it: a retry after a failure to close must not append
+         * them a second time */
+        for (i = 0; i < N_output_array; i++) {
+            LALInferenceClearVariables(output_array[i]);
+            XLALFree(output_array[i]);
+        }
+        XLALFree(output_array);
+        output_array = NULL;
+        N_output_array = 0;
+        LALInferenceSetVariable(thread->algorithmParams, "outputarray", &output_array);
+        LALInferenceSetVariable(thread->algorithmParams, "N_outputarray", &N_output_array);
+
+        if (LALInferenceH5TableWriterClose(writer) != XLAL_SUCCESS) {
+            XLALH5FileClose(group);
+            XLALH5FileClose(li_group);
+            XLALH5FileClose(output);
+            XLAL_ERROR_VOID(XLAL_EIO, "Failed to close the samples table in %s", runState->outFileName);
         }
     }
-    char *cl=NULL;
-    cl=LALInferencePrintCommandLine(runState->commandLine);
-    XLALH5FileAddStringAttribute(group,"CommandLine",cl);
     XLALH5FileClose(group);
+    XLALH5FileClose(li_group);
     XLALH5FileClose(output);
     LALInferencePrintCheckpointFileInfo(runState->outFileName);
     return;
@@ -1967,7 +2003,7 @@ void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState
     return;
 }
 
-void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
+void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model, LALInferenceVariables *params) {
     char filename[FILENAME_MAX];
     FILE *out;
     UINT4 ui;
@@ -1993,13 +2029,31 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     fclose(out);
 
     while (data != NULL) {
+        /* Project the template as the likelihood does for the current
+         * parameters, falling back to the responses stored when the data
+         * were read if the sky position or time is not known */
+        REAL8 fPlus = data->fPlus, fCross = data->fCross, timeshift = data->timeshift;
+        if (LALInferenceCheckVariable(params, "rightascension") && LALInferenceCheckVariable(params, "declination") &&
+            LALInferenceCheckVariable(params, "polarisation") && LALInferenceCheckVariable(params, "time") &&
+            LALInferenceCheckVariable(model->params, "time")) {
+            REAL8 ra = LALInferenceGetREAL8Variable(params, "rightascension");
+            REAL8 dec = LALInferenceGetREAL8Variable(params, "declination");
+            REAL8 psi = LALInferenceGetREAL8Variable(params, "polarisation");
+            REAL8 GPSdouble = LALInferenceGetREAL8Variable(params, "time");
+            LIGOTimeGPS GPSlal;
+            XLALGPSSetREAL8(&GPSlal, GPSdouble);
+            XLALComputeDetAMResponse(&fPlus, &fCross, (const REAL4(*)[3])data->detector->response, ra, dec, psi, XLALGreenwichMeanSiderealTime(&GPSlal));
+            timeshift = (GPSdouble - LALInferenceGetREAL8Variable(model->params, "time")) +
+                XLALTimeDelayFromEarthCenter(data->detector->location, ra, dec, &GPSlal);
+        }
+
         snprintf(filename, sizeof(filename), "%s-freqTemplateStrain.dat", data->name);
         out = fopen(filename, "w");
         for (ui = 0; ui < model->freqhCross->data->length; ui++) {
             REAL8 f = model->freqhCross->deltaF * ui;
             COMPLEX16 d;
-            d = data->fPlus * model->freqhPlus->data->data[ui] +
-            data->fCross * model->freqhCross->data->data[ui];
+            d = fPlus * model->freqhPlus->data->data[ui] +
+            fCross * model->freqhCross->data->data[ui];
 
             fprintf(out, "%g %g %g\n", f, creal(d), cimag(d) );
         }
@@ -2009,9 +2063,9 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         out = fopen(filename, "w");
         for (ui = 0; ui < model->timehCross->data->length; ui++) {
             REAL8 tt = XLALGPSGetREAL8(&(model->timehCross->epoch)) +
-            data->timeshift + ui*model->timehCross->deltaT;
-            REAL8 d = data->fPlus*model->timehPlus->data->data[ui] +
-            data->fCross*model->timehCross->data->data[ui];
+            timeshift + ui*model->timehCross->deltaT;
+            REAL8 d = fPlus*model->timehPlus->data->data[ui] +
+            fCross*model->timehCross->data->data[ui];
 
             fprintf(out, "%.6f %g\n", tt, d);
         }
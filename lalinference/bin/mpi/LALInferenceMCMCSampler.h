@@ -80,15 +80,16 @@ void LALInferencePrintPTMCMCHeadersOrResume(LALInferenceRunState *runState);
 void LALInferencePrintPTMCMCHeaderFile(LALInferenceRunState *runState, LALInferenceThreadState *thread, FILE *threadoutput);
 void LALInferencePrintAdaptationHeader(FILE *outfile, LALInferenceThreadState *thread);
 void LALInferencePrintPTMCMCInjectionSample(LALInferenceRunState *runState);
-void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model);
+void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model, LALInferenceVariables *params);
 void LALInferenceSaveSample(LALInferenceThreadState *thread, FILE *output);
 void LALInferencePrintAdaptationSettings(FILE *outfile, LALInferenceThreadState *thread);
 void LALInferencePrintMCMCSample(LALInferenceThreadState *thread, LALInferenceIFOData *data, INT4 iteration, REAL8 timestamp, FILE *threadoutput);
+void LALInferenceCreateMCMCOutput(LALInferenceRunState *runState);
 void LALInferenceWriteMCMCSamples(LALInferenceRunState *runState);
 void LALInferenceNameOutputs(LALInferenceRunState *runState);
 void LALInferenceCheckpointMCMC(LALInferenceRunState *runState);
 void LALInferenceResumeMCMC(LALInferenceRunState *runState);
-void LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState);
+INT4 LALInferenceReadMCMCCheckpoint(LALInferenceRunState *runState);
 void LALInferenceAddPTMCMCMetaInfo(LALInferenceRunState *runState);
 
 /** Reads final parameter values from the given output file, and
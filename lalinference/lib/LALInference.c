@@ -270,7 +270,7 @@ INT4 LALInferenceGetVariableDimensionNonFixedChooseVectors(LALInferenceVariables
     while (ptr != NULL) {
       /* print name: */
       //TBL: LALInferenceGetVariableDimensionNonFixed had to be modified for noise-parameters, which are stored in a gsl_matrix
-      if (LALInferenceCheckVariableNonFixed(vars,ptr->name))
+      if (ptr->vary==LALINFERENCE_PARAM_LINEAR || ptr->vary==LALINFERENCE_PARAM_CIRCULAR)
       {
         //Generalize to allow for other data types
         if(ptr->type == LALINFERENCE_gslMatrix_t)
@@ -555,6 +555,99 @@ void LALInferenceClearVariables(LALInferenceVariables *vars)
   return;
 }
 
+/* Return 1 if the items of "a" and "b" have the same names, types, vary types
+ * and (for vectors and matrices) sizes in the same order, 0 otherwise */
+static int LALInferenceVariablesSameLayout(const LALInferenceVariables *a, const LALInferenceVariables *b)
+{
+  const LALInferenceVariableItem *pa, *pb;
+  if(a->dimension!=b->dimension) return 0;
+  for(pa=a->head, pb=b->head; pa && pb; pa=pa->next, pb=pb->next)
+  {
+    if(pa->type!=pb->type || pa->vary!=pb->vary || !pa->value || !pb->value) return 0;
+    if(strcmp(pa->name,pb->name)) return 0;
+    switch(pa->type)
+    {
+      case LALINFERENCE_gslMatrix_t:
+      {
+        const gsl_matrix *ma=*(gsl_matrix **)pa->value, *mb=*(gsl_matrix **)pb->value;
+        if(!ma || !mb || ma->size1!=mb->size1 || ma->size2!=mb->size2) return 0;
+        break;
+      }
+      case LALINFERENCE_INT4Vector_t:
+      {
+        const INT4Vector *va=*(INT4Vector **)pa->value, *vb=*(INT4Vector **)pb->value;
+        if(!va || !vb || va->length!=vb->length) return 0;
+        break;
+      }
+      case LALINFERENCE_UINT4Vector_t:
+      {
+        const UINT4Vector *va=*(UINT4Vector **)pa->value, *vb=*(UINT4Vector **)pb->value;
+        if(!va || !vb || va->length!=vb->length) return 0;
+        break;
+      }
+      case LALINFERENCE_REAL8Vector_t:
+      {
+        const REAL8Vector *va=*(REAL8Vector **)pa->value, *vb=*(REAL8Vector **)pb->value;
+        if(!va || !vb || va->length!=vb->length) return 0;
+        break;
+      }
+      case LALINFERENCE_COMPLEX16Vector_t:
+      {
+        const COMPLEX16Vector *va=*(COMPLEX16Vector **)pa->value, *vb=*(COMPLEX16Vector **)pb->value;
+        if(!va || !vb || va->length!=vb->length) return 0;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return pa==NULL && pb==NULL;
+}
+
+/* Copy the values of "origin" into "target", which must have the same layout,
+ * without reallocating any items */
+static void LALInferenceCopyVariablesInPlace(const LALInferenceVariables *origin, LALInferenceVariables *target)
+{
+  const LALInferenceVariableItem *po;
+  LALInferenceVariableItem *pt;
+  for(po=origin->head, pt=target->head; po && pt; po=po->next, pt=pt->next)
+  {
+    switch(po->type)
+    {
+      case LALINFERENCE_gslMatrix_t:
+        gsl_matrix_memcpy(*(gsl_matrix **)pt->value, *(gsl_matrix **)po->value);
+        break;
+      case LALINFERENCE_INT4Vector_t:
+      {
+        INT4Vector *vt=*(INT4Vector **)pt->value;
+        memcpy(vt->data, (*(INT4Vector **)po->value)->data, vt->length*sizeof(vt->data[0]));
+        break;
+      }
+      case LALINFERENCE_UINT4Vector_t:
+      {
+        UINT4Vector *vt=*(UINT4Vector **)pt->value;
+        memcpy(vt->data, (*(UINT4Vector **)po->value)->data, vt->length*sizeof(vt->data[0]));
+        break;
+      }
+      case LALINFERENCE_REAL8Vector_t:
+      {
+        REAL8Vector *vt=*(REAL8Vector **)pt->value;
+        memcpy(vt->data, (*(REAL8Vector **)po->value)->data, vt->length*sizeof(vt->data[0]));
+        break;
+      }
+      case LALINFERENCE_COMPLEX16Vector_t:
+      {
+        COMPLEX16Vector *vt=*(COMPLEX16Vector **)pt->value;
+        memcpy(vt->data, (*(COMPLEX16Vector **)po->value)->data, vt->length*sizeof(vt->data[0]));
+        break;
+      }
+      default:
+        memcpy(pt->value, po->value, LALInferenceTypeSize[po->type]);
+        break;
+    }
+  }
+}
+
 void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariables *target)
 /*  copy contents of "origin" over to "target"  */
 {
@@ -572,6 +665,15 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
   /* Make sure the structure is initialised */
   if(!target) XLAL_ERROR_VOID(XLAL_EFAULT, "Unable to copy to uninitialised LALInferenceVariables structure.");
 
+  /* Samplers mostly copy between states holding the same parameters, in
+   * which case the values can be copied over without rebuilding the list
+   * and its hash table */
+  if(origin->dimension>0 && LALInferenceVariablesSameLayout(origin, target))
+  {
+    LALInferenceCopyVariablesInPlace(origin, target);
+    return;
+  }
+
   /* First clear the target */
   LALInferenceClearVariables(target);
 
@@ -1627,7 +1729,7 @@ void LALInferenceCopyVariablesToArray(LALInferenceVariables *origin, REAL8 *targ
   LALInferenceVariableItem *ptr=origin->head;
   INT4 p=0;
   while(ptr!=NULL) {
-    if (LALInferenceCheckVariableNonFixed(origin, ptr->name)) {
+    if (ptr->vary==LALINFERENCE_PARAM_LINEAR || ptr->vary==LALINFERENCE_PARAM_CIRCULAR) {
       //Generalized to allow for parameters stored in gsl_matrix or UINT4Vector
       if(ptr->type == LALINFERENCE_gslMatrix_t)
       {
@@ -1691,7 +1793,7 @@ void LALInferenceCopyArrayToVariables(REAL8 *origin, LALInferenceVariables *targ
   LALInferenceVariableItem *ptr = target->head;
   INT4 p=0;
   while(ptr!=NULL) {
-    if (LALInferenceCheckVariableNonFixed(target, ptr->name))
+    if (ptr->vary==LALINFERENCE_PARAM_LINEAR || ptr->vary==LALINFERENCE_PARAM_CIRCULAR)
     {
       //Generalized to allow for parameters stored in gsl_matrix
       if(ptr->type == LALINFERENCE_gslMatrix_t)
@@ -2336,6 +2438,55 @@ void LALInferenceLambdaTsEta2Lambdas(REAL8 lambdaT, REAL8 dLambdaT, REAL8 eta, R
   return;
 }
 
+/* Number of neutron star families whose tables are kept between calls */
+#define LALINFERENCE_NS_FAMILY_CACHE_SIZE 64
+
+/* Tables of recently seen neutron star families, shared by all threads.
+   Created on first use and freed by LALInferenceDestroyNSFamilyCache(). */
+static LALSimNeutronStarFamilyCache *LALInferenceNSFamilyCache = NULL;
+
+/* Make the neutron star family of an eos, reusing the tables of recently
+   seen eos parameters so that repeated evaluations at the same eos (e.g.
+   proposals that only change the masses) avoid the TOV solves.
+   The key holds a tag for the eos model followed by its parameters. */
+static LALSimNeutronStarFamily *LALInferenceCreateNSFamily(const double *key, size_t keylen, LALSimNeutronStarEOS *eos){
+  LALSimNeutronStarFamilyCache *c;
+  #pragma omp critical (LALInferenceNSFamilyCache)
+  {
+    if (!LALInferenceNSFamilyCache)
+      LALInferenceNSFamilyCache = XLALCreateSimNeutronStarFamilyCache(LALINFERENCE_NS_FAMILY_CACHE_SIZE);
+    c = LALInferenceNSFamilyCache;
+  }
+  if (!c)
+    return XLALCreateSimNeutronStarFamily(eos);
+  return XLALCreateSimNeutronStarFamilyCached(c, key, keylen, eos);
+}
+
+void LALInferenceDestroyNSFamilyCache(void){
+  #pragma omp critical (LALInferenceNSFamilyCache)
+  {
+    XLALDestroySimNeutronStarFamilyCache(LALInferenceNSFamilyCache);
+    LALInferenceNSFamilyCache = NULL;
+  }
+  return;
+}
+
+/* Cached family for the 4-piece polytrope EOS model */
+static LALSimNeutronStarFamily *LALInferenceCreateNSFamilyPP(REAL8 logp1_si, REAL8 gamma1, REAL8 gamma2, REAL8 gamma3, LALSimNeutronStarEOS *eos){
+  const double key[] = {0., logp1_si, gamma1, gamma2, gamma3};
+  return LALInferenceCreateNSFamily(key, sizeof(key)/sizeof(key[0]), eos);
+}
+
+/* Cached family for the spectral EOS model */
+static LALSimNeutronStarFamily *LALInferenceCreateNSFamilySD(const REAL8 gamma[], int size, LALSimNeutronStarEOS *eos){
+  double key[1 + 8];
+  if (size < 0 || size > 8)
+    return XLALCreateSimNeutronStarFamily(eos);
+  key[0] = 1.;
+  memcpy(key + 1, gamma, size * sizeof(*gamma));
+  return LALInferenceCreateNSFamily(key, 1 + size, eos);
+}
+
 /* Find lambda1,2(m1,2|eos) for 4-piece polytrope EOS model */
 void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1,REAL8 gamma1,REAL8 gamma2,REAL8 gamma3, REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2){
 // Convert to SI
@@ -2347,7 +2498,7 @@ double mass2_kg=mass2*LAL_MSUN_SI;
 LALSimNeutronStarEOS *eos = NULL;
 LALSimNeutronStarFamily *fam = NULL;
 eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si, gamma1, gamma2, gamma3);
-fam = XLALCreateSimNeutronStarFamily(eos);
+fam = LALInferenceCreateNSFamilyPP(logp1_si, gamma1, gamma2, gamma3, eos);
 
 // Calculate lambda1(m1|eos)
 double r = XLALSimNeutronStarRadius(mass1_kg, fam);
@@ -2384,7 +2535,7 @@ else{
   LALSimNeutronStarEOS *eos = NULL;
   LALSimNeutronStarFamily *fam = NULL;
   eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,size);
-  fam = XLALCreateSimNeutronStarFamily(eos);
+  fam = LALInferenceCreateNSFamilySD(gamma, size, eos);
 
   // Calculate lambda1(m1|eos)
   double r = XLALSimNeutronStarRadius(mass1_kg, fam);
@@ -2412,6 +2563,7 @@ int ret;
 
 LALSimNeutronStarEOS *eos=NULL;
 LALSimNeutronStarFamily *fam=NULL;
+double eoskey[5];
 
 // If using 4-piece polytrope eos params...
 if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(params, "gamma1") && LALInferenceCheckVariable(params, "gamma2") && LALInferenceCheckVariable(params, "gamma3"))
@@ -2427,6 +2579,7 @@ if(LALInferenceCheckVariable(params, "logp1") && LALInferenceCheckVariable(param
 
   // Make 4-piece polytrope eos
   eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1_si,gamma1,gamma2,gamma3);
+  eoskey[0]=0.; eoskey[1]=logp1_si; eoskey[2]=gamma1; eoskey[3]=gamma2; eoskey[4]=gamma3;
 
 // Else if using 4-coeff spectral eos params...
 }
@@ -2444,6 +2597,7 @@ else if( LALInferenceCheckVariable(params,"SDgamma0") && LALInferenceCheckVariab
 
   // Make 4-piece polytrope eos
   eos = XLALSimNeutronStarEOSSpectralDecomposition(gamma,4);
+  eoskey[0]=1.; eoskey[1]=SDgamma0; eoskey[2]=SDgamma1; eoskey[3]=SDgamma2; eoskey[4]=SDgamma3;
 
 }
 // Else fail, since you need an eos
@@ -2495,7 +2649,7 @@ for (int i = 0; i < 4; ++i) {
 
 
 // Make family
-fam = XLALCreateSimNeutronStarFamily(eos);
+fam = LALInferenceCreateNSFamily(eoskey, 5, eos);
 
 // Determine which mass parameterization is used
 double mass1 = 0.;
@@ -3278,6 +3432,200 @@ REAL8 LALInferenceKDLogProposalRatio(LALInferenceKDTree *tree, REAL8 *current,
   return logCurrentCellFactor + logCurrentVolume - logProposedCellFactor - logProposedVolume;
 }
 
+/* Values of the tracked parameters of point in cov->x, with circular
+   parameters unwrapped about cov->ref */
+static int runningCovarianceValues(LALInferenceRunningCovariance *cov, LALInferenceVariables *point) {
+  for (UINT4 k = 0; k < cov->dim; k++) {
+    LALInferenceVariableItem *item = LALInferenceGetItem(point, cov->names[k]);
+    XLAL_CHECK(item != NULL, XLAL_ENAME, "point has no parameter %s", cov->names[k]);
+    REAL8 val = *(REAL8 *)item->value;
+    if (cov->circular[k]) {
+      REAL8 d = fmod(val - cov->ref[k], LAL_TWOPI);
+      if (d > LAL_PI) d -= LAL_TWOPI;
+      else if (d <= -LAL_PI) d += LAL_TWOPI;
+      val = cov->ref[k] + d;
+    }
+    cov->x[k] = val;
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Rank-one update of the mean and scatter matrix for the point in cov->x
+   entering (sign = +1) or leaving (sign = -1) the set */
+static void runningCovarianceUpdate(LALInferenceRunningCovariance *cov, INT4 sign) {
+  const UINT4 dim = cov->dim;
+  const UINT4 n = cov->npts;
+  const UINT4 nnew = sign > 0 ? n + 1 : n - 1;
+  REAL8 *delta = cov->x;
+  cov->npts = nnew;
+  cov->nupdates++;
+  if (nnew == 0) {
+    memset(cov->mean, 0, dim * sizeof(REAL8));
+    gsl_matrix_set_zero(cov->scatter);
+    return;
+  }
+  for (UINT4 k = 0; k < dim; k++) {
+    delta[k] -= cov->mean[k];
+    cov->mean[k] += sign * delta[k] / nnew;
+  }
+  const REAL8 w = sign * (REAL8)n / (REAL8)nnew;
+  for (UINT4 j = 0; j < dim; j++) {
+    REAL8 *row = gsl_matrix_ptr(cov->scatter, j, 0);
+    const REAL8 wj = w * delta[j];
+    for (UINT4 k = 0; k < dim; k++)
+      row[k] += wj * delta[k];
+  }
+}
+
+LALInferenceRunningCovariance *LALInferenceCreateRunningCovariance(LALInferenceVariables **points, UINT4 npts) {
+  XLAL_CHECK_NULL(points != NULL && npts > 0 && points[0] != NULL, XLAL_EFAULT);
+  LALInferenceVariableItem *item;
+  UINT4 dim = 0;
+  for (item = points[0]->head; item; item = item->next)
+    if ((item->vary == LALINFERENCE_PARAM_LINEAR || item->vary == LALINFERENCE_PARAM_CIRCULAR) && item->type == LALINFERENCE_REAL8_t)
+      dim++;
+  XLAL_CHECK_NULL(dim > 0, XLAL_EINVAL, "no varying REAL8 parameters");
+
+  LALInferenceRunningCovariance *cov = XLALCalloc(1, sizeof(*cov));
+  XLAL_CHECK_NULL(cov != NULL, XLAL_ENOMEM);
+  cov->dim = dim;
+  cov->names = XLALCalloc(dim, sizeof(char *));
+  cov->circular = XLALCalloc(dim, sizeof(INT4));
+  cov->ref = XLALCalloc(dim, sizeof(REAL8));
+  cov->mean = XLALCalloc(dim, sizeof(REAL8));
+  cov->x = XLALCalloc(dim, sizeof(REAL8));
+  cov->scatter = gsl_matrix_calloc(dim, dim);
+  cov->frameCov = gsl_matrix_calloc(dim, dim);
+  cov->eigenvectors = gsl_matrix_calloc(dim, dim);
+  cov->eigenvalues = XLALCreateREAL8Vector(dim);
+  cov->work = gsl_matrix_alloc(dim, dim);
+  cov->evalwork = gsl_vector_alloc(dim);
+  cov->ws = gsl_eigen_symmv_alloc(dim);
+  if (!cov->names || !cov->circular || !cov->ref || !cov->mean || !cov->x || !cov->scatter || !cov->frameCov
+      || !cov->eigenvectors || !cov->eigenvalues || !cov->work || !cov->evalwork || !cov->ws) {
+    LALInferenceDestroyRunningCovariance(cov);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  UINT4 k = 0;
+  for (item = points[0]->head; item; item = item->next) {
+    if ((item->vary != LALINFERENCE_PARAM_LINEAR && item->vary != LALINFERENCE_PARAM_CIRCULAR) || item->type != LALINFERENCE_REAL8_t)
+      continue;
+    cov->names[k] = XLALStringDuplicate(item->name);
+    cov->circular[k] = item->vary == LALINFERENCE_PARAM_CIRCULAR;
+    k++;
+  }
+
+  if (LALInferenceRunningCovarianceRecompute(cov, points, npts) != XLAL_SUCCESS
+      || LALInferenceRunningCovarianceEigen(cov) != XLAL_SUCCESS) {
+    LALInferenceDestroyRunningCovariance(cov);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  }
+  return cov;
+}
+
+void LALInferenceDestroyRunningCovariance(LALInferenceRunningCovariance *cov) {
+  if (cov == NULL) return;
+  if (cov->names)
+    for (UINT4 k = 0; k < cov->dim; k++)
+      XLALFree(cov->names[k]);
+  XLALFree(cov->names);
+  XLALFree(cov->circular);
+  XLALFree(cov->ref);
+  XLALFree(cov->mean);
+  XLALFree(cov->x);
+  if (cov->scatter) gsl_matrix_free(cov->scatter);
+  if (cov->frameCov) gsl_matrix_free(cov->frameCov);
+  if (cov->eigenvectors) gsl_matrix_free(cov->eigenvectors);
+  XLALDestroyREAL8Vector(cov->eigenvalues);
+  if (cov->work) gsl_matrix_free(cov->work);
+  if (cov->evalwork) gsl_vector_free(cov->evalwork);
+  if (cov->ws) gsl_eigen_symmv_free(cov->ws);
+  XLALFree(cov);
+}
+
+int LALInferenceRunningCovarianceRecompute(LALInferenceRunningCovariance *cov, LALInferenceVariables **points, UINT4 npts) {
+  XLAL_CHECK(cov != NULL && points != NULL, XLAL_EFAULT);
+  const UINT4 dim = cov->dim;
+
+  /* Unwrap circular parameters about their circular mean */
+  for (UINT4 k = 0; k < dim; k++) {
+    if (!cov->circular[k]) continue;
+    REAL8 ms = 0, mc = 0;
+    for (UINT4 i = 0; i < npts; i++) {
+      LALInferenceVariableItem *item = LALInferenceGetItem(points[i], cov->names[k]);
+      XLAL_CHECK(item != NULL, XLAL_ENAME, "point has no parameter %s", cov->names[k]);
+      ms += sin(*(REAL8 *)item->value);
+      mc += cos(*(REAL8 *)item->value);
+    }
+    cov->ref[k] = atan2(ms, mc);
+    if (cov->ref[k] < 0) cov->ref[k] += LAL_TWOPI;
+  }
+
+  cov->npts = 0;
+  memset(cov->mean, 0, dim * sizeof(REAL8));
+  gsl_matrix_set_zero(cov->scatter);
+  for (UINT4 i = 0; i < npts; i++) {
+    XLAL_CHECK(runningCovarianceValues(cov, points[i]) == XLAL_SUCCESS, XLAL_EFUNC);
+    runningCovarianceUpdate(cov, +1);
+  }
+  cov->nupdates = 0;
+  return XLAL_SUCCESS;
+}
+
+int LALInferenceRunningCovarianceAdd(LALInferenceRunningCovariance *cov, LALInferenceVariables *point) {
+  XLAL_CHECK(cov != NULL && point != NULL, XLAL_EFAULT);
+  XLAL_CHECK(runningCovarianceValues(cov, point) == XLAL_SUCCESS, XLAL_EFUNC);
+  runningCovarianceUpdate(cov, +1);
+  return XLAL_SUCCESS;
+}
+
+int LALInferenceRunningCovarianceRemove(LALInferenceRunningCovariance *cov, LALInferenceVariables *point) {
+  XLAL_CHECK(cov != NULL && point != NULL, XLAL_EFAULT);
+  XLAL_CHECK(cov->npts > 0, XLAL_EDOM, "set is empty");
+  XLAL_CHECK(runningCovarianceValues(cov, point) == XLAL_SUCCESS, XLAL_EFUNC);
+  runningCovarianceUpdate(cov, -1);
+  return XLAL_SUCCESS;
+}
+
+int LALInferenceRunningCovarianceMatrix(const LALInferenceRunningCovariance *cov, gsl_matrix *cvm) {
+  XLAL_CHECK(cov != NULL && cvm != NULL, XLAL_EFAULT);
+  XLAL_CHECK(cvm->size1 == cov->dim && cvm->size2 == cov->dim, XLAL_EBADLEN);
+  XLAL_CHECK(cov->npts > 0, XLAL_EDOM, "set is empty");
+  gsl_matrix_memcpy(cvm, cov->scatter);
+  gsl_matrix_scale(cvm, 1.0 / cov->npts);
+  return XLAL_SUCCESS;
+}
+
+REAL8 LALInferenceRunningCovarianceDrift(const LALInferenceRunningCovariance *cov) {
+  XLAL_CHECK_REAL8(cov != NULL, XLAL_EFAULT);
+  if (cov->npts == 0) return INFINITY;
+  const REAL8 norm = 1.0 / cov->npts;
+  REAL8 diff = 0, ref = 0;
+  for (UINT4 j = 0; j < cov->dim; j++) {
+    const REAL8 *row = gsl_matrix_const_ptr(cov->scatter, j, 0);
+    const REAL8 *frow = gsl_matrix_const_ptr(cov->frameCov, j, 0);
+    for (UINT4 k = 0; k < cov->dim; k++) {
+      const REAL8 d = row[k] * norm - frow[k];
+      diff += d * d;
+      ref += frow[k] * frow[k];
+    }
+  }
+  if (ref == 0) return diff == 0 ? 0 : INFINITY;
+  return sqrt(diff / ref);
+}
+
+int LALInferenceRunningCovarianceEigen(LALInferenceRunningCovariance *cov) {
+  XLAL_CHECK(cov != NULL, XLAL_EFAULT);
+  XLAL_CHECK(LALInferenceRunningCovarianceMatrix(cov, cov->frameCov) == XLAL_SUCCESS, XLAL_EFUNC);
+  gsl_matrix_memcpy(cov->work, cov->frameCov);
+  int status;
+  if ((status = gsl_eigen_symmv(cov->work, cov->evalwork, cov->eigenvectors, cov->ws)) != GSL_SUCCESS)
+    XLAL_ERROR(XLAL_EFAILED, "gsl_eigen_symmv: %s", gsl_strerror(status));
+  for (UINT4 k = 0; k < cov->dim; k++)
+    cov->eigenvalues->data[k] = gsl_vector_get(cov->evalwork, k);
+  return XLAL_SUCCESS;
+}
+
 UINT4 LALInferenceCheckPositiveDefinite(
                           gsl_matrix       *matrix,
                           UINT4            dim
@@ -4428,6 +4776,178 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
   }
 }
 
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibration(const REAL8Vector *logfreqs, const REAL8 *freqs, UINT4 length) {
+  XLAL_CHECK_NULL(logfreqs != NULL && (freqs != NULL || length == 0), XLAL_EFAULT);
+  const UINT4 N = logfreqs->length;
+  const REAL8 *x = logfreqs->data;
+  XLAL_CHECK_NULL(N >= 3, XLAL_EINVAL, "need at least 3 spline nodes, got %u", N);
+  for (UINT4 k = 1; k < N; k++)
+    XLAL_CHECK_NULL(x[k] > x[k-1], XLAL_EINVAL, "spline node log-frequencies must increase");
+
+  LALInferenceSplineCalibration *cal = XLALCalloc(1, sizeof(*cal));
+  XLAL_CHECK_NULL(cal != NULL, XLAL_ENOMEM);
+  cal->npts = N;
+  cal->length = length;
+  cal->logfreqs = XLALMalloc(N * sizeof(REAL8));
+  cal->curvature = XLALCalloc(N * N, sizeof(REAL8));
+  cal->amps = XLALMalloc(N * sizeof(REAL8));
+  cal->phases = XLALMalloc(N * sizeof(REAL8));
+  cal->work = XLALMalloc(10 * N * sizeof(REAL8));
+  cal->interval = XLALMalloc((length ? length : 1) * sizeof(UINT4));
+  cal->offset = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  cal->factor = XLALCreateCOMPLEX16Vector(length);
+  REAL8 *diag = XLALMalloc(N * sizeof(REAL8));
+  if (!cal->logfreqs || !cal->curvature || !cal->amps || !cal->phases || !cal->work || !cal->interval || !cal->offset || !cal->factor || !diag) {
+    XLALFree(diag);
+    LALInferenceDestroySplineCalibration(cal);
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  }
+  memcpy(cal->logfreqs, x, N * sizeof(REAL8));
+
+  /* The natural cubic spline used by gsl_interp_cspline has half second
+     derivatives c[0] = c[N-1] = 0 and, for the interior nodes, T c = G y,
+     where T is the symmetric tridiagonal matrix with diagonal
+     2 (h[k] + h[k+1]) and off-diagonal h[k+1], h[k] = x[k+1] - x[k], and
+     G y are the scaled second differences of the node values y.  Build G
+     in the interior rows of the curvature matrix and solve T C = G in
+     place, so that c = C y. */
+  REAL8 *C = cal->curvature;
+  for (UINT4 k = 0; k + 2 < N; k++) {
+    const REAL8 h0 = x[k+1] - x[k], h1 = x[k+2] - x[k+1];
+    C[(k+1)*N + k] = 3.0 / h0;
+    C[(k+1)*N + k+1] = -3.0 / h1 - 3.0 / h0;
+    C[(k+1)*N + k+2] = 3.0 / h1;
+  }
+  /* Thomas algorithm, forward elimination then back substitution */
+  for (UINT4 k = 0; k + 2 < N; k++) {
+    diag[k] = 2.0 * (x[k+2] - x[k]);
+    if (k > 0) {
+      const REAL8 off = x[k+1] - x[k];
+      const REAL8 m = off / diag[k-1];
+      diag[k] -= m * off;
+      for (UINT4 j = 0; j < N; j++)
+        C[(k+1)*N + j] -= m * C[k*N + j];
+    }
+  }
+  for (UINT4 k = N - 2; k-- > 0; ) {
+    for (UINT4 j = 0; j < N; j++) {
+      if (k + 3 < N)
+        C[(k+1)*N + j] -= (x[k+2] - x[k+1]) * C[(k+2)*N + j];
+      C[(k+1)*N + j] /= diag[k];
+    }
+  }
+  XLALFree(diag);
+
+  /* Interval and offset of each output frequency; frequencies outside the
+     nodes use the extra interval npts-1, whose coefficients are zero */
+  const REAL8 lowf = exp(x[0]), highf = exp(x[N-1]);
+  for (UINT4 i = 0; i < length; i++) {
+    const REAL8 f = freqs[i];
+    if (f < lowf || f > highf) {
+      cal->interval[i] = N - 1;
+      cal->offset[i] = 0.0;
+      continue;
+    }
+    const REAL8 logf = log(f);
+    UINT4 lo = 0, hi = N - 1;
+    while (hi > lo + 1) {
+      const UINT4 mid = (lo + hi) / 2;
+      if (x[mid] > logf) hi = mid;
+      else lo = mid;
+    }
+    cal->interval[i] = lo;
+    cal->offset[i] = logf - x[lo];
+  }
+
+  return cal;
+}
+
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibrationFD(const REAL8Vector *logfreqs, REAL8 deltaF, UINT4 length) {
+  REAL8 *freqs = XLALMalloc((length ? length : 1) * sizeof(REAL8));
+  XLAL_CHECK_NULL(freqs != NULL, XLAL_ENOMEM);
+  for (UINT4 i = 0; i < length; i++)
+    freqs[i] = deltaF * i;
+  LALInferenceSplineCalibration *cal = LALInferenceCreateSplineCalibration(logfreqs, freqs, length);
+  XLALFree(freqs);
+  XLAL_CHECK_NULL(cal != NULL, XLAL_EFUNC);
+  return cal;
+}
+
+void LALInferenceDestroySplineCalibration(LALInferenceSplineCalibration *cal) {
+  if (cal == NULL) return;
+  XLALFree(cal->logfreqs);
+  XLALFree(cal->curvature);
+  XLALFree(cal->interval);
+  XLALFree(cal->offset);
+  XLALFree(cal->amps);
+  XLALFree(cal->phases);
+  XLALFree(cal->work);
+  XLALDestroyCOMPLEX16Vector(cal->factor);
+  XLALFree(cal);
+}
+
+int LALInferenceSplineCalibrationMatches(const LALInferenceSplineCalibration *cal, const REAL8Vector *logfreqs, UINT4 length) {
+  if (cal == NULL || logfreqs == NULL) return 0;
+  if (cal->npts != logfreqs->length || cal->length != length) return 0;
+  return memcmp(cal->logfreqs, logfreqs->data, cal->npts * sizeof(REAL8)) == 0;
+}
+
+const COMPLEX16Vector *LALInferenceSplineCalibrationEval(LALInferenceSplineCalibration *cal, const REAL8Vector *deltaAmps, const REAL8Vector *deltaPhases) {
+  XLAL_CHECK_NULL(cal != NULL && deltaAmps != NULL && deltaPhases != NULL, XLAL_EFAULT);
+  const UINT4 N = cal->npts;
+  XLAL_CHECK_NULL(deltaAmps->length == N && deltaPhases->length == N, XLAL_EINVAL, "input lengths differ");
+  const REAL8 *ya = deltaAmps->data, *yp = deltaPhases->data;
+
+  if (cal->valid && memcmp(cal->amps, ya, N * sizeof(REAL8)) == 0 && memcmp(cal->phases, yp, N * sizeof(REAL8)) == 0)
+    return cal->factor;
+
+  /* Cubic coefficients of each interval, as in gsl_interp_cspline,
+     with a final all-zero interval for frequencies outside the nodes */
+  REAL8 *a0 = cal->work, *a1 = a0 + N, *a2 = a1 + N, *a3 = a2 + N;
+  REAL8 *p0 = a3 + N, *p1 = p0 + N, *p2 = p1 + N, *p3 = p2 + N;
+  REAL8 *ca = p3 + N, *cp = ca + N;
+  for (UINT4 k = 0; k < N; k++) {
+    REAL8 sa = 0.0, sp = 0.0;
+    for (UINT4 j = 0; j < N; j++) {
+      sa += cal->curvature[k*N + j] * ya[j];
+      sp += cal->curvature[k*N + j] * yp[j];
+    }
+    ca[k] = sa;
+    cp[k] = sp;
+  }
+  for (UINT4 k = 0; k + 1 < N; k++) {
+    const REAL8 h = cal->logfreqs[k+1] - cal->logfreqs[k];
+    a0[k] = ya[k];
+    a1[k] = (ya[k+1] - ya[k]) / h - h * (ca[k+1] + 2.0 * ca[k]) / 3.0;
+    a2[k] = ca[k];
+    a3[k] = (ca[k+1] - ca[k]) / (3.0 * h);
+    p0[k] = yp[k];
+    p1[k] = (yp[k+1] - yp[k]) / h - h * (cp[k+1] + 2.0 * cp[k]) / 3.0;
+    p2[k] = cp[k];
+    p3[k] = (cp[k+1] - cp[k]) / (3.0 * h);
+  }
+  a0[N-1] = a1[N-1] = a2[N-1] = a3[N-1] = 0.0;
+  p0[N-1] = p1[N-1] = p2[N-1] = p3[N-1] = 0.0;
+
+  /* (1 + dA) (2 + i dPhi) / (2 - i dPhi), without complex division */
+  const UINT4 *restrict interval = cal->interval;
+  const REAL8 *restrict offset = cal->offset;
+  COMPLEX16 *restrict factor = cal->factor->data;
+  for (UINT4 i = 0; i < cal->length; i++) {
+    const UINT4 k = interval[i];
+    const REAL8 dx = offset[i];
+    const REAL8 dA = a0[k] + dx * (a1[k] + dx * (a2[k] + dx * a3[k]));
+    const REAL8 dPhi = p0[k] + dx * (p1[k] + dx * (p2[k] + dx * p3[k]));
+    const REAL8 norm = (1.0 + dA) / (4.0 + dPhi * dPhi);
+    factor[i] = crect(norm * (4.0 - dPhi * dPhi), norm * 4.0 * dPhi);
+  }
+
+  memcpy(cal->amps, ya, N * sizeof(REAL8));
+  memcpy(cal->phases, yp, N * sizeof(REAL8));
+  cal->valid = 1;
+  return cal->factor;
+}
+
 void LALInferenceFprintSplineCalibrationHeader(FILE *output, LALInferenceThreadState *thread) {
     INT4 i, nifo;
     char **ifo_names = NULL;
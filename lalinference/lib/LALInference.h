@@ -94,6 +94,7 @@ struct tagLALInferenceRunState;
 struct tagLALInferenceThreadState;
 struct tagLALInferenceIFOData;
 struct tagLALInferenceModel;
+struct tagLALInferenceMarginalDistance;
 
 /*Data storage type definitions*/
 
@@ -366,6 +367,59 @@ int LALInferenceSplineCalibrationFactorROQ(REAL8Vector *logfreqs,
 					REAL8Sequence *freqNodesQuad,
 					COMPLEX16Sequence **calFactorROQQuad);
 
+/**
+ * Precomputed evaluation of the spline calibration model for a fixed set
+ * of spline nodes and output frequencies.
+ *
+ * The natural cubic spline through the node values is linear in those
+ * values, so the matrix mapping the node values to the spline curvature at
+ * each node, and the spline interval and offset of each output frequency,
+ * are computed once.  Evaluating the calibration factor is then a small
+ * matrix-vector product followed by a polynomial per frequency, with no
+ * logarithms, searches or allocation.  The factor from the most recent
+ * evaluation is kept, and returned without recomputation when the node
+ * values have not changed.  The result agrees with
+ * LALInferenceSplineCalibrationFactor() to rounding.
+ */
+typedef struct tagLALInferenceSplineCalibration
+{
+  UINT4 npts;             /** Number of spline nodes */
+  REAL8 *logfreqs;        /** Log-frequencies of the nodes */
+  REAL8 *curvature;       /** npts x npts matrix from node values to half the second derivatives of the spline */
+  UINT4 length;           /** Number of output frequencies */
+  UINT4 *interval;        /** Spline interval of each output frequency; npts-1 if outside the nodes */
+  REAL8 *offset;          /** Log-frequency of each output frequency relative to the start of its interval */
+  REAL8 *amps, *phases;   /** Node values of the most recent evaluation */
+  INT4 valid;             /** Whether factor holds the evaluation at amps, phases */
+  REAL8 *work;            /** Workspace for the spline coefficients */
+  COMPLEX16Vector *factor; /** Calibration factor at each output frequency */
+} LALInferenceSplineCalibration;
+
+/**
+ * Create a spline calibration engine for nodes at logfreqs and output at
+ * the length frequencies freqs.
+ */
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibration(const REAL8Vector *logfreqs, const REAL8 *freqs, UINT4 length);
+
+/**
+ * Create a spline calibration engine for nodes at logfreqs and output at
+ * the frequency bins i*deltaF, i = 0 ... length-1, as filled by
+ * LALInferenceSplineCalibrationFactor().
+ */
+LALInferenceSplineCalibration *LALInferenceCreateSplineCalibrationFD(const REAL8Vector *logfreqs, REAL8 deltaF, UINT4 length);
+
+void LALInferenceDestroySplineCalibration(LALInferenceSplineCalibration *cal);
+
+/** Whether cal was created for the nodes logfreqs and length output frequencies */
+int LALInferenceSplineCalibrationMatches(const LALInferenceSplineCalibration *cal, const REAL8Vector *logfreqs, UINT4 length);
+
+/**
+ * Evaluate the calibration factor for the node values deltaAmps and
+ * deltaPhases.  Returns cal->factor, which is owned by cal and valid
+ * until the next evaluation.
+ */
+const COMPLEX16Vector *LALInferenceSplineCalibrationEval(LALInferenceSplineCalibration *cal, const REAL8Vector *deltaAmps, const REAL8Vector *deltaPhases);
+
 
 //Wrapper for template computation
 //(relies on LAL libraries for implementation) <- could be a #DEFINE ?
@@ -463,6 +517,9 @@ typedef struct tagLALInferenceModel
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
+  struct tagLALInferenceMarginalDistance *margdist; /** Distance marginalisation table, shared between threads */
+  LALInferenceSplineCalibration **spcal; /** Spline calibration engines, two per detector, created on first use */
+  struct tagLALInferenceMarginalTime *margtime; /** Time marginalisation workspace, created on first use */
 
 } LALInferenceModel;
 
@@ -646,7 +703,6 @@ tagLALInferenceIFOData
   REAL8Window               *window;        /** A window */
   REAL8                      padding; /** Padding for the above window */
   REAL8FFTPlan              *timeToFreqFFTPlan, *freqToTimeFFTPlan; /** Pre-calculated FFT plans for forward and reverse FFTs */
-  REAL8FFTPlan              *margFFTPlan; /** FFT plan needed for time/time-and-phase marginalisation */
   REAL8                     fLow, fHigh;	/** integration limits for overlap integral in F-domain */
   LALDetector               *detector;          /** LALDetector structure for where this data came from */
   LIGOTimeGPS		    epoch;              /** The epoch of this observation (the time of the first sample) */
@@ -671,7 +727,11 @@ tagLALInferenceROQData
   FILE *weightsFileQuadratic;
 
 
-  struct tagLALInferenceROQSplineWeightsLinear *weights_linear;
+  /* Cubic spline coefficients of the linear weights as functions of the
+     time shift, see LALInferenceROQLinearWeightsInit() */
+  UINT4 n_basis_linear; /** number of linear basis elements */
+  REAL8 *weights_linear_tcs; /** time shifts at which the linear weights are tabulated */
+  REAL8 *weights_linear_coeffs; /** spline coefficients, interval-major and contiguous in basis element */
 
  
   /* Deprecated functions that should be removed at some point */ 
@@ -682,21 +742,6 @@ tagLALInferenceROQData
 
 } LALInferenceROQData;
 
-/**
- *  *  * Structure to contain spline of ROQ weights as a function of tc
- *   *   */
-
-typedef struct
-tagLALInferenceROQSplineWeightsLinear
-{
-  
- 
-  gsl_spline *spline_real_weight_linear;
-  gsl_spline *spline_imag_weight_linear; 
-  gsl_interp_accel *acc_real_weight_linear;
-  gsl_interp_accel *acc_imag_weight_linear;
-
-} LALInferenceROQSplineWeights;
 /**
  *  * Structure to contain model-related Reduced Order Quadrature quantities
  *   */
@@ -883,6 +928,12 @@ void LALInferenceLogp1GammasMasses2Lambdas(REAL8 logp1, REAL8 gamma1, REAL8 gamm
 /** Convert from spectral parameters to lambda1, lambda2 */
 void LALInferenceSDGammasMasses2Lambdas(REAL8 gamma[], REAL8 mass1, REAL8 mass2, REAL8 *lambda1, REAL8 *lambda2, int size);
 
+/** Free the neutron star families cached by LALInferenceLogp1GammasMasses2Lambdas(),
+ * LALInferenceSDGammasMasses2Lambdas() and LALInferenceEOSPhysicalCheck().
+ * The cache is recreated on next use; call this before exiting, when no other
+ * thread is using it. */
+void LALInferenceDestroyNSFamilyCache(void);
+
 /** Check for causality violation and mass conflict given masses and eos */
 int LALInferenceEOSPhysicalCheck(LALInferenceVariables *params, ProcessParamsTable *commandLine);
 
@@ -1012,6 +1063,74 @@ void LALInferenceKDDrawEigenFrame(gsl_rng * rng, LALInferenceKDTree *tree, REAL8
 REAL8 LALInferenceKDLogProposalRatio(LALInferenceKDTree *tree, REAL8 *current,
                                      REAL8 *proposed, size_t Npts);
 
+/**
+ * Running mean and covariance of a set of points, such as the live points
+ * of the nested sampler, together with the eigenvectors of the covariance
+ * matrix used by the covariance eigenvector proposal.
+ *
+ * Points entering and leaving the set update the mean and covariance with
+ * a rank-one update in O(dim^2), instead of a pass over all the points.
+ * The eigenvectors are those of the covariance matrix at the time they
+ * were last computed; LALInferenceRunningCovarianceDrift() measures how
+ * far the covariance has moved since then, so that the eigen-decomposition
+ * need only be repeated when it has moved appreciably.  Circular
+ * parameters are unwrapped about the circular mean of the points at the
+ * last full computation.  The parameters tracked are the varying REAL8
+ * parameters of the first point, as for the covariance of the live points.
+ */
+typedef struct tagLALInferenceRunningCovariance
+{
+  UINT4 dim;                  /** Number of parameters */
+  UINT4 npts;                 /** Number of points in the set */
+  char **names;               /** Names of the parameters */
+  INT4 *circular;             /** Whether each parameter is circular (modulo 2 pi) */
+  REAL8 *ref;                 /** Angle about which each circular parameter is unwrapped */
+  REAL8 *mean;                /** Mean of the points */
+  gsl_matrix *scatter;        /** Sum over points of the outer product of their deviations from the mean */
+  UINT4 nupdates;             /** Number of points added or removed since the last full computation */
+  gsl_matrix *frameCov;       /** Covariance matrix at the last eigen-decomposition */
+  gsl_matrix *eigenvectors;   /** Eigenvectors of frameCov, one per column */
+  REAL8Vector *eigenvalues;   /** Eigenvalues of frameCov */
+  REAL8 *x;                   /** Workspace for one point */
+  gsl_matrix *work;           /** Workspace for the eigen-decomposition */
+  gsl_vector *evalwork;
+  gsl_eigen_symmv_workspace *ws;
+} LALInferenceRunningCovariance;
+
+/**
+ * Create a running covariance of the npts points, and compute the
+ * eigenvectors of their covariance matrix.
+ */
+LALInferenceRunningCovariance *LALInferenceCreateRunningCovariance(LALInferenceVariables **points, UINT4 npts);
+
+void LALInferenceDestroyRunningCovariance(LALInferenceRunningCovariance *cov);
+
+/**
+ * Recompute the mean and covariance from the npts points, discarding
+ * the rounding error accumulated by the rank-one updates.  The
+ * eigenvectors are not recomputed.
+ */
+int LALInferenceRunningCovarianceRecompute(LALInferenceRunningCovariance *cov, LALInferenceVariables **points, UINT4 npts);
+
+/** Add point to the set */
+int LALInferenceRunningCovarianceAdd(LALInferenceRunningCovariance *cov, LALInferenceVariables *point);
+
+/** Remove point, which must be in the set, from the set */
+int LALInferenceRunningCovarianceRemove(LALInferenceRunningCovariance *cov, LALInferenceVariables *point);
+
+/** Copy the covariance matrix of the set into cvm, which must be dim x dim */
+int LALInferenceRunningCovarianceMatrix(const LALInferenceRunningCovariance *cov, gsl_matrix *cvm);
+
+/**
+ * Frobenius norm of the change in the covariance matrix since the
+ * eigenvectors were computed, relative to the norm of the covariance
+ * matrix at that time.
+ */
+REAL8 LALInferenceRunningCovarianceDrift(const LALInferenceRunningCovariance *cov);
+
+/** Compute the eigenvectors and eigenvalues of the current covariance matrix */
+int LALInferenceRunningCovarianceEigen(LALInferenceRunningCovariance *cov);
+
 /** Check matrix is positive definite. dim is matrix dimensions */
 UINT4 LALInferenceCheckPositiveDefinite(
                           gsl_matrix       *matrix,
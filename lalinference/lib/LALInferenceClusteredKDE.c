@@ -717,9 +717,13 @@ void LALInferenceKmeansRandomPartitionInitialize(LALInferenceKmeans *kmeans) {
  */
 void LALInferenceKmeansAssignment(LALInferenceKmeans *kmeans) {
     INT4 i, j;
+    INT4 changed = 0;
 
-    kmeans->error = 0.;
+    /* Points are assigned independently, so split them between threads.  The
+     *  distances are kept to sum the error in a fixed order. */
+    REAL8 *best_dists = XLALMalloc(kmeans->npts * sizeof(REAL8));
 
+    #pragma omp parallel for private(j) reduction(|:changed) schedule(static)
     for (i = 0; i < kmeans->npts; i++) {
         gsl_vector_view x = gsl_matrix_row(kmeans->data, i);
         gsl_vector_view c;
@@ -742,12 +746,20 @@ void LALInferenceKmeansAssignment(LALInferenceKmeans *kmeans) {
         /* Check if the point's assignment has changed */
         INT4 current_cluster = kmeans->assignments[i];
         if (best_cluster != current_cluster) {
-            kmeans->has_changed = 1;
+            changed = 1;
             kmeans->assignments[i] = best_cluster;
         }
-        kmeans->error += best_dist;
+        best_dists[i] = best_dist;
     }
 
+    if (changed)
+        kmeans->has_changed = 1;
+
+    kmeans->error = 0.;
+    for (i = 0; i < kmeans->npts; i++)
+        kmeans->error += best_dists[i];
+    XLALFree(best_dists);
+
     /* Recalculate cluster sizes */
     for (i = 0; i < kmeans->k; i++)
         kmeans->sizes[i] = 0;
@@ -1175,10 +1187,12 @@ gsl_matrix * LALInferenceWhitenSamples(gsl_matrix *samples) {
  */
 REAL8 euclidean_dist_squared(gsl_vector *x, gsl_vector *y) {
     size_t i;
+    const REAL8 *xd = x->data, *yd = y->data;
+    const size_t xs = x->stride, ys = y->stride;
 
     REAL8 dist = 0.;
     for (i = 0; i < x->size; i++) {
-        REAL8 diff = gsl_vector_get(x, i) - gsl_vector_get(y, i);
+        REAL8 diff = xd[i*xs] - yd[i*ys];
         dist += diff * diff;
     }
 
@@ -1305,12 +1319,22 @@ REAL8 LALInferenceKmeansBIC(LALInferenceKmeans *kmeans) {
     REAL8 N = (REAL8) kmeans->npts;
     REAL8 d = (REAL8) kmeans->dim;
 
-    log_l = 0.;
+    /* Build the KDEs before evaluating them from several threads */
+    if (kmeans->KDEs == NULL)
+        LALInferenceKmeansBuildKDE(kmeans);
+
+    REAL8 *pdfs = XLALMalloc(kmeans->npts * sizeof(REAL8));
+    #pragma omp parallel for schedule(dynamic, 64)
     for (i = 0; i < kmeans->npts; i++) {
         gsl_vector_view pt = gsl_matrix_row(kmeans->data, i);
-        log_l += LALInferenceWhitenedKmeansPDF(kmeans, (&pt.vector)->data);
+        pdfs[i] = LALInferenceWhitenedKmeansPDF(kmeans, (&pt.vector)->data);
     }
 
+    log_l = 0.;
+    for (i = 0; i < kmeans->npts; i++)
+        log_l += pdfs[i];
+    XLALFree(pdfs);
+
     /* Determine the total number of parameters in clustered-KDE */
     /* Account for centroid locations */
     REAL8 nparams = k * d;
@@ -19,6 +19,7 @@
  *  MA  02110-1301  USA
  */
 
+#include <string.h>
 #include <lal/LALInferenceGenerateROQ.h>
 #include <lal/XLALGSL.h>
 
@@ -2015,6 +2016,166 @@ COMPLEX16 LALInferenceROQCOMPLEX16DotProduct(COMPLEX16Vector *weights, COMPLEX16
 }
 
 
+/* number of spline coefficients per basis element and interval: the value
+ * and the linear, quadratic and cubic coefficients of the real and then of
+ * the imaginary part */
+#define ROQ_WEIGHT_NCOEFFS 8
+
+/** \brief Tabulate the linear ROQ weights as cubic splines in the time shift
+ *
+ * The linear weights for \f$\langle d|h\rangle\f$ depend on the time shift of the
+ * template, and are given at a set of time shifts \c tcs. This function
+ * computes natural cubic spline coefficients through these values, identical
+ * to those of a \c gsl_interp_cspline, and stores them in \c roq ordered by
+ * interval and then by basis element. A single bracket search then serves all
+ * basis elements, and the evaluation over basis elements is a contiguous,
+ * vectorisable loop that needs no \c gsl_interp_accel, so it can be called
+ * from any number of threads.
+ *
+ * @param[in,out] roq The ROQ data to hold the tables
+ * @param[in] tcs The (increasing) time shifts at which the weights are given
+ * @param[in] weights The weights, with \c n_time_steps consecutive entries for
+ * each basis element
+ * @param[in] n_time_steps The number of time shifts
+ * @param[in] n_basis The number of linear basis elements
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE on error
+ */
+INT4 LALInferenceROQLinearWeightsInit(LALInferenceROQData *roq, const REAL8 *tcs, const COMPLEX16 *weights, UINT4 n_time_steps, UINT4 n_basis){
+  XLAL_CHECK( roq != NULL && tcs != NULL && weights != NULL, XLAL_EFAULT );
+  XLAL_CHECK( n_time_steps >= 3, XLAL_EINVAL, "Need at least three time steps to interpolate the weights." );
+  for ( UINT4 k = 1; k < n_time_steps; k++ ){
+    XLAL_CHECK( tcs[k] > tcs[k-1], XLAL_EINVAL, "Time shifts must be strictly increasing." );
+  }
+
+  REAL8 *tabtcs = XLALMalloc( n_time_steps*sizeof(REAL8) );
+  REAL8 *coeffs = XLALMalloc( (size_t)(n_time_steps-1)*n_basis*ROQ_WEIGHT_NCOEFFS*sizeof(REAL8) );
+  REAL8 *y = XLALMalloc( n_time_steps*sizeof(REAL8) );
+  REAL8 *c = XLALMalloc( n_time_steps*sizeof(REAL8) );
+  gsl_spline *spline = NULL;
+  XLAL_CALLGSL( spline = gsl_spline_alloc( gsl_interp_cspline, n_time_steps ) );
+  if ( !tabtcs || !coeffs || !y || !c || !spline ){
+    XLALFree( tabtcs );
+    XLALFree( coeffs );
+    XLALFree( y );
+    XLALFree( c );
+    if ( spline ) gsl_spline_free( spline );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  memcpy( tabtcs, tcs, n_time_steps*sizeof(REAL8) );
+
+  for ( UINT4 i = 0; i < n_basis; i++ ){
+    for ( UINT4 part = 0; part < 2; part++ ){
+      for ( UINT4 k = 0; k < n_time_steps; k++ ){
+        y[k] = part ? cimag( weights[(size_t)i*n_time_steps + k] ) : creal( weights[(size_t)i*n_time_steps + k] );
+      }
+      XLAL_CALLGSL( gsl_spline_init( spline, tabtcs, y, n_time_steps ) );
+
+      /* the second derivative of the spline at a knot is exactly twice its
+       * quadratic coefficient there, and it vanishes at the last knot */
+      for ( UINT4 k = 0; k < n_time_steps - 1; k++ ){
+        c[k] = 0.5*gsl_spline_eval_deriv2( spline, tabtcs[k], NULL );
+      }
+      c[n_time_steps-1] = 0.;
+
+      /* coefficients as in the GSL cspline evaluation */
+      for ( UINT4 k = 0; k < n_time_steps - 1; k++ ){
+        REAL8 dx = tabtcs[k+1] - tabtcs[k];
+        REAL8 dy = y[k+1] - y[k];
+        REAL8 *ck = coeffs + ((size_t)k*ROQ_WEIGHT_NCOEFFS + 4*part)*n_basis + i;
+        ck[0] = y[k];
+        ck[n_basis] = (dy / dx) - dx * (c[k+1] + 2.0 * c[k]) / 3.0;
+        ck[2*n_basis] = c[k];
+        ck[3*n_basis] = (c[k+1] - c[k]) / (3.0 * dx);
+      }
+    }
+  }
+
+  gsl_spline_free( spline );
+  XLALFree( y );
+  XLALFree( c );
+
+  LALInferenceROQLinearWeightsFree( roq );
+  roq->n_basis_linear = n_basis;
+  roq->n_time_steps = n_time_steps;
+  roq->weights_linear_tcs = tabtcs;
+  roq->weights_linear_coeffs = coeffs;
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Calculate the ROQ \f$\langle d|h\rangle\f$ of a time-shifted template
+ *
+ * This evaluates the linear weights tabulated by \c LALInferenceROQLinearWeightsInit
+ * at the time shift \c timeshift, and returns
+ * \f$\sum_i w_i(t)\, [c_i (F_+ h_{+,i} + F_\times h_{\times,i})]^*\f$ over the
+ * linear basis elements, without storing the interpolated weights. The
+ * result equals that of evaluating a \c gsl_interp_cspline of each weight.
+ *
+ * @param[in] roq The ROQ data holding the weight tables
+ * @param[in] timeshift The time shift of the template
+ * @param[in] hplus The plus polarisation at the linear interpolation nodes
+ * @param[in] hcross The cross polarisation at the linear interpolation nodes
+ * @param[in] fplus The plus antenna response
+ * @param[in] fcross The cross antenna response
+ * @param[in] calfactor Calibration factors at the nodes, or \c NULL for none
+ *
+ * @return The complex inner product, or NaN on error
+ */
+COMPLEX16 LALInferenceROQTimeShiftedDotProduct(const LALInferenceROQData *roq, REAL8 timeshift,
+                                               const COMPLEX16 *hplus, const COMPLEX16 *hcross,
+                                               REAL8 fplus, REAL8 fcross, const COMPLEX16 *calfactor){
+  XLAL_CHECK_VAL( XLAL_REAL8_FAIL_NAN, roq != NULL && roq->weights_linear_coeffs != NULL, XLAL_EFAULT, "Linear weights have not been tabulated." );
+  XLAL_CHECK_VAL( XLAL_REAL8_FAIL_NAN, hplus != NULL && hcross != NULL, XLAL_EFAULT );
+
+  const UINT4 n = roq->n_basis_linear;
+  const UINT4 ntcs = (UINT4)roq->n_time_steps;
+  const REAL8 *tcs = roq->weights_linear_tcs;
+  XLAL_CHECK_VAL( XLAL_REAL8_FAIL_NAN, timeshift >= tcs[0] && timeshift <= tcs[ntcs-1], XLAL_EDOM,
+                  "Time shift %g outside the range [%g, %g] of the ROQ weights.", timeshift, tcs[0], tcs[ntcs-1] );
+
+  /* find k with tcs[k] <= timeshift < tcs[k+1], as gsl_interp_bsearch() */
+  UINT4 lo = 0, hi = ntcs - 1;
+  while ( hi > lo + 1 ){
+    UINT4 mid = (hi + lo)/2;
+    if ( tcs[mid] > timeshift ) hi = mid;
+    else lo = mid;
+  }
+
+  const REAL8 delx = timeshift - tcs[lo];
+  const REAL8 *a = roq->weights_linear_coeffs + (size_t)lo*ROQ_WEIGHT_NCOEFFS*n;
+  const REAL8 *are = a, *bre = a + n, *cre = a + 2*n, *dre = a + 3*n;
+  const REAL8 *aim = a + 4*n, *bim = a + 5*n, *cim = a + 6*n, *dim = a + 7*n;
+  REAL8 sumre = 0., sumim = 0.;
+
+  for ( UINT4 i = 0; i < n; i++ ){
+    REAL8 wre = are[i] + delx * (bre[i] + delx * (cre[i] + delx * dre[i]));
+    REAL8 wim = aim[i] + delx * (bim[i] + delx * (cim[i] + delx * dim[i]));
+    COMPLEX16 h = fplus*hplus[i] + fcross*hcross[i];
+    if ( calfactor ) h = calfactor[i] * h;
+    /* w * conj(h) */
+    sumre += wre*creal(h) + wim*cimag(h);
+    sumim += wim*creal(h) - wre*cimag(h);
+  }
+
+  return sumre + I*sumim;
+}
+
+
+/** \brief Free the linear weight tables of \c LALInferenceROQLinearWeightsInit
+ *
+ * @param[in,out] roq The ROQ data holding the tables
+ */
+void LALInferenceROQLinearWeightsFree(LALInferenceROQData *roq){
+  if ( roq == NULL ) { return; }
+  XLALFree( roq->weights_linear_tcs );
+  XLALFree( roq->weights_linear_coeffs );
+  roq->weights_linear_tcs = NULL;
+  roq->weights_linear_coeffs = NULL;
+  roq->n_basis_linear = 0;
+}
+
 /** \brief Free memory for a \c LALInferenceREALROQInterpolant
  *
  * @param[in] a A pointer to a  \c LALInferenceREALROQInterpolant
@@ -119,6 +119,13 @@ COMPLEX16Vector *LALInferenceGenerateCOMPLEX16LinearWeights(COMPLEX16Array *B, C
 REAL8 LALInferenceROQREAL8DotProduct(REAL8Vector *weights, REAL8Vector *model);
 COMPLEX16 LALInferenceROQCOMPLEX16DotProduct(COMPLEX16Vector *weights, COMPLEX16Vector *model);
 
+/* tabulate the time-shift dependence of the linear weights and use it to calculate <d|h> */
+INT4 LALInferenceROQLinearWeightsInit(LALInferenceROQData *roq, const REAL8 *tcs, const COMPLEX16 *weights, UINT4 n_time_steps, UINT4 n_basis);
+COMPLEX16 LALInferenceROQTimeShiftedDotProduct(const LALInferenceROQData *roq, REAL8 timeshift,
+                                               const COMPLEX16 *hplus, const COMPLEX16 *hcross,
+                                               REAL8 fplus, REAL8 fcross, const COMPLEX16 *calfactor);
+void LALInferenceROQLinearWeightsFree(LALInferenceROQData *roq);
+
 /* memory destruction */
 void LALInferenceRemoveREALROQInterpolant( LALInferenceREALROQInterpolant *a );
 void LALInferenceRemoveCOMPLEXROQInterpolant( LALInferenceCOMPLEXROQInterpolant *a );
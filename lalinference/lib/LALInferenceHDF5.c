@@ -214,18 +214,45 @@ int LALInferenceH5VariablesArrayToDataset(
     if (N == 0)
         return 0;
 
-    const char *column_names[varsArray[0]->dimension];
-    UINT4 Nvary = 0;
-    size_t type_size = 0;
-    size_t column_offsets[varsArray[0]->dimension];
-    size_t column_sizes[varsArray[0]->dimension];
-    LALTYPECODE column_types[varsArray[0]->dimension];
-    char *fixed_names[varsArray[0]->dimension];
-    int vary[varsArray[0]->dimension];
+    LALInferenceH5TableWriter *writer = LALInferenceH5TableWriterOpen(
+        h5file, TableName, varsArray[0], 32, 0);
+    XLAL_CHECK_ABORT(writer);
+    int ret = LALInferenceH5TableWriterAppendArray(writer, varsArray, N);
+    (void) ret;
+    XLAL_CHECK_ABORT(ret == 0);
+    ret = LALInferenceH5TableWriterClose(writer);
+    XLAL_CHECK_ABORT(ret == 0);
+    return XLAL_SUCCESS;
+}
+
+
+LALInferenceH5TableWriter *LALInferenceH5TableWriterOpen(
+    LALH5File *h5file, const char *TableName, LALInferenceVariables *vars,
+    UINT4 chunk_size, int compress)
+{
+    if (!h5file || !TableName || !vars)
+        XLAL_ERROR_NULL(XLAL_EFAULT);
+    if (chunk_size == 0)
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Chunk size must be positive");
+
+    const char *column_names[vars->dimension];
+    LALTYPECODE column_types[vars->dimension];
+    char *fixed_names[vars->dimension];
+    int vary[vars->dimension];
     UINT4 Nfixed = 0;
 
+    LALInferenceH5TableWriter *writer = XLALCalloc(1, sizeof(*writer));
+    XLAL_CHECK_NULL(writer, XLAL_ENOMEM);
+    writer->column_offsets = XLALCalloc(vars->dimension + 1, sizeof(size_t));
+    writer->column_sizes = XLALCalloc(vars->dimension + 1, sizeof(size_t));
+    if (!writer->column_offsets || !writer->column_sizes)
+    {
+        LALInferenceH5TableWriterClose(writer);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
     /* Build a list of PARAM and FIELD elements */
-    for (LALInferenceVariableItem *varitem = varsArray[0]->head; varitem;
+    for (LALInferenceVariableItem *varitem = vars->head; varitem;
          varitem = varitem->next)
     {
         switch(varitem->vary)
@@ -257,12 +284,12 @@ int LALInferenceH5VariablesArrayToDataset(
                             varitem->type, varitem->name);
                         continue;
                 } /* End switch */
-                vary[Nvary] = varitem->vary;
-                column_types[Nvary] = tp;
-                column_sizes[Nvary] = sz;
-                column_offsets[Nvary] = type_size;
-                type_size += sz;
-                column_names[Nvary++] = varitem->name;
+                vary[writer->Ncolumns] = varitem->vary;
+                column_types[writer->Ncolumns] = tp;
+                writer->column_sizes[writer->Ncolumns] = sz;
+                writer->column_offsets[writer->Ncolumns] = writer->row_size;
+                writer->row_size += sz;
+                column_names[writer->Ncolumns++] = varitem->name;
                 break;
             }
             case LALINFERENCE_PARAM_FIXED:
@@ -273,50 +300,174 @@ int LALInferenceH5VariablesArrayToDataset(
         }
     }
 
-    /* Gather together data in one big array */
-    char *data = XLALCalloc(N, type_size);
-    XLAL_CHECK_ABORT(data);
-    for (UINT4 i = 0; i < N; i++)
+    writer->column_names = XLALCalloc(writer->Ncolumns + 1, sizeof(char *));
+    if (!writer->column_names)
     {
-        for (UINT4 j = 0; j < Nvary; j++)
+        LALInferenceH5TableWriterClose(writer);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    for (UINT4 i = 0; i < writer->Ncolumns; i++)
+    {
+        writer->column_names[i] = XLALStringDuplicate(column_names[i]);
+        if (!writer->column_names[i])
         {
-            void *var = LALInferenceGetVariable(varsArray[i], column_names[j]);
-            memcpy(
-                data + type_size * i + column_offsets[j], var, column_sizes[j]);
+            LALInferenceH5TableWriterClose(writer);
+            XLAL_ERROR_NULL(XLAL_ENOMEM);
         }
     }
+    writer->buffer_size = chunk_size;
+    writer->buffer = XLALCalloc(chunk_size, writer->row_size);
+    if (!writer->buffer)
+    {
+        LALInferenceH5TableWriterClose(writer);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    if (XLALH5FileCheckDatasetExists(h5file, TableName))
+    {
+        /* Append to the existing table, whose columns must match */
+        writer->dataset = XLALH5DatasetRead(h5file, TableName);
+        if (!writer->dataset)
+        {
+            LALInferenceH5TableWriterClose(writer);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+        int match = XLALH5TableQueryNColumns(writer->dataset) == writer->Ncolumns;
+        for (UINT4 i = 0; match && i < writer->Ncolumns; i++)
+        {
+            char name[strlen(column_names[i]) + 2];
+            XLALH5TableQueryColumnName(name, sizeof(name), writer->dataset, i);
+            match = strcmp(name, column_names[i]) == 0
+                && XLALH5TableQueryColumnType(writer->dataset, i) == column_types[i];
+        }
+        if (!match)
+        {
+            LALInferenceH5TableWriterClose(writer);
+            XLAL_ERROR_NULL(XLAL_EINVAL,
+                "Columns of table %s do not match the samples", TableName);
+        }
+        writer->Nwritten = XLALH5TableQueryNRows(writer->dataset);
+        return writer;
+    }
 
     /* Create table */
-    LALH5Dataset *dataset = XLALH5TableAlloc(h5file, TableName, Nvary,
-        column_names, column_types, column_offsets, type_size);
-    XLAL_CHECK_ABORT(dataset);
-    int ret = XLALH5TableAppend(
-        dataset, column_offsets, column_sizes, N, type_size, data);
-    (void) ret;
-    XLAL_CHECK_ABORT(ret == 0);
-    XLALFree(data);
+    writer->dataset = XLALH5TableAllocChunked(h5file, TableName,
+        writer->Ncolumns, column_names, column_types, writer->column_offsets,
+        writer->row_size, chunk_size, compress);
+    if (!writer->dataset)
+    {
+        LALInferenceH5TableWriterClose(writer);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
 
-    LALH5Generic gdataset = {.dset = dataset};
-    for (UINT4 i = 0; i < Nvary; i ++)
+    LALH5Generic gdataset = {.dset = writer->dataset};
+    for (UINT4 i = 0; i < writer->Ncolumns; i ++)
     {
         INT4 value = vary[i];
         char pname[] = "FIELD_NNN_VARY";
         snprintf(pname, sizeof(pname), "FIELD_%d_VARY", i);
-        ret = XLALH5AttributeAddScalar(
-            gdataset, pname, &value, LAL_I4_TYPE_CODE);
-        XLAL_CHECK_ABORT(ret == 0);
+        if (XLALH5AttributeAddScalar(gdataset, pname, &value, LAL_I4_TYPE_CODE))
+        {
+            LALInferenceH5TableWriterClose(writer);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
     }
 
     /* Write attributes, if any */
     for (UINT4 i = 0; i < Nfixed; i++)
-        LALInferenceH5VariableToAttribute(
-            gdataset, varsArray[0], fixed_names[i]);
+        LALInferenceH5VariableToAttribute(gdataset, vars, fixed_names[i]);
+
+    return writer;
+}
+
+
+/* Copy the columns of a sample into a row of the table */
+static void LALInferenceH5PackRow(
+    LALInferenceH5TableWriter *writer, LALInferenceVariables *vars, char *row)
+{
+    for (UINT4 j = 0; j < writer->Ncolumns; j++)
+    {
+        void *var = LALInferenceGetVariable(vars, writer->column_names[j]);
+        memcpy(row + writer->column_offsets[j], var, writer->column_sizes[j]);
+    }
+}
+
+
+int LALInferenceH5TableWriterAppend(
+    LALInferenceH5TableWriter *writer, LALInferenceVariables *vars)
+{
+    XLAL_CHECK(writer && vars, XLAL_EFAULT);
+    LALInferenceH5PackRow(
+        writer, vars, writer->buffer + writer->Nbuffered * writer->row_size);
+    writer->Nbuffered++;
+    if (writer->Nbuffered == writer->buffer_size)
+        XLAL_CHECK(LALInferenceH5TableWriterFlush(writer) == XLAL_SUCCESS, XLAL_EFUNC);
+    return XLAL_SUCCESS;
+}
+
+
+int LALInferenceH5TableWriterAppendArray(
+    LALInferenceH5TableWriter *writer, LALInferenceVariables *const *const varsArray,
+    UINT4 N)
+{
+    XLAL_CHECK(writer && (varsArray || N == 0), XLAL_EFAULT);
+    if (N == 0)
+        return XLAL_SUCCESS;
+
+    /* Keep rows in order behind any that are still buffered */
+    XLAL_CHECK(LALInferenceH5TableWriterFlush(writer) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    char *data = XLALCalloc(N, writer->row_size);
+    XLAL_CHECK(data, XLAL_ENOMEM);
+    for (UINT4 i = 0; i < N; i++)
+        LALInferenceH5PackRow(writer, varsArray[i], data + writer->row_size * i);
 
-    XLALH5DatasetFree(dataset);
+    int ret = XLALH5TableAppend(writer->dataset, writer->column_offsets,
+        writer->column_sizes, N, writer->row_size, data);
+    XLALFree(data);
+    XLAL_CHECK(ret == 0, XLAL_EFUNC);
+    writer->Nwritten += N;
     return XLAL_SUCCESS;
 }
 
 
+int LALInferenceH5TableWriterFlush(LALInferenceH5TableWriter *writer)
+{
+    XLAL_CHECK(writer, XLAL_EFAULT);
+    if (writer->Nbuffered == 0)
+        return XLAL_SUCCESS;
+    XLAL_CHECK(XLALH5TableAppend(writer->dataset, writer->column_offsets,
+        writer->column_sizes, writer->Nbuffered, writer->row_size,
+        writer->buffer) == 0, XLAL_EFUNC);
+    writer->Nwritten += writer->Nbuffered;
+    writer->Nbuffered = 0;
+    return XLAL_SUCCESS;
+}
+
+
+int LALInferenceH5TableWriterClose(LALInferenceH5TableWriter *writer)
+{
+    int ret = XLAL_SUCCESS;
+    if (!writer)
+        return ret;
+    if (writer->dataset)
+    {
+        ret = LALInferenceH5TableWriterFlush(writer);
+        XLALH5DatasetFree(writer->dataset);
+    }
+    if (writer->column_names)
+        for (UINT4 i = 0; i < writer->Ncolumns; i++)
+            XLALFree(writer->column_names[i]);
+    XLALFree(writer->column_names);
+    XLALFree(writer->column_offsets);
+    XLALFree(writer->column_sizes);
+    XLALFree(writer->buffer);
+    XLALFree(writer);
+    XLAL_CHECK(ret == XLAL_SUCCESS, XLAL_EFUNC);
+    return ret;
+}
+
+
 static void LALInferenceH5VariableToAttribute(
     LALH5Generic gdataset, LALInferenceVariables *vars, char *name)
 {
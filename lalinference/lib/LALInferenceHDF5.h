@@ -40,6 +40,61 @@ int LALInferenceH5VariablesArrayToDataset(
 int LALInferenceH5DatasetToVariablesArray(
     LALH5Dataset *dataset, LALInferenceVariables ***varsArray, UINT4 *N);
 
+/**
+ * Appends samples to a HDF5 table, buffering them in memory and
+ * writing them a chunk at a time.  The columns of the table are the
+ * non-fixed parameters of the LALInferenceVariables the writer is
+ * opened with, and the fixed parameters are stored as attributes.
+ */
+typedef struct tagLALInferenceH5TableWriter
+{
+  LALH5Dataset *dataset;      /** Table being written */
+  UINT4 Ncolumns;             /** Number of columns in the table */
+  char **column_names;        /** Names of the columns */
+  size_t *column_offsets;     /** Offset of each column within a row */
+  size_t *column_sizes;       /** Size of each column in bytes */
+  size_t row_size;            /** Size of a row in bytes */
+  char *buffer;               /** Rows waiting to be written */
+  UINT4 Nbuffered;            /** Number of rows in the buffer */
+  UINT4 buffer_size;          /** Capacity of the buffer in rows */
+  UINT4 Nwritten;             /** Number of rows in the table in the file */
+} LALInferenceH5TableWriter;
+
+/**
+ * Opens the table TableName in h5file for appending.  If the table does not
+ * exist it is created with the columns and attributes of vars, stored in
+ * chunks of chunk_size rows and compressed if compress is non-zero.  If it
+ * does exist its columns must match those of vars, and rows are added after
+ * the ones already in the file, so that h5file should be opened in mode "a".
+ */
+LALInferenceH5TableWriter *LALInferenceH5TableWriterOpen(
+    LALH5File *h5file, const char *TableName, LALInferenceVariables *vars,
+    UINT4 chunk_size, int compress);
+
+/**
+ * Adds a sample to the table, writing the buffer to the file once it holds
+ * a whole chunk.
+ */
+int LALInferenceH5TableWriterAppend(
+    LALInferenceH5TableWriter *writer, LALInferenceVariables *vars);
+
+/**
+ * Adds N samples to the table, writing them to the file in one go.
+ */
+int LALInferenceH5TableWriterAppendArray(
+    LALInferenceH5TableWriter *writer, LALInferenceVariables *const *const varsArray,
+    UINT4 N);
+
+/**
+ * Writes any buffered samples to the file.
+ */
+int LALInferenceH5TableWriterFlush(LALInferenceH5TableWriter *writer);
+
+/**
+ * Flushes the buffer and frees the writer.
+ */
+int LALInferenceH5TableWriterClose(LALInferenceH5TableWriter *writer);
+
 /**
  * Create a HDF5 heirarchy in the given LALH5File reference
  * /codename/runID/
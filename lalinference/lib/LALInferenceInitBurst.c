@@ -239,6 +239,9 @@ LALInferenceModel * LALInferenceInitBurstModel(LALInferenceRunState *state)
   LALInferenceModel *model = XLALMalloc(sizeof(LALInferenceModel));
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
+  model->margdist = NULL;
+  model->spcal = NULL;
+  model->margtime = NULL;
   LALInferenceVariables *currentParams=model->params;
 
   UINT4 signal_flag=1;
@@ -41,6 +41,23 @@
 #define omp ignore
 #endif
 
+/* Maximum number of points in a leaf of the kd-tree of a KDE */
+#define KDE_LEAF_SIZE 16
+
+/* Kernels smaller than exp(-KDE_LOG_TRUNCATION) times the largest kernel at
+ * a point are neglected when evaluating the KDE there */
+#define KDE_LOG_TRUNCATION 40.0
+
+struct tagKDENode {
+    INT4 start;  /* First point of the node in whitened_data */
+    INT4 count;  /* Number of points in the node */
+    INT4 left;   /* Child nodes, -1 for a leaf */
+    INT4 right;
+};
+
+static void destroyKDETree(LALInferenceKDE *kde);
+static void buildKDETree(LALInferenceKDE *kde);
+static REAL8 kdeLogSumKernels(LALInferenceKDE *kde, REAL8 *point);
 
 
 /**
@@ -194,6 +211,7 @@ void LALInferenceDestroyKDE(LALInferenceKDE *kde) {
         gsl_matrix_free(kde->cov);
 
         if (kde->npts > 0) gsl_matrix_free(kde->data);
+        destroyKDETree(kde);
 
         XLALFree(kde->lower_bound_types);
         XLALFree(kde->upper_bound_types);
@@ -284,6 +302,8 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
     kde->log_norm_factor =
         log(kde->npts * sqrt(pow(2*LAL_PI, kde->dim) * det_cov));
 
+    buildKDETree(kde);
+
     return;
 }
 
@@ -299,8 +319,7 @@ void LALInferenceSetKDEBandwidth(LALInferenceKDE *kde) {
  */
 REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
     INT4 dim = kde->dim;
-    INT4 npts = kde->npts;
-    INT4 i, j, p;
+    INT4 i, p;
     INT4 n_evals = 1;  // Number of evaluations to be done
     REAL8 min, max, width, val;
 
@@ -368,50 +387,17 @@ REAL8 LALInferenceKDEEvaluatePoint(LALInferenceKDE *kde, REAL8 *point) {
         }
     }
 
-    /* Loop over list of reflected and cycled points */
-    REAL8* results = XLALMalloc(npts * sizeof(REAL8));
-    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
-
     /* Loop over reflected and cycled set of points */
+    REAL8* eval_results = XLALMalloc(n_evals * sizeof(REAL8));
     for (i = 0; i < n_evals; i++) {
         gsl_vector_view pt = gsl_matrix_row(points, i);
-
-        /* Loop over points in KDE dataset, using the Cholesky decomposition
-         * of the covariance to avoid ever inverting the covariance matrix */
-        #pragma omp parallel
-        {
-            /* Vectors that will hold the difference and transformed distance */
-            gsl_vector *diff = gsl_vector_alloc(dim);
-            gsl_vector *tdiff = gsl_vector_alloc(dim);
-
-            #pragma omp for schedule(static)
-            for (j = 0; j < npts; j++) {
-                gsl_vector_view d = gsl_matrix_row(kde->data, j);
-                gsl_vector_memcpy(diff, &d.vector);
-
-                gsl_vector_sub(diff, &pt.vector);
-                gsl_linalg_cholesky_solve(kde->cholesky_decomp_cov, diff, tdiff);
-                gsl_vector_mul(diff, tdiff);
-
-                REAL8 energy = 0.;
-                for (INT4 k=0; k<dim; k++)
-                    energy += gsl_vector_get(diff, k);
-                results[j] = -energy/2.;
-            }
-
-            gsl_vector_free(diff);
-            gsl_vector_free(tdiff);
-        }
-
-        /* Normalize the result */
-        eval_results[i] = log_add_exps(results, npts) - kde->log_norm_factor;
+        eval_results[i] = kdeLogSumKernels(kde, (&pt.vector)->data) - kde->log_norm_factor;
     }
 
     /* Accumulate probability after accounting for all boundaries */
     REAL8 result = log_add_exps(eval_results, n_evals);
 
     gsl_matrix_free(points);
-    XLALFree(results);
     XLALFree(eval_results);
 
     return result;
@@ -614,3 +600,224 @@ REAL8 log_add_exps(REAL8 *vals, INT4 size) {
 
     return result;
 }
+
+
+/* Free the kd-tree of a KDE */
+static void destroyKDETree(LALInferenceKDE *kde) {
+    XLALFree(kde->whitened_data);
+    XLALFree(kde->tree);
+    XLALFree(kde->tree_bounds);
+    kde->whitened_data = NULL;
+    kde->tree = NULL;
+    kde->tree_bounds = NULL;
+    kde->tree_size = 0;
+}
+
+
+/* Transform x by the inverse of the lower Cholesky factor of the kernel
+ * covariance, in which frame the kernel is a unit Gaussian */
+static void kdeWhiten(LALInferenceKDE *kde, const REAL8 *x, REAL8 *y) {
+    INT4 i, k;
+    for (i = 0; i < kde->dim; i++) {
+        const REAL8 *L = gsl_matrix_const_ptr(kde->cholesky_decomp_cov_lower, i, 0);
+        REAL8 val = x[i];
+        for (k = 0; k < i; k++)
+            val -= L[k] * y[k];
+        y[i] = val / L[i];
+    }
+}
+
+
+/* Swap two points of the whitened data */
+static void kdeSwapPoints(REAL8 *data, INT4 dim, INT4 a, INT4 b) {
+    INT4 p;
+    for (p = 0; p < dim; p++) {
+        REAL8 tmp = data[a*dim + p];
+        data[a*dim + p] = data[b*dim + p];
+        data[b*dim + p] = tmp;
+    }
+}
+
+
+/* Reorder the points lo ... hi-1 so that point nth has the value it would
+ * have if they were sorted along axis, with no point before it larger and
+ * none after it smaller */
+static void kdeSelectPoints(REAL8 *data, INT4 dim, INT4 lo, INT4 hi, INT4 nth, INT4 axis) {
+    while (hi - lo > 1) {
+        REAL8 pivot = data[((lo + hi)/2)*dim + axis];
+        INT4 i = lo, j = hi - 1;
+        while (i <= j) {
+            while (data[i*dim + axis] < pivot) i++;
+            while (data[j*dim + axis] > pivot) j--;
+            if (i <= j) {
+                kdeSwapPoints(data, dim, i, j);
+                i++;
+                j--;
+            }
+        }
+        if (nth <= j)
+            hi = j + 1;
+        else if (nth >= i)
+            lo = i;
+        else
+            return;
+    }
+}
+
+
+/* Add the node holding points start ... start+count-1 to the kd-tree,
+ * splitting it at the median of its widest axis until the leaves hold
+ * at most KDE_LEAF_SIZE points */
+static INT4 kdeAddNode(LALInferenceKDE *kde, INT4 *capacity, INT4 start, INT4 count) {
+    INT4 dim = kde->dim;
+    INT4 i, p;
+
+    if (kde->tree_size == *capacity) {
+        *capacity *= 2;
+        kde->tree = XLALRealloc(kde->tree, *capacity * sizeof(struct tagKDENode));
+        kde->tree_bounds = XLALRealloc(kde->tree_bounds, *capacity * 2 * dim * sizeof(REAL8));
+    }
+    INT4 node = kde->tree_size++;
+    REAL8 *lower = &kde->tree_bounds[2*dim*node];
+    REAL8 *upper = lower + dim;
+
+    for (p = 0; p < dim; p++) {
+        lower[p] = INFINITY;
+        upper[p] = -INFINITY;
+    }
+    for (i = start; i < start + count; i++) {
+        for (p = 0; p < dim; p++) {
+            REAL8 val = kde->whitened_data[i*dim + p];
+            if (val < lower[p]) lower[p] = val;
+            if (val > upper[p]) upper[p] = val;
+        }
+    }
+
+    INT4 axis = 0;
+    for (p = 1; p < dim; p++)
+        if (upper[p] - lower[p] > upper[axis] - lower[axis])
+            axis = p;
+
+    kde->tree[node].start = start;
+    kde->tree[node].count = count;
+    kde->tree[node].left = -1;
+    kde->tree[node].right = -1;
+    if (count <= KDE_LEAF_SIZE || !(upper[axis] > lower[axis]))
+        return node;
+
+    INT4 half = count/2;
+    kdeSelectPoints(kde->whitened_data, dim, start, start + count, start + half, axis);
+    INT4 left = kdeAddNode(kde, capacity, start, half);
+    INT4 right = kdeAddNode(kde, capacity, start + half, count - half);
+    kde->tree[node].left = left;
+    kde->tree[node].right = right;
+
+    return node;
+}
+
+
+/* Whiten the points of a KDE and build a kd-tree over them */
+static void buildKDETree(LALInferenceKDE *kde) {
+    INT4 i;
+    INT4 dim = kde->dim;
+
+    destroyKDETree(kde);
+
+    kde->whitened_data = XLALMalloc(kde->npts * dim * sizeof(REAL8));
+    for (i = 0; i < kde->npts; i++)
+        kdeWhiten(kde, gsl_matrix_const_ptr(kde->data, i, 0), &kde->whitened_data[i*dim]);
+
+    INT4 capacity = 2*(kde->npts/KDE_LEAF_SIZE) + 1;
+    kde->tree = XLALMalloc(capacity * sizeof(struct tagKDENode));
+    kde->tree_bounds = XLALMalloc(capacity * 2 * dim * sizeof(REAL8));
+    kdeAddNode(kde, &capacity, 0, kde->npts);
+}
+
+
+/* Squared distance from y to the bounding box of a node */
+static REAL8 kdeNodeDistance(LALInferenceKDE *kde, INT4 node, const REAL8 *y) {
+    INT4 dim = kde->dim;
+    const REAL8 *lower = &kde->tree_bounds[2*dim*node];
+    const REAL8 *upper = lower + dim;
+    REAL8 dist = 0.;
+    for (INT4 p = 0; p < dim; p++) {
+        REAL8 d = 0.;
+        if (y[p] < lower[p])
+            d = lower[p] - y[p];
+        else if (y[p] > upper[p])
+            d = y[p] - upper[p];
+        dist += d*d;
+    }
+    return dist;
+}
+
+
+/* Squared distance between y and whitened point i */
+static REAL8 kdePointDistance(LALInferenceKDE *kde, INT4 i, const REAL8 *y) {
+    INT4 dim = kde->dim;
+    const REAL8 *x = &kde->whitened_data[i*dim];
+    REAL8 dist = 0.;
+    for (INT4 p = 0; p < dim; p++) {
+        REAL8 d = x[p] - y[p];
+        dist += d*d;
+    }
+    return dist;
+}
+
+
+/* Update nearest with the squared distance from y to the nearest point of node */
+static void kdeNearest(LALInferenceKDE *kde, INT4 node, const REAL8 *y, REAL8 *nearest) {
+    struct tagKDENode *n = &kde->tree[node];
+    if (n->left < 0) {
+        for (INT4 i = n->start; i < n->start + n->count; i++) {
+            REAL8 dist = kdePointDistance(kde, i, y);
+            if (dist < *nearest)
+                *nearest = dist;
+        }
+        return;
+    }
+
+    /* Descend into the closer child first */
+    REAL8 dleft = kdeNodeDistance(kde, n->left, y);
+    REAL8 dright = kdeNodeDistance(kde, n->right, y);
+    INT4 first = dleft <= dright ? n->left : n->right;
+    INT4 second = dleft <= dright ? n->right : n->left;
+    if ((dleft <= dright ? dleft : dright) < *nearest)
+        kdeNearest(kde, first, y, nearest);
+    if ((dleft <= dright ? dright : dleft) < *nearest)
+        kdeNearest(kde, second, y, nearest);
+}
+
+
+/* Sum exp(-(r^2 - r2min)/2) over the points of node within squared distance
+ * cutoff of y */
+static REAL8 kdeSumKernels(LALInferenceKDE *kde, INT4 node, const REAL8 *y, REAL8 r2min, REAL8 cutoff) {
+    struct tagKDENode *n = &kde->tree[node];
+    if (kdeNodeDistance(kde, node, y) > cutoff)
+        return 0.;
+
+    if (n->left >= 0)
+        return kdeSumKernels(kde, n->left, y, r2min, cutoff) +
+            kdeSumKernels(kde, n->right, y, r2min, cutoff);
+
+    REAL8 sum = 0.;
+    for (INT4 i = n->start; i < n->start + n->count; i++) {
+        REAL8 dist = kdePointDistance(kde, i, y);
+        if (dist <= cutoff)
+            sum += exp(-(dist - r2min)/2.);
+    }
+    return sum;
+}
+
+
+/* Log of the sum of the unnormalised kernels at point, neglecting kernels
+ * smaller than exp(-KDE_LOG_TRUNCATION) times the largest */
+static REAL8 kdeLogSumKernels(LALInferenceKDE *kde, REAL8 *point) {
+    REAL8 y[kde->dim];
+    kdeWhiten(kde, point, y);
+
+    REAL8 r2min = INFINITY;
+    kdeNearest(kde, 0, y, &r2min);
+
+    return -r2min/2. + log(kdeSumKernels(kde, 0, y, r2min, r2min + 2.*KDE_LOG_TRUNCATION));
+}
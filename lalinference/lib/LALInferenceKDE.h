@@ -29,6 +29,9 @@
 
 struct tagkmeans;
 
+/** Node of the kd-tree over the whitened points of a LALInferenceKDE */
+struct tagKDENode;
+
 /**
  * Structure containing the Guassian kernel density of a set of samples.
  */
@@ -47,6 +50,12 @@ tagKDE
                                                   as returned by gsl_linalg_cholesky_decomp(). */
     gsl_matrix * cholesky_decomp_cov_lower; /**< Just the lower portion of \a cholesky_decomp_cov. */
 
+    REAL8 * whitened_data;                  /**< \a data transformed by the inverse of \a cholesky_decomp_cov_lower,
+                                                  where the kernel is a unit Gaussian, in kd-tree order. */
+    struct tagKDENode * tree;               /**< kd-tree over \a whitened_data. */
+    INT4 tree_size;                         /**< Number of nodes in \a tree. */
+    REAL8 * tree_bounds;                    /**< Lower then upper bounds of the points in each node of \a tree. */
+
     LALInferenceParamVaryType * lower_bound_types; /**< Array of param boundary types */
     LALInferenceParamVaryType * upper_bound_types; /**< Array of param boundary types */
     REAL8 * lower_bounds;              /**< Lower param bounds */
@@ -32,7 +32,9 @@
 #include <lal/Sequence.h>
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
+#include <lal/ComplexFFT.h>
 #include <lal/LALInferenceDistanceMarg.h>
+#include <lal/LALInferenceGenerateROQ.h>
 
 #include <gsl/gsl_sf_bessel.h>
 #include <gsl/gsl_sf_dawson.h>
@@ -72,6 +74,24 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 static double integrate_interpolated_log(double h, REAL8 *log_ys, size_t n, double *imean, size_t *imax);
 
+static double model_marginal_distance_loglikelihood(const LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi);
+static int model_marginal_distance_loglikelihood_batch(const LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double *d_inner_h, double *snr, size_t n, int cosmology, int margphi);
+
+static LALInferenceMarginalTime *get_marginal_time(LALInferenceModel *model, UINT4 freqLength, UINT4 istart, UINT4 n, int margphi);
+
+/* Noise-weighted sums over the frequency bins of one detector */
+typedef struct tagFDInnerProducts
+{
+  REAL8 dd; /* <d|d> */
+  REAL8 hh; /* <h|h> */
+  REAL8 rr; /* <d-h|d-h> */
+  COMPLEX16 dh; /* sum of d conj(h) */
+} FDInnerProducts;
+
+static int fd_inner_products(FDInnerProducts *out, const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                             const REAL8 *psd, const COMPLEX16 *cal, REAL8 Fplus, REAL8 Fcross, REAL8 dphi, UINT4 lower, UINT4 n,
+                             REAL8 deltaT, REAL8 TwoDeltaToverN, COMPLEX16 *dh_tilde);
+
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases);
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases)
 {
@@ -99,6 +119,29 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
   return(XLAL_SUCCESS);
 }
 
+/* Spline calibration engine slot (0: frequency bins or linear ROQ nodes,
+   1: quadratic ROQ nodes) of detector ifo, created on first use and
+   rebuilt if the spline nodes or the output frequencies have changed.
+   If freqs is NULL the output frequencies are the bins i*deltaF. */
+static LALInferenceSplineCalibration *get_calib_engine(LALInferenceModel *model, UINT4 nifos, UINT4 ifo, UINT4 slot,
+                                                       const REAL8Vector *logfreqs, const REAL8 *freqs, REAL8 deltaF, UINT4 length)
+{
+  if (model->spcal == NULL) {
+    model->spcal = XLALCalloc(2 * nifos, sizeof(*model->spcal));
+    XLAL_CHECK_NULL(model->spcal != NULL, XLAL_ENOMEM);
+  }
+  LALInferenceSplineCalibration **cal = &(model->spcal[2 * ifo + slot]);
+  if (!LALInferenceSplineCalibrationMatches(*cal, logfreqs, length)) {
+    LALInferenceDestroySplineCalibration(*cal);
+    if (freqs)
+      *cal = LALInferenceCreateSplineCalibration(logfreqs, freqs, length);
+    else
+      *cal = LALInferenceCreateSplineCalibrationFD(logfreqs, deltaF, length);
+    XLAL_CHECK_NULL(*cal != NULL, XLAL_EFUNC);
+  }
+  return *cal;
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -184,6 +227,28 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
       runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
    }
 
+   /* Build the distance marginalisation table once and share it between the threads' models,
+      replacing any built by an earlier call */
+   LALInferenceClearMarginalDistance(runState);
+   if (thread->model && LALInferenceCheckVariable(thread->model->params, "MARGDIST") && LALInferenceGetVariable(thread->model->params, "MARGDIST"))
+   {
+     double dist_min, dist_max;
+     int cosmology=0;
+     int margphi = (runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood || runState->likelihood==&LALInferenceMarginalisedTimePhaseLogLikelihood);
+     LALInferenceGetMinMaxPrior(thread->model->params, "logdistance", &dist_min, &dist_max);
+     if(LALInferenceCheckVariable(thread->model->params,"MARGDIST_COSMOLOGY"))
+       cosmology=LALInferenceGetINT4Variable(thread->model->params,"MARGDIST_COSMOLOGY");
+     fprintf(stdout,"Initialising distance integration lookup table\n");
+     LALInferenceMarginalDistance *margdist = LALInferenceCreateMarginalDistance(exp(dist_min), exp(dist_max), cosmology, margphi);
+     if (!margdist) {
+       fprintf(stderr,"ERROR: Unable to initialise distance marginalisation integrator. Exiting...\n");
+       exit(1);
+     }
+     for(INT4 t=0; t < runState->nthreads; t++)
+       if (runState->threads[t].model)
+         runState->threads[t].model->margdist = margdist;
+   }
+
    /* Try to determine a model-less likelihood, if such a thing makes sense */
    if (runState->likelihood==&LALInferenceUndecomposedFreqDomainLogLikelihood || runState->likelihood==&LALInferenceMarginalisedPhaseLogLikelihood ){
 
@@ -356,7 +421,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   /* Burst templates are generated at hrss=1, thus need to rescale amplitude */
   double amp_prefactor=1.0;
 
-  COMPLEX16FrequencySeries *calFactor = NULL;
+  const COMPLEX16 *calFactor = NULL;
   COMPLEX16 calF = 0.0;
 
   REAL8Vector *logfreqs = NULL;
@@ -476,10 +541,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     signalFlag = *((INT4 *)LALInferenceGetVariable(currentParams, "signalModelFlag"));
 
   int freq_length=0,time_length=0;
-  COMPLEX16Vector * dh_S_tilde=NULL;
-  COMPLEX16Vector * dh_S_phase_tilde = NULL;
-  REAL8Vector *dh_S=NULL;
-  REAL8Vector *dh_S_phase = NULL;
+  LALInferenceMarginalTime *mt=NULL;
+  COMPLEX16 *dh_S_tilde=NULL;
+  int istart=0, iend=0;
   /* Setup times to integrate over */
   freq_length = data->freqData->data->length;
   time_length = 2*(freq_length-1);
@@ -553,28 +617,22 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   if(margtime)
   {
     GPSdouble = desired_tc;
-    dh_S_tilde = XLALCreateCOMPLEX16Vector(freq_length);
-    dh_S = XLALCreateREAL8Vector(time_length);
-
-    if (dh_S_tilde ==NULL || dh_S == NULL)
-      XLAL_ERROR_REAL8(XLAL_ENOMEM, "Out of memory in LALInferenceMarginalisedTimeLogLikelihood.");
 
-    for (i = 0; i < freq_length; i++) {
-      dh_S_tilde->data[i] = 0.0;
+    /* Samples of the time prior, which are all the inverse FFT is needed at */
+    REAL8 time_low,time_high;
+    LALInferenceGetMinMaxPrior(currentParams,"time",&time_low,&time_high);
+    istart = (UINT4)round((time_low - epoch)/deltaT);
+    iend = (UINT4)round((time_high - epoch)/deltaT);
+    if(iend > time_length || istart < 0 ) {
+      fprintf(stderr,"ERROR: integration over time extends past end of buffer! Is your time prior too wide?\n");
+      exit(1);
     }
 
-    if (margphi) {
-      dh_S_phase_tilde = XLALCreateCOMPLEX16Vector(freq_length);
-      dh_S_phase = XLALCreateREAL8Vector(time_length);
-
-      if (dh_S_phase_tilde == NULL || dh_S_phase == NULL) {
-	XLAL_ERROR_REAL8(XLAL_ENOMEM, "Out of memory in time-phase marginalised likelihood.");
-      }
-
-      for (i = 0; i < freq_length; i++) {
-	dh_S_phase_tilde->data[i] = 0.0;
-      }
-    }
+    /* Reuse the model's buffers; the detectors are summed into one spectrum */
+    mt = get_marginal_time(model, freq_length, istart, iend - istart, margphi);
+    if (mt == NULL)
+      XLAL_ERROR_REAL8(XLAL_EFUNC, "Unable to set up time marginalisation.");
+    dh_S_tilde = LALInferenceMarginalTimeResetSpectrum(mt);
   }
 
   /* figure out GMST: */
@@ -648,10 +706,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
           {
             case XLAL_EUSR0: /* Template generation failed in a known way, set -Inf likelihood */
 		      /* Free up allocated vectors */
-              if(dh_S_tilde) XLALDestroyCOMPLEX16Vector(dh_S_tilde);
-              if(dh_S) XLALDestroyREAL8Vector(dh_S);
-              if(dh_S_phase_tilde) XLALDestroyCOMPLEX16Vector(dh_S_phase_tilde);
-              if(dh_S_phase) XLALDestroyREAL8Vector(dh_S_phase);
               if(model->roq_flag)
               {
                 if ( model->roq->hptildeLinear ) XLALDestroyCOMPLEX16FrequencySeries(model->roq->hptildeLinear);
@@ -687,23 +741,25 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 	  /* get_calib_spline creates and fills the logfreqs, amps, phases arrays */
 	  get_calib_spline(currentParams, dataPtr->name, &logfreqs, &amps, &phases);
 	  if (model->roq_flag) {
-
-             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
-						model->roq->frequencyNodesLinear,
-						&(model->roq->calFactorLinear),
-						model->roq->frequencyNodesQuadratic,
-						&(model->roq->calFactorQuadratic));
+	    LALInferenceSplineCalibration *calLin = get_calib_engine(model, Nifos, ifo, 0, logfreqs,
+						model->roq->frequencyNodesLinear->data, 0, model->roq->frequencyNodesLinear->length);
+	    LALInferenceSplineCalibration *calQuad = get_calib_engine(model, Nifos, ifo, 1, logfreqs,
+						model->roq->frequencyNodesQuadratic->data, 0, model->roq->frequencyNodesQuadratic->length);
+	    const COMPLEX16Vector *facLin = calLin ? LALInferenceSplineCalibrationEval(calLin, amps, phases) : NULL;
+	    const COMPLEX16Vector *facQuad = calQuad ? LALInferenceSplineCalibrationEval(calQuad, amps, phases) : NULL;
+	    if (!facLin || !facQuad)
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to evaluate spline calibration for %s", dataPtr->name);
+	    memcpy(model->roq->calFactorLinear->data, facLin->data, facLin->length * sizeof(COMPLEX16));
+	    memcpy(model->roq->calFactorQuadratic->data, facQuad->data, facQuad->length * sizeof(COMPLEX16));
 	  }
 
 	  else{
-	    if (calFactor == NULL) {
-	      calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors",
-                       &(dataPtr->freqData->epoch),
-                       0, dataPtr->freqData->deltaF,
-                       &lalDimensionlessUnit,
-                       dataPtr->freqData->data->length);
-	    }
-          LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+	    LALInferenceSplineCalibration *cal = get_calib_engine(model, Nifos, ifo, 0, logfreqs,
+						NULL, dataPtr->freqData->deltaF, dataPtr->freqData->data->length);
+	    const COMPLEX16Vector *fac = cal ? LALInferenceSplineCalibrationEval(cal, amps, phases) : NULL;
+	    if (!fac)
+	      XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to evaluate spline calibration for %s", dataPtr->name);
+	    calFactor = fac->data;
 	}
 	if(logfreqs) XLALDestroyREAL8Vector(logfreqs);
 	if(amps) XLALDestroyREAL8Vector(amps);
@@ -746,10 +802,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         /* For burst, add the right hrss in the amplitude. */
         Fplus*=amp_prefactor;
         Fcross*=amp_prefactor;
-
-        dataPtr->fPlus = Fplus;
-        dataPtr->fCross = Fcross;
-        dataPtr->timeshift = timeshift;
     }//end signalFlag condition
 
     /* determine frequency range & loop over frequency bins: */
@@ -798,36 +850,19 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     if (model->roq_flag) {
 
-	double complex weight_iii;
-
 	if (spcal_active){
 
-	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += ( weight_iii * ( conj( template_EI ) ) );
-		}
+		this_ifo_d_inner_h += LALInferenceROQTimeShiftedDotProduct(dataPtr->roq, timeshift, model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data, Fplus, Fcross, model->roq->calFactorLinear->data);
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
 	else{
 
-		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
-
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
-
-			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
-
-			this_ifo_d_inner_h += weight_iii*conj(template_EI) ;
-
-		}
+		this_ifo_d_inner_h += LALInferenceROQTimeShiftedDotProduct(dataPtr->roq, timeshift, model->roq->hptildeLinear->data->data, model->roq->hctildeLinear->data->data, Fplus, Fcross, NULL);
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 			complex double template_EI = model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross;
@@ -897,6 +932,32 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     REAL8 this_ifo_S=0.0;
     COMPLEX16 this_ifo_Rcplx=0.0;
 
+    if (signalFlag && !psdFlag && !glitchFlag && !constantcal_active && marginalisationflags!=STUDENTT)
+    {
+      /* Common case: all bins are treated alike, so use the fused kernel */
+      FDInnerProducts ip;
+      if (fd_inner_products(&ip, dtilde, hptilde, hctilde, psd, spcal_active ? &(calFactor[lower]) : NULL,
+                            Fplus, Fcross, twopit*deltaF, lower, upper>=lower ? upper-lower+1 : 0, deltaT, TwoDeltaToverN,
+                            margtime ? &(dh_S_tilde[lower]) : NULL) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC, "Failed to compute the inner products for %s", dataPtr->name);
+      D+=ip.dd;
+      this_ifo_S+=ip.hh;
+      this_ifo_Rcplx+=ip.dh;
+      Rcplx+=ip.dh;
+      switch(marginalisationflags)
+      {
+        case GAUSSIAN:
+          model->ifo_loglikelihoods[ifo] -= ip.rr;
+          break;
+        case MARGTIME:
+        case MARGTIMEPHI:
+          loglikelihood+=-(ip.hh+ip.dd);
+          break;
+        default:
+          break;
+      }
+    }
+    else
     for (i=lower,chisq=0.0,re = cos(twopit*deltaF*i),im = -sin(twopit*deltaF*i);
          i<=upper;
          i++, psd++, hptilde++, hctilde++, dtilde++,
@@ -947,7 +1008,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       template = plainTemplate * (re + I*im);
 
       if (spcal_active) {
-          calF = calFactor->data->data[i];
+          calF = calFactor[i];
           template = template*calF;
       }
 
@@ -1003,12 +1064,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 	     COMPLEX16FFT.  Also, we use d*conj(h) because we are
 	     using a complex->real *inverse* FFT to compute the
 	     time-series of likelihoods. */
-          dh_S_tilde->data[i] += TwoDeltaToverN * d * conj(template) / sigmasq;
+          dh_S_tilde[i] += TwoDeltaToverN * d * conj(template) / sigmasq;
 
-          if (margphi) {
-            /* This is the other phase quadrature */
-            dh_S_phase_tilde->data[i] += TwoDeltaToverN * d * conj(I*template) / sigmasq;
-          }
+          /* The other phase quadrature, d*conj(I*template), is
+             derived from the same spectrum when transforming. */
 
           break;
         }
@@ -1066,11 +1125,11 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       {
           if (margphi)
           {
-            XLAL_TRY(model->ifo_loglikelihoods[ifo] = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(this_ifo_S), 2.0*cabs(this_ifo_Rcplx), cosmology, margphi), errnum);
+            XLAL_TRY(model->ifo_loglikelihoods[ifo] = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(this_ifo_S), 2.0*cabs(this_ifo_Rcplx), cosmology, margphi), errnum);
           }
           else
           {
-            XLAL_TRY(model->ifo_loglikelihoods[ifo] = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(this_ifo_S), 2.0*creal(this_ifo_Rcplx), cosmology, margphi), errnum);
+            XLAL_TRY(model->ifo_loglikelihoods[ifo] = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(this_ifo_S), 2.0*creal(this_ifo_Rcplx), cosmology, margphi), errnum);
           } 
           errnum&=~XLAL_EFUNC;
           if(errnum!=XLAL_SUCCESS)
@@ -1078,7 +1137,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
             switch(errnum)
             {
               case XLAL_ERANGE: /* The SNR input was outside the interpolation range */
-		if(calFactor) {XLALDestroyCOMPLEX16FrequencySeries(calFactor); calFactor=NULL;}
                 return (-INFINITY);
                 break;
               default: /* Panic! */
@@ -1089,11 +1147,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
             }
           }
       }
-   /* Clean up calibration if necessary */
-    if (!(calFactor == NULL)) {
-      XLALDestroyCOMPLEX16FrequencySeries(calFactor);
-      calFactor = NULL;
-    }
+    calFactor = NULL;
   } /* end loop over detectors */
 
   }
@@ -1163,7 +1217,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       
       if(margdist )
       {
-        XLAL_TRY(loglikelihood = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), R, cosmology, margphi), errnum);
+        XLAL_TRY(loglikelihood = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), R, cosmology, margphi), errnum);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
         {
@@ -1191,7 +1245,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       d_inner_h = creal(Rcplx);
       if(margdist )
       {
-        XLAL_TRY(loglikelihood = LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), 2.0*d_inner_h, cosmology, margphi), errnum);
+        XLAL_TRY(loglikelihood = model_marginal_distance_loglikelihood(model, dist_min, dist_max, sqrt(S), 2.0*d_inner_h, cosmology, margphi), errnum);
         errnum&=~XLAL_EFUNC;
         if(errnum!=XLAL_SUCCESS)
         {
@@ -1217,93 +1271,46 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     case MARGTIMEPHI:
     case MARGTIME:
     {
-      /* LALSuite only performs complex->real reverse-FFTs. */
-      dh_S_tilde->data[0] = crect( creal(dh_S_tilde->data[0]), 0. );
+      /* dh_S[j] and dh_S_phase[j] are the two phase quadratures at sample istart+j */
+      REAL8 *dh_S=NULL, *dh_S_phase=NULL;
+      if (LALInferenceMarginalTimeTransform(mt, &dh_S, &dh_S_phase) != XLAL_SUCCESS)
+        XLAL_ERROR_REAL8(XLAL_EFUNC, "Inverse FFT for time marginalisation failed.");
 
-      XLALREAL8ReverseFFT(dh_S, dh_S_tilde, data->margFFTPlan);
-
-      if (margphi) {
-          dh_S_phase_tilde->data[0] = crect( creal(dh_S_phase_tilde->data[0]), 0.0);
-          XLALREAL8ReverseFFT(dh_S_phase, dh_S_phase_tilde, data->margFFTPlan);
-      }
-
-      REAL8 time_low,time_high;
-      LALInferenceGetMinMaxPrior(currentParams,"time",&time_low,&time_high);
-      t0 = XLALGPSGetREAL8(&(data->freqData->epoch));
-      int istart = (UINT4)round((time_low - t0)/deltaT);
-      int iend = (UINT4)round((time_high - t0)/deltaT);
-      if(iend > (int) dh_S->length || istart < 0 ) {
-              fprintf(stderr,"ERROR: integration over time extends past end of buffer! Is your time prior too wide?\n");
-              exit(1);
-      }
+      t0 = epoch;
       UINT4 n = iend - istart;
       REAL8 xMax = -1.0;
       REAL8 angMax = 0.0;
       if (margphi) {
           /* We've got the real and imaginary parts of the FFT in the two
              arrays.  Now combine them into one Bessel function. */
-          for (i = istart; i < iend; i++) {
+          for (i = 0; i < (int) n; i++) {
               /* Note: No factor of 2 for x because the 2-sided FFT above introduces that for us */
-              double x = sqrt(dh_S->data[i]*dh_S->data[i] + dh_S_phase->data[i]*dh_S_phase->data[i]);
+              double x = sqrt(dh_S[i]*dh_S[i] + dh_S_phase[i]*dh_S_phase[i]);
               if (x > xMax) { /* Store the phase angle at max L */
-                  angMax = atan2(dh_S_phase->data[i], dh_S->data[i]);
+                  angMax = atan2(dh_S_phase[i], dh_S[i]);
                   xMax=x;
               }
               
               if(margdist)
-              {
-                XLAL_TRY(dh_S->data[i]=LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), x, cosmology, margphi) + S, errnum);
-	        errnum&=~XLAL_EFUNC;
-        	if(errnum!=XLAL_SUCCESS)
-	        {
-        	    switch(errnum)
-	            {
-                        case XLAL_ERANGE: /* The SNR input was outside the interpolation range */
-                            dh_S->data[i] = -INFINITY;
-                            break;
-                        default: /* Panic! */
-                            fprintf(stderr,"Unhandled error in marginal distance likelihood - exiting!\n");
-                            fprintf(stderr,"XLALError: %d, %s\n",errnum,XLALErrorString(errnum));
-                            exit(1);
-                            break;
-                    }
-                }
-              }
+                dh_S[i] = x;
               else
               {
                 double I0=log(gsl_sf_bessel_I0_scaled(x)) + fabs(x);
-                dh_S->data[i] = I0;
+                dh_S[i] = I0;
               }
           }
       }
-      else
+      if(margdist)
       {
-          if(margdist)
-            {
-                for (i = istart; i < iend; i++)
-                {
-                    XLAL_TRY(dh_S->data[i]=LALInferenceMarginalDistanceLogLikelihood(dist_min, dist_max, sqrt(S), dh_S->data[i], cosmology, margphi) + S, errnum);
-                    errnum&=~XLAL_EFUNC;
-                    if(errnum!=XLAL_SUCCESS)
-                    {
-                        switch(errnum)
-                        {
-                            case XLAL_ERANGE: /* The SNR input was outside the interpolation range */
-                                dh_S->data[i] = -INFINITY;
-                                break;
-                            default: /* Panic! */
-                                fprintf(stderr,"Unhandled error in marginal distance likelihood - exiting!\n");
-                                fprintf(stderr,"XLALError: %d, %s\n",errnum,XLALErrorString(errnum));
-                                exit(1);
-                                break;
-                        }
-                    }
-                }
-            }
+          /* Samples whose SNR is outside the interpolation range get -INFINITY */
+          if (model_marginal_distance_loglikelihood_batch(model, dist_min, dist_max, sqrt(S), dh_S, LALInferenceMarginalTimeScratch(mt), n, cosmology, margphi) != XLAL_SUCCESS)
+              XLAL_ERROR_REAL8(XLAL_EFUNC, "Distance marginalisation over the time window failed.");
+          for (i = 0; i < (int) n; i++)
+              dh_S[i] += S;
       }
       size_t imax;
       REAL8 imean;
-      loglikelihood += integrate_interpolated_log(deltaT, dh_S->data + istart, n, &imean, &imax) - log(n*deltaT);
+      loglikelihood += integrate_interpolated_log(deltaT, dh_S, n, &imean, &imax) - log(n*deltaT);
 
       REAL8 max_time=t0+((REAL8) imax + istart)*deltaT;
       REAL8 mean_time=t0+(imean+(double)istart)*deltaT;
@@ -1319,7 +1326,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       }
       else
       {
-        d_inner_h=0.5*dh_S->data[imax+istart];
+        d_inner_h=0.5*dh_S[imax];
       }
       if(margdist)
       {
@@ -1328,12 +1335,6 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       }
       LALInferenceAddVariable(currentParams,"time_maxl",&max_time,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
       LALInferenceAddVariable(currentParams,"time_mean",&mean_time,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-      XLALDestroyCOMPLEX16Vector(dh_S_tilde);
-      XLALDestroyREAL8Vector(dh_S);
-      if (margphi) {
-        XLALDestroyCOMPLEX16Vector(dh_S_phase_tilde);
-        XLALDestroyREAL8Vector(dh_S_phase);
-      }
       break;
     }
     default:
@@ -1405,46 +1406,355 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   return(loglikelihood);
 }
 
-double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+struct tagLALInferenceMarginalDistance
+{
+        log_radial_integrator *integrator;
+        double log_norm; /* distance prior normalisation */
+        double dist_min, dist_max;
+        double pmax; /* maximum optimal SNR in the table */
+        int cosmology, margphi;
+};
+
+LALInferenceMarginalDistance *LALInferenceCreateMarginalDistance(double dist_min, double dist_max, int cosmology, int margphi)
 {
         static const size_t default_log_radial_integrator_size = 400;
-        double loglikelihood=0;
-        static double log_norm = 0;
-        static log_radial_integrator *integrator;
-
-        double pmax = 100000; /* CHECKME: Max SNR allowed ? */
-        #pragma omp critical
-        {
-            if (integrator == NULL)
-            {
-                printf("Initialising distance integration lookup table\n");
-                /* Initialise the integrator for the first time */
-                integrator = log_radial_integrator_init(
+        LALInferenceMarginalDistance *margdist = XLALCalloc(1, sizeof(*margdist));
+        if (!margdist) XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+        margdist->dist_min = dist_min;
+        margdist->dist_max = dist_max;
+        margdist->pmax = 100000; /* CHECKME: Max SNR allowed ? */
+        margdist->cosmology = cosmology;
+        margdist->margphi = margphi;
+        margdist->integrator = log_radial_integrator_init(
                                 dist_min,
                                 dist_max,
                                 2, /* Power of distance in prior */
                                 cosmology,
-                                pmax,
+                                margdist->pmax,
                                 default_log_radial_integrator_size * 5, /* CHECKME: fudge factor of 5 compared to bayestar */
                                 !margphi);
-                /* distance prior normalisation */
-                log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
+        if (!margdist->integrator)
+        {
+            XLALFree(margdist);
+            XLAL_ERROR_NULL(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
+        }
+        /* distance prior normalisation */
+        margdist->log_norm = log_radial_integrator_eval(margdist->integrator, 0, 0, -INFINITY, -INFINITY);
+        return margdist;
+}
+
+void LALInferenceDestroyMarginalDistance(LALInferenceMarginalDistance *margdist)
+{
+        if (margdist)
+        {
+            log_radial_integrator_free(margdist->integrator);
+            XLALFree(margdist);
+        }
+}
+
+void LALInferenceClearMarginalDistance(LALInferenceRunState *runState)
+{
+        LALInferenceMarginalDistance *margdist = NULL;
+        if (!runState || !runState->threads) return;
+        for (INT4 t = 0; t < runState->nthreads; t++)
+        {
+            LALInferenceModel *model = runState->threads[t].model;
+            if (model && model->margdist)
+            {
+                margdist = model->margdist;
+                model->margdist = NULL;
             }
         }
-        #pragma omp barrier
-        if (!integrator) XLAL_ERROR(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
-        
-        if (isnan(OptimalSNR) || isnan(d_inner_h) || pmax<OptimalSNR)
+        LALInferenceDestroyMarginalDistance(margdist);
+}
+
+double LALInferenceMarginalDistanceEval(const LALInferenceMarginalDistance *margdist, double OptimalSNR, double d_inner_h)
+{
+        if (!margdist) XLAL_ERROR_REAL8(XLAL_EFAULT);
+        if (isnan(OptimalSNR) || isnan(d_inner_h) || margdist->pmax<OptimalSNR)
+        {
+            XLAL_ERROR_REAL8(XLAL_ERANGE,"warning: Optimal SNR %lf exceeded pmax %lf\n",OptimalSNR, margdist->pmax);
+        }
+        double marg_l = log_radial_integrator_eval(margdist->integrator, OptimalSNR , d_inner_h, log(OptimalSNR), log(d_inner_h));
+        return marg_l - margdist->log_norm; /* Normalise prior */
+}
+
+int LALInferenceMarginalDistanceEvalBatch(const LALInferenceMarginalDistance *margdist, const double *OptimalSNR, const double *d_inner_h, double *loglikelihood, size_t n)
+{
+        if (!margdist || !OptimalSNR || !d_inner_h || !loglikelihood) XLAL_ERROR(XLAL_EFAULT);
+        for (size_t i = 0; i < n; i++)
+        {
+            double p = OptimalSNR[i], b = d_inner_h[i];
+            if (isnan(p) || isnan(b) || margdist->pmax<p)
+                loglikelihood[i] = -INFINITY;
+            else
+                loglikelihood[i] = log_radial_integrator_eval(margdist->integrator, p, b, log(p), log(b)) - margdist->log_norm;
+        }
+        return XLAL_SUCCESS;
+}
+
+/* The table shared by all callers of LALInferenceMarginalDistanceLogLikelihood(), built on first use */
+static const LALInferenceMarginalDistance *shared_marginal_distance(double dist_min, double dist_max, int cosmology, int margphi)
+{
+        static LALInferenceMarginalDistance *margdist;
+        LALInferenceMarginalDistance *md;
+
+        #pragma omp critical (LALInferenceMarginalDistanceLogLikelihood)
         {
-            loglikelihood=-INFINITY;
-            XLAL_ERROR(XLAL_ERANGE,"warning: Optimal SNR %lf exceeded pmax %lf\n",OptimalSNR, pmax);
+            if (margdist == NULL)
+            {
+                printf("Initialising distance integration lookup table\n");
+                /* Initialise the integrator for the first time */
+                margdist = LALInferenceCreateMarginalDistance(dist_min, dist_max, cosmology, margphi);
+            }
+            md = margdist;
+        }
+        if (!md) XLAL_ERROR_NULL(XLAL_EFUNC, "Unable to initialise distance marginalisation integrator");
+        return md;
+}
+
+double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+{
+        const LALInferenceMarginalDistance *md = shared_marginal_distance(dist_min, dist_max, cosmology, margphi);
+        if (!md) XLAL_ERROR_REAL8(XLAL_EFUNC);
+        return LALInferenceMarginalDistanceEval(md, OptimalSNR, d_inner_h);
+}
+
+/* The model's distance marginalisation table if it matches the requested settings, or the shared one */
+static const LALInferenceMarginalDistance *model_marginal_distance(const LALInferenceModel *model, double dist_min, double dist_max, int cosmology, int margphi)
+{
+        const LALInferenceMarginalDistance *md = model->margdist;
+        if (md && md->dist_min == dist_min && md->dist_max == dist_max && md->cosmology == cosmology && md->margphi == margphi)
+            return md;
+        return shared_marginal_distance(dist_min, dist_max, cosmology, margphi);
+}
+
+static double model_marginal_distance_loglikelihood(const LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi)
+{
+        const LALInferenceMarginalDistance *md = model_marginal_distance(model, dist_min, dist_max, cosmology, margphi);
+        if (!md) XLAL_ERROR_REAL8(XLAL_EFUNC);
+        return LALInferenceMarginalDistanceEval(md, OptimalSNR, d_inner_h);
+}
+
+/* Replace each of the n d_inner_h[i] by its distance-marginalised log-likelihood at OptimalSNR,
+   or -INFINITY outside the table; snr is n elements of scratch */
+static int model_marginal_distance_loglikelihood_batch(const LALInferenceModel *model, double dist_min, double dist_max, double OptimalSNR, double *d_inner_h, double *snr, size_t n, int cosmology, int margphi)
+{
+        const LALInferenceMarginalDistance *md = model_marginal_distance(model, dist_min, dist_max, cosmology, margphi);
+        if (!md) XLAL_ERROR(XLAL_EFUNC);
+        for (size_t i = 0; i < n; i++)
+            snr[i] = OptimalSNR;
+        return LALInferenceMarginalDistanceEvalBatch(md, snr, d_inner_h, d_inner_h, n);
+}
+
+/*
+ * The window of the inverse transform is evaluated either from a full
+ * complex->real FFT (two with margphi), or by splitting the N point transform
+ * of the spectrum into Nblocks = N/blockLength transforms of the decimated
+ * spectra X[q + Nblocks*r], which give
+ *   z[t] = sum_q exp(2 pi i q t/N) Z_q[t mod blockLength],
+ * whose real and imaginary parts are both phase quadratures.
+ */
+struct tagLALInferenceMarginalTime
+{
+        UINT4 freqLength, timeLength;
+        UINT4 istart, n; /* window of samples */
+        int margphi;
+        UINT4 blockLength, Nblocks; /* blockLength == 0 for the full FFT */
+        COMPLEX16Vector *dh_tilde; /* summed d conj(h)/S */
+        REAL8Vector *dh, *dh_phase; /* full series, or the window only */
+        /* full FFT */
+        COMPLEX16Vector *phase_tilde;
+        REAL8FFTPlan *plan;
+        /* block transforms */
+        COMPLEX16Vector *block_in, *block_out;
+        COMPLEX16Vector *twiddle; /* exp(2 pi i q t/N) for block q and window sample t */
+        COMPLEX16FFTPlan *blockPlan;
+        REAL8Vector *scratch; /* window-length array for the caller */
+};
+
+/* Choose the cheapest way to evaluate n samples of an N point inverse
+   transform, counting 5 L log2(L) flops per complex FFT of length L and
+   half that for a complex->real one. Returns 0 for the full FFT. */
+static UINT4 marginal_time_block_length(UINT4 N, UINT4 n, int margphi)
+{
+        double best = (margphi ? 2 : 1) * 2.5 * N * log2(N);
+        UINT4 M, blockLength = 0;
+        for (M = N; M >= n && M >= 2; M /= 2)
+        {
+            double cost = 5.0 * N * log2(M) + 8.0 * n * (N / M);
+            if (cost < best)
+            {
+                best = cost;
+                blockLength = M;
+            }
+            if (M % 2) break;
+        }
+        return blockLength;
+}
+
+LALInferenceMarginalTime *LALInferenceCreateMarginalTime(UINT4 freqLength, UINT4 istart, UINT4 n, int margphi)
+{
+        XLAL_CHECK_NULL(freqLength >= 2, XLAL_EINVAL, "Spectrum must have at least 2 bins");
+        const UINT4 N = 2 * (freqLength - 1);
+        XLAL_CHECK_NULL(n > 0 && istart + n <= N, XLAL_EINVAL, "Time window [%u, %u) outside the %u samples of the series", istart, istart + n, N);
+
+        LALInferenceMarginalTime *mt = XLALCalloc(1, sizeof(*mt));
+        if (!mt) XLAL_ERROR_NULL(XLAL_ENOMEM);
+        mt->freqLength = freqLength;
+        mt->timeLength = N;
+        mt->istart = istart;
+        mt->n = n;
+        mt->margphi = margphi;
+        mt->blockLength = marginal_time_block_length(N, n, margphi);
+        mt->dh_tilde = XLALCreateCOMPLEX16Vector(freqLength);
+        mt->scratch = XLALCreateREAL8Vector(n);
+        if (mt->blockLength)
+        {
+            const UINT4 M = mt->blockLength;
+            mt->Nblocks = N / M;
+            mt->dh = XLALCreateREAL8Vector(n);
+            if (margphi) mt->dh_phase = XLALCreateREAL8Vector(n);
+            mt->block_in = XLALCreateCOMPLEX16Vector(M);
+            mt->block_out = XLALCreateCOMPLEX16Vector(M);
+            mt->twiddle = XLALCreateCOMPLEX16Vector(mt->Nblocks * n);
+            mt->blockPlan = XLALCreateReverseCOMPLEX16FFTPlan(M, 1);
+            if (mt->twiddle)
+                for (UINT4 q = 0; q < mt->Nblocks; q++)
+                    for (UINT4 j = 0; j < n; j++)
+                    {
+                        /* reduce the phase exactly before taking the exponential */
+                        UINT8 k = ((UINT8) q * (istart + j)) % N;
+                        mt->twiddle->data[q * n + j] = cexp(I * LAL_TWOPI * k / N);
+                    }
         }
         else
         {
-            double marg_l = log_radial_integrator_eval(integrator, OptimalSNR , d_inner_h, log(OptimalSNR), log(d_inner_h));
-            loglikelihood = marg_l - log_norm; /* Normalise prior */
+            mt->dh = XLALCreateREAL8Vector(N);
+            if (margphi)
+            {
+                mt->dh_phase = XLALCreateREAL8Vector(N);
+                mt->phase_tilde = XLALCreateCOMPLEX16Vector(freqLength);
+            }
+            mt->plan = XLALCreateReverseREAL8FFTPlan(N, 1);
+        }
+        if (!mt->dh_tilde || !mt->scratch || !mt->dh || (margphi && !mt->dh_phase)
+            || (mt->blockLength && (!mt->block_in || !mt->block_out || !mt->twiddle || !mt->blockPlan))
+            || (!mt->blockLength && (!mt->plan || (margphi && !mt->phase_tilde))))
+        {
+            LALInferenceDestroyMarginalTime(mt);
+            XLAL_ERROR_NULL(XLAL_ENOMEM, "Unable to allocate time marginalisation workspace");
+        }
+        return mt;
+}
+
+void LALInferenceDestroyMarginalTime(LALInferenceMarginalTime *margtime)
+{
+        if (margtime)
+        {
+            XLALDestroyCOMPLEX16Vector(margtime->dh_tilde);
+            XLALDestroyREAL8Vector(margtime->dh);
+            XLALDestroyREAL8Vector(margtime->dh_phase);
+            XLALDestroyCOMPLEX16Vector(margtime->phase_tilde);
+            XLALDestroyREAL8FFTPlan(margtime->plan);
+            XLALDestroyCOMPLEX16Vector(margtime->block_in);
+            XLALDestroyCOMPLEX16Vector(margtime->block_out);
+            XLALDestroyCOMPLEX16Vector(margtime->twiddle);
+            XLALDestroyCOMPLEX16FFTPlan(margtime->blockPlan);
+            XLALDestroyREAL8Vector(margtime->scratch);
+            XLALFree(margtime);
+        }
+}
+
+int LALInferenceMarginalTimeMatches(const LALInferenceMarginalTime *margtime, UINT4 freqLength, UINT4 istart, UINT4 n, int margphi)
+{
+        return margtime && margtime->freqLength == freqLength && margtime->istart == istart
+            && margtime->n == n && !margtime->margphi == !margphi;
+}
+
+COMPLEX16 *LALInferenceMarginalTimeResetSpectrum(LALInferenceMarginalTime *margtime)
+{
+        if (!margtime) XLAL_ERROR_NULL(XLAL_EFAULT);
+        memset(margtime->dh_tilde->data, 0, margtime->freqLength * sizeof(*margtime->dh_tilde->data));
+        return margtime->dh_tilde->data;
+}
+
+REAL8 *LALInferenceMarginalTimeScratch(LALInferenceMarginalTime *margtime)
+{
+        if (!margtime) XLAL_ERROR_NULL(XLAL_EFAULT);
+        return margtime->scratch->data;
+}
+
+int LALInferenceMarginalTimeTransform(LALInferenceMarginalTime *mt, REAL8 **dh, REAL8 **dh_phase)
+{
+        if (!mt || !dh) XLAL_ERROR(XLAL_EFAULT);
+        COMPLEX16 *X = mt->dh_tilde->data;
+        const UINT4 n = mt->n;
+
+        if (!mt->blockLength)
+        {
+            /* LALSuite only performs complex->real reverse-FFTs. */
+            const COMPLEX16 X0 = X[0];
+            X[0] = crect(creal(X0), 0.0);
+            XLAL_CHECK(XLALREAL8ReverseFFT(mt->dh, mt->dh_tilde, mt->plan) == XLAL_SUCCESS, XLAL_EFUNC);
+            if (mt->margphi)
+            {
+                /* The other phase quadrature, d conj(i h) = -i d conj(h) */
+                COMPLEX16 *Y = mt->phase_tilde->data;
+                Y[0] = crect(cimag(X0), 0.0);
+                for (UINT4 k = 1; k < mt->freqLength; k++)
+                    Y[k] = crect(cimag(X[k]), -creal(X[k]));
+                XLAL_CHECK(XLALREAL8ReverseFFT(mt->dh_phase, mt->phase_tilde, mt->plan) == XLAL_SUCCESS, XLAL_EFUNC);
+            }
+            *dh = mt->dh->data + mt->istart;
+            if (dh_phase) *dh_phase = mt->margphi ? mt->dh_phase->data + mt->istart : NULL;
+            return XLAL_SUCCESS;
+        }
+
+        const UINT4 N = mt->timeLength, M = mt->blockLength, P = mt->Nblocks, half = N / 2;
+        REAL8 *x = mt->dh->data;
+        REAL8 *y = mt->margphi ? mt->dh_phase->data : NULL;
+        memset(x, 0, n * sizeof(*x));
+        if (y) memset(y, 0, n * sizeof(*y));
+        for (UINT4 q = 0; q < P; q++)
+        {
+            /* One-sided spectrum, doubling the bins between DC and Nyquist
+               so that the real part is the complex->real transform */
+            COMPLEX16 *in = mt->block_in->data;
+            for (UINT4 r = 0; r < M; r++)
+            {
+                const UINT4 k = q + P * r;
+                in[r] = k > half ? 0.0 : (k == 0 || k == half ? X[k] : 2.0 * X[k]);
+            }
+            XLAL_CHECK(XLALCOMPLEX16VectorFFT(mt->block_out, mt->block_in, mt->blockPlan) == XLAL_SUCCESS, XLAL_EFUNC);
+
+            const COMPLEX16 *Z = mt->block_out->data;
+            const COMPLEX16 *w = mt->twiddle->data + q * n;
+            UINT4 s = mt->istart % M;
+            for (UINT4 j = 0; j < n; j++)
+            {
+                const COMPLEX16 zj = w[j] * Z[s];
+                x[j] += creal(zj);
+                if (y) y[j] += cimag(zj);
+                if (++s == M) s = 0;
+            }
         }
-        return (loglikelihood);
+        *dh = x;
+        if (dh_phase) *dh_phase = y;
+        return XLAL_SUCCESS;
+}
+
+/* The time marginalisation workspace of the model, rebuilt if the settings have changed */
+static LALInferenceMarginalTime *get_marginal_time(LALInferenceModel *model, UINT4 freqLength, UINT4 istart, UINT4 n, int margphi)
+{
+        if (!LALInferenceMarginalTimeMatches(model->margtime, freqLength, istart, n, margphi))
+        {
+            LALInferenceDestroyMarginalTime(model->margtime);
+            model->margtime = LALInferenceCreateMarginalTime(freqLength, istart, n, margphi);
+            XLAL_CHECK_NULL(model->margtime != NULL, XLAL_EFUNC);
+        }
+        return model->margtime;
 }
 
 /***************************************************************/
@@ -1578,6 +1888,109 @@ REAL8 LALInferenceMarginalisedPhaseLogLikelihood(LALInferenceVariables *currentP
   return LALInferenceFusedFreqDomainLogLikelihood(currentParams, data, model, MARGPHI);
 }
 
+/* Number of frequency bins handled together by fd_inner_products() */
+#define FD_BLOCK_SIZE 64
+/* Minimum number of blocks for which fd_inner_products() uses threads */
+#define FD_PARALLEL_MIN_BLOCKS 512
+
+/*
+ * Computes the noise-weighted inner products of one detector over n
+ * frequency bins starting at bin lower, for the template
+ * cal * (Fplus*hplus + Fcross*hcross) * exp(-i*dphi*k) at bin k.
+ * The arrays start at bin lower; cal may be NULL.  If dh_tilde is not
+ * NULL the weighted d conj(h) of each bin is added to it, for the
+ * time-marginalised likelihoods.
+ *
+ * Rather than a sequential recurrence the time-shift phase is the
+ * product of its exact value at the start of each block of bins and a
+ * table of exact phase increments within a block, so all bins of a block
+ * are independent and the arithmetic vectorises.  The sums are formed per
+ * block and then added in block order, so the result does not depend on
+ * the number of threads.
+ *
+ * Returns XLAL_SUCCESS, or fails with XLAL_ENOMEM.
+ */
+static int fd_inner_products(FDInnerProducts *out, const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                             const REAL8 *psd, const COMPLEX16 *cal, REAL8 Fplus, REAL8 Fcross, REAL8 dphi, UINT4 lower, UINT4 n,
+                             REAL8 deltaT, REAL8 TwoDeltaToverN, COMPLEX16 *dh_tilde)
+{
+  REAL8 wre[FD_BLOCK_SIZE], wim[FD_BLOCK_SIZE];
+  const UINT4 nblocks = (n + FD_BLOCK_SIZE - 1) / FD_BLOCK_SIZE;
+  FDInnerProducts partial_stack[16];
+  FDInnerProducts *partial = nblocks <= 16 ? partial_stack : XLALMalloc(nblocks * sizeof(*partial));
+  UINT4 b, k;
+
+  memset(out, 0, sizeof(*out));
+  if (n == 0) return XLAL_SUCCESS;
+  if (!partial) XLAL_ERROR(XLAL_ENOMEM);
+
+  /* exp(-i*dphi*k) within a block */
+  for (k = 0; k < FD_BLOCK_SIZE; k++) {
+    wre[k] = cos(dphi*k);
+    wim[k] = -sin(dphi*k);
+  }
+
+  #pragma omp parallel for if(nblocks >= FD_PARALLEL_MIN_BLOCKS)
+  for (b = 0; b < nblocks; b++) {
+    const UINT4 k0 = b * FD_BLOCK_SIZE;
+    const UINT4 m = n - k0 < FD_BLOCK_SIZE ? n - k0 : FD_BLOCK_SIZE;
+    const REAL8 phi0 = dphi * (lower + k0);
+    const REAL8 s0re = cos(phi0), s0im = -sin(phi0);
+    REAL8 tre[FD_BLOCK_SIZE], tim[FD_BLOCK_SIZE], w[FD_BLOCK_SIZE];
+    UINT4 j;
+
+    /* time-shifted, projected template and noise weight of each bin */
+    for (j = 0; j < m; j++) {
+      const REAL8 pre = s0re*wre[j] - s0im*wim[j];
+      const REAL8 pim = s0re*wim[j] + s0im*wre[j];
+      const REAL8 hre = Fplus*creal(hptilde[k0+j]) + Fcross*creal(hctilde[k0+j]);
+      const REAL8 him = Fplus*cimag(hptilde[k0+j]) + Fcross*cimag(hctilde[k0+j]);
+      tre[j] = hre*pre - him*pim;
+      tim[j] = hre*pim + him*pre;
+      w[j] = TwoDeltaToverN / (psd[k0+j]*deltaT*deltaT);
+    }
+    if (cal) {
+      for (j = 0; j < m; j++) {
+        const REAL8 cre = creal(cal[k0+j]), cim = cimag(cal[k0+j]);
+        const REAL8 t = tre[j];
+        tre[j] = cre*t - cim*tim[j];
+        tim[j] = cre*tim[j] + cim*t;
+      }
+    }
+
+    FDInnerProducts sum = {0.0, 0.0, 0.0, 0.0};
+    REAL8 dhre = 0.0, dhim = 0.0;
+    for (j = 0; j < m; j++) {
+      const REAL8 dre = creal(dtilde[k0+j]), dim = cimag(dtilde[k0+j]);
+      const REAL8 rre = dre - tre[j], rim = dim - tim[j];
+      /* d conj(h) */
+      const REAL8 xre = w[j]*(dre*tre[j] + dim*tim[j]);
+      const REAL8 xim = w[j]*(dim*tre[j] - dre*tim[j]);
+      sum.dd += w[j]*(dre*dre + dim*dim);
+      sum.hh += w[j]*(tre[j]*tre[j] + tim[j]*tim[j]);
+      sum.rr += w[j]*(rre*rre + rim*rim);
+      dhre += xre;
+      dhim += xim;
+      if (dh_tilde) dh_tilde[k0+j] += crect(xre, xim);
+    }
+    sum.dh = crect(dhre, dhim);
+    partial[b] = sum;
+  }
+
+  REAL8 dhre = 0.0, dhim = 0.0;
+  for (b = 0; b < nblocks; b++) {
+    out->dd += partial[b].dd;
+    out->hh += partial[b].hh;
+    out->rr += partial[b].rr;
+    dhre += creal(partial[b].dh);
+    dhim += cimag(partial[b].dh);
+  }
+  out->dh = crect(dhre, dhim);
+
+  if (partial != partial_stack) XLALFree(partial);
+  return XLAL_SUCCESS;
+}
+
 /** Integrate interpolated log, returns the mean index in *imax if it
  * is not a NULL pointer.  Stores the mean index in *imean (can be
  * fractional).
@@ -1802,11 +2215,6 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       Fplus*=amp_prefactor;
       Fcross*=amp_prefactor;
 
-      dataPtr->fPlus = Fplus;
-      dataPtr->fCross = Fcross;
-      dataPtr->timeshift = timeshift;
-
-
       /* determine frequency range & loop over frequency bins: */
       deltaF = 1.0 / (((double)dataPtr->timeData->data->length) * deltaT);
       lower = (UINT4)ceil(dataPtr->fLow / deltaF);
@@ -2028,9 +2436,6 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
     /* determine beam pattern response (F_plus and F_cross) for given Ifo: */
     XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
 
-    dataPtr->fPlus = Fplus;
-    dataPtr->fCross = Fcross;
-
     /* determine frequency range & loop over frequency bins: */
     deltaT = dataPtr->timeData->deltaT;
     deltaF = 1.0 / (((double)dataPtr->timeData->data->length) * deltaT);
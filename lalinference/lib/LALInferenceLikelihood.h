@@ -181,9 +181,66 @@ REAL8 LALInferenceMarginalisedTimePhaseLogLikelihood(LALInferenceVariables *curr
 
 /** Compute delta-log-likelihood for given distance min, max and OptimalSNR and d_inner_h when evaluated at 1Mpc
   * cosmology: 0 = Euclidean distance prior , 1 = uniform in comoving volume
-    margphi: 0 = use gaussian likelihood, 1 = phase-marginalised bessel likelihood */
+    margphi: 0 = use gaussian likelihood, 1 = phase-marginalised bessel likelihood
+  * The lookup table is built on the first call and reused for all later calls, whatever their
+  * distance range; use a LALInferenceMarginalDistance to evaluate other ranges or from several threads. */
 double LALInferenceMarginalDistanceLogLikelihood(double dist_min, double dist_max, double OptimalSNR, double d_inner_h, int cosmology, int margphi);
 
+/**
+ * Lookup table for the distance-marginalised likelihood over a given distance range.
+ * It is immutable once created, so one table may be used by any number of threads.
+ */
+typedef struct tagLALInferenceMarginalDistance LALInferenceMarginalDistance;
+
+/** Create a distance marginalisation table for distances in [dist_min, dist_max] (Mpc), with the
+  * cosmology and margphi options of LALInferenceMarginalDistanceLogLikelihood() */
+LALInferenceMarginalDistance *LALInferenceCreateMarginalDistance(double dist_min, double dist_max, int cosmology, int margphi);
+
+/** Free a distance marginalisation table */
+void LALInferenceDestroyMarginalDistance(LALInferenceMarginalDistance *margdist);
+
+/** Free the distance marginalisation table shared by the models of the threads of runState,
+  * set up by LALInferenceInitLikelihood(), and clear it from every model */
+void LALInferenceClearMarginalDistance(LALInferenceRunState *runState);
+
+/** Distance-marginalised delta-log-likelihood for OptimalSNR and d_inner_h evaluated at 1Mpc.
+  * Fails with XLAL_ERANGE if the inputs are NaN or the SNR is outside the table. */
+double LALInferenceMarginalDistanceEval(const LALInferenceMarginalDistance *margdist, double OptimalSNR, double d_inner_h);
+
+/** Evaluate LALInferenceMarginalDistanceEval() for n pairs (OptimalSNR[i], d_inner_h[i]), storing
+  * the results in loglikelihood[i], which may be the same array as either input.
+  * Entries outside the table are set to -INFINITY rather than raising an error. */
+int LALInferenceMarginalDistanceEvalBatch(const LALInferenceMarginalDistance *margdist, const double *OptimalSNR, const double *d_inner_h, double *loglikelihood, size_t n);
+
+/**
+ * Workspace for the time (and phase) marginalised likelihood. It holds the detector-summed
+ * spectrum of d conj(h) and inverse transforms it only at the samples of the time prior window.
+ * Each model keeps its own, so one workspace must not be used by several threads at once.
+ */
+typedef struct tagLALInferenceMarginalTime LALInferenceMarginalTime;
+
+/** Create a workspace for spectra of freqLength bins whose 2*(freqLength-1) point inverse
+  * transform is evaluated at the n samples starting at istart. If margphi is set the phase
+  * quadrature is computed as well. */
+LALInferenceMarginalTime *LALInferenceCreateMarginalTime(UINT4 freqLength, UINT4 istart, UINT4 n, int margphi);
+
+/** Free a time marginalisation workspace */
+void LALInferenceDestroyMarginalTime(LALInferenceMarginalTime *margtime);
+
+/** Whether margtime was created with the given settings */
+int LALInferenceMarginalTimeMatches(const LALInferenceMarginalTime *margtime, UINT4 freqLength, UINT4 istart, UINT4 n, int margphi);
+
+/** Zero the spectrum of the workspace and return it, for d conj(h)/S to be summed into */
+COMPLEX16 *LALInferenceMarginalTimeResetSpectrum(LALInferenceMarginalTime *margtime);
+
+/** Inverse transform the spectrum. On return (*dh)[j] and, with margphi, (*dh_phase)[j] hold the
+  * two phase quadratures at sample istart+j. The arrays belong to the workspace and may be
+  * overwritten by the caller until the next call. */
+int LALInferenceMarginalTimeTransform(LALInferenceMarginalTime *margtime, REAL8 **dh, REAL8 **dh_phase);
+
+/** An array of n elements belonging to the workspace, free for the caller to use as scratch */
+REAL8 *LALInferenceMarginalTimeScratch(LALInferenceMarginalTime *margtime);
+
 
 /**
  * Returns the log-likelihood marginalised over the time dimension
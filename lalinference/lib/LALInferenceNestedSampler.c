@@ -36,6 +36,7 @@
 
 #define MAX_MCMC 5000 /* Maximum chain length, set to be higher than expected from a reasonable run */
 #define ACF_TOLERANCE 0.01 /* Desired maximum correlation of MCMC samples */
+#define EIGEN_DRIFT 0.05 /* Relative change in the covariance of the live points before recomputing its eigenvectors */
 
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
@@ -293,9 +294,6 @@ static REAL8 LALInferenceNSSample_logt(int Nlive,gsl_rng *RNG);
 static REAL8 mean(REAL8 *array,int N);
 
 
-/** Calculate covariance matrix from a collection of live points */
-static void LALInferenceNScalcCVM(gsl_matrix **cvm, LALInferenceVariables **Live, UINT4 Nlive);
-
 /* log( exp(a) - exp(b) ) */
 static double logsubexp(double a, double b);
 static double logsubexp(double a, double b)
@@ -311,7 +309,33 @@ static double logsubexp(double a, double b)
 		}
 }
 
-static void SetupEigenProposals(LALInferenceRunState *runState);
+/* Compute the covariance of the live points from scratch and set up the
+ * eigenvector proposals of all threads from it */
+static void SetupEigenProposals(LALInferenceRunState *runState, LALInferenceRunningCovariance **cov);
+/* Copy the current eigenvectors of cov to the proposals of all threads */
+static void UpdateEigenProposals(LALInferenceRunState *runState, LALInferenceRunningCovariance *cov);
+
+/* Versions of LALInferenceMCMCSamplePrior() and
+ * LALInferenceNestedSamplingSloppySample() which operate on a given
+ * thread, reading and writing the sampler settings (logLmin, Nmcmc,
+ * sloppyfraction, ...) in algorithmParams and drawing from rng */
+static UINT4 samplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng);
+static INT4 sloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng);
+
+/* Copy the sampler setting name from one set of algorithm parameters to another */
+static void copyAlgorithmParam(LALInferenceVariables *from, LALInferenceVariables *to, const char *name);
+static void copyAlgorithmParam(LALInferenceVariables *from, LALInferenceVariables *to, const char *name)
+{
+  if(!LALInferenceCheckVariable(from,name)) return;
+  LALInferenceAddVariable(to,name,LALInferenceGetVariable(from,name),LALInferenceGetVariableType(from,name),LALInferenceGetVariableVaryType(from,name));
+}
+
+/* Settings of the sloppy sampler, which each thread keeps its own copy of
+ * when several live points are replaced concurrently */
+static const char *threadAlgorithmParams[]={"logLmin","Nmcmc","sloppyfraction","accept_rate","sub_accept_rate","logZnoise"};
+#define N_THREAD_ALGORITHM_PARAMS (sizeof(threadAlgorithmParams)/sizeof(threadAlgorithmParams[0]))
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -435,143 +459,16 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(&runState->threads[t]);
+    /* Threads sampling concurrently keep their own copy of the chain length */
+    if(runState->nthreads>1)
+        for(INT4 t=0;t<runState->nthreads;t++)
+            copyAlgorithmParam(runState->algorithmParams,runState->threads[t].algorithmParams,"Nmcmc");
     return(max);
 }
 
-/* estimateCovarianceMatrix reads the list of live points,
- and works out the covariance matrix of the varying parameters
- - CIRCULAR parameters are wrapped around before the calculation and must be
- scaled to the range 0 -> 2pi. Only works with REAL8 variables */
-static void LALInferenceNScalcCVM(gsl_matrix **cvm, LALInferenceVariables **Live, UINT4 Nlive)
-{
-	UINT4 i,j,k;
-	UINT4 ND=0;
-	LALInferenceVariableItem *item,*k_item,*j_item;
-	REAL8 *means, *ms, *mc,jval=0.,kval=0.;
-
-	/* Find the number of dimensions which vary in the covariance matrix */
-	for(item=Live[0]->head;item!=NULL;item=item->next)
-		if((item->vary==LALINFERENCE_PARAM_LINEAR || item->vary==LALINFERENCE_PARAM_CIRCULAR) && item->type==LALINFERENCE_REAL8_t) ND++;
-
-	/* Set up matrix if necessary */
-	if(*cvm==NULL)
-	{if(NULL==(*cvm=gsl_matrix_alloc(ND,ND))) {fprintf(stderr,"Unable to allocate matrix memory\n"); exit(1);}}
-	else {
-		if((*cvm)->size1!=(*cvm)->size2 || (*cvm)->size1!=ND)
-		{	fprintf(stderr,"ERROR: Matrix wrong size. Something has gone wrong in LALInferenceNScalcCVM\n");
-			exit(1);
-		}
-	}
-	/* clear the matrix */
-	for(i=0;i<(*cvm)->size1;i++) for(j=0;j<(*cvm)->size2;j++) gsl_matrix_set(*cvm,i,j,0.0);
-
-	/* Find the means */
-	if(NULL==(means = XLALMalloc((size_t)ND*sizeof(REAL8)))){fprintf(stderr,"Can't allocate RAM"); exit(-1);}
-	if(NULL==(ms = XLALMalloc((size_t)ND*sizeof(REAL8)))){fprintf(stderr,"Can't allocate RAM"); exit(-1);}
-	if(NULL==(mc = XLALMalloc((size_t)ND*sizeof(REAL8)))){fprintf(stderr,"Can't allocate RAM"); exit(-1);}
-	for(i=0;i<ND;i++){
-          means[i]=0.0;
-          ms[i] = 0.;
-          mc[i] = 0.;
-        }
-        for(item=Live[0]->head,j=0;item;item=item->next){
-	  if((item->vary!=LALINFERENCE_PARAM_CIRCULAR && item->vary!=LALINFERENCE_PARAM_LINEAR) || item->type!=LALINFERENCE_REAL8_t) continue;
-	    for(i=0;i<Nlive;i++){
-			void *ptr = LALInferenceGetVariable(Live[i],item->name);
-			switch(item->vary)
-			{
-			  case LALINFERENCE_PARAM_LINEAR:
-			  {
-                                means[j]+=*(REAL8 *)ptr;
-				break;
-			  }
-			  case LALINFERENCE_PARAM_CIRCULAR:
-			  {
-                               ms[j] += sin(*(REAL8 *)ptr);
-                               mc[j] += cos(*(REAL8 *)ptr);
-                               break;
-			  }
-			  default:
-			  {
-			    break;
-			  }
-			}
-	  }
-	  j++;
-	}
-
-        for(item=Live[0]->head,j=0;item;item=item->next){
-          if( item->vary==LALINFERENCE_PARAM_LINEAR && item->type==LALINFERENCE_REAL8_t ){
-            means[j]/=(REAL8)Nlive;
-            j++;
-          }
-          if( item->vary==LALINFERENCE_PARAM_CIRCULAR && item->type==LALINFERENCE_REAL8_t ){
-            ms[j]/=(REAL8)Nlive;
-            mc[j]/=(REAL8)Nlive;
-
-            means[j] = atan2(ms[j], mc[j]);
-            means[j] = means[j]<0? 2.0*LAL_PI + means[j] : means[j];
-
-            j++;
-          }
-        }
-
-        XLALFree(ms);
-        XLALFree(mc);
-
-	/* Iterate over the matrix elements one at a time */
-	j_item=k_item=Live[0]->head;
-	for(j=0,j_item=Live[0]->head;j_item;j_item=j_item->next)
-	{
-	  /* Skip non-varying parameters */
-	  if((j_item->vary!=LALINFERENCE_PARAM_LINEAR && j_item->vary!=LALINFERENCE_PARAM_CIRCULAR )||j_item->type!=LALINFERENCE_REAL8_t ) {continue;}
-
-	  for(k_item=Live[0]->head,k=0;k_item &&k<=j;k_item=k_item->next)
-	  {
-	    /* Skip non-varying parameters */
-	    if((k_item->vary!=LALINFERENCE_PARAM_LINEAR && k_item->vary!=LALINFERENCE_PARAM_CIRCULAR)||k_item->type!=LALINFERENCE_REAL8_t) {continue;}
-
-	    /* Loop over live points updating covariance elements */
-	    for(i=0;i<Nlive;i++)
-	    {
-	      void *jptr=LALInferenceGetVariable(Live[i],j_item->name);
-	      void *kptr=LALInferenceGetVariable(Live[i],k_item->name);
-
-	      /* Check for linear or circular */
-	      if( j_item->vary==LALINFERENCE_PARAM_CIRCULAR )
-		jval = LALInferenceAngularDistance(*(REAL8 *)jptr, means[j]);
-	      else if( j_item->vary==LALINFERENCE_PARAM_LINEAR )
-		jval = *(REAL8 *)jptr - means[j];
-
-	      if( k_item->vary==LALINFERENCE_PARAM_CIRCULAR )
-		kval = LALInferenceAngularDistance(*(REAL8 *)kptr, means[k]);
-	      else if( k_item->vary==LALINFERENCE_PARAM_LINEAR )
-		kval = *(REAL8 *)kptr - means[k];
-
-	      gsl_matrix_set(*cvm,j,k, gsl_matrix_get(*cvm,j,k) + kval*jval);
-
-	    }
-
-	    k++;
-	  } /* end loop over k */
-	  j++;
-	}/* end loop over j */
-
-	/* Normalise */
-	for(i=0;i<ND;i++) for(j=0;j<ND;j++) gsl_matrix_set(*cvm,i,j,gsl_matrix_get(*cvm,i,j)/((REAL8) Nlive));
-	XLALFree(means);
-
-	/* the other half */
-	for(i=0;i<ND;i++)
-          for(j=0;j<i;j++)
-            gsl_matrix_set(*cvm,j,i,gsl_matrix_get(*cvm,i,j));
-
-	return;
-}
-
 void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 {
   char help[]="\
@@ -586,6 +483,11 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--Nparallel K)                  Replace the K lowest likelihood live points at each iteration,\n\
+                                     using K concurrent MCMC chains on separate threads (1).\n\
+                                     The chains generate waveforms at the same time, so K>1 needs\n\
+                                     an approximant that is safe to call from several threads.\n\
+                                     Without OpenMP the K chains run one after another\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -640,15 +542,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t].proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -697,6 +597,17 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     LALInferenceAddVariable(runState->algorithmParams,"Nruns",&tmpi,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
   }
 
+  /* Optionally replace several live points per iteration, one per thread */
+  ppt=LALInferenceGetProcParamVal(commandLine,"--Nparallel");
+  if(ppt) {
+    tmpi=atoi(ppt->value);
+    if(tmpi<1 || tmpi>runState->nthreads) {
+      fprintf(stderr,"Error, --Nparallel %i needs between 1 and the %i threads set up\n",tmpi,runState->nthreads);
+      exit(1);
+    }
+    LALInferenceAddVariable(runState->algorithmParams,"Nparallel",&tmpi,LALINFERENCE_INT4_t,LALINFERENCE_PARAM_FIXED);
+  }
+
   printf("set tolerance.\n");
   /* Tolerance of the Nested sampling integrator */
   ppt=LALInferenceGetProcParamVal(commandLine,"--tolerance");
@@ -726,6 +637,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 {
   UINT4 iter=0,i,j,minpos;
+  UINT4 Npar=1;
+  LALInferenceRunningCovariance *livecov=NULL;
   /* Single thread here */
   LALInferenceThreadState *threadState = &runState->threads[0];
   UINT4 HDFOUTPUT=1;
@@ -777,6 +690,21 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceCheckVariable(runState->algorithmParams,"Nruns"))
     Nruns = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nruns");
 
+  /* Number of live points to replace concurrently at each iteration */
+  if(LALInferenceCheckVariable(runState->algorithmParams,"Nparallel"))
+    Npar = *(UINT4 *) LALInferenceGetVariable(runState->algorithmParams,"Nparallel");
+  if(Npar>(UINT4)runState->nthreads) Npar=runState->nthreads;
+  if(Npar>1 && runState->evolve!=&LALInferenceNestedSamplingOneStep)
+  {
+    fprintf(stderr,"Warning: parallel replacement needs the default nested sampling evolve function, using one thread\n");
+    Npar=1;
+  }
+  if(Npar>=Nlive)
+  {
+    fprintf(stderr,"Error, cannot replace %i of %i live points at once\n",Npar,Nlive);
+    exit(1);
+  }
+
   /* Create workspace for arrays */
   NSintegralState *s=NULL;
 
@@ -831,12 +759,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     LALInferenceSortVariablesByName(runState->livePoints[i]);
 
   /* Set up eigenvector proposals */
-  SetupEigenProposals(runState);
+  SetupEigenProposals(runState,&livecov);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
+    runState->threads[t].differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -911,7 +841,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     LALInferenceSortVariablesByName(runState->livePoints[i]);
 
   /* Update the covariance matrix for proposal distribution */
-  SetupEigenProposals(runState);
+  SetupEigenProposals(runState,&livecov);
 
   /* Reset proposal stats before starting */
   LALInferenceZeroProposalStats(threadState->cycle);
@@ -943,8 +873,23 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   {
       install_resume_handler(CondorExitCode);
   }
+  /* Workspace for replacing several live points per iteration */
+  UINT4 *worst=NULL, *isworst=NULL;
+  if(Npar>1)
+  {
+    worst=XLALCalloc(Npar,sizeof(UINT4));
+    isworst=XLALCalloc(Nlive,sizeof(UINT4));
+    for(UINT4 t=0;t<Npar;t++)
+      for(UINT4 k=0;k<N_THREAD_ALGORITHM_PARAMS;k++)
+        copyAlgorithmParam(runState->algorithmParams,runState->threads[t].algorithmParams,threadAlgorithmParams[k]);
+    fprintf(stdout,"Replacing %i live points per iteration\n",Npar);
+  }
   /* Iterate until termination condition is met */
   do {
+    UINT4 itercounter=0;
+    UINT4 nreplaced=1;
+    if(Npar==1)
+    {
     /* Find minimum likelihood sample to replace */
     minpos=0;
     for(i=1;i<Nlive;i++){
@@ -959,7 +904,6 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     H=mean(Harray,Nruns);
     logZ=logZnew;
     if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
-    UINT4 itercounter=0;
 
     /* Generate a new live point */
     do{ /* This loop is here in case it is necessary to find a different sample */
@@ -972,7 +916,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
       itercounter++;
     }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
 
+    if(livecov && LALInferenceRunningCovarianceRemove(livecov,runState->livePoints[minpos])!=XLAL_SUCCESS)
+      XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to remove live point from covariance");
     LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
+    if(livecov && LALInferenceRunningCovarianceAdd(livecov,runState->livePoints[minpos])!=XLAL_SUCCESS)
+      XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to add live point to covariance");
     logLikelihoods[minpos]=threadState->currentLikelihood;
 
   if (threadState->currentLikelihood>logLmax)
@@ -980,6 +928,68 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
   logw=mean(logwarray,Nruns);
   LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    }
+    else
+    {
+    /* Remove the Npar lowest likelihood points, in increasing order of
+       likelihood.  This is the same as Npar successive iterations in which
+       the live points are not replaced, so the prior volume shrinks as for
+       Nlive, Nlive-1, ..., Nlive-Npar+1 live points. */
+    for(UINT4 m=0;m<Npar;m++)
+    {
+      minpos=Nlive;
+      for(i=0;i<Nlive;i++)
+        if(!isworst[i] && (minpos==Nlive || logLikelihoods[i]<logLikelihoods[minpos]))
+          minpos=i;
+      worst[m]=minpos;
+      isworst[minpos]=1;
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive-m, logLikelihoods[minpos], s);
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
+    }
+    H=mean(Harray,Nruns);
+    logZ=logZnew;
+    /* All new points must lie above the highest removed likelihood */
+    logLmin=logLikelihoods[worst[Npar-1]];
+    if(samplePrior) logLmin=-INFINITY;
+    LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
+
+    /* Evolve a copy of a surviving point on each thread */
+    #pragma omp parallel for reduction(+:itercounter)
+    for(UINT4 t=0;t<Npar;t++)
+    {
+      LALInferenceThreadState *thread=&runState->threads[t];
+      UINT4 start;
+      LALInferenceSetVariable(thread->algorithmParams,"logLmin",(void *)&logLmin);
+      do{
+        while(isworst[(start=gsl_rng_uniform_int(thread->GSLrandom,Nlive))]){};
+        LALInferenceCopyVariables(runState->livePoints[start],thread->currentParams);
+        thread->currentLikelihood = logLikelihoods[start];
+        sloppySampleThread(runState,thread,thread->algorithmParams,thread->GSLrandom);
+        itercounter++;
+      }while( thread->currentLikelihood<=logLmin || *(REAL8*)LALInferenceGetVariable(thread->algorithmParams,"accept_rate")==0.0);
+    }
+
+    logw=mean(logwarray,Nruns);
+    for(UINT4 t=0;t<Npar;t++)
+    {
+      LALInferenceThreadState *thread=&runState->threads[t];
+      if(livecov && LALInferenceRunningCovarianceRemove(livecov,runState->livePoints[worst[t]])!=XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to remove live point from covariance");
+      LALInferenceCopyVariables(thread->currentParams,runState->livePoints[worst[t]]);
+      if(livecov && LALInferenceRunningCovarianceAdd(livecov,runState->livePoints[worst[t]])!=XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to add live point to covariance");
+      logLikelihoods[worst[t]]=thread->currentLikelihood;
+      if (thread->currentLikelihood>logLmax)
+        logLmax=thread->currentLikelihood;
+      LALInferenceAddVariable(runState->livePoints[worst[t]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+      isworst[worst[t]]=0;
+    }
+    /* Report the statistics of the first thread */
+    copyAlgorithmParam(threadState->algorithmParams,runState->algorithmParams,"accept_rate");
+    copyAlgorithmParam(threadState->algorithmParams,runState->algorithmParams,"sub_accept_rate");
+    copyAlgorithmParam(threadState->algorithmParams,runState->algorithmParams,"sloppyfraction");
+    nreplaced=Npar;
+    }
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -996,7 +1006,15 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=nreplaced;
+
+  /* Recompute the eigenvectors of the covariance once it has drifted */
+  if(livecov && LALInferenceRunningCovarianceDrift(livecov)>EIGEN_DRIFT)
+  {
+    if(LALInferenceRunningCovarianceEigen(livecov)!=XLAL_SUCCESS)
+      XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to update eigenvectors of live points");
+    UpdateEigenProposals(runState,livecov);
+  }
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1012,17 +1030,19 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
 
   /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
-    /* Update the covariance matrix */
-    if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
-      SetupEigenProposals(runState);
-    }
+  if(iter/(Nlive/10) != (iter-nreplaced)/(Nlive/10)) {
+    /* Recompute the covariance matrix from the live points after every
+       Nlive replacements, to discard the rounding error of the updates */
+    if(livecov && livecov->nupdates>=2*Nlive)
+      if(LALInferenceRunningCovarianceRecompute(livecov,runState->livePoints,Nlive)!=XLAL_SUCCESS)
+        XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to compute covariance of live points");
 
     /* Update NMCMC from ACF */
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(INT4 t=0;t<runState->nthreads;t++)
+      syncLivePointsDifferentialPoints(runState,&runState->threads[t]);
 
     /* Output some information */
     if(verbose){
@@ -1036,6 +1056,10 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   while(samplePrior?((Nlive+iter)<samplePrior):( iter <= Nlive ||  dZ> TOLERANCE)); /* End of NS loop! */
 
+  XLALFree(worst);
+  XLALFree(isworst);
+  LALInferenceDestroyRunningCovariance(livecov);
+
   /* Sort the remaining points (not essential, just nice)*/
   for(i=0;i<Nlive-1;i++){
     minpos=i;
@@ -1338,7 +1362,12 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
 UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 {
     /* Single threaded here */
-    LALInferenceThreadState * threadState=&runState->threads[0];
+    return samplePriorThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom);
+}
+
+static UINT4 samplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng)
+{
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1346,7 +1375,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     //LALInferenceVariables *oldParams=&tempParams;
     LALInferenceVariables proposedParams;
     memset(&proposedParams,0,sizeof(proposedParams));
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logLmin");
     REAL8 thislogL=-INFINITY;
     UINT4 accepted=0;
 
@@ -1360,7 +1389,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(rng)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1484,9 +1513,14 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
 
 INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
 {
-    LALInferenceVariables oldParams;
     /* Single thread here */
-    LALInferenceThreadState *threadState = &runState->threads[0];
+    return sloppySampleThread(runState,&runState->threads[0],runState->algorithmParams,runState->GSLrandom);
+}
+
+static INT4 sloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState,
+                               LALInferenceVariables *algorithmParams, gsl_rng *rng)
+{
+    LALInferenceVariables oldParams;
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1494,14 +1528,14 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 logLold=*(REAL8 *)LALInferenceGetVariable(threadState->currentParams,"logL");
     memset(&oldParams,0,sizeof(oldParams));
     LALInferenceCopyVariables(threadState->currentParams,&oldParams);
-    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logLmin");
-    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nmcmc");
+    REAL8 logLmin=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logLmin");
+    UINT4 Nmcmc=*(UINT4 *)LALInferenceGetVariable(algorithmParams,"Nmcmc");
     REAL8 maxsloppyfraction=((REAL8)Nmcmc-1)/(REAL8)Nmcmc ;
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (LALInferenceCheckVariable(algorithmParams,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(algorithmParams,"sloppyfraction");
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1526,7 +1560,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=samplePriorThread(runState,threadState,algorithmParams,rng);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1546,8 +1580,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             Naccepted++;
             /* Update information to pass back out */
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algorithmParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1577,8 +1611,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
             logLnew=runState->likelihood(threadState->currentParams,runState->data,threadState->model);
             threadState->currentLikelihood=logLnew;
             LALInferenceAddVariable(threadState->currentParams,"logL",(void *)&logLnew,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
-            if(LALInferenceCheckVariable(runState->algorithmParams,"logZnoise")){
-               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"logZnoise");
+            if(LALInferenceCheckVariable(algorithmParams,"logZnoise")){
+               tmp=logLnew-*(REAL8 *)LALInferenceGetVariable(algorithmParams,"logZnoise");
                LALInferenceAddVariable(threadState->currentParams,"deltalogL",(void *)&tmp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
             }
             ifo=0;
@@ -1596,8 +1630,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    LALInferenceSetVariable(algorithmParams,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(algorithmParams,"sub_accept_rate",&sub_accept_rate);
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1605,7 +1639,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	LALInferenceSetVariable(algorithmParams,"sloppyfraction",&sloppyfraction);
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1644,8 +1678,12 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 		fprintf(stderr,"Unable to allocate memory for %i live points\n",Nlive);
 		exit(1);
 	}
-	threadState->differentialPoints=runState->livePoints;
-	threadState->differentialPointsLength=(size_t) Nlive;
+	/* All threads use the live points for differential evolution */
+	for(INT4 t=0;t<runState->nthreads;t++)
+	{
+	    runState->threads[t].differentialPoints=runState->livePoints;
+	    runState->threads[t].differentialPointsLength=(size_t) Nlive;
+	}
 	logLs=XLALCreateREAL8Vector(Nlive);
 
 	LALInferenceAddVariable(runState->algorithmParams,"logLikelihoods",&logLs,LALINFERENCE_REAL8Vector_t,LALINFERENCE_PARAM_FIXED);
@@ -1673,65 +1711,58 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 }
 
 
-static void SetupEigenProposals(LALInferenceRunState *runState)
+static void SetupEigenProposals(LALInferenceRunState *runState, LALInferenceRunningCovariance **cov)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = &runState->threads[0];
-  gsl_matrix *eVectors=NULL;
-  gsl_vector *eValues =NULL;
-  REAL8Vector *eigenValues=NULL;
-  /* Check for existing covariance matrix */
-  gsl_matrix **cvm=NULL;
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceMatrix"))
-    LALInferenceRemoveVariable(threadState->proposalArgs,"covarianceMatrix");
-//    cvm=(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceMatrix");
-  cvm=XLALCalloc(1,sizeof(gsl_matrix *));
-
-  /* Add the covariance matrix for proposal distribution */
-  UINT4 *Nlive=LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+  UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
   /* Sort the variables to ensure consistent order */
-  for(UINT4 i=0;i<*Nlive;i++) LALInferenceSortVariablesByName(runState->livePoints[i]);
-  LALInferenceNScalcCVM(cvm,runState->livePoints,*Nlive);
-  UINT4 N=(*cvm)->size1;
-
-
-  /* Check for the eigenvectors and values */
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
-    eVectors=*(gsl_matrix **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvectors");
-  else
-    eVectors=gsl_matrix_alloc(N,N);
-
-  if(LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
-    eigenValues=*(REAL8Vector **)LALInferenceGetVariable(threadState->proposalArgs,"covarianceEigenvalues");
-  else
-    eigenValues=XLALCreateREAL8Vector(N);
-
-  /* Set up eigenvectors and eigenvalues. */
-  gsl_matrix *covCopy = gsl_matrix_alloc(N,N);
-  eValues = gsl_vector_alloc(N);
-  gsl_eigen_symmv_workspace *ws = gsl_eigen_symmv_alloc(N);
-  int gsl_status;
-  gsl_matrix_memcpy(covCopy, *cvm);
-
-  if ((gsl_status = gsl_eigen_symmv(covCopy, eValues, eVectors, ws)) != GSL_SUCCESS) {
-    XLALPrintError("Error in gsl_eigen_symmv (in %s, line %d): %d: %s\n", __FILE__, __LINE__, gsl_status, gsl_strerror(gsl_status));
-    XLAL_ERROR_VOID(XLAL_EFAILED);
+  for(UINT4 i=0;i<Nlive;i++) LALInferenceSortVariablesByName(runState->livePoints[i]);
+  if(*cov==NULL)
+  {
+    if(NULL==(*cov=LALInferenceCreateRunningCovariance(runState->livePoints,Nlive)))
+      XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to compute covariance of live points");
   }
+  else if(LALInferenceRunningCovarianceRecompute(*cov,runState->livePoints,Nlive)!=XLAL_SUCCESS
+          || LALInferenceRunningCovarianceEigen(*cov)!=XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC,"Unable to compute covariance of live points");
+  UpdateEigenProposals(runState,*cov);
+}
 
-  for (UINT4 i = 0; i < N; i++) {
-    eigenValues->data[i] = gsl_vector_get(eValues,i);
-  }
+static void UpdateEigenProposals(LALInferenceRunState *runState, LALInferenceRunningCovariance *cov)
+{
+  UINT4 N=cov->dim;
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    LALInferenceVariables *args=runState->threads[t].proposalArgs;
+    gsl_matrix *eVectors=NULL, *cvm=NULL;
+    REAL8Vector *eigenValues=NULL;
 
-  if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvectors"))
-    LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvectors", &eVectors, LALINFERENCE_gslMatrix_t, LALINFERENCE_PARAM_FIXED);
-  if(!LALInferenceCheckVariable(threadState->proposalArgs,"covarianceEigenvalues"))
-    LALInferenceAddVariable(threadState->proposalArgs, "covarianceEigenvalues", &eigenValues, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
-  LALInferenceAddVariable(threadState->proposalArgs,"covarianceMatrix",cvm,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
+    if(LALInferenceCheckVariable(args,"covarianceEigenvectors"))
+      eVectors=*(gsl_matrix **)LALInferenceGetVariable(args,"covarianceEigenvectors");
+    else
+    {
+      eVectors=gsl_matrix_alloc(N,N);
+      LALInferenceAddVariable(args, "covarianceEigenvectors", &eVectors, LALINFERENCE_gslMatrix_t, LALINFERENCE_PARAM_FIXED);
+    }
+    gsl_matrix_memcpy(eVectors,cov->eigenvectors);
 
-  gsl_matrix_free(covCopy);
-  gsl_vector_free(eValues);
-  gsl_eigen_symmv_free(ws);
-  XLALFree(cvm);
+    if(LALInferenceCheckVariable(args,"covarianceEigenvalues"))
+      eigenValues=*(REAL8Vector **)LALInferenceGetVariable(args,"covarianceEigenvalues");
+    else
+    {
+      eigenValues=XLALCreateREAL8Vector(N);
+      LALInferenceAddVariable(args, "covarianceEigenvalues", &eigenValues, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
+    }
+    memcpy(eigenValues->data,cov->eigenvalues->data,N*sizeof(REAL8));
+
+    if(LALInferenceCheckVariable(args,"covarianceMatrix"))
+      cvm=*(gsl_matrix **)LALInferenceGetVariable(args,"covarianceMatrix");
+    else
+    {
+      cvm=gsl_matrix_alloc(N,N);
+      LALInferenceAddVariable(args,"covarianceMatrix",&cvm,LALINFERENCE_gslMatrix_t,LALINFERENCE_PARAM_OUTPUT);
+    }
+    gsl_matrix_memcpy(cvm,cov->frameCov);
+  }
 }
 
 
@@ -93,8 +93,7 @@ void LALInferenceCyclicReflectiveBound(LALInferenceVariables *parameter, LALInfe
  * crossing a boundary requires the initial phase parameter \f$\phi_0\f$ to be
  * rotated through \f$\pi\f$ radians. The function assumes the value of
  * \f$\psi\f$ has been rescaled to be between 0 and \f$2\pi\f$ - this is a
- * requirement of the covariance matrix routine \c LALInferenceNScalcCVM
- * function.
+ * requirement of the live point covariance, \c LALInferenceRunningCovariance.
  *
  * This is particularly relevant for pulsar analyses.
  *
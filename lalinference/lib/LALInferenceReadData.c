@@ -73,6 +73,7 @@
 #include <lal/LALInference.h>
 #include <lal/LALInferenceReadData.h>
 #include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferenceGenerateROQ.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALSimNoise.h>
@@ -771,8 +772,6 @@ LALInferenceIFOData *LALInferenceReadData(ProcessParamsTable *commandLine)
         if(!IFOdata[i].timeToFreqFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
         IFOdata[i].freqToTimeFFTPlan = XLALCreateReverseREAL8FFTPlan((UINT4) seglen, 1 );
         if(!IFOdata[i].freqToTimeFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
-        IFOdata[i].margFFTPlan = XLALCreateReverseREAL8FFTPlan((UINT4) seglen, 1);
-        if(!IFOdata[i].margFFTPlan) XLAL_ERROR_NULL(XLAL_ENOMEM);
         /* Setup windows */
         ppt=LALInferenceGetProcParamVal(commandLine,"--padding");
         if (ppt){
@@ -2625,7 +2624,9 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
     while (thisData) {
       thisData->roq = XLALMalloc(sizeof(LALInferenceROQData));
 
-      thisData->roq->weights_linear = XLALMalloc(n_basis_linear*sizeof(LALInferenceROQSplineWeights));
+      thisData->roq->n_basis_linear = 0;
+      thisData->roq->weights_linear_tcs = NULL;
+      thisData->roq->weights_linear_coeffs = NULL;
 
       sprintf(tmp, "--%s-roqweightsLinear", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
@@ -2648,9 +2649,6 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       fprintf(stderr, "basis_size = %d\n", n_basis_linear);
       fprintf(stderr, "time steps = %d\n", time_steps);
 
-      double *tmp_real_weight = malloc(time_steps*(sizeof(double)));
-      double *tmp_imag_weight = malloc(time_steps*(sizeof(double)));
-
       double *tmp_tcs = malloc(time_steps*(sizeof(double)));
 
       sprintf(tmp, "--roq-times");
@@ -2671,24 +2669,19 @@ void LALInferenceSetupROQdata(LALInferenceIFOData *IFOdata, ProcessParamsTable *
       for(unsigned int ii=0; ii<n_basis_linear;ii++){
 	for(unsigned int jj=0; jj<time_steps;jj++){
 	  fread(&(thisData->roq->weightsLinear[ii*time_steps + jj]), sizeof(double complex), 1, thisData->roq->weightsFileLinear);
-	  tmp_real_weight[jj] = creal(thisData->roq->weightsLinear[ii*time_steps + jj]);
-	  tmp_imag_weight[jj] = cimag(thisData->roq->weightsLinear[ii*time_steps + jj]);
 	}
-  //gsl_interp_accel is not thread-safe, and each OpenMP thread will need its
-  //own gsl_interp_accel object.
-	thisData->roq->weights_linear[ii].acc_real_weight_linear = NULL;
- 	thisData->roq->weights_linear[ii].acc_imag_weight_linear = NULL;
-
-	thisData->roq->weights_linear[ii].spline_real_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_real_weight_linear, tmp_tcs, tmp_real_weight, time_steps);
-
-        thisData->roq->weights_linear[ii].spline_imag_weight_linear = gsl_spline_alloc (gsl_interp_cspline, time_steps);
-        gsl_spline_init(thisData->roq->weights_linear[ii].spline_imag_weight_linear, tmp_tcs, tmp_imag_weight, time_steps);
       }
       fclose(thisData->roq->weightsFileLinear);
       thisData->roq->weightsFileLinear = NULL;
       fclose(tcFile);
 
+      /* tables of the weights used by the likelihood */
+      if (LALInferenceROQLinearWeightsInit(thisData->roq, tmp_tcs, thisData->roq->weightsLinear, time_steps, n_basis_linear) != XLAL_SUCCESS){
+        fprintf(stderr, "Error: cannot tabulate the linear ROQ weights\n");
+        exit(1);
+      }
+      free(tmp_tcs);
+
       sprintf(tmp, "--%s-roqweightsQuadratic", thisData->name);
       ppt = LALInferenceGetProcParamVal(commandLine,tmp);
       thisData->roq->weightsQuadratic = (double*)malloc(n_basis_quadratic*sizeof(double));
@@ -0,0 +1,161 @@
+/*
+ *  LALInferenceFDInnerProductsTest.c:  Unit test of the fused frequency-domain
+ *  inner products of LALInferenceLikelihood.c
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/*
+ * Compares fd_inner_products() with the per-bin loop of the frequency-domain
+ * likelihood, which advances the time-shift phase by a trigonometric
+ * recurrence, for ranges shorter than a block, a whole number of blocks, a
+ * partial last block and enough blocks to use threads, with and without
+ * calibration factors.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+
+#include "../lib/LALInferenceLikelihood.c"
+
+/* relative tolerance; the recurrence loses a few digits over many bins */
+#define TOLERANCE 1e-9
+
+/* the per-bin loop, as in LALInferenceFusedFreqDomainLogLikelihood() */
+static void per_bin_inner_products(FDInnerProducts *out, const COMPLEX16 *dtilde, const COMPLEX16 *hptilde, const COMPLEX16 *hctilde,
+                                   const REAL8 *psd, const COMPLEX16 *cal, REAL8 Fplus, REAL8 Fcross, REAL8 dphi, UINT4 lower, UINT4 n,
+                                   REAL8 deltaT, REAL8 TwoDeltaToverN, COMPLEX16 *dh_tilde)
+{
+  REAL8 re = cos(dphi*lower), im = -sin(dphi*lower), newRe, newIm;
+  const REAL8 dim = -sin(dphi), dre = -2.0*sin(0.5*dphi)*sin(0.5*dphi);
+  UINT4 k;
+
+  memset(out, 0, sizeof(*out));
+  for (k = 0; k < n; k++, newRe = re + re*dre - im*dim, newIm = im + re*dim + im*dre, re = newRe, im = newIm) {
+    COMPLEX16 d = dtilde[k];
+    REAL8 sigmasq = psd[k]*deltaT*deltaT;
+    COMPLEX16 template = (Fplus*hptilde[k] + Fcross*hctilde[k]) * (re + I*im);
+    if (cal) template = template*cal[k];
+    COMPLEX16 diff = d - template;
+    COMPLEX16 dhstar = TwoDeltaToverN*d*conj(template)/sigmasq;
+    out->dd += TwoDeltaToverN*(creal(d)*creal(d) + cimag(d)*cimag(d))/sigmasq;
+    out->hh += TwoDeltaToverN*(creal(template)*creal(template) + cimag(template)*cimag(template))/sigmasq;
+    out->rr += TwoDeltaToverN*(creal(diff)*creal(diff) + cimag(diff)*cimag(diff))/sigmasq;
+    out->dh += dhstar;
+    if (dh_tilde) dh_tilde[k] += dhstar;
+  }
+}
+
+static int compare(UINT4 lower, UINT4 n, int use_cal)
+{
+  const REAL8 deltaT = 1.0/4096.0, Fplus = 0.43, Fcross = -0.71, dphi = LAL_TWOPI*0.0123*0.25;
+  const REAL8 TwoDeltaToverN = 2.0*deltaT/(2.0*(lower + n));
+  COMPLEX16 *dtilde = XLALMalloc((n + 1)*sizeof(*dtilde));
+  COMPLEX16 *hptilde = XLALMalloc((n + 1)*sizeof(*hptilde));
+  COMPLEX16 *hctilde = XLALMalloc((n + 1)*sizeof(*hctilde));
+  COMPLEX16 *cal = XLALMalloc((n + 1)*sizeof(*cal));
+  COMPLEX16 *dh = XLALCalloc(n + 1, sizeof(*dh));
+  COMPLEX16 *dhref = XLALCalloc(n + 1, sizeof(*dhref));
+  REAL8 *psd = XLALMalloc((n + 1)*sizeof(*psd));
+  FDInnerProducts ip, ref;
+  REAL8 diff, maxdh = 0.0, scale = 0.0;
+  int errors = 0;
+  UINT4 k;
+
+  if (!dtilde || !hptilde || !hctilde || !cal || !dh || !dhref || !psd) {
+    fprintf(stderr, "FAIL: out of memory\n");
+    return 1;
+  }
+
+  /* an inspiral-like template and data holding part of it plus "noise" */
+  for (k = 0; k < n; k++) {
+    REAL8 f = 20.0 + 0.25*(lower + k);
+    COMPLEX16 h = pow(f, -7.0/6.0)*cexp(-I*(3.0e3*pow(f, -5.0/3.0) + 0.01*f));
+    hptilde[k] = h;
+    hctilde[k] = -I*0.8*h;
+    psd[k] = 1e-46*(1.0 + pow(40.0/f, 4.0) + f*f/1e5);
+    dtilde[k] = 0.6*h + 1e-23*deltaT*(sin(1.7*k) + I*cos(2.3*k + 0.4));
+    cal[k] = (1.0 + 0.05*sin(0.01*k))*cexp(I*0.02*cos(0.003*k));
+  }
+
+  if (fd_inner_products(&ip, dtilde, hptilde, hctilde, psd, use_cal ? cal : NULL, Fplus, Fcross, dphi, lower, n,
+                        deltaT, TwoDeltaToverN, dh) != XLAL_SUCCESS) {
+    fprintf(stderr, "FAIL: fd_inner_products() failed for %u bins from %u\n", n, lower);
+    errors++;
+  }
+  per_bin_inner_products(&ref, dtilde, hptilde, hctilde, psd, use_cal ? cal : NULL, Fplus, Fcross, dphi, lower, n,
+                         deltaT, TwoDeltaToverN, dhref);
+
+  /* <d|d>, <h|h> and <d-h|d-h> relative to themselves, <d|h> and its
+   * terms relative to sqrt(<d|d><h|h>) */
+  if (n > 0) {
+    diff = fmax(fabs(ip.dd - ref.dd)/ref.dd, fabs(ip.hh - ref.hh)/ref.hh);
+    diff = fmax(diff, fabs(ip.rr - ref.rr)/ref.rr);
+    scale = sqrt(ref.dd*ref.hh);
+    diff = fmax(diff, cabs(ip.dh - ref.dh)/scale);
+    for (k = 0; k < n; k++) {
+      maxdh = fmax(maxdh, cabs(dh[k] - dhref[k]));
+      scale = fmax(scale, cabs(dhref[k]));
+    }
+    diff = fmax(diff, maxdh/scale);
+  }
+  else if (ip.dd != 0.0 || ip.hh != 0.0 || ip.rr != 0.0 || ip.dh != 0.0) {
+    diff = INFINITY;
+  }
+  else {
+    diff = 0.0;
+  }
+
+  printf("%u bins from %u%s: largest relative difference %g\n", n, lower, use_cal ? " with calibration" : "", diff);
+  if (!(diff <= TOLERANCE)) {
+    fprintf(stderr, "FAIL: fused inner products of %u bins from %u%s differ from the per-bin loop by %g\n",
+            n, lower, use_cal ? " with calibration" : "", diff);
+    errors++;
+  }
+
+  XLALFree(dtilde);
+  XLALFree(hptilde);
+  XLALFree(hctilde);
+  XLALFree(cal);
+  XLALFree(dh);
+  XLALFree(dhref);
+  XLALFree(psd);
+  return errors;
+}
+
+int main(void)
+{
+  /* empty, shorter than a block, whole blocks, a partial last block, and
+   * enough blocks to be shared between threads */
+  const UINT4 sizes[] = {0, 1, 37, FD_BLOCK_SIZE, 3*FD_BLOCK_SIZE, 3*FD_BLOCK_SIZE + 5, FD_PARALLEL_MIN_BLOCKS*FD_BLOCK_SIZE + 17};
+  int errors = 0;
+  UINT4 i;
+  int use_cal;
+
+  for (i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    for (use_cal = 0; use_cal < 2; use_cal++)
+      errors += compare(80, sizes[i], use_cal);
+
+  if (errors) {
+    fprintf(stderr, "FAIL: fused inner products differ from the per-bin loop\n");
+    return 1;
+  }
+
+  LALCheckMemoryLeaks();
+  printf("PASS: fused inner products agree with the per-bin loop\n");
+  return 0;
+}
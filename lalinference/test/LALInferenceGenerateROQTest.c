@@ -2,9 +2,11 @@
 #include <lal/LALConstants.h>
 #include <lal/XLALGSL.h>
 #include <gsl/gsl_randist.h>
+#include <gsl/gsl_spline.h>
 
 #include <time.h>
 #include <math.h>
+#include <string.h>
 
 /* check whether to include omp.h for use of multiple cores */
 #ifdef HAVE_OPENMP
@@ -22,6 +24,13 @@
 /* tolerance allow for fractional percentage log likelihood difference */
 #define LTOL 0.1
 
+/* sizes of the time-shifted ROQ weight test */
+#define NTIMESTEPS 37
+#define NBASISTS 23
+
+/* relative tolerance between the tabulated and spline-interpolated <d|h> */
+#define TSTOL 1e-12
+
 /* simple inspiral phase model */
 double calc_phase(double frequency, double Mchirp);
 
@@ -31,6 +40,9 @@ double real_model(double frequency, double Mchirp, double modperiod);
 /* model for a complex frequency domain inspiral-like signal */
 COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod);
 
+/* compare LALInferenceROQTimeShiftedDotProduct() with cspline interpolation of each weight */
+int test_time_shifted_dot_product(void);
+
 double calc_phase(double frequency, double Mchirp){
   return (-0.25*LAL_PI + ( 3./( 128. * pow(Mchirp*LAL_MTSUN_SI*LAL_PI*frequency, 5./3.) ) ) );
 }
@@ -43,6 +55,78 @@ COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod){
   return ( pow(frequency, -7./6.) * pow(Mchirp*LAL_MTSUN_SI,5./6.) * cexp(I*calc_phase(frequency,Mchirp)) )*sin(LAL_TWOPI*frequency/modperiod);
 }
 
+int test_time_shifted_dot_product(void){
+  REAL8 tcs[NTIMESTEPS], re[NTIMESTEPS], im[NTIMESTEPS];
+  COMPLEX16 weights[NBASISTS*NTIMESTEPS], hplus[NBASISTS], hcross[NBASISTS], calfactor[NBASISTS];
+  REAL8 wre[NBASISTS], wim[NBASISTS];
+  const REAL8 fplus = 0.37, fcross = -0.81;
+  LALInferenceROQData roq;
+  REAL8 maxdiff = 0.;
+  UINT4 i, k, n, failed = 0;
+
+  /* unevenly spaced time shifts, and smooth but distinct weights */
+  for ( k = 0; k < NTIMESTEPS; k++ ){
+    tcs[k] = -0.1 + 0.2*k/(NTIMESTEPS-1.) + 1e-3*sin(3.*k);
+  }
+  for ( i = 0; i < NBASISTS; i++ ){
+    for ( k = 0; k < NTIMESTEPS; k++ ){
+      weights[i*NTIMESTEPS + k] = cexp(I*(40.*(i+1.)*tcs[k] + 0.3*i)) * (1. + 0.1*i);
+    }
+    hplus[i] = cos(0.7*i) + I*sin(1.3*i);
+    hcross[i] = 0.5*sin(0.4*i) - I*cos(0.9*i);
+    calfactor[i] = 1. + 0.05*cos(0.2*i) + 0.02*I*sin(0.5*i);
+  }
+
+  memset( &roq, 0, sizeof(roq) );
+  if ( LALInferenceROQLinearWeightsInit(&roq, tcs, weights, NTIMESTEPS, NBASISTS) != XLAL_SUCCESS ){
+    fprintf(stderr, "Error... could not tabulate the linear weights\n");
+    return 1;
+  }
+
+  /* weights interpolated one basis element at a time, as the likelihood used to */
+  gsl_spline *splre[NBASISTS], *splim[NBASISTS];
+  for ( i = 0; i < NBASISTS; i++ ){
+    for ( k = 0; k < NTIMESTEPS; k++ ){
+      re[k] = creal(weights[i*NTIMESTEPS + k]);
+      im[k] = cimag(weights[i*NTIMESTEPS + k]);
+    }
+    splre[i] = gsl_spline_alloc(gsl_interp_cspline, NTIMESTEPS);
+    splim[i] = gsl_spline_alloc(gsl_interp_cspline, NTIMESTEPS);
+    gsl_spline_init(splre[i], tcs, re, NTIMESTEPS);
+    gsl_spline_init(splim[i], tcs, im, NTIMESTEPS);
+  }
+
+  /* time shifts between and on the knots, including both end points */
+  for ( n = 0; n <= 4*(NTIMESTEPS-1); n++ ){
+    REAL8 t = n % 4 ? tcs[n/4] + 0.25*(n % 4)*(tcs[n/4+1] - tcs[n/4]) : tcs[n/4];
+    COMPLEX16 ref = 0., refcal = 0., dh, dhcal;
+
+    for ( i = 0; i < NBASISTS; i++ ){
+      wre[i] = gsl_spline_eval(splre[i], t, NULL);
+      wim[i] = gsl_spline_eval(splim[i], t, NULL);
+      COMPLEX16 h = fplus*hplus[i] + fcross*hcross[i];
+      ref += (wre[i] + I*wim[i])*conj(h);
+      refcal += (wre[i] + I*wim[i])*conj(calfactor[i]*h);
+    }
+
+    dh = LALInferenceROQTimeShiftedDotProduct(&roq, t, hplus, hcross, fplus, fcross, NULL);
+    dhcal = LALInferenceROQTimeShiftedDotProduct(&roq, t, hplus, hcross, fplus, fcross, calfactor);
+    if ( !(cabs(dh - ref) <= TSTOL*cabs(ref)) || !(cabs(dhcal - refcal) <= TSTOL*cabs(refcal)) ){ failed++; }
+    maxdiff = fmax(maxdiff, cabs(dh - ref)/cabs(ref));
+    maxdiff = fmax(maxdiff, cabs(dhcal - refcal)/cabs(refcal));
+  }
+
+  for ( i = 0; i < NBASISTS; i++ ){
+    gsl_spline_free(splre[i]);
+    gsl_spline_free(splim[i]);
+  }
+  LALInferenceROQLinearWeightsFree(&roq);
+
+  fprintf(stderr, "Time-shifted <d|h>:\n - Largest fractional difference from spline interpolation = %le\n", maxdiff);
+
+  return failed ? 1 : 0;
+}
+
 int main(void) {
   REAL8Array *TS = NULL, *TSquad = NULL, *cTSquad = NULL;  /* the training set of real waveforms (and quadratic model) */
   COMPLEX16Array *cTS = NULL;              /* the training set of complex waveforms */
@@ -331,6 +415,9 @@ int main(void) {
   /* check log likelihood difference is within tolerance */
   if ( Lfrac > LTOL ) { return 1; }
 
+  /* check the tabulated time-shift dependence of the linear weights */
+  if ( test_time_shifted_dot_product() ) { return 1; }
+
   LALCheckMemoryLeaks();
 
   return 0;
@@ -113,6 +113,64 @@ int main(int argc, char **argv)
   /* Close file. */
   XLALH5FileClose(file);
 
+  /* Stream samples into a table in three batches, reopening the file for
+   * appending between batches as a checkpointing sampler does. */
+  for (UINT4 batch = 0; batch < 3; batch ++)
+  {
+    file = XLALH5FileOpen("test_append.hdf5", batch ? "a" : "w");
+    group = XLALH5GroupOpen(file, "lalinference/lalinference_mcmc");
+    LALInferenceVariables vars = {NULL, 0, NULL};
+    LALInferenceAddREAL8Variable(&vars, "abc", 0, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddREAL8Variable(&vars, "ghi", 5, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddINT4Variable (&vars, "lmn", 0, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceH5TableWriter *writer = LALInferenceH5TableWriterOpen(
+      group, LALInferenceHDF5PosteriorSamplesDatasetName, &vars, 16, 1);
+    gsl_test_int(writer->Nwritten, 40 * batch,
+      "number of rows found when reopening table");
+    for (UINT4 i = 40 * batch; i < 40 * (batch + 1); i ++)
+    {
+      REAL8 abc = i;
+      INT4 lmn = i;
+      LALInferenceSetVariable(&vars, "abc", &abc);
+      LALInferenceSetVariable(&vars, "lmn", &lmn);
+      LALInferenceH5TableWriterAppend(writer, &vars);
+    }
+    gsl_test_int(writer->Nbuffered, 8, "number of rows left in buffer");
+    LALInferenceH5TableWriterClose(writer);
+    LALInferenceClearVariables(&vars);
+    XLALH5FileClose(group);
+    XLALH5FileClose(file);
+  }
+
+  /* Read the streamed table back. */
+  file = XLALH5FileOpen("test_append.hdf5", "r");
+  dataset = XLALH5DatasetRead(
+    file, "lalinference/lalinference_mcmc/posterior_samples");
+  N = 0;
+  vars_array = NULL;
+  LALInferenceH5DatasetToVariablesArray(dataset, &vars_array, &N);
+
+  gsl_test_int(N, 120, "number of rows appended");
+  for (UINT4 i = 0; i < N; i ++)
+  {
+    LALInferenceVariables *vars = vars_array[i];
+    gsl_test_int(LALInferenceGetVariableDimension(vars), 3,
+      "number of columns appended");
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars, "abc"), i, 0,
+      "value of appended column abc");
+    gsl_test_abs(LALInferenceGetREAL8Variable(vars, "ghi"), 5, 0,
+      "value of appended column ghi");
+    gsl_test_int(LALInferenceGetINT4Variable (vars, "lmn"), i,
+      "value of appended column lmn");
+    gsl_test_int(LALInferenceGetVariableVaryType(vars, "lmn"),
+      LALINFERENCE_PARAM_OUTPUT, "vary type of appended column lmn");
+    LALInferenceClearVariables(vars);
+    XLALFree(vars);
+  }
+  XLALFree(vars_array);
+  XLALH5DatasetFree(dataset);
+  XLALH5FileClose(file);
+
   /* Check for memory leaks. */
   LALCheckMemoryLeaks();
 
@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
 #include <lal/FrequencySeries.h>
@@ -37,6 +38,9 @@
 #include <lal/LALInferenceLikelihood.h>
 #include <lal/LALInferenceTemplate.h>
 #include <lal/LALInferencePrior.h>
+#include <lal/LALInferenceKDE.h>
+#include <lal/LALSimNeutronStar.h>
+#include <lal/distance_integrator.h>
 
 #include "LALInferenceTest.h"
 
@@ -59,6 +63,27 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceSplineCalibration tests */
+int LALInferenceSplineCalibrationTEST(void);
+
+/*  LALInferenceRunningCovariance tests */
+int LALInferenceRunningCovarianceTEST(void);
+
+/*  LALInferenceKDE tests */
+int LALInferenceKDETEST(void);
+
+/*  LALInferenceMarginalTime tests */
+int LALInferenceMarginalTimeTEST(void);
+
+/*  Neutron star family cache tests */
+int LALInferenceNSFamilyCacheTEST(void);
+
+/*  Distance marginalisation table tests */
+int LALInferenceMarginalDistanceTEST(void);
+
+/*  LALInferenceCopyVariables tests */
+int LALInferenceCopyVariablesTEST(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -77,6 +102,20 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceSplineCalibrationTEST();
+	printf("\n");
+	failureCount += LALInferenceRunningCovarianceTEST();
+	printf("\n");
+	failureCount += LALInferenceKDETEST();
+	printf("\n");
+	failureCount += LALInferenceMarginalTimeTEST();
+	printf("\n");
+	failureCount += LALInferenceNSFamilyCacheTEST();
+	printf("\n");
+	failureCount += LALInferenceMarginalDistanceTEST();
+	printf("\n");
+	failureCount += LALInferenceCopyVariablesTEST();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -357,6 +396,476 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 }
 
 
+/*****************     TEST CODE for LALInferenceSplineCalibration     *****************/
+/* Test that the precomputed spline calibration agrees with LALInferenceSplineCalibrationFactor,
+   and that repeated evaluations with the same node values reuse the result. */
+
+int LALInferenceSplineCalibrationTEST(void){
+
+    TEST_HEADER();
+
+    UINT4 i, npts = 10, length = 8193;
+    REAL8 deltaF = 0.25, maxdiff = 0.0;
+    LIGOTimeGPS epoch = {0,0};
+
+    REAL8Vector *logfreqs = XLALCreateREAL8Vector(npts);
+    REAL8Vector *amps = XLALCreateREAL8Vector(npts);
+    REAL8Vector *phases = XLALCreateREAL8Vector(npts);
+    for (i=0; i<npts; i++) {
+        logfreqs->data[i] = log(20.0) + i*(log(1800.0) - log(20.0))/(npts - 1);
+        amps->data[i] = 0.1*sin(3.0*i + 1.0);
+        phases->data[i] = 0.05*cos(2.0*i);
+    }
+
+    COMPLEX16FrequencySeries *calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &epoch, 0, deltaF, &lalDimensionlessUnit, length);
+    LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+
+    LALInferenceSplineCalibration *cal = LALInferenceCreateSplineCalibrationFD(logfreqs, deltaF, length);
+    if (cal == NULL) {
+        TEST_FAIL("Could not create spline calibration");
+    }
+    else {
+        const COMPLEX16Vector *factor = LALInferenceSplineCalibrationEval(cal, amps, phases);
+        for (i=0; i<length; i++)
+            maxdiff = fmax(maxdiff, cabs(factor->data[i] - calFactor->data->data[i]));
+        if (maxdiff > 1e-12)
+            TEST_FAIL("Calibration factors differ by %g", maxdiff);
+        if (!LALInferenceSplineCalibrationMatches(cal, logfreqs, length) || LALInferenceSplineCalibrationMatches(cal, logfreqs, length + 1))
+            TEST_FAIL("Spline calibration does not match its own nodes");
+
+        /* A changed node value must be picked up */
+        amps->data[3] += 0.01;
+        factor = LALInferenceSplineCalibrationEval(cal, amps, phases);
+        LALInferenceSplineCalibrationFactor(logfreqs, amps, phases, calFactor);
+        maxdiff = 0.0;
+        for (i=0; i<length; i++)
+            maxdiff = fmax(maxdiff, cabs(factor->data[i] - calFactor->data->data[i]));
+        if (maxdiff > 1e-12)
+            TEST_FAIL("Calibration factors differ by %g after changing a node", maxdiff);
+    }
+
+    LALInferenceDestroySplineCalibration(cal);
+    XLALDestroyCOMPLEX16FrequencySeries(calFactor);
+    XLALDestroyREAL8Vector(logfreqs);
+    XLALDestroyREAL8Vector(amps);
+    XLALDestroyREAL8Vector(phases);
+
+    TEST_FOOTER();
+
+}
+
+/* Fill point with a draw from a correlated distribution of a linear
+   parameter x, a parameter y correlated with it and an angle phi
+   scattered about zero, so wrapping around 2 pi */
+static void RunningCovariancePoint(gsl_rng *rng, LALInferenceVariables *point){
+    REAL8 z0 = gsl_ran_gaussian(rng, 1.0), z1 = gsl_ran_gaussian(rng, 1.0);
+    REAL8 x = 10.0 + z0, y = 0.5*z0 + 0.1*z1, phi = fmod(0.3*z1 + LAL_TWOPI, LAL_TWOPI);
+    LALInferenceAddVariable(point, "x", &x, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddVariable(point, "y", &y, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddVariable(point, "phi", &phi, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_CIRCULAR);
+}
+
+int LALInferenceRunningCovarianceTEST(void){
+
+    TEST_HEADER();
+
+    UINT4 i, j, k, npts = 500;
+    REAL8 fixed = 1.0, maxdiff = 0.0;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 1234);
+
+    LALInferenceVariables **points = XLALCalloc(npts, sizeof(LALInferenceVariables *));
+    for (i=0; i<npts; i++) {
+        points[i] = XLALCalloc(1, sizeof(LALInferenceVariables));
+        LALInferenceAddVariable(points[i], "fixed", &fixed, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_FIXED);
+        RunningCovariancePoint(rng, points[i]);
+    }
+
+    LALInferenceRunningCovariance *cov = LALInferenceCreateRunningCovariance(points, npts);
+    if (cov == NULL || cov->dim != 3) {
+        TEST_FAIL("Could not create running covariance of 3 parameters");
+    }
+    else {
+        gsl_matrix *updated = gsl_matrix_alloc(3, 3), *exact = gsl_matrix_alloc(3, 3);
+        if (LALInferenceRunningCovarianceDrift(cov) != 0.0)
+            TEST_FAIL("Covariance has drifted before any update");
+
+        /* Replace the points one at a time, as the nested sampler does */
+        for (k=0; k<5*npts; k++) {
+            i = gsl_rng_uniform_int(rng, npts);
+            LALInferenceRunningCovarianceRemove(cov, points[i]);
+            LALInferenceClearVariables(points[i]);
+            RunningCovariancePoint(rng, points[i]);
+            LALInferenceRunningCovarianceAdd(cov, points[i]);
+        }
+        LALInferenceRunningCovarianceMatrix(cov, updated);
+        LALInferenceRunningCovarianceRecompute(cov, points, npts);
+        LALInferenceRunningCovarianceMatrix(cov, exact);
+        for (i=0; i<3; i++)
+            for (j=0; j<3; j++)
+                maxdiff = fmax(maxdiff, fabs(gsl_matrix_get(updated, i, j) - gsl_matrix_get(exact, i, j)));
+        if (maxdiff > 1e-10)
+            TEST_FAIL("Updated covariance differs from recomputed covariance by %g", maxdiff);
+
+        /* The angle wraps around 2 pi but its variance is 0.09 */
+        i = strcmp(cov->names[0], "phi") == 0 ? 0 : (strcmp(cov->names[1], "phi") == 0 ? 1 : 2);
+        if (fabs(gsl_matrix_get(exact, i, i) - 0.09) > 0.02)
+            TEST_FAIL("Variance of circular parameter is %g", gsl_matrix_get(exact, i, i));
+
+        /* The eigenvectors are those of the covariance when last computed */
+        if (LALInferenceRunningCovarianceDrift(cov) <= 0.0)
+            TEST_FAIL("Covariance has not drifted after updates");
+        LALInferenceRunningCovarianceEigen(cov);
+        if (LALInferenceRunningCovarianceDrift(cov) != 0.0)
+            TEST_FAIL("Covariance has drifted after computing eigenvectors");
+        for (k=0; k<3; k++) {
+            REAL8 resid = 0.0;
+            for (i=0; i<3; i++) {
+                REAL8 Av = 0.0;
+                for (j=0; j<3; j++)
+                    Av += gsl_matrix_get(exact, i, j) * gsl_matrix_get(cov->eigenvectors, j, k);
+                resid = fmax(resid, fabs(Av - cov->eigenvalues->data[k] * gsl_matrix_get(cov->eigenvectors, i, k)));
+            }
+            if (resid > 1e-10)
+                TEST_FAIL("Eigenvector %u has residual %g", k, resid);
+        }
+
+        gsl_matrix_free(updated);
+        gsl_matrix_free(exact);
+    }
+
+    LALInferenceDestroyRunningCovariance(cov);
+    for (i=0; i<npts; i++) {
+        LALInferenceClearVariables(points[i]);
+        XLALFree(points[i]);
+    }
+    XLALFree(points);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+int LALInferenceKDETEST(void){
+
+    TEST_HEADER();
+
+    INT4 i, j, p, q, dim = 3, npts = 2000;
+    REAL8 maxdiff = 0.0;
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 4321);
+
+    /* Two correlated clusters */
+    REAL8 *pts = XLALMalloc(npts * dim * sizeof(REAL8));
+    for (i = 0; i < npts; i++) {
+        REAL8 z0 = gsl_ran_gaussian(rng, 1.0), z1 = gsl_ran_gaussian(rng, 1.0);
+        pts[i*dim] = z0 + (i % 2 ? 6.0 : 0.0);
+        pts[i*dim + 1] = 0.8*z0 + 0.2*z1;
+        pts[i*dim + 2] = 50.0 + 5.0*gsl_ran_gaussian(rng, 1.0);
+    }
+
+    LALInferenceKDE *kde = LALInferenceNewKDE(pts, npts, dim, NULL);
+
+    /* Compare with the sum over all kernels, inverting the kernel covariance */
+    gsl_matrix *inv = gsl_matrix_alloc(dim, dim);
+    gsl_matrix_memcpy(inv, kde->cholesky_decomp_cov);
+    gsl_linalg_cholesky_invert(inv);
+    REAL8 *energies = XLALMalloc(npts * sizeof(REAL8));
+    for (q = 0; q < 20; q++) {
+        REAL8 point[3];
+        INT4 k = gsl_rng_uniform_int(rng, npts);
+        for (p = 0; p < dim; p++)
+            point[p] = pts[k*dim + p] + (q < 10 ? 0.1 : 3.0)*gsl_ran_gaussian(rng, 1.0);
+
+        for (j = 0; j < npts; j++) {
+            REAL8 energy = 0.;
+            for (p = 0; p < dim; p++)
+                for (k = 0; k < dim; k++)
+                    energy += (pts[j*dim + p] - point[p]) * gsl_matrix_get(inv, p, k) * (pts[j*dim + k] - point[k]);
+            energies[j] = -energy/2.;
+        }
+        REAL8 expected = log_add_exps(energies, npts) - kde->log_norm_factor;
+        REAL8 result = LALInferenceKDEEvaluatePoint(kde, point);
+        maxdiff = fmax(maxdiff, fabs(result - expected));
+    }
+    if (maxdiff > 1e-8)
+        TEST_FAIL("KDE differs from the sum over all kernels by %g", maxdiff);
+
+    XLALFree(energies);
+    gsl_matrix_free(inv);
+    LALInferenceDestroyKDE(kde);
+    XLALFree(pts);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+int LALInferenceMarginalTimeTEST(void){
+
+    TEST_HEADER();
+
+    UINT4 j, k, w, freqLength = 2049, N = 2*(freqLength-1);
+    /* windows [istart, istart+n), including one wrapping the blocks and the whole series */
+    const UINT4 windows[][2] = {{100, 50}, {3000, 600}, {4000, 96}, {0, 4096}, {17, 1}};
+    gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, 2468);
+
+    /* Reference quadratures from complex->real FFTs of the spectrum and of -i times it */
+    COMPLEX16Vector *X = XLALCreateCOMPLEX16Vector(freqLength);
+    COMPLEX16Vector *Y = XLALCreateCOMPLEX16Vector(freqLength);
+    REAL8Vector *x = XLALCreateREAL8Vector(N);
+    REAL8Vector *y = XLALCreateREAL8Vector(N);
+    REAL8FFTPlan *plan = XLALCreateReverseREAL8FFTPlan(N, 0);
+    X->data[0] = 0.0;
+    for (k = 1; k < freqLength; k++)
+        X->data[k] = crect(gsl_ran_gaussian(rng, 1.0), gsl_ran_gaussian(rng, 1.0));
+    for (k = 0; k < freqLength; k++)
+        Y->data[k] = -I*X->data[k];
+    XLALREAL8ReverseFFT(x, X, plan);
+    XLALREAL8ReverseFFT(y, Y, plan);
+
+    for (w = 0; w < sizeof(windows)/sizeof(windows[0]); w++) {
+        UINT4 istart = windows[w][0], n = windows[w][1];
+        for (int margphi = 0; margphi < 2; margphi++) {
+            LALInferenceMarginalTime *mt = LALInferenceCreateMarginalTime(freqLength, istart, n, margphi);
+            REAL8 *dh = NULL, *dh_phase = NULL, maxdiff = 0.0;
+            if (!mt) {
+                TEST_FAIL("Could not create workspace for window %u+%u", istart, n);
+                continue;
+            }
+            /* evaluate twice to check that the workspace is reused cleanly */
+            for (int rep = 0; rep < 2; rep++) {
+                COMPLEX16 *spectrum = LALInferenceMarginalTimeResetSpectrum(mt);
+                for (k = 0; k < freqLength; k++)
+                    spectrum[k] += X->data[k];
+                if (LALInferenceMarginalTimeTransform(mt, &dh, &dh_phase) != XLAL_SUCCESS)
+                    TEST_FAIL("Transform failed for window %u+%u", istart, n);
+            }
+            if (margphi != (dh_phase != NULL))
+                TEST_FAIL("Phase quadrature should %sbe computed", margphi ? "" : "not ");
+            for (j = 0; j < n; j++) {
+                maxdiff = fmax(maxdiff, fabs(dh[j] - x->data[istart+j]));
+                if (dh_phase)
+                    maxdiff = fmax(maxdiff, fabs(dh_phase[j] - y->data[istart+j]));
+            }
+            if (maxdiff > 1e-9)
+                TEST_FAIL("Window %u+%u (margphi %d) differs from the full FFT by %g", istart, n, margphi, maxdiff);
+            LALInferenceDestroyMarginalTime(mt);
+        }
+    }
+
+    XLALDestroyREAL8FFTPlan(plan);
+    XLALDestroyREAL8Vector(y);
+    XLALDestroyREAL8Vector(x);
+    XLALDestroyCOMPLEX16Vector(Y);
+    XLALDestroyCOMPLEX16Vector(X);
+    gsl_rng_free(rng);
+
+    TEST_FOOTER();
+
+}
+
+
+/*****************     TEST CODE for the neutron star family cache     *****************/
+/* Test that families built from cached tables give the same radii, Love numbers
+   and tidal deformabilities as freshly computed families, both through the
+   LALSimulation cache and through the cache shared by LALInference. */
+
+int LALInferenceNSFamilyCacheTEST(void){
+
+    TEST_HEADER();
+
+    /* 4-piece polytrope close to SLy, in the units of LALInference */
+    const REAL8 logp1 = 34.384, gamma1 = 3.005, gamma2 = 2.988, gamma3 = 2.851;
+    const REAL8 masses[] = {1.25, 1.35};
+    const double key[] = {0., logp1 - 1.0, gamma1, gamma2, gamma3};
+    REAL8 lambda[2], lambda1, lambda2;
+    size_t hits = 0, misses = 0;
+    UINT4 i, rep;
+
+    LALSimNeutronStarEOS *eos = XLALSimNeutronStarEOS4ParameterPiecewisePolytrope(logp1 - 1.0, gamma1, gamma2, gamma3);
+    LALSimNeutronStarFamily *fresh = XLALCreateSimNeutronStarFamily(eos);
+    LALSimNeutronStarFamilyCache *cache = XLALCreateSimNeutronStarFamilyCache(4);
+    if (!eos || !fresh || !cache) {
+        TEST_FAIL("Could not create neutron star family and cache");
+        XLALDestroySimNeutronStarFamilyCache(cache);
+        XLALDestroySimNeutronStarFamily(fresh);
+        XLALDestroySimNeutronStarEOS(eos);
+        TEST_FOOTER();
+    }
+
+    for (i = 0; i < 2; i++) {
+        REAL8 r = XLALSimNeutronStarRadius(masses[i]*LAL_MSUN_SI, fresh);
+        REAL8 k2 = XLALSimNeutronStarLoveNumberK2(masses[i]*LAL_MSUN_SI, fresh);
+        lambda[i] = (2.0/3.0) * k2 / pow(masses[i] * LAL_MRSUN_SI / r, 5.0);
+    }
+
+    /* the first request solves and stores the family, the second rebuilds it from the tables */
+    for (rep = 0; rep < 2; rep++) {
+        LALSimNeutronStarFamily *fam = XLALCreateSimNeutronStarFamilyCached(cache, key, sizeof(key)/sizeof(key[0]), eos);
+        if (!fam) {
+            TEST_FAIL("Could not create cached family");
+            continue;
+        }
+        if (XLALSimNeutronStarMaximumMass(fam) != XLALSimNeutronStarMaximumMass(fresh))
+            TEST_FAIL("Maximum mass of cached family differs from fresh family");
+        for (i = 0; i < 2; i++) {
+            REAL8 m = masses[i]*LAL_MSUN_SI;
+            if (XLALSimNeutronStarRadius(m, fam) != XLALSimNeutronStarRadius(m, fresh)
+                || XLALSimNeutronStarLoveNumberK2(m, fam) != XLALSimNeutronStarLoveNumberK2(m, fresh))
+                TEST_FAIL("Radius or Love number of a %g Msun star differs between cached and fresh families", masses[i]);
+        }
+        XLALDestroySimNeutronStarFamily(fam);
+    }
+    XLALSimNeutronStarFamilyCacheStats(&hits, &misses, cache);
+    if (hits != 1 || misses != 1)
+        TEST_FAIL("Expected 1 cache hit and 1 miss, got %zu and %zu", hits, misses);
+
+    /* the LALInference cache, before and after it is freed and recreated */
+    for (rep = 0; rep < 3; rep++) {
+        if (rep == 2)
+            LALInferenceDestroyNSFamilyCache();
+        LALInferenceLogp1GammasMasses2Lambdas(logp1, gamma1, gamma2, gamma3, masses[0], masses[1], &lambda1, &lambda2);
+        if (lambda1 != lambda[0] || lambda2 != lambda[1])
+            TEST_FAIL("Tidal deformabilities (%g, %g) differ from those of a fresh family (%g, %g)", lambda1, lambda2, lambda[0], lambda[1]);
+    }
+    LALInferenceDestroyNSFamilyCache();
+
+    XLALDestroySimNeutronStarFamilyCache(cache);
+    XLALDestroySimNeutronStarFamily(fresh);
+    XLALDestroySimNeutronStarEOS(eos);
+
+    TEST_FOOTER();
+
+}
+
+/*****************     TEST CODE for LALInferenceMarginalDistance     *****************/
+/* Test that the scalar and batch evaluations of the distance marginalisation table
+   agree with a log_radial_integrator built with the same settings, and that entries
+   outside the table are rejected by the scalar form and set to -INFINITY by the batch. */
+
+int LALInferenceMarginalDistanceTEST(void){
+
+    TEST_HEADER();
+
+    /* settings used by LALInferenceCreateMarginalDistance() for the phase-marginalised likelihood */
+    const double dist_min = 10.0, dist_max = 1000.0, pmax = 100000;
+    const size_t size = 2000;
+    const int cosmology = 0, margphi = 1;
+    /* optimal SNR and <d|h> at 1 Mpc; the last three entries are outside the table */
+    const double snr[] = {50.0, 800.0, 3000.0, 12000.0, 90000.0, 3000.0, 2.0*pmax, NAN, 3000.0};
+    const double dh[] = {100.0, 1.0e5, 4.0e6, 1.0e8, 5.0e9, 0.0, 1.0e6, 1.0e6, NAN};
+    const size_t n = sizeof(snr)/sizeof(snr[0]), nin = n - 3;
+    double batch[sizeof(snr)/sizeof(snr[0])], inplace[sizeof(snr)/sizeof(snr[0])];
+    size_t i;
+
+    LALInferenceMarginalDistance *md = LALInferenceCreateMarginalDistance(dist_min, dist_max, cosmology, margphi);
+    log_radial_integrator *integrator = log_radial_integrator_init(dist_min, dist_max, 2, cosmology, pmax, size, !margphi);
+    if (!md || !integrator) {
+        TEST_FAIL("Could not create distance marginalisation tables");
+        LALInferenceDestroyMarginalDistance(md);
+        if (integrator) log_radial_integrator_free(integrator);
+        TEST_FOOTER();
+    }
+    const double log_norm = log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY);
+
+    if (LALInferenceMarginalDistanceEvalBatch(md, snr, dh, batch, n) != XLAL_SUCCESS)
+        TEST_FAIL("Batch evaluation failed");
+    memcpy(inplace, dh, sizeof(inplace));
+    if (LALInferenceMarginalDistanceEvalBatch(md, snr, inplace, inplace, n) != XLAL_SUCCESS)
+        TEST_FAIL("In-place batch evaluation failed");
+
+    for (i = 0; i < n; i++) {
+        int errnum;
+        double scalar;
+        XLAL_TRY(scalar = LALInferenceMarginalDistanceEval(md, snr[i], dh[i]), errnum);
+        if (i < nin) {
+            double expected = log_radial_integrator_eval(integrator, snr[i], dh[i], log(snr[i]), log(dh[i])) - log_norm;
+            if (errnum != XLAL_SUCCESS || !isfinite(scalar)) {
+                TEST_FAIL("Scalar evaluation failed for SNR %g, <d|h> %g", snr[i], dh[i]);
+            } else if (scalar != expected) {
+                TEST_FAIL("Scalar evaluation %.17g differs from integrator %.17g for SNR %g, <d|h> %g", scalar, expected, snr[i], dh[i]);
+            }
+            if (batch[i] != scalar || inplace[i] != scalar)
+                TEST_FAIL("Batch evaluation %.17g (in place %.17g) differs from scalar %.17g for SNR %g, <d|h> %g", batch[i], inplace[i], scalar, snr[i], dh[i]);
+        } else {
+            if (errnum != XLAL_ERANGE)
+                TEST_FAIL("Scalar evaluation should fail with XLAL_ERANGE for SNR %g, <d|h> %g, got error %d", snr[i], dh[i], errnum);
+            if (batch[i] != -INFINITY || inplace[i] != -INFINITY)
+                TEST_FAIL("Batch evaluation should give -INFINITY for SNR %g, <d|h> %g, got %g (in place %g)", snr[i], dh[i], batch[i], inplace[i]);
+        }
+    }
+
+    log_radial_integrator_free(integrator);
+    LALInferenceDestroyMarginalDistance(md);
+
+    TEST_FOOTER();
+
+}
+
+/*****************     TEST CODE for LALInferenceCopyVariables     *****************/
+/* Test that copying into variables with the same layout updates the existing items
+   in place, and that copying into a different layout rebuilds the target; both must
+   leave the target equal to the source. */
+
+int LALInferenceCopyVariablesTEST(void){
+
+    TEST_HEADER();
+
+    LALInferenceVariables source = {NULL, 0, NULL}, target = {NULL, 0, NULL};
+    REAL8 pi = LAL_PI, seven = 7.0;
+    INT4 small = 123;
+    COMPLEX16 c = crect(1.23, -3.45);
+    REAL8Vector *vec = XLALCreateREAL8Vector(3);
+    vec->data[0] = 1.0; vec->data[1] = 2.0; vec->data[2] = 3.0;
+
+    LALInferenceAddVariable(&source, "seven", &seven, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddVariable(&source, "pi", &pi, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddVariable(&source, "small", &small, LALINFERENCE_INT4_t, LALINFERENCE_PARAM_FIXED);
+    LALInferenceAddVariable(&source, "complex", &c, LALINFERENCE_COMPLEX16_t, LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddVariable(&source, "vector", &vec, LALINFERENCE_REAL8Vector_t, LALINFERENCE_PARAM_FIXED);
+    /* vec now belongs to source and is freed with it */
+
+    /* the first copy builds the target */
+    LALInferenceCopyVariables(&source, &target);
+    if (LALInferenceCompareVariables(&source, &target))
+        TEST_FAIL("Copy into empty variables differs from the source");
+
+    /* change the source and copy again: the target's items must be reused */
+    void *pi_ptr = LALInferenceGetVariable(&target, "pi");
+    void *vec_ptr = LALInferenceGetVariable(&target, "vector");
+    REAL8Vector *target_vec = *(REAL8Vector **)vec_ptr;
+    pi = 3.0; seven = 8.0; c = crect(1.23, 4.56);
+    vec->data[1] = -2.0;
+    LALInferenceSetVariable(&source, "pi", &pi);
+    LALInferenceSetVariable(&source, "seven", &seven);
+    LALInferenceSetVariable(&source, "complex", &c);
+    LALInferenceCopyVariables(&source, &target);
+    if (LALInferenceCompareVariables(&source, &target))
+        TEST_FAIL("Copy into variables with the same layout differs from the source");
+    if (pi_ptr != LALInferenceGetVariable(&target, "pi") || vec_ptr != LALInferenceGetVariable(&target, "vector"))
+        TEST_FAIL("Copy into variables with the same layout did not reuse the items");
+    if (*(REAL8Vector **)vec_ptr != target_vec || target_vec->data[1] != -2.0)
+        TEST_FAIL("Vector was not copied into the existing target vector");
+    if (LALInferenceGetREAL8Variable(&target, "pi") != 3.0 || LALInferenceGetREAL8Variable(&target, "seven") != 8.0)
+        TEST_FAIL("Values were not copied into the existing items");
+
+    /* a different layout must be rebuilt */
+    LALInferenceRemoveVariable(&source, "small");
+    LALInferenceCopyVariables(&source, &target);
+    if (LALInferenceCompareVariables(&source, &target))
+        TEST_FAIL("Copy into variables with a different layout differs from the source");
+    if (LALInferenceCheckVariable(&target, "small"))
+        TEST_FAIL("Copy into variables with a different layout kept a removed item");
+
+    LALInferenceClearVariables(&target);
+    LALInferenceClearVariables(&source);
+
+    TEST_FOOTER();
+
+}
+
 /******************************************
  * 
  * Old tests
@@ -154,11 +154,14 @@ int XLALSimIMRPhenomT(
   /* Add the modes to the polarisations using lalsim routines.
   Negative modes are explicitely passed, instead of using the symmetry flag */
 
-  SphHarmTimeSeries *hlms_temp = hlms;
-  while ( hlms_temp )
+  status = XLALSimAddModesFromSphHarmTimeSeries(hplus, hcross, hlms, inclination, LAL_PI/2. - phiRef);
+  if (status != XLAL_SUCCESS)
   {
-      XLALSimAddMode(hplus, hcross, hlms_temp->mode, inclination, LAL_PI/2. - phiRef, hlms_temp->l, hlms_temp->m, 0);
-      hlms_temp = hlms_temp->next;
+    XLALDestroyREAL8TimeSeries(hplus);
+    XLALDestroyREAL8TimeSeries(hcross);
+    XLALDestroySphHarmTimeSeries(hlms);
+    XLALDestroyDict(lalParams_aux);
+    XLAL_ERROR(XLAL_EFUNC, "Error: XLALSimAddModesFromSphHarmTimeSeries failed.");
   }
 
   /* Point the output pointers to the relevant time series */
@@ -167,7 +170,6 @@ int XLALSimIMRPhenomT(
 
   /* Destroy intermediate time series */
   XLALDestroySphHarmTimeSeries(hlms);
-  XLALDestroySphHarmTimeSeries(hlms_temp);
 
   /* Destroy lalParams_aux. */
   XLALDestroyDict(lalParams_aux);
@@ -260,11 +262,13 @@ int XLALSimIMRPhenomTHM(
   /* Add the modes to the polarisations using lalsim routines.
   Negative modes are explicitely passed, instead of using the symmetry flag */
 
-  SphHarmTimeSeries *hlms_temp = hlms;
-  while ( hlms_temp )
+  status = XLALSimAddModesFromSphHarmTimeSeries(hplus, hcross, hlms, inclination, LAL_PI/2. - phiRef);
+  if (status != XLAL_SUCCESS)
   {
-      XLALSimAddMode(hplus, hcross, hlms_temp->mode, inclination, LAL_PI/2. - phiRef, hlms_temp->l, hlms_temp->m, 0);
-      hlms_temp = hlms_temp->next;
+    XLALDestroyREAL8TimeSeries(hplus);
+    XLALDestroyREAL8TimeSeries(hcross);
+    XLALDestroySphHarmTimeSeries(hlms);
+    XLAL_ERROR(XLAL_EFUNC, "Error: XLALSimAddModesFromSphHarmTimeSeries failed.");
   }
 
   /* Point the output pointers to the relevant time series */
@@ -273,7 +277,6 @@ int XLALSimIMRPhenomTHM(
 
   /* Destroy intermediate time series */
   XLALDestroySphHarmTimeSeries(hlms);
-  XLALDestroySphHarmTimeSeries(hlms_temp);
 
   return status;
 }
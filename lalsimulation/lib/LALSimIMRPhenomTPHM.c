@@ -171,11 +171,13 @@ int XLALSimIMRPhenomTP(
   /* Add the modes to the polarisations using lalsim routines.
   Negative modes are explicitely passed, instead of using the symmetry flag */
 
-  SphHarmTimeSeries *hlms_temp = hlm;
-  while ( hlms_temp )
+  status = XLALSimAddModesFromSphHarmTimeSeries(hplus, hcross, hlm, inclination, LAL_PI/2. - phiRef);
+  if (status != XLAL_SUCCESS)
   {
-      XLALSimAddMode(hplus, hcross, hlms_temp->mode, inclination, LAL_PI/2. - phiRef, hlms_temp->l, hlms_temp->m, 0);
-      hlms_temp = hlms_temp->next;
+    XLALDestroyREAL8TimeSeries(hplus);
+    XLALDestroyREAL8TimeSeries(hcross);
+    XLALDestroySphHarmTimeSeries(hlm);
+    XLAL_ERROR(XLAL_EFUNC, "Error: XLALSimAddModesFromSphHarmTimeSeries failed.");
   }
 
   /* Point the output pointers to the relevant time series */
@@ -184,7 +186,6 @@ int XLALSimIMRPhenomTP(
 
   /* Destroy intermediate time series */
   XLALDestroySphHarmTimeSeries(hlm);
-  XLALDestroySphHarmTimeSeries(hlms_temp);
 
   return status;
 }
@@ -262,11 +263,13 @@ int XLALSimIMRPhenomTPHM(
   /* Add the modes to the polarisations using lalsim routines.
   Negative modes are explicitely passed, instead of using the symmetry flag */
 
-  SphHarmTimeSeries *hlms_temp = hlm;
-  while ( hlms_temp )
+  status = XLALSimAddModesFromSphHarmTimeSeries(hplus, hcross, hlm, inclination, LAL_PI/2. - phiRef);
+  if (status != XLAL_SUCCESS)
   {
-      XLALSimAddMode(hplus, hcross, hlms_temp->mode, inclination, LAL_PI/2. - phiRef, hlms_temp->l, hlms_temp->m, 0);
-      hlms_temp = hlms_temp->next;
+    XLALDestroyREAL8TimeSeries(hplus);
+    XLALDestroyREAL8TimeSeries(hcross);
+    XLALDestroySphHarmTimeSeries(hlm);
+    XLAL_ERROR(XLAL_EFUNC, "Error: XLALSimAddModesFromSphHarmTimeSeries failed.");
   }
 
   /* Point the output pointers to the relevant time series */
@@ -275,7 +278,6 @@ int XLALSimIMRPhenomTPHM(
 
   /* Destroy intermediate time series */
   XLALDestroySphHarmTimeSeries(hlm);
-  XLALDestroySphHarmTimeSeries(hlms_temp);
 
   return status;
 }
@@ -545,64 +545,85 @@ static bool NRSur7dq4_IsSetup(void) {
     else return false;
 }
 
-/**
- * Helper function for integer powers
+/*
+ * The fits below are sums of products of monomials in the 7 fit parameters.
+ * All monomials needed by a fit are collected in a table x_powers with
+ * x_powers[7*k + j] = x_j^k, so that the basis function orders k_{i,j} index
+ * the table directly. The table only depends on the fit parameters and is
+ * shared by all fits evaluated at the same point.
  */
-REAL8 ipow(REAL8 base, int exponent) {
-    if (exponent == 0) return 1.0;
-    REAL8 res = base;
-    while (exponent > 1) {
-        res = res*base;
-        exponent -= 1;
+#define NRSUR_N_FIT_POWERS 22 // 3 per spin component, 4 for mass ratio
+
+static void PrecessingNRSur_fill_powers(
+    REAL8 *x_powers,        /**< Output: NRSUR_N_FIT_POWERS monomials */
+    const REAL8 *fit_params /**< size 7, the transformed fit parameters */
+) {
+    for (int j=0; j<7; j++) {
+        x_powers[j] = 1.0;
+        x_powers[7 + j] = fit_params[j];
+        x_powers[14 + j] = fit_params[j]*fit_params[j];
     }
-    return res;
+    x_powers[21] = x_powers[14]*fit_params[0];
 }
 
+/*
+ * Computes the monomial table of a NRSur7dq2 fit.
+ * The fits were constructed using an affine transformation of the mass ratio
+ * rather than using q directly.
+ */
+static void NRSur7dq2_fit_powers(
+    REAL8 *x_powers,    /**< Output: NRSUR_N_FIT_POWERS monomials */
+    const REAL8 *x      /**< size 7, giving mass ratio q, and dimensionless spin components */
+) {
+    REAL8 fit_params[7];
+    fit_params[0] = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
+    for (int j=1; j<7; j++) {
+        fit_params[j] = x[j];
+    }
+    PrecessingNRSur_fill_powers(x_powers, fit_params);
+}
 
 /*
- * Evaluate a NRSur7dq2 scalar fit.
+ * Evaluates a scalar fit from the monomial table of its fit parameters.
  * The fit result is given by
  *      \sum_{i=1}^{n} c_i * \prod_{j=1}^7 B_j(k_{i, j}; x_j)
  * where i runs over fit coefficients, j runs over the 7 dimensional parameter
  * space, and B_j is a basis function, taking an integer order k_{i, j} and
- * the parameter component x_j. For this surrogate, B_j are monomials in the spin
- * components, and monomials in an affine transformation of the mass ratio.
+ * the parameter component x_j.
  */
-REAL8 NRSur7dq2_eval_fit(
-    FitData *data,  /**< Data for fit */
-    REAL8 *x       /**< size 7, giving mass ratio q, and dimensionless spin components */
+static REAL8 PrecessingNRSur_eval_fit_powers(
+    const FitData *data,    /**< Data for fit */
+    const REAL8 *x_powers   /**< monomials from PrecessingNRSur_fit_powers */
 ) {
-    REAL8 x_powers[22]; // 3 per spin component, 4 for mass ratio
+    const gsl_matrix_long *orders = data->basisFunctionOrders;
+    const gsl_vector *coefs = data->coefs;
     REAL8 res = 0.0;
-    REAL8 prod;
-    int i, j;
-
-    // The fits were constructed using this rather than using q directly
-    REAL8 q_fit = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
 
-    // Compute powers of components of x
-    for (i=0; i<22; i++) {
-        if (i%7==0) {
-            x_powers[i] = ipow(q_fit, i/7);
-        } else {
-            x_powers[i] = ipow(x[i%7], i/7);
-        }
-    }
-
-    // Sum up fit terms
-    for (i=0; i < data->n_coefs; i++) {
-        // Initialize with q basis function:
-        prod = x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, 0)];
-        // Multiply with spin basis functions:
-        for (j=1; j<7; j++) {
-            prod *= x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, j) + j];
-        }
-        res += gsl_vector_get(data->coefs, i) * prod;
+    for (int i=0; i < data->n_coefs; i++) {
+        const long *k = orders->data + i * orders->tda;
+        REAL8 prod = x_powers[7*k[0]] * x_powers[7*k[1] + 1] * x_powers[7*k[2] + 2]
+            * x_powers[7*k[3] + 3] * x_powers[7*k[4] + 4] * x_powers[7*k[5] + 5]
+            * x_powers[7*k[6] + 6];
+        res += coefs->data[i * coefs->stride] * prod;
     }
 
     return res;
 }
 
+/*
+ * Evaluate a NRSur7dq2 scalar fit.
+ * For this surrogate, B_j are monomials in the spin components, and monomials
+ * in an affine transformation of the mass ratio.
+ */
+REAL8 NRSur7dq2_eval_fit(
+    FitData *data,  /**< Data for fit */
+    REAL8 *x       /**< size 7, giving mass ratio q, and dimensionless spin components */
+) {
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    NRSur7dq2_fit_powers(x_powers, x);
+    return PrecessingNRSur_eval_fit_powers(data, x_powers);
+}
+
 /*
  * This is very similar to NRSur7dq2_eval_fit except that the result is a
  * 2d or 3d vector instead of a scalar. Each fit coefficient now applies to
@@ -611,38 +632,25 @@ REAL8 NRSur7dq2_eval_fit(
 static void NRSur7dq2_eval_vector_fit(
     REAL8 *res,            /**< Result */
     VectorFitData *data,    /**< Data for fit */
-    REAL8 *x               /**< size 7, giving mass ratio q, and dimensionless spin components */
+    const REAL8 *x_powers  /**< monomials from PrecessingNRSur_fit_powers */
 ) {
-    REAL8 x_powers[22]; // 3 per spin component, 4 for mass ratio
-    REAL8 prod;
-    int i, j;
+    const gsl_matrix_long *orders = data->basisFunctionOrders;
+    const gsl_vector *coefs = data->coefs;
+    const gsl_vector_long *components = data->componentIndices;
+    int i;
 
     // Initialize the result
     for (i=0; i < data->vec_dim; i++) {
         res[i] = 0.0;
     }
 
-    // The fits were constructed using this rather than using q directly
-    REAL8 q_fit = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE*x[0];
-
-    // Compute powers of components of x
-    for (i=0; i<22; i++) {
-        if (i%7==0) {
-            x_powers[i] = ipow(q_fit, i/7);
-        } else {
-            x_powers[i] = ipow(x[i%7], i/7);
-        }
-    }
-
     // Sum up fit terms
     for (i=0; i < data->n_coefs; i++) {
-        // Initialize with q basis function:
-        prod = x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, 0)];
-        // Multiply with spin basis functions:
-        for (j=1; j<7; j++) {
-            prod *= x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, j) + j];
-        }
-        res[gsl_vector_long_get(data->componentIndices, i)] += gsl_vector_get(data->coefs, i) * prod;
+        const long *k = orders->data + i * orders->tda;
+        REAL8 prod = x_powers[7*k[0]] * x_powers[7*k[1] + 1] * x_powers[7*k[2] + 2]
+            * x_powers[7*k[3] + 3] * x_powers[7*k[4] + 4] * x_powers[7*k[5] + 5]
+            * x_powers[7*k[6] + 6];
+        res[components->data[i * components->stride]] += coefs->data[i * coefs->stride] * prod;
     }
 }
 
@@ -669,17 +677,12 @@ static int NRSur7dq4_effective_spins(
 }
 
 /*
- * Evaluate a NRSur7dq4 scalar fit.
+ * Computes the monomial table of a NRSur7dq4 fit.
  */
-REAL8 NRSur7dq4_eval_fit(
-    FitData *data,  /**< Data for fit */
-    REAL8 *x       /**< size 7, giving mass ratio q, and dimensionless spin components */
+static void NRSur7dq4_fit_powers(
+    REAL8 *x_powers,    /**< Output: NRSUR_N_FIT_POWERS monomials */
+    const REAL8 *x      /**< size 7, giving mass ratio q, and dimensionless spin components */
 ) {
-    REAL8 x_powers[22]; // 3 per spin component, 4 for mass ratio
-    REAL8 res = 0.0;
-    REAL8 prod;
-    int i, j;
-
     // get effective spins chiHat and chi_a
     // chiHat is defined in Eq.(3) of 1508.07253.
     // and chi_a = (chi1z - chi2z)/2.
@@ -698,49 +701,61 @@ REAL8 NRSur7dq4_eval_fit(
     fit_params[6] = chi_a;
 
     // The fits were constructed using this rather than using q directly
-    REAL8 q_fit = NRSUR7DQ4_Q_FIT_OFFSET
+    fit_params[0] = NRSUR7DQ4_Q_FIT_OFFSET
         + NRSUR7DQ4_Q_FIT_SLOPE*fit_params[0];
 
-    // Compute powers of components of fit_params
-    for (i=0; i<22; i++) {
-        if (i%7==0) {
-            x_powers[i] = ipow(q_fit, i/7);
-        } else {
-            x_powers[i] = ipow(fit_params[i%7], i/7);
-        }
-    }
-
-    // Sum up fit terms
-    for (i=0; i < data->n_coefs; i++) {
-        // Initialize with q basis function:
-        prod = x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, 0)];
-        // Multiply with spin basis functions:
-        for (j=1; j<7; j++) {
-            prod *= x_powers[7 * gsl_matrix_long_get(data->basisFunctionOrders, i, j) + j];
-        }
-        res += gsl_vector_get(data->coefs, i) * prod;
-    }
+    PrecessingNRSur_fill_powers(x_powers, fit_params);
+}
 
-    return res;
+/*
+ * Evaluate a NRSur7dq4 scalar fit.
+ */
+REAL8 NRSur7dq4_eval_fit(
+    FitData *data,  /**< Data for fit */
+    REAL8 *x       /**< size 7, giving mass ratio q, and dimensionless spin components */
+) {
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    NRSur7dq4_fit_powers(x_powers, x);
+    return PrecessingNRSur_eval_fit_powers(data, x_powers);
 }
 
 /*
  * This is very similar to NRSur7dq4_eval_fit except that the result is a
- * 2d or 3d vector instead of a scalar. Each fit coefficient now applies to
- * just a single component of the result.
+ * 2d or 3d vector instead of a scalar. For this model the vector fit is a
+ * vector of scalar fits, which all share the same monomials.
  */
 static void NRSur7dq4_eval_vector_fit(
     REAL8 *res,            /**< Result */
     VectorFitData *data,    /**< Data for fit */
-    REAL8 *x               /**< size 7, giving mass ratio q, and dimensionless spin components */
+    const REAL8 *x_powers  /**< monomials from PrecessingNRSur_fit_powers */
 ) {
     // loop over vector indices
     for (int i=0; i < data->vec_dim; i++) {
-        res[i] = NRSur7dq4_eval_fit((*data).fit_data[i], x);
+        res[i] = PrecessingNRSur_eval_fit_powers((*data).fit_data[i], x_powers);
     }
 }
 
 
+/*
+ * Wrapper for NRSur7dq2_fit_powers and NRSur7dq4_fit_powers.
+ * The result can be passed to PrecessingNRSur_eval_fit_powers and
+ * PrecessingNRSur_eval_vector_fit for every fit evaluated at x.
+ */
+static int PrecessingNRSur_fit_powers(
+    REAL8 *x_powers,   /**< Output: NRSUR_N_FIT_POWERS monomials */
+    const REAL8 *x,    /**< size 7, giving mass ratio q, and dimensionless spin components */
+    PrecessingNRSurData *__sur_data  /**< Loaded surrogate data */
+) {
+    if (__sur_data->PrecessingNRSurVersion == 0) {
+        NRSur7dq2_fit_powers(x_powers, x);
+    } else if (__sur_data->PrecessingNRSurVersion == 1) {
+        NRSur7dq4_fit_powers(x_powers, x);
+    } else {
+        XLAL_ERROR(XLAL_FAILURE, "Only 0 or 1 are currently allowed for PrecessingNRSurVersion\n");
+    }
+    return XLAL_SUCCESS;
+}
+
 /*
  * Wrapper for NRSur7dq2_eval_fit and NRSur7dq4_eval_fit
  */
@@ -764,13 +779,13 @@ REAL8 PrecessingNRSur_eval_fit(
 static void PrecessingNRSur_eval_vector_fit(
     REAL8 *res,            /**< Result */
     VectorFitData *data,    /**< Data for fit */
-    REAL8 *x,               /**< size 7, giving mass ratio q, and dimensionless spin components */
+    const REAL8 *x_powers, /**< monomials from PrecessingNRSur_fit_powers */
     PrecessingNRSurData *__sur_data   /**< Loaded surrogate data */
 ) {
     if (__sur_data->PrecessingNRSurVersion == 0) {
-        return NRSur7dq2_eval_vector_fit(res, data, x);
+        return NRSur7dq2_eval_vector_fit(res, data, x_powers);
     } else if (__sur_data->PrecessingNRSurVersion == 1) {
-        return NRSur7dq4_eval_vector_fit(res, data, x);
+        return NRSur7dq4_eval_vector_fit(res, data, x_powers);
     } else {
         XLAL_ERROR_VOID(XLAL_FAILURE, "Only 0 or 1 are currently allowed for PrecessingNRSurVersion\n");
     }
@@ -1125,15 +1140,23 @@ static void PrecessingNRSur_get_time_deriv_from_index(
         ds_node = __sur_data->ds_half_node_data[-1*i0 - 1];
     }
 
-    // Evaluate fits
+    // Evaluate fits; all fits at this node share the same monomials
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    if (PrecessingNRSur_fit_powers(x_powers, x, __sur_data) != XLAL_SUCCESS) {
+        int j;
+        for (j=0; j<11; j++) {
+            dydt[j] = XLAL_REAL8_FAIL_NAN;
+        }
+        XLAL_ERROR_VOID(XLAL_EFUNC, "Failed to evaluate fit monomials");
+    }
     REAL8 omega, Omega_coorb_xy[2], chiA_dot[3], chiB_dot[3];
-    omega = PrecessingNRSur_eval_fit(ds_node->omega_data, x, __sur_data);
+    omega = PrecessingNRSur_eval_fit_powers(ds_node->omega_data, x_powers);
     PrecessingNRSur_eval_vector_fit(Omega_coorb_xy, ds_node->omega_copr_data,
-            x, __sur_data);
+            x_powers, __sur_data);
     PrecessingNRSur_eval_vector_fit(chiA_dot, ds_node->chiA_dot_data,
-            x, __sur_data);
+            x_powers, __sur_data);
     PrecessingNRSur_eval_vector_fit(chiB_dot, ds_node->chiB_dot_data,
-            x, __sur_data);
+            x_powers, __sur_data);
     PrecessingNRSur_assemble_dydt(dydt, y, Omega_coorb_xy, omega, chiA_dot, chiB_dot);
 }
 
@@ -1905,28 +1928,50 @@ static PrecessingNRSurData* PrecessingNRSur_core(
     // Transform spins from coprecessing frame to coorbital frame for use in coorbital waveform surrogate
     PrecessingNRSur_rotate_spins(chiA_coorb, chiB_coorb, phi_coorb);
 
-    // Evaluate the coorbital waveform surrogate
+    // Evaluate the coorbital waveform surrogate.
+    // First collect the active waveform data pieces together with the modes
+    // they contribute to; the data pieces are independent and are evaluated
+    // in parallel, then combined into the modes in a fixed order.
     MultiModalWaveform *h_coorb = NULL;
     MultiModalWaveform_Init(&h_coorb, NRSUR_LMAX, n_coorb);
-    gsl_vector *data_piece_eval = gsl_vector_alloc(n_coorb);
-    WaveformDataPiece *data_piece_data;
+    int max_pieces = 0;
+    for (ell=2; ell<=NRSUR_LMAX; ell++) {
+        max_pieces += 2 + 4*ell;
+    }
+    WaveformDataPiece **pieces = XLALMalloc(max_pieces * sizeof(*pieces));
+    gsl_vector **targets = XLALMalloc(2 * max_pieces * sizeof(*targets));
+    int *signs = XLALMalloc(2 * max_pieces * sizeof(*signs));
+    if (!pieces || !targets || !signs) {
+        XLALFree(pieces);
+        XLALFree(targets);
+        XLALFree(signs);
+        MultiModalWaveform_Destroy(h_coorb);
+        for (i=0; i<3; i++) {
+            gsl_vector_free(chiA_coorb[i]);
+            gsl_vector_free(chiB_coorb[i]);
+            gsl_vector_free(quat_coorb[i]);
+        }
+        gsl_vector_free(quat_coorb[3]);
+        gsl_vector_free(phi_coorb);
+        XLAL_ERROR_NULL(XLAL_ENOMEM, "Failed to allocate coorbital data piece tables");
+    }
+    int n_pieces = 0;
     int i0; // for indexing the (ell, m=0) mode, such that the (ell, m) mode is index (i0 + m).
     WaveformFixedEllModeData *ell_data;
+#define NRSUR_ADD_PIECE(piece, target0, sign0, target1, sign1) do { \
+        pieces[n_pieces] = (piece); \
+        targets[2*n_pieces] = (target0); signs[2*n_pieces] = (sign0); \
+        targets[2*n_pieces+1] = (target1); signs[2*n_pieces+1] = (sign1); \
+        n_pieces++; \
+    } while (0)
     for (ell=2; ell<=NRSUR_LMAX; ell++) {
         ell_data = __sur_data->coorbital_mode_data[ell - 2];
         i0 = ell*(ell+1) - 4;
 
         // m=0
-        if (XLALSimInspiralModeArrayIsModeActive(ModeArray, ell, 0) != 1) {
-        }
-        else {
-            data_piece_data = ell_data->m0_real_data;
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_real_part[i0], data_piece_eval);
-
-            data_piece_data = ell_data->m0_imag_data;
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_imag_part[i0], data_piece_eval);
+        if (XLALSimInspiralModeArrayIsModeActive(ModeArray, ell, 0) == 1) {
+            NRSUR_ADD_PIECE(ell_data->m0_real_data, h_coorb->modes_real_part[i0], 1, NULL, 0);
+            NRSUR_ADD_PIECE(ell_data->m0_imag_data, h_coorb->modes_imag_part[i0], 1, NULL, 0);
         }
 
         // Other modes
@@ -1940,30 +1985,58 @@ static PrecessingNRSurData* PrecessingNRSur_core(
             // h^{ell, -m} = (X_plus - X_minus)* <- complex conjugate
 
             // Re[X_plus] gets added to both Re[h^{ell, m}] and Re[h^{ell, -m}]
-            data_piece_data = ell_data->X_real_plus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_real_part[i0+m], data_piece_eval);
-            gsl_vector_add(h_coorb->modes_real_part[i0-m], data_piece_eval);
+            NRSUR_ADD_PIECE(ell_data->X_real_plus_data[m-1],
+                    h_coorb->modes_real_part[i0+m], 1, h_coorb->modes_real_part[i0-m], 1);
 
             // Re[X_minus] gets added to Re[h^{ell, m}] and subtracted from Re[h^{ell, -m}]
-            data_piece_data = ell_data->X_real_minus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_real_part[i0+m], data_piece_eval);
-            gsl_vector_sub(h_coorb->modes_real_part[i0-m], data_piece_eval);
+            NRSUR_ADD_PIECE(ell_data->X_real_minus_data[m-1],
+                    h_coorb->modes_real_part[i0+m], 1, h_coorb->modes_real_part[i0-m], -1);
 
             // Im[X_plus] gets added to Re[h^{ell, m}] and subtracted from Re[h^{ell, -m}]
-            data_piece_data = ell_data->X_imag_plus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_imag_part[i0+m], data_piece_eval);
-            gsl_vector_sub(h_coorb->modes_imag_part[i0-m], data_piece_eval);
+            NRSUR_ADD_PIECE(ell_data->X_imag_plus_data[m-1],
+                    h_coorb->modes_imag_part[i0+m], 1, h_coorb->modes_imag_part[i0-m], -1);
 
             // Im[X_minus] gets added to both Re[h^{ell, m}] and Re[h^{ell, -m}]
-            data_piece_data = ell_data->X_imag_minus_data[m-1];
-            PrecessingNRSur_eval_data_piece(data_piece_eval, q, chiA_coorb, chiB_coorb, data_piece_data, __sur_data);
-            gsl_vector_add(h_coorb->modes_imag_part[i0+m], data_piece_eval);
-            gsl_vector_add(h_coorb->modes_imag_part[i0-m], data_piece_eval);
+            NRSUR_ADD_PIECE(ell_data->X_imag_minus_data[m-1],
+                    h_coorb->modes_imag_part[i0+m], 1, h_coorb->modes_imag_part[i0-m], 1);
+        }
+    }
+#undef NRSUR_ADD_PIECE
+
+    gsl_matrix *data_piece_eval = gsl_matrix_alloc(n_pieces > 0 ? n_pieces : 1, n_coorb);
+    if (!data_piece_eval) {
+        XLALFree(pieces);
+        XLALFree(targets);
+        XLALFree(signs);
+        MultiModalWaveform_Destroy(h_coorb);
+        for (i=0; i<3; i++) {
+            gsl_vector_free(chiA_coorb[i]);
+            gsl_vector_free(chiB_coorb[i]);
+            gsl_vector_free(quat_coorb[i]);
+        }
+        gsl_vector_free(quat_coorb[3]);
+        gsl_vector_free(phi_coorb);
+        XLAL_ERROR_NULL(XLAL_ENOMEM, "Failed to allocate coorbital data piece evaluations");
+    }
+    #pragma omp parallel for schedule(dynamic)
+    for (i=0; i<n_pieces; i++) {
+        gsl_vector_view row = gsl_matrix_row(data_piece_eval, i);
+        PrecessingNRSur_eval_data_piece(&row.vector, q, chiA_coorb, chiB_coorb, pieces[i], __sur_data);
+    }
+    for (i=0; i<n_pieces; i++) {
+        gsl_vector_view row = gsl_matrix_row(data_piece_eval, i);
+        for (j=0; j<2; j++) {
+            if (signs[2*i+j] > 0) {
+                gsl_vector_add(targets[2*i+j], &row.vector);
+            } else if (signs[2*i+j] < 0) {
+                gsl_vector_sub(targets[2*i+j], &row.vector);
+            }
         }
     }
+    gsl_matrix_free(data_piece_eval);
+    XLALFree(pieces);
+    XLALFree(targets);
+    XLALFree(signs);
 
     // Rotate to the inertial frame, write results in h
     MultiModalWaveform_Init(h, NRSUR_LMAX, n_coorb);
@@ -1978,7 +2051,6 @@ static PrecessingNRSurData* PrecessingNRSur_core(
     }
     gsl_vector_free(quat_coorb[3]);
     gsl_vector_free(phi_coorb);
-    gsl_vector_free(data_piece_eval);
 
     return __sur_data;
 }
@@ -176,29 +176,32 @@ static void PrecessingNRSur_LoadCoorbitalEllModes(WaveformFixedEllModeData **coo
 static void PrecessingNRSur_LoadWaveformDataPiece(LALH5File *sub, WaveformDataPiece **data, bool invert_sign);
 static bool NRSur7dq2_IsSetup(void);
 static bool NRSur7dq4_IsSetup(void);
-static double ipow(double base, int exponent); // integer powers
 
+static void NRSur7dq2_fit_powers(double *x_powers, const double *x);
 static double NRSur7dq2_eval_fit(FitData *data, double *x);
 
 static void NRSur7dq2_eval_vector_fit(
     double *res, // Result
     VectorFitData *data, // Data for fit
-    double *x // size 7, giving mass ratio q, and dimensionless spin components
+    const double *x_powers // monomials of the fit parameters, see PrecessingNRSur_fit_powers
 );
 
 static int NRSur7dq4_effective_spins(REAL8 *chiHat, REAL8 *chi_a,
         const double q, const double chi1z, const double chi2z);
+static void NRSur7dq4_fit_powers(double *x_powers, const double *x);
 static double NRSur7dq4_eval_fit(FitData *data, double *x);
 
 static void NRSur7dq4_eval_vector_fit(
     double *res, // Result
     VectorFitData *data, // Data for fit
-    double *x // size 7, giving mass ratio q, and dimensionless spin components
+    const double *x_powers // monomials of the fit parameters, see PrecessingNRSur_fit_powers
 );
 
+static int PrecessingNRSur_fit_powers(double *x_powers, const double *x, PrecessingNRSurData *__sur_data);
+static double PrecessingNRSur_eval_fit_powers(const FitData *data, const double *x_powers);
 double PrecessingNRSur_eval_fit(FitData *data, double *x, PrecessingNRSurData *__sur_data);
 
-static void PrecessingNRSur_eval_vector_fit(double *res, VectorFitData *data, double *x, PrecessingNRSurData *__sur_data);
+static void PrecessingNRSur_eval_vector_fit(double *res, VectorFitData *data, const double *x_powers, PrecessingNRSurData *__sur_data);
 
 static void PrecessingNRSur_normalize_y(
     double chiANorm,
@@ -96,6 +96,31 @@ UNUSED static REAL8 Interpolate_Coefficent_Matrix(
   gsl_bspline_workspace *bwy
 );
 
+// Nonzero cubic B-spline basis functions at a single parameter value
+typedef struct tagROMBSplineBasis {
+  size_t is;   // index of the first nonzero B-spline
+  double B[4]; // values of the four nonzero B-splines is, ..., is+3
+} ROMBSplineBasis;
+
+UNUSED static int ROM_BSpline_Basis(
+  ROMBSplineBasis *basis,
+  REAL8 x,
+  const double *breakpts,
+  size_t nbreak
+);
+
+UNUSED static int Interpolate_Coefficent_Tensor_Basis(
+  double *c_out,
+  const double *cvec,
+  size_t nk,
+  int ncx,
+  int ncy,
+  int ncz,
+  const ROMBSplineBasis *bx,
+  const ROMBSplineBasis *by,
+  const ROMBSplineBasis *bz
+);
+
 UNUSED static gsl_vector *Fit_cubic(const gsl_vector *xi, const gsl_vector *yi);
 
 UNUSED static bool approximately_equal(REAL8 x, REAL8 y, REAL8 epsilon);
@@ -519,6 +544,108 @@ static REAL8 Interpolate_Coefficent_Matrix(
   return sum;
 }
 
+// Evaluate the four nonzero cubic B-spline basis functions at x for the knot
+// sequence gsl_bspline_knots() builds from the given breakpoints, i.e. the
+// breakpoints with the end points repeated four times. Unlike
+// gsl_bspline_eval_nonzero() this needs no workspace, so it is thread-safe
+// and the result can be reused for every SVD mode of a ROM.
+static int ROM_BSpline_Basis(
+  ROMBSplineBasis *basis,
+  REAL8 x,
+  const double *breakpts,
+  size_t nbreak
+) {
+  if (nbreak < 2)
+    XLAL_ERROR(XLAL_EINVAL, "Need at least two B-spline breakpoints, got %zu", nbreak);
+  const size_t l = nbreak - 1; // number of knot intervals
+  if (!(x >= breakpts[0] && x <= breakpts[l]))
+    XLAL_ERROR(XLAL_EDOM, "Value %g outside of B-spline domain [%g, %g]", x, breakpts[0], breakpts[l]);
+
+  // Find the knot interval j with breakpts[j] <= x < breakpts[j+1];
+  // the right end point belongs to the last interval.
+  size_t lo = 0, hi = l;
+  while (hi - lo > 1) {
+    size_t mid = (lo + hi) / 2;
+    if (x < breakpts[mid])
+      hi = mid;
+    else
+      lo = mid;
+  }
+  const size_t j = lo;
+
+  // Knots t_{j+3+m} around the interval, clamped to the repeated end points
+  double t[8];
+  for (int m = -3; m <= 4; m++) {
+    ptrdiff_t idx = (ptrdiff_t)j + m;
+    if (idx < 0) idx = 0;
+    if (idx > (ptrdiff_t)l) idx = l;
+    t[m + 3] = breakpts[idx];
+  }
+
+  // Cox-de Boor recursion for the nonzero basis functions (cf. The NURBS Book, A2.2);
+  // t[3] <= x < t[4] is the current interval.
+  double left[4], right[4];
+  double *N = basis->B;
+  N[0] = 1.0;
+  for (int d = 1; d <= 3; d++) {
+    left[d] = x - t[4 - d];
+    right[d] = t[3 + d] - x;
+    double saved = 0.0;
+    for (int r = 0; r < d; r++) {
+      double temp = N[r] / (right[r + 1] + left[d - r]);
+      N[r] = saved + right[r + 1] * temp;
+      saved = left[d - r] * temp;
+    }
+    N[d] = saved;
+  }
+  basis->is = j; // the first nonzero B-spline has the same index as the interval
+
+  return XLAL_SUCCESS;
+}
+
+// Evaluate a tensor product spline for nk SVD modes at once.
+// cvec holds nk consecutive ncx x ncy x ncz coefficient tensors and the basis
+// functions bx, by, bz have been computed with ROM_BSpline_Basis() at the
+// desired parameters. The 64 tensor weights and offsets are formed once and
+// then contracted with the coefficients of every mode.
+static int Interpolate_Coefficent_Tensor_Basis(
+  double *c_out,
+  const double *cvec,
+  size_t nk,
+  int ncx,
+  int ncy,
+  int ncz,
+  const ROMBSplineBasis *bx,
+  const ROMBSplineBasis *by,
+  const ROMBSplineBasis *bz
+) {
+  if (bx->is + 4 > (size_t)ncx || by->is + 4 > (size_t)ncy || bz->is + 4 > (size_t)ncz)
+    XLAL_ERROR(XLAL_EBADLEN, "B-spline basis does not match coefficient tensor of size %d x %d x %d", ncx, ncy, ncz);
+
+  double w[64];
+  size_t off[16];
+  for (int i=0; i<4; i++)
+    for (int j=0; j<4; j++) {
+      off[4*i + j] = ((bx->is + i)*ncy + by->is + j)*ncz + bz->is;
+      for (int k=0; k<4; k++)
+        w[(4*i + j)*4 + k] = bx->B[i] * by->B[j] * bz->B[k];
+    }
+
+  const size_t N = (size_t)ncx*ncy*ncz; // Size of the data tensor for one SVD mode
+  for (size_t n=0; n<nk; n++) {
+    const double *c = cvec + n*N;
+    double sum = 0;
+    for (int m=0; m<16; m++) {
+      const double *cm = c + off[m];
+      const double *wm = w + 4*m;
+      sum += cm[0]*wm[0] + cm[1]*wm[1] + cm[2]*wm[2] + cm[3]*wm[3];
+    }
+    c_out[n] = sum;
+  }
+
+  return XLAL_SUCCESS;
+}
+
 // Returns fitting coefficients for cubic y = c[0] + c[1]*x + c[2]*x**2 + c[3]*x**3
 static gsl_vector *Fit_cubic(const gsl_vector *xi, const gsl_vector *yi) {
   const int n = xi->size; // how many data points are we fitting
@@ -85,7 +85,7 @@ static const INT4 ROMDataHDF5_VERSION_MICRO = 0;
 
 
 #ifdef LAL_PTHREAD_LOCK
-static pthread_once_t SEOBNRv4HMROM_is_initialized = PTHREAD_ONCE_INIT;
+static pthread_mutex_t SEOBNRv4HMROM_init_mutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
 
@@ -187,7 +187,7 @@ typedef struct tagAmpPhaseSplineData
 /**************** Internal functions **********************/
 
 UNUSED static bool SEOBNRv4HMROM_IsSetup(UINT4);
-UNUSED static void SEOBNRv4HMROM_Init_LALDATA(void);
+UNUSED static int SEOBNRv4HMROM_Init_LALDATA(UINT4 nModes);
 UNUSED static int SEOBNRv4HMROM_Init(const char dir[],UINT4);
 UNUSED static int SEOBNRROMdataDS_Init(SEOBNRROMdataDS *romdata, const char dir[], UINT4);
 UNUSED static void SEOBNRROMdataDS_Cleanup(SEOBNRROMdataDS *romdata);
@@ -430,35 +430,60 @@ UNUSED static int spline_to_gsl_vectors(gsl_spline *s, gsl_vector **x, gsl_vecto
 }
 
 
-/** Setup SEOBNRv4HMROM model using data files installed in $LAL_DATA_PATH
+/** Setup the first nModes modes of the SEOBNRv4HMROM model, or all of them
+ * if nModes is 0, using data files installed in $LAL_DATA_PATH.
+ * Modes are loaded on first use, so that a process which only needs the
+ * (2,2) mode does not read the data of the higher modes.
  */
-UNUSED static void SEOBNRv4HMROM_Init_LALDATA(void)
+UNUSED static int SEOBNRv4HMROM_Init_LALDATA(UINT4 nModes)
 {
-  // Loop over all the available modes and check if they have already been initialized
-  for(int i = 0; i < NMODES; i++) {
-    if (SEOBNRv4HMROM_IsSetup(i)) return;
+  int ret = XLAL_SUCCESS;
+
+  if (nModes == 0 || nModes > NMODES)
+    nModes = NMODES;
+
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_lock(&SEOBNRv4HMROM_init_mutex);
+#endif
+
+  // Check if the requested modes have already been initialized
+  UINT4 i;
+  for(i = 0; i < nModes; i++) {
+    if (!SEOBNRv4HMROM_IsSetup(i)) break;
   }
 
-  // Expect ROM datafile in a directory listed in LAL_DATA_PATH,
+  if (i < nModes) {
+    // Expect ROM datafile in a directory listed in LAL_DATA_PATH,
 #ifdef LAL_HDF5_ENABLED
 #define datafile ROMDataHDF5
-  char *path = XLAL_FILE_RESOLVE_PATH(datafile);
-  if (path==NULL){
-    XLAL_ERROR_VOID(XLAL_EIO, "Unable to resolve data file %s in $LAL_DATA_PATH\n", datafile);
+    char *path = XLAL_FILE_RESOLVE_PATH(datafile);
+    if (path==NULL){
+      XLALPrintError("Unable to resolve data file %s in $LAL_DATA_PATH\n", datafile);
+      ret = XLAL_EIO;
+    } else {
+      char *dir = dirname(path);
+      for(; i < nModes && ret == XLAL_SUCCESS; i++) {
+        if (SEOBNRv4HMROM_IsSetup(i)) continue;
+        if (SEOBNRv4HMROM_Init(dir, i) != XLAL_SUCCESS) {
+          XLALPrintError("Unable to find SEOBNRv4HMROM data files in $LAL_DATA_PATH for the mode = %d\n", i);
+          ret = XLAL_FAILURE;
+        }
+      }
+      XLALFree(path);
+    }
+#else
+    XLALPrintError("SEOBNRv4HMROM requires HDF5 support which is not enabled\n");
+    ret = XLAL_EFAILED;
+#endif
   }
-  char *dir = dirname(path);
 
-  UINT4 ret = XLAL_SUCCESS;
-  for(int i = 0; i < NMODES; i++) {
-    ret = SEOBNRv4HMROM_Init(dir, i);
-    if(ret != XLAL_SUCCESS)
-      XLAL_ERROR_VOID(XLAL_FAILURE, "Unable to find SEOBNRv4HMROM data \
-      files in $LAL_DATA_PATH for the mode = %d\n", i);
-  }
-  XLALFree(path);
-#else
-  XLAL_ERROR_VOID(XLAL_EFAILED, "SEOBNRv4HMROM requires HDF5 support which is not enabled\n");
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_unlock(&SEOBNRv4HMROM_init_mutex);
 #endif
+
+  if (ret != XLAL_SUCCESS)
+    XLAL_ERROR(ret);
+  return XLAL_SUCCESS;
 }
 
 /** Helper function to check if the SEOBNRv4HMROM model has been initialised */
@@ -594,21 +619,16 @@ static int TP_Spline_interpolation_3d(
     }
   }
 
-  SplineData *splinedata=NULL;
-  SplineData_Init(&splinedata, ncx, ncy, ncz, qvec, chi1vec, chi2vec);
-
-  gsl_bspline_workspace *bwx=splinedata->bwx;
-  gsl_bspline_workspace *bwy=splinedata->bwy;
-  gsl_bspline_workspace *bwz=splinedata->bwz;
-
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
-  // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, q, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_out, k, csum);
-  }
-  SplineData_Destroy(splinedata);
+  // Compute the nonzero B-splines once and evaluate the TP spline for all SVD modes
+  ROMBSplineBasis bx, by, bz;
+  if (ROM_BSpline_Basis(&bx, q, qvec, ncx-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&by, chi1, chi1vec, ncy-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&bz, chi2, chi2vec, ncz-2) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+  XLAL_CHECK(cvec->stride == 1 && c_out->stride == 1 && cvec->size >= (size_t)nk*ncx*ncy*ncz && c_out->size >= (size_t)nk,
+    XLAL_EBADLEN, "Inconsistent ROM coefficient vectors");
+  if (Interpolate_Coefficent_Tensor_Basis(c_out->data, cvec->data, nk, ncx, ncy, ncz, &bx, &by, &bz) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
 
   return(0);
 }
@@ -2587,12 +2607,12 @@ int XLALSimIMRSEOBNRv4HMROM(
   freqs->data[0] = fLow;
   freqs->data[1] = fHigh;
 
-  /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
-  (void) pthread_once(&SEOBNRv4HMROM_is_initialized, SEOBNRv4HMROM_Init_LALDATA);
-#else
-  SEOBNRv4HMROM_Init_LALDATA();
-#endif
+  /* Load ROM data for the requested modes if not loaded already */
+  if (SEOBNRv4HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+    XLALDestroyREAL8Sequence(freqs);
+    XLALDestroyValue(ModeArray);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
   SphHarmFrequencySeries *hlm = NULL;
 
   /* Generate modes */
@@ -2702,12 +2722,11 @@ int XLALSimIMRSEOBNRv4HMROMFrequencySequence(
     XLAL_ERROR(XLAL_EFUNC);
   }
 
-  /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
-  (void) pthread_once(&SEOBNRv4HMROM_is_initialized, SEOBNRv4HMROM_Init_LALDATA);
-#else
-  SEOBNRv4HMROM_Init_LALDATA();
-#endif
+  /* Load ROM data for the requested modes if not loaded already */
+  if (SEOBNRv4HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+    XLALDestroyValue(ModeArray);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
   SphHarmFrequencySeries *hlm = NULL;
 
   // Call the internal core function with deltaF = 0 to indicate that freqs is non-uniformly
@@ -2819,12 +2838,11 @@ int XLALSimIMRSEOBNRv4HMROM_Modes(
   freqs->data[0] = fLow;
   freqs->data[1] = fHigh;
 
-  /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
-  (void) pthread_once(&SEOBNRv4HMROM_is_initialized, SEOBNRv4HMROM_Init_LALDATA);
-#else
-  SEOBNRv4HMROM_Init_LALDATA();
-#endif
+  /* Load ROM data for the requested modes if not loaded already */
+  if (SEOBNRv4HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+    XLALDestroyREAL8Sequence(freqs);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
 
   /* Generate modes */
   UNUSED UINT8 retcode;
@@ -2911,12 +2929,11 @@ int XLALSimIMRSEOBNRv4HMROMFrequencySequence_Modes(
     XLAL_ERROR(XLAL_EFUNC);
   }
 
-  /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
-  (void) pthread_once(&SEOBNRv4HMROM_is_initialized, SEOBNRv4HMROM_Init_LALDATA);
-#else
-  SEOBNRv4HMROM_Init_LALDATA();
-#endif
+  /* Load ROM data for the requested modes if not loaded already */
+  if (SEOBNRv4HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+    XLALDestroyValue(ModeArray);
+    XLAL_ERROR(XLAL_EFUNC);
+  }
 
   // Call the internal core function with deltaF = 0 to indicate that freqs is non-uniformly
   // spaced and we want the modes only at these frequencies
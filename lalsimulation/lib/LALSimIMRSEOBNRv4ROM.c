@@ -370,29 +370,24 @@ static int TP_Spline_interpolation_3d(
     }
   }
 
-  SplineData *splinedata=NULL;
-  SplineData_Init(&splinedata, ncx, ncy, ncz, etavec, chi1vec, chi2vec);
-
-  gsl_bspline_workspace *bwx=splinedata->bwx;
-  gsl_bspline_workspace *bwy=splinedata->bwy;
-  gsl_bspline_workspace *bwz=splinedata->bwz;
-
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
-  // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk_amp; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_amp, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_amp, k, csum);
-  }
-
-  // Evaluate the TP spline for all SVD modes - phase
-  for (int k=0; k<nk_phi; k++) {  // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec_phi, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, eta, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_phi, k, csum);
-  }
-
-  SplineData_Destroy(splinedata);
+  // Compute the nonzero B-splines once and evaluate the TP spline for all SVD modes
+  ROMBSplineBasis bx, by, bz;
+  if (ROM_BSpline_Basis(&bx, eta, etavec, ncx-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&by, chi1, chi1vec, ncy-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&bz, chi2, chi2vec, ncz-2) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+  const size_t N = (size_t)ncx*ncy*ncz;  // Size of the data tensor for one SVD-mode
+  XLAL_CHECK(cvec_amp->stride == 1 && c_amp->stride == 1 && cvec_amp->size >= nk_amp*N && c_amp->size >= (size_t)nk_amp,
+    XLAL_EBADLEN, "Inconsistent ROM amplitude coefficient vectors");
+  XLAL_CHECK(cvec_phi->stride == 1 && c_phi->stride == 1 && cvec_phi->size >= nk_phi*N && c_phi->size >= (size_t)nk_phi,
+    XLAL_EBADLEN, "Inconsistent ROM phase coefficient vectors");
+
+  // amplitude
+  if (Interpolate_Coefficent_Tensor_Basis(c_amp->data, cvec_amp->data, nk_amp, ncx, ncy, ncz, &bx, &by, &bz) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+  // phase
+  if (Interpolate_Coefficent_Tensor_Basis(c_phi->data, cvec_phi->data, nk_phi, ncx, ncy, ncz, &bx, &by, &bz) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
 
   return(0);
 }
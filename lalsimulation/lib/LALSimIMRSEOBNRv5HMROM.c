@@ -90,7 +90,7 @@ static const INT4 ROM22DataHDF5_VERSION_MICRO = 0;
 
 
 #ifdef LAL_PTHREAD_LOCK
-static pthread_once_t SEOBNRv5HMROM_is_initialized = PTHREAD_ONCE_INIT;
+static pthread_mutex_t SEOBNRv5HMROM_init_mutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_once_t SEOBNRv5ROM_is_initialized = PTHREAD_ONCE_INIT;
 #endif
 
@@ -196,7 +196,7 @@ typedef struct tagAmpPhaseSplineData
 /**************** Internal functions **********************/
 
 UNUSED static bool SEOBNRv5HMROM_IsSetup(UINT4, SEOBNRROMdataDS *romdataset);
-UNUSED static void SEOBNRv5HMROM_Init_LALDATA(void);
+UNUSED static int SEOBNRv5HMROM_Init_LALDATA(UINT4 nModes);
 UNUSED static void SEOBNRv5ROM_Init_LALDATA(void);
 UNUSED static int SEOBNRv5HMROM_Init(const char dir[],UINT4, bool, SEOBNRROMdataDS *romdataset);
 UNUSED static int SEOBNRROMdataDS_Init(SEOBNRROMdataDS *romdata, const char dir[], UINT4, bool);
@@ -457,36 +457,61 @@ UNUSED static int spline_to_gsl_vectors(gsl_spline *s, gsl_vector **x, gsl_vecto
 }
 
 
-/** Setup SEOBNRv5HMROM model using data files installed in $LAL_DATA_PATH
+/** Setup the first nModes modes of the SEOBNRv5HMROM model, or all of them
+ * if nModes is 0, using data files installed in $LAL_DATA_PATH.
+ * Modes are loaded on first use, so that only the data of the modes that
+ * are actually requested is read.
  */
-UNUSED static void SEOBNRv5HMROM_Init_LALDATA(void)
+UNUSED static int SEOBNRv5HMROM_Init_LALDATA(UINT4 nModes)
 {
-  // Loop over all the available modes and check if they have already been initialized
-  for(int i = 0; i < NMODES; i++) {
-    if (SEOBNRv5HMROM_IsSetup(i,__lalsim_SEOBNRv5HMROMDS_data)) return;
+  int ret = XLAL_SUCCESS;
+
+  if (nModes == 0 || nModes > NMODES)
+    nModes = NMODES;
+
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_lock(&SEOBNRv5HMROM_init_mutex);
+#endif
+
+  // Check if the requested modes have already been initialized
+  UINT4 i;
+  for(i = 0; i < nModes; i++) {
+    if (!SEOBNRv5HMROM_IsSetup(i,__lalsim_SEOBNRv5HMROMDS_data)) break;
   }
 
-  // Expect ROM datafile in a directory listed in LAL_DATA_PATH,
+  if (i < nModes) {
+    // Expect ROM datafile in a directory listed in LAL_DATA_PATH,
 #ifdef LAL_HDF5_ENABLED
 #define datafile ROMDataHDF5
-  char *path = XLAL_FILE_RESOLVE_PATH(datafile);
-  if (path==NULL){
-    XLAL_ERROR_VOID(XLAL_EIO, "Unable to resolve data file %s in $LAL_DATA_PATH\n", datafile);
+    char *path = XLAL_FILE_RESOLVE_PATH(datafile);
+    if (path==NULL){
+      XLALPrintError("Unable to resolve data file %s in $LAL_DATA_PATH\n", datafile);
+      ret = XLAL_EIO;
+    } else {
+      char *dir = dirname(path);
+      bool use_hm = true;
+      for(; i < nModes && ret == XLAL_SUCCESS; i++) {
+        if (SEOBNRv5HMROM_IsSetup(i,__lalsim_SEOBNRv5HMROMDS_data)) continue;
+        if (SEOBNRv5HMROM_Init(dir, i, use_hm, __lalsim_SEOBNRv5HMROMDS_data) != XLAL_SUCCESS) {
+          XLALPrintError("Unable to find SEOBNRv5HMROM data files in $LAL_DATA_PATH for the mode = %d\n", i);
+          ret = XLAL_FAILURE;
+        }
+      }
+      XLALFree(path);
+    }
+#else
+    XLALPrintError("SEOBNRv5HMROM requires HDF5 support which is not enabled\n");
+    ret = XLAL_EFAILED;
+#endif
   }
-  char *dir = dirname(path);
 
-  UINT4 ret = XLAL_SUCCESS;
-  bool use_hm = true;
-  for(int i = 0; i < NMODES; i++) {
-    ret = SEOBNRv5HMROM_Init(dir, i, use_hm, __lalsim_SEOBNRv5HMROMDS_data);
-    if(ret != XLAL_SUCCESS)
-      XLAL_ERROR_VOID(XLAL_FAILURE, "Unable to find SEOBNRv5HMROM data \
-      files in $LAL_DATA_PATH for the mode = %d\n", i);
-  }
-  XLALFree(path);
-#else
-  XLAL_ERROR_VOID(XLAL_EFAILED, "SEOBNRv5HMROM requires HDF5 support which is not enabled\n");
+#ifdef LAL_PTHREAD_LOCK
+  pthread_mutex_unlock(&SEOBNRv5HMROM_init_mutex);
 #endif
+
+  if (ret != XLAL_SUCCESS)
+    XLAL_ERROR(ret);
+  return XLAL_SUCCESS;
 }
 
 /** Setup SEOBNRv5ROM model using data files installed in $LAL_DATA_PATH
@@ -654,21 +679,16 @@ static int TP_Spline_interpolation_3d(
     }
   }
 
-  SplineData *splinedata=NULL;
-  SplineData_Init(&splinedata, ncx, ncy, ncz, qvec, chi1vec, chi2vec);
-
-  gsl_bspline_workspace *bwx=splinedata->bwx;
-  gsl_bspline_workspace *bwy=splinedata->bwy;
-  gsl_bspline_workspace *bwz=splinedata->bwz;
-
-  int N = ncx*ncy*ncz;  // Size of the data matrix for one SVD-mode
-  // Evaluate the TP spline for all SVD modes - amplitude
-  for (int k=0; k<nk; k++) { // For each SVD mode
-    gsl_vector v = gsl_vector_subvector(cvec, k*N, N).vector; // Pick out the coefficient matrix corresponding to the k-th SVD mode.
-    REAL8 csum = Interpolate_Coefficent_Tensor(&v, q, chi1, chi2, ncy, ncz, bwx, bwy, bwz);
-    gsl_vector_set(c_out, k, csum);
-  }
-  SplineData_Destroy(splinedata);
+  // Compute the nonzero B-splines once and evaluate the TP spline for all SVD modes
+  ROMBSplineBasis bx, by, bz;
+  if (ROM_BSpline_Basis(&bx, q, qvec, ncx-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&by, chi1, chi1vec, ncy-2) != XLAL_SUCCESS
+      || ROM_BSpline_Basis(&bz, chi2, chi2vec, ncz-2) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
+  XLAL_CHECK(cvec->stride == 1 && c_out->stride == 1 && cvec->size >= (size_t)nk*ncx*ncy*ncz && c_out->size >= (size_t)nk,
+    XLAL_EBADLEN, "Inconsistent ROM coefficient vectors");
+  if (Interpolate_Coefficent_Tensor_Basis(c_out->data, cvec->data, nk, ncx, ncy, ncz, &bx, &by, &bz) != XLAL_SUCCESS)
+    XLAL_ERROR(XLAL_EFUNC);
 
   return(0);
 }
@@ -2608,23 +2628,22 @@ int XLALSimIMRSEOBNRv5HMROM(
   SEOBNRROMdataDS *romdataset;
 
   /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
   if (nModes == 1){
     romdataset=__lalsim_SEOBNRv5ROMDS_data;
+#ifdef LAL_PTHREAD_LOCK
     (void) pthread_once(&SEOBNRv5ROM_is_initialized, SEOBNRv5ROM_Init_LALDATA);
-  }
-  else{
-    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
-    (void) pthread_once(&SEOBNRv5HMROM_is_initialized, SEOBNRv5HMROM_Init_LALDATA);
-  }
 #else
-  if (nModes == 1){
     SEOBNRv5ROM_Init_LALDATA();
+#endif
   }
   else{
-    SEOBNRv5HMROM_Init_LALDATA();
+    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
+    if (SEOBNRv5HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+      XLALDestroyREAL8Sequence(freqs);
+      XLALDestroyValue(ModeArray);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
   }
-#endif
   SphHarmFrequencySeries *hlm = NULL;
 
   /* Generate modes */
@@ -2737,23 +2756,21 @@ int XLALSimIMRSEOBNRv5HMROMFrequencySequence(
   SEOBNRROMdataDS *romdataset;
 
   /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
   if (nModes == 1){
     romdataset=__lalsim_SEOBNRv5ROMDS_data;
+#ifdef LAL_PTHREAD_LOCK
     (void) pthread_once(&SEOBNRv5ROM_is_initialized, SEOBNRv5ROM_Init_LALDATA);
-  }
-  else{
-    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
-    (void) pthread_once(&SEOBNRv5HMROM_is_initialized, SEOBNRv5HMROM_Init_LALDATA);
-  }
 #else
-  if (nModes == 1){
     SEOBNRv5ROM_Init_LALDATA();
+#endif
   }
   else{
-    SEOBNRv5HMROM_Init_LALDATA();
+    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
+    if (SEOBNRv5HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+      XLALDestroyValue(ModeArray);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
   }
-#endif
   SphHarmFrequencySeries *hlm = NULL;
 
   // Call the internal core function with deltaF = 0 to indicate that freqs is non-uniformly
@@ -2868,23 +2885,21 @@ int XLALSimIMRSEOBNRv5HMROM_Modes(
   SEOBNRROMdataDS *romdataset;
 
   /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
   if (nModes == 1){
     romdataset=__lalsim_SEOBNRv5ROMDS_data;
+#ifdef LAL_PTHREAD_LOCK
     (void) pthread_once(&SEOBNRv5ROM_is_initialized, SEOBNRv5ROM_Init_LALDATA);
-  }
-  else{
-    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
-    (void) pthread_once(&SEOBNRv5HMROM_is_initialized, SEOBNRv5HMROM_Init_LALDATA);
-  }
 #else
-  if (nModes == 1){
     SEOBNRv5ROM_Init_LALDATA();
+#endif
   }
   else{
-    SEOBNRv5HMROM_Init_LALDATA();
+    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
+    if (SEOBNRv5HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+      XLALDestroyREAL8Sequence(freqs);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
   }
-#endif
 
   /* Generate modes */
   UNUSED UINT8 retcode;
@@ -2974,23 +2989,21 @@ int XLALSimIMRSEOBNRv5HMROMFrequencySequence_Modes(
   SEOBNRROMdataDS *romdataset;
 
   /* Load ROM data if not loaded already */
-#ifdef LAL_PTHREAD_LOCK
   if (nModes == 1){
     romdataset=__lalsim_SEOBNRv5ROMDS_data;
+#ifdef LAL_PTHREAD_LOCK
     (void) pthread_once(&SEOBNRv5ROM_is_initialized, SEOBNRv5ROM_Init_LALDATA);
-  }
-  else{
-    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
-    (void) pthread_once(&SEOBNRv5HMROM_is_initialized, SEOBNRv5HMROM_Init_LALDATA);
-  }
 #else
-  if (nModes == 1){
     SEOBNRv5ROM_Init_LALDATA();
+#endif
   }
   else{
-    SEOBNRv5HMROM_Init_LALDATA();
+    romdataset=__lalsim_SEOBNRv5HMROMDS_data;
+    if (SEOBNRv5HMROM_Init_LALDATA(nModes) != XLAL_SUCCESS) {
+      XLALDestroyValue(ModeArray);
+      XLAL_ERROR(XLAL_EFUNC);
+    }
   }
-#endif
 
   // Call the internal core function with deltaF = 0 to indicate that freqs is non-uniformly
   // spaced and we want the modes only at these frequencies
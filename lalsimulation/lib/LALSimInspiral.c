@@ -547,6 +547,212 @@ int XLALSimInspiralGenerateFDModes(
     XLAL_ERROR(XLAL_EINVAL, "generator does not provide a method to generate frequency-domain modes");
 }
 
+/**
+ * Returns time-domain polarizations for a batch of @p n parameter points.
+ *
+ * `params[i]` holds the parameters of the i-th waveform, which is returned
+ * in `hplus[i]` and `hcross[i]`; as for XLALSimInspiralGenerateTDWaveform(),
+ * each of these must point to NULL.  If the generator provides its own batch
+ * method, which can share precomputation across the batch, it is used;
+ * otherwise the waveforms are generated one after another.  Generators whose
+ * waveform methods are known to be reentrant generate the batch in parallel
+ * using OpenMP if it is enabled, and the number of threads is controlled in
+ * the usual way, e.g. with `OMP_NUM_THREADS`.
+ *
+ * If any waveform fails, the index of the first one is reported and
+ * XLAL_FAILURE is returned; the outputs of the other points are still
+ * valid and must be destroyed by the caller.
+ */
+int XLALSimInspiralGenerateTDWaveformBatch(
+    REAL8TimeSeries **hplus,
+    REAL8TimeSeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *generator
+)
+{
+    XLAL_CHECK(hplus && hcross && params && generator, XLAL_EFAULT);
+
+    if (generator->generate_td_waveform_batch) {
+        if (generator->generate_td_waveform_batch(hplus, hcross, params, n, generator) < 0)
+            XLAL_ERROR(XLAL_EFUNC);
+        return XLAL_SUCCESS;
+    }
+    if (!generator->generate_td_waveform)
+        XLAL_ERROR(XLAL_EINVAL, "generator does not provide a method to generate time-domain waveforms");
+
+    if (XLALSimInspiralGenerateTDWaveformBatchSerial(hplus, hcross, params, n, generator) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Returns frequency-domain polarizations for a batch of @p n parameter points.
+ * See XLALSimInspiralGenerateTDWaveformBatch() for details.
+ */
+int XLALSimInspiralGenerateFDWaveformBatch(
+    COMPLEX16FrequencySeries **hplus,
+    COMPLEX16FrequencySeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *generator
+)
+{
+    XLAL_CHECK(hplus && hcross && params && generator, XLAL_EFAULT);
+
+    if (generator->generate_fd_waveform_batch) {
+        if (generator->generate_fd_waveform_batch(hplus, hcross, params, n, generator) < 0)
+            XLAL_ERROR(XLAL_EFUNC);
+        return XLAL_SUCCESS;
+    }
+    if (!generator->generate_fd_waveform)
+        XLAL_ERROR(XLAL_EINVAL, "generator does not provide a method to generate frequency-domain waveforms");
+
+    if (XLALSimInspiralGenerateFDWaveformBatchSerial(hplus, hcross, params, n, generator) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
+    return XLAL_SUCCESS;
+}
+
+/* Batch methods that generate each waveform in turn on the calling thread,
+ * which is the default; the whole batch is still generated even if some
+ * waveforms fail */
+int XLALSimInspiralGenerateTDWaveformBatchSerial(
+    REAL8TimeSeries **hplus,
+    REAL8TimeSeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *myself
+)
+{
+    size_t i, failed = n;
+    XLAL_CHECK(myself->generate_td_waveform, XLAL_EINVAL, "generator does not provide a method to generate time-domain waveforms");
+    for (i = 0; i < n; ++i)
+        if (XLALSimInspiralGenerateTDWaveform(&hplus[i], &hcross[i], params[i], myself) < 0 && failed == n)
+            failed = i;
+    if (failed < n)
+        XLAL_ERROR(XLAL_EFUNC, "failed to generate waveform %zu of %zu", failed, n);
+    return XLAL_SUCCESS;
+}
+
+int XLALSimInspiralGenerateFDWaveformBatchSerial(
+    COMPLEX16FrequencySeries **hplus,
+    COMPLEX16FrequencySeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *myself
+)
+{
+    size_t i, failed = n;
+    XLAL_CHECK(myself->generate_fd_waveform, XLAL_EINVAL, "generator does not provide a method to generate frequency-domain waveforms");
+    for (i = 0; i < n; ++i)
+        if (XLALSimInspiralGenerateFDWaveform(&hplus[i], &hcross[i], params[i], myself) < 0 && failed == n)
+            failed = i;
+    if (failed < n)
+        XLAL_ERROR(XLAL_EFUNC, "failed to generate waveform %zu of %zu", failed, n);
+    return XLAL_SUCCESS;
+}
+
+/* Batch methods that generate the waveforms in parallel; only generators
+ * whose waveform methods are reentrant may use these */
+int XLALSimInspiralGenerateTDWaveformBatchParallel(
+    REAL8TimeSeries **hplus,
+    REAL8TimeSeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *myself
+)
+{
+    size_t i, failed = n;
+    XLAL_CHECK(myself->generate_td_waveform, XLAL_EINVAL, "generator does not provide a method to generate time-domain waveforms");
+    #pragma omp parallel for schedule(dynamic)
+    for (i = 0; i < n; ++i)
+        if (XLALSimInspiralGenerateTDWaveform(&hplus[i], &hcross[i], params[i], myself) < 0) {
+            #pragma omp critical (XLALSimInspiralGenerateWaveformBatchParallel)
+            failed = i < failed ? i : failed;
+        }
+    if (failed < n)
+        XLAL_ERROR(XLAL_EFUNC, "failed to generate waveform %zu of %zu", failed, n);
+    return XLAL_SUCCESS;
+}
+
+int XLALSimInspiralGenerateFDWaveformBatchParallel(
+    COMPLEX16FrequencySeries **hplus,
+    COMPLEX16FrequencySeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *myself
+)
+{
+    size_t i, failed = n;
+    XLAL_CHECK(myself->generate_fd_waveform, XLAL_EINVAL, "generator does not provide a method to generate frequency-domain waveforms");
+    #pragma omp parallel for schedule(dynamic)
+    for (i = 0; i < n; ++i)
+        if (XLALSimInspiralGenerateFDWaveform(&hplus[i], &hcross[i], params[i], myself) < 0) {
+            #pragma omp critical (XLALSimInspiralGenerateWaveformBatchParallel)
+            failed = i < failed ? i : failed;
+        }
+    if (failed < n)
+        XLAL_ERROR(XLAL_EFUNC, "failed to generate waveform %zu of %zu", failed, n);
+    return XLAL_SUCCESS;
+}
+
+/**
+ * Create the parameter dictionaries of a batch from a table of values.
+ *
+ * The table holds @p nkeys columns of @p n values each, stored one column
+ * after another, so that `values[k * n + i]` is the value of the REAL8
+ * parameter `keys[k]` at the i-th point.  Each dictionary is a copy of
+ * @p common, which may be NULL, with these parameters inserted.  The
+ * result is suitable for XLALSimInspiralGenerateTDWaveformBatch() and
+ * XLALSimInspiralGenerateFDWaveformBatch(), and is freed with
+ * XLALSimInspiralDestroyDictArray().
+ */
+LALDict **XLALSimInspiralCreateDictArrayFromTable(
+    LALDict *common,
+    const char *const *keys,
+    const REAL8 *values,
+    size_t nkeys,
+    size_t n
+)
+{
+    LALDict **params;
+    size_t i, k;
+
+    XLAL_CHECK_NULL(n > 0, XLAL_EINVAL);
+    XLAL_CHECK_NULL(nkeys == 0 || (keys && values), XLAL_EFAULT);
+
+    params = XLALCalloc(n, sizeof(*params));
+    XLAL_CHECK_NULL(params, XLAL_ENOMEM);
+    for (i = 0; i < n; ++i) {
+        params[i] = common ? XLALDictDuplicate(common) : XLALCreateDict();
+        if (!params[i])
+            goto fail;
+        for (k = 0; k < nkeys; ++k)
+            if (XLALDictInsertREAL8Value(params[i], keys[k], values[k * n + i]) < 0)
+                goto fail;
+    }
+    return params;
+
+fail:
+    XLALSimInspiralDestroyDictArray(params, n);
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+}
+
+/**
+ * Destroy an array of dictionaries made by
+ * XLALSimInspiralCreateDictArrayFromTable().
+ */
+void XLALSimInspiralDestroyDictArray(LALDict **params, size_t n)
+{
+    size_t i;
+    if (params) {
+        for (i = 0; i < n; ++i)
+            XLALDestroyDict(params[i]);
+        XLALFree(params);
+    }
+    return;
+}
+
 /** @} */
 
 /**
@@ -2306,12 +2512,9 @@ int XLALSimInspiralPolarizationsFromSphHarmTimeSeries(
                 ts->mode->deltaT, &lalStrainUnit, length);
     memset( (*hp)->data->data, 0, (*hp)->data->length*sizeof(REAL8) );
     memset( (*hc)->data->data, 0, (*hc)->data->length*sizeof(REAL8) );
-    while (ts) { // Add the contribution from the current mode to hp, hx...
-        // This function adds hlm(t) * Y_lm(incl,phiRef) to (h+ - i hx)(t)
-        ret = XLALSimAddMode(*hp, *hc, ts->mode, iota, phiRef, ts->l, ts->m, 0);
-        if( ret != XLAL_SUCCESS ) XLAL_ERROR(XLAL_EFUNC);
-        ts = ts->next;
-    }
+    // Add hlm(t) * Y_lm(incl,phiRef) of every mode to (h+ - i hx)(t)
+    ret = XLALSimAddModesFromSphHarmTimeSeries(*hp, *hc, ts, iota, phiRef);
+    if( ret != XLAL_SUCCESS ) XLAL_ERROR(XLAL_EFUNC);
 
     return XLAL_SUCCESS;
 }
@@ -2507,11 +2710,9 @@ int XLALSimInspiralPolarizationsFromSphHarmFrequencySeries(
 
     SphHarmFrequencySeries *fs = hlms;
     UINT4 len = fs->mode->data->length;
-    INT4 offset = 0;
     /* This is to account that ChooseFDModes return the modes for both negative and positve frequencies,
         but here we return the polarizations just for positive frequencies. */
     len = (UINT4) ceil(len/2.);
-    offset = len-1;
     // Destroy hp, hc FrequencySeries if they already exist
     if( (*hp) ) XLALDestroyCOMPLEX16FrequencySeries( *hp );
     if( (*hc) ) XLALDestroyCOMPLEX16FrequencySeries( *hc );
@@ -2524,19 +2725,8 @@ int XLALSimInspiralPolarizationsFromSphHarmFrequencySeries(
 
 
     /* Build the polarizations by summing the modes */
-    while ( fs ){
-        COMPLEX16 Ylm = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, fs->l, fs->m);
-        COMPLEX16 Ylmstar = conj(Ylm);
-
-        for(UINT4 idx = 0; idx<len; idx++){
-            COMPLEX16 hlm = fs->mode->data->data[idx + offset];
-            COMPLEX16 hlm2 = conj(fs->mode->data->data[len - 1 - idx]);
-            (*hp)->data->data[idx] += 0.5 * (hlm * Ylm + hlm2 * Ylmstar);
-            (*hc)->data->data[idx] += 0.5 * I * (hlm * Ylm - hlm2 * Ylmstar);
-        }
-        fs = fs->next;
-    }
-    XLALDestroySphHarmFrequencySeries(fs);
+    if (XLALSimAddModesFromSphHarmFrequencySeries(*hp, *hc, fs, theta, phi) < 0)
+        XLAL_ERROR(XLAL_EFUNC);
 
     return XLAL_SUCCESS;
 }
@@ -1078,6 +1078,33 @@ int XLALSimInspiralGenerateFDModes(
     LALSimInspiralGenerator *generator
 );
 
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALSimInspiralGenerateTDWaveformBatch(
+    REAL8TimeSeries **hplus,
+    REAL8TimeSeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *generator
+);
+
+int XLALSimInspiralGenerateFDWaveformBatch(
+    COMPLEX16FrequencySeries **hplus,
+    COMPLEX16FrequencySeries **hcross,
+    LALDict **params,
+    size_t n,
+    LALSimInspiralGenerator *generator
+);
+
+LALDict **XLALSimInspiralCreateDictArrayFromTable(
+    LALDict *common,
+    const char *const *keys,
+    const REAL8 *values,
+    size_t nkeys,
+    size_t n
+);
+void XLALSimInspiralDestroyDictArray(LALDict **params, size_t n);
+#endif /* SWIG */
+
 void XLALSimInspiralParseDictionaryToChooseTDWaveform(
     REAL8 *m1,                             /**< [out] mass of companion 1 (kg) */
     REAL8 *m2,                             /**< [out] mass of companion 2 (kg) */
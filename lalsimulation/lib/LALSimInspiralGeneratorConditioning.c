@@ -643,6 +643,11 @@ int XLALSimInspiralGeneratorAddConditioningForApproximant(LALSimInspiralGenerato
     else if (internal_data->generator->generate_td_waveform)
         generator->generate_fd_waveform = generate_conditioned_fd_waveform_from_td;
 
+    /* batch methods of the wrapped generator produce unconditioned
+     * waveforms, so conditioned batches are always generated in turn */
+    generator->generate_td_waveform_batch = NULL;
+    generator->generate_fd_waveform_batch = NULL;
+
     /* FUTURE: implement routines for conditioning modes */
     // generator->generate_td_modes = generate_conditioned_td_modes;
     // generator->generate_fd_modes = generate_conditioned_fd_modes;
@@ -228,6 +228,22 @@ static int generate_td_waveform(
         .internal_data = &_lal ## approx ## GeneratorInternalData \
     };
 
+/* as above, for approximants whose waveforms may be generated concurrently */
+#define DEFINE_REENTRANT_GENERATOR_TEMPLATE(approx, fd_modes, fd_waveform, td_modes, td_waveform) \
+    static Approximant _lal ## approx ## GeneratorInternalData = approx; \
+    const LALSimInspiralGenerator lal ## approx ## GeneratorTemplate = { \
+        .name = #approx,  \
+        .initialize = initialize, \
+        .finalize = NULL, \
+        .generate_fd_modes = fd_modes, \
+        .generate_fd_waveform = fd_waveform, \
+        .generate_td_modes = td_modes, \
+        .generate_td_waveform = td_waveform, \
+        .generate_td_waveform_batch = XLALSimInspiralGenerateTDWaveformBatchParallel, \
+        .generate_fd_waveform_batch = XLALSimInspiralGenerateFDWaveformBatchParallel, \
+        .internal_data = &_lal ## approx ## GeneratorInternalData \
+    };
+
 /* TD POLARIZATIONS ONLY */
 DEFINE_GENERATOR_TEMPLATE(EccentricTD, NULL, NULL, NULL, generate_td_waveform)
 DEFINE_GENERATOR_TEMPLATE(HGimri, NULL, NULL, NULL, generate_td_waveform)
@@ -292,7 +308,7 @@ DEFINE_GENERATOR_TEMPLATE(SEOBNRv4_ROM_NRTidal, NULL, generate_fd_waveform, NULL
 DEFINE_GENERATOR_TEMPLATE(SpinTaylorF2, NULL, generate_fd_waveform, NULL, NULL)
 DEFINE_GENERATOR_TEMPLATE(SpinTaylorT4Fourier, NULL, generate_fd_waveform, NULL, NULL)
 DEFINE_GENERATOR_TEMPLATE(SpinTaylorT5Fourier, NULL, generate_fd_waveform, NULL, NULL)
-DEFINE_GENERATOR_TEMPLATE(TaylorF2, NULL, generate_fd_waveform, NULL, NULL)
+DEFINE_REENTRANT_GENERATOR_TEMPLATE(TaylorF2, NULL, generate_fd_waveform, NULL, NULL)
 DEFINE_GENERATOR_TEMPLATE(TaylorF2Ecc, NULL, generate_fd_waveform, NULL, NULL)
 DEFINE_GENERATOR_TEMPLATE(TaylorF2NLTides, NULL, generate_fd_waveform, NULL, NULL)
 DEFINE_GENERATOR_TEMPLATE(TaylorF2RedSpin, NULL, generate_fd_waveform, NULL, NULL)
@@ -26,6 +26,8 @@ const LALSimInspiralGenerator lalPythonGeneratorTemplate = {
     .generate_fd_waveform = NULL,
     .generate_td_modes = NULL,
     .generate_fd_modes = NULL,
+    .generate_td_waveform_batch = NULL,
+    .generate_fd_waveform_batch = NULL,
     .internal_data = NULL
 };
 
@@ -770,6 +772,10 @@ static int initialize(LALSimInspiralGenerator *myself, LALDict *params)
     if (internal_data->generate_fd_modes)
         myself->generate_fd_modes = generate_fd_modes;
 
+    /* the python interpreter must not be entered from several threads */
+    myself->generate_td_waveform_batch = XLALSimInspiralGenerateTDWaveformBatchSerial;
+    myself->generate_fd_waveform_batch = XLALSimInspiralGenerateFDWaveformBatchSerial;
+
     myself->internal_data = internal_data;
     return 0;
 
@@ -794,6 +800,8 @@ static int finalize(LALSimInspiralGenerator *myself)
     myself->generate_fd_waveform = NULL;
     myself->generate_td_modes = NULL;
     myself->generate_fd_modes = NULL;
+    myself->generate_td_waveform_batch = NULL;
+    myself->generate_fd_waveform_batch = NULL;
     myself->internal_data = NULL;
     /* don't Py_Finalize() since other things might be using the interpreter */
     // Py_Finalize();
@@ -1115,6 +1123,8 @@ const LALSimInspiralGenerator lalPythonGeneratorTemplate = {
     .generate_fd_waveform = generate_fd_waveform,
     .generate_td_modes = generate_td_modes,
     .generate_fd_modes = generate_fd_modes,
+    .generate_td_waveform_batch = XLALSimInspiralGenerateTDWaveformBatchSerial,
+    .generate_fd_waveform_batch = XLALSimInspiralGenerateFDWaveformBatchSerial,
     .internal_data = NULL
 };
 
@@ -40,8 +40,37 @@ struct tagLALSimInspiralGenerator {
         LALSimInspiralGenerator *myself
     );
 
+    /* optional methods to generate many waveforms at once; a generator
+     * can use these to share precomputation across a batch, or set them
+     * to the parallel methods below if its single-waveform methods are
+     * reentrant; by default each waveform is generated in turn */
+    int (*generate_td_waveform_batch) (
+        REAL8TimeSeries **hplus,
+        REAL8TimeSeries **hcross,
+        LALDict **params,
+        size_t n,
+        LALSimInspiralGenerator *myself
+    );
+
+    int (*generate_fd_waveform_batch) (
+        COMPLEX16FrequencySeries **hplus,
+        COMPLEX16FrequencySeries **hcross,
+        LALDict **params,
+        size_t n,
+        LALSimInspiralGenerator *myself
+    );
+
     /* ... */
     void *internal_data;
 };
 
+/* batch methods that generate each waveform in turn on the calling thread */
+int XLALSimInspiralGenerateTDWaveformBatchSerial(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, LALDict **params, size_t n, LALSimInspiralGenerator *myself);
+int XLALSimInspiralGenerateFDWaveformBatchSerial(COMPLEX16FrequencySeries **hplus, COMPLEX16FrequencySeries **hcross, LALDict **params, size_t n, LALSimInspiralGenerator *myself);
+
+/* batch methods that generate the waveforms in parallel with OpenMP; only
+ * for generators whose single-waveform methods are reentrant */
+int XLALSimInspiralGenerateTDWaveformBatchParallel(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, LALDict **params, size_t n, LALSimInspiralGenerator *myself);
+int XLALSimInspiralGenerateFDWaveformBatchParallel(COMPLEX16FrequencySeries **hplus, COMPLEX16FrequencySeries **hcross, LALDict **params, size_t n, LALSimInspiralGenerator *myself);
+
 #endif
@@ -462,13 +462,12 @@ static void TransformModesCoorbitalToInertial(
     gsl_vector **quat,              /**< Coprecessing frame quaternions - 4 vectors. */
     gsl_vector *orbphase            /**< Orbital phase. */
 ) {
-    int i, j, ell, m, mp;
+    int i, j, k, ell, m, mp;
     int n_times = h_coorb->n_times;
     int lmax = h_coorb->lvals[h_coorb->n_modes -1];
     int lmin;
     gsl_vector *cosmphi = gsl_vector_alloc(n_times);
     gsl_vector *sinmphi = gsl_vector_alloc(n_times);
-    gsl_vector *tmp_vec = gsl_vector_alloc(n_times);
 
     // First transform to the coprecessing frame:
     // h^{\ell, m}_\mathrm{copr} = e^{-i m \varphi} h^{\ell, m}_\mathrm{coorb}.
@@ -494,27 +493,20 @@ static void TransformModesCoorbitalToInertial(
             }
             for (ell = lmin; ell<=lmax; ell++) {
                 i = ell*(ell+1) - 4 + m;
-                // compute and add combinations of {real, imag} and {cosmphi, sinmphi}
-                // real * cosmphi
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_coorb->modes_real_part[i]);
-                gsl_vector_mul(tmp_vec, cosmphi);
-                gsl_vector_add(h_copr->modes_real_part[i], tmp_vec);
-                // -1 * real * I * sinmphi
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_coorb->modes_real_part[i]);
-                gsl_vector_mul(tmp_vec, sinmphi);
-                gsl_vector_sub(h_copr->modes_imag_part[i], tmp_vec);
-                // I * imag * cosmphi
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_coorb->modes_imag_part[i]);
-                gsl_vector_mul(tmp_vec, cosmphi);
-                gsl_vector_add(h_copr->modes_imag_part[i], tmp_vec);
-                // imag * sinmphi
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_coorb->modes_imag_part[i]);
-                gsl_vector_mul(tmp_vec, sinmphi);
-                gsl_vector_add(h_copr->modes_real_part[i], tmp_vec);
+                // compute and add combinations of {real, imag} and {cosmphi, sinmphi},
+                // one pass over the time samples per mode
+                const double *re_coorb = h_coorb->modes_real_part[i]->data;
+                const double *im_coorb = h_coorb->modes_imag_part[i]->data;
+                double *re_copr = h_copr->modes_real_part[i]->data;
+                double *im_copr = h_copr->modes_imag_part[i]->data;
+                for (j=0; j<n_times; j++) {
+                    // real * cosmphi - real * I * sinmphi
+                    re_copr[j] += re_coorb[j] * cosmphi->data[j];
+                    im_copr[j] -= re_coorb[j] * sinmphi->data[j];
+                    // I * imag * cosmphi + imag * sinmphi
+                    im_copr[j] += im_coorb[j] * cosmphi->data[j];
+                    re_copr[j] += im_coorb[j] * sinmphi->data[j];
+                }
             }
         }
     }
@@ -530,29 +522,20 @@ static void TransformModesCoorbitalToInertial(
             for (mp = -1 * ell; mp <= ell; mp++) {
                 j = ell*(ell+1) - 4 + mp;
                 matrix_index = WignerDMatrix_Index(ell, m, mp);
-                // Re[h] * Re[D]
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_copr->modes_real_part[j]);
-                gsl_vector_mul(tmp_vec, matrices->real_part[matrix_index]);
-                gsl_vector_add(h->modes_real_part[i], tmp_vec);
-
-                // Re[h] * Im[D]
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_copr->modes_real_part[j]);
-                gsl_vector_mul(tmp_vec, matrices->imag_part[matrix_index]);
-                gsl_vector_add(h->modes_imag_part[i], tmp_vec);
-
-                // Im[h] * Re[D]
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_copr->modes_imag_part[j]);
-                gsl_vector_mul(tmp_vec, matrices->real_part[matrix_index]);
-                gsl_vector_add(h->modes_imag_part[i], tmp_vec);
-
-                // Im[h] * Im[D]
-                gsl_vector_set_zero(tmp_vec);
-                gsl_vector_add(tmp_vec, h_copr->modes_imag_part[j]);
-                gsl_vector_mul(tmp_vec, matrices->imag_part[matrix_index]);
-                gsl_vector_sub(h->modes_real_part[i], tmp_vec);
+                const double *re_copr = h_copr->modes_real_part[j]->data;
+                const double *im_copr = h_copr->modes_imag_part[j]->data;
+                const double *re_D = matrices->real_part[matrix_index]->data;
+                const double *im_D = matrices->imag_part[matrix_index]->data;
+                double *re_h = h->modes_real_part[i]->data;
+                double *im_h = h->modes_imag_part[i]->data;
+                for (k=0; k<n_times; k++) {
+                    // Re[h] * Re[D] + I Re[h] * Im[D]
+                    re_h[k] += re_copr[k] * re_D[k];
+                    im_h[k] += re_copr[k] * im_D[k];
+                    // I Im[h] * Re[D] - Im[h] * Im[D]
+                    im_h[k] += im_copr[k] * re_D[k];
+                    re_h[k] -= im_copr[k] * im_D[k];
+                }
             }
         }
     }
@@ -560,7 +543,6 @@ static void TransformModesCoorbitalToInertial(
     MultiModalWaveform_Destroy(h_copr);
     gsl_vector_free(cosmphi);
     gsl_vector_free(sinmphi);
-    gsl_vector_free(tmp_vec);
 }
 
 /**
@@ -32,6 +32,7 @@
 #ifndef _LALSIMNEUTRONSTAR_H
 #define _LALSIMNEUTRONSTAR_H
 
+#include <stddef.h>
 #include <lal/LALConstants.h>
 
 
@@ -61,6 +62,9 @@ extern const char * const lalSimNeutronStarEOSNames[65];
 /** Incomplete type for a neutron star family having a particular EOS. */
 typedef struct tagLALSimNeutronStarFamily LALSimNeutronStarFamily;
 
+/** Incomplete type for a cache of neutron star family tables. */
+typedef struct tagLALSimNeutronStarFamilyCache LALSimNeutronStarFamilyCache;
+
 void XLALDestroySimNeutronStarEOS(LALSimNeutronStarEOS * eos);
 char *XLALSimNeutronStarEOSName(LALSimNeutronStarEOS * eos);
 
@@ -140,6 +144,19 @@ double XLALSimNeutronStarCentralPressure(double m,
 double XLALSimNeutronStarRadius(double m, LALSimNeutronStarFamily * fam);
 double XLALSimNeutronStarLoveNumberK2(double m, LALSimNeutronStarFamily * fam);
 
+LALSimNeutronStarFamilyCache * XLALCreateSimNeutronStarFamilyCache(
+    size_t capacity);
+void XLALDestroySimNeutronStarFamilyCache(LALSimNeutronStarFamilyCache * cache);
+LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamilyCached(
+    LALSimNeutronStarFamilyCache * cache, const double * key, size_t keylen,
+    LALSimNeutronStarEOS * eos);
+int XLALSimNeutronStarFamilyCacheStats(size_t * hits, size_t * misses,
+    LALSimNeutronStarFamilyCache * cache);
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALCreateSimNeutronStarFamilies(LALSimNeutronStarFamily ** fam,
+    LALSimNeutronStarEOS ** eos, size_t n);
+#endif /* SWIG */
+
 #endif /* _LALSIMNEUTRONSTAR_H */
 
 /** @} */
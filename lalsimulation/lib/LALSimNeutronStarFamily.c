@@ -30,9 +30,15 @@
 #include <gsl/gsl_min.h>
 GSL_VAR const gsl_interp_type * lal_gsl_interp_steffen;
 
+#include <string.h>
 #include <lal/LALStdlib.h>
+#include <lal/LALConfig.h>
 #include <lal/LALSimNeutronStar.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 /** @cond */
 
 /* Contents of the neutron star family structure. */
@@ -50,6 +56,32 @@ struct tagLALSimNeutronStarFamily {
     gsl_interp_accel *k_of_m_acc;
 };
 
+/* An entry of the family cache:  the tables of a family and the key of
+ * the equation of state that produced them. */
+struct family_cache_entry {
+    double *key;
+    size_t keylen;
+    unsigned long used;
+    double *pdat;
+    double *mdat;
+    double *rdat;
+    double *kdat;
+    size_t ndat;
+};
+
+/* Contents of the neutron star family cache structure. */
+struct tagLALSimNeutronStarFamilyCache {
+    struct family_cache_entry *entries;
+    size_t capacity;
+    size_t size;
+    unsigned long clock;
+    size_t hits;
+    size_t misses;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t mutex;
+#endif
+};
+
 /* gsl function for use in finding the maximum neutron star mass */
 static double fminimizer_gslfunction(double x, void * params);
 static double fminimizer_gslfunction(double x, void * params)
@@ -84,6 +116,49 @@ void XLALDestroySimNeutronStarFamily(LALSimNeutronStarFamily * fam)
     return;
 }
 
+/* sets up the interpolators of a family whose tables have been filled in */
+static int neutron_star_family_init(LALSimNeutronStarFamily * fam)
+{
+    size_t ndat = fam->ndat;
+
+    fam->p_of_m_acc = gsl_interp_accel_alloc();
+    fam->r_of_m_acc = gsl_interp_accel_alloc();
+    fam->k_of_m_acc = gsl_interp_accel_alloc();
+
+    fam->p_of_m_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
+    fam->r_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+    fam->k_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+
+    if (!fam->p_of_m_acc || !fam->r_of_m_acc || !fam->k_of_m_acc
+        || !fam->p_of_m_interp || !fam->r_of_m_interp || !fam->k_of_m_interp)
+        XLAL_ERROR(XLAL_ENOMEM);
+
+    gsl_interp_init(fam->p_of_m_interp, fam->mdat, fam->pdat, ndat);
+    gsl_interp_init(fam->r_of_m_interp, fam->mdat, fam->rdat, ndat);
+    gsl_interp_init(fam->k_of_m_interp, fam->mdat, fam->kdat, ndat);
+
+    return 0;
+}
+
+/* allocates a family with no tables */
+static LALSimNeutronStarFamily * neutron_star_family_alloc(size_t ndat)
+{
+    LALSimNeutronStarFamily * fam;
+    fam = LALCalloc(1, sizeof(*fam));
+    if (!fam)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    fam->pdat = LALMalloc(ndat * sizeof(*fam->pdat));
+    fam->mdat = LALMalloc(ndat * sizeof(*fam->mdat));
+    fam->rdat = LALMalloc(ndat * sizeof(*fam->rdat));
+    fam->kdat = LALMalloc(ndat * sizeof(*fam->kdat));
+    fam->ndat = ndat;
+    if (!fam->pdat || !fam->mdat || !fam->rdat || !fam->kdat) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    return fam;
+}
+
 /**
  * @brief Creates a neutron star family structure for a given equation of state.
  * @details
@@ -107,15 +182,9 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     size_t i;
 
     /* allocate memory */
-    fam = LALMalloc(sizeof(*fam));
+    fam = neutron_star_family_alloc(ndat);
     if (!fam)
-        XLAL_ERROR_NULL(XLAL_ENOMEM);
-    fam->pdat = LALMalloc(ndat * sizeof(*fam->pdat));
-    fam->mdat = LALMalloc(ndat * sizeof(*fam->mdat));
-    fam->rdat = LALMalloc(ndat * sizeof(*fam->rdat));
-    fam->kdat = LALMalloc(ndat * sizeof(*fam->kdat));
-    if (!fam->mdat || !fam->rdat || !fam->kdat)
-        XLAL_ERROR_NULL(XLAL_ENOMEM);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
 
     /* compute data tables */
     logpmax = log(XLALSimNeutronStarEOSMaxPressure(eos));
@@ -174,22 +243,290 @@ LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamily(
     fam->ndat = ndat;
 
     /* setup interpolators */
+    if (neutron_star_family_init(fam) < 0) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
 
-    fam->p_of_m_acc = gsl_interp_accel_alloc();
-    fam->r_of_m_acc = gsl_interp_accel_alloc();
-    fam->k_of_m_acc = gsl_interp_accel_alloc();
+    return fam;
+}
 
-    fam->p_of_m_interp = gsl_interp_alloc(gsl_interp_cspline, ndat);
-    fam->r_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
-    fam->k_of_m_interp = gsl_interp_alloc(lal_gsl_interp_steffen, ndat);
+/* builds a family from a copy of the tables of a cache entry */
+static LALSimNeutronStarFamily * neutron_star_family_from_entry(
+    const struct family_cache_entry * entry)
+{
+    LALSimNeutronStarFamily * fam;
+    fam = neutron_star_family_alloc(entry->ndat);
+    if (!fam)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    memcpy(fam->pdat, entry->pdat, entry->ndat * sizeof(*fam->pdat));
+    memcpy(fam->mdat, entry->mdat, entry->ndat * sizeof(*fam->mdat));
+    memcpy(fam->rdat, entry->rdat, entry->ndat * sizeof(*fam->rdat));
+    memcpy(fam->kdat, entry->kdat, entry->ndat * sizeof(*fam->kdat));
+    if (neutron_star_family_init(fam) < 0) {
+        XLALDestroySimNeutronStarFamily(fam);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    return fam;
+}
 
-    gsl_interp_init(fam->p_of_m_interp, fam->mdat, fam->pdat, ndat);
-    gsl_interp_init(fam->r_of_m_interp, fam->mdat, fam->rdat, ndat);
-    gsl_interp_init(fam->k_of_m_interp, fam->mdat, fam->kdat, ndat);
+static void family_cache_entry_clear(struct family_cache_entry * entry)
+{
+    LALFree(entry->key);
+    LALFree(entry->pdat);
+    LALFree(entry->mdat);
+    LALFree(entry->rdat);
+    LALFree(entry->kdat);
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* stores copies of the key and of the tables of a family in an entry */
+static int family_cache_entry_set(struct family_cache_entry * entry,
+    const double * key, size_t keylen, const LALSimNeutronStarFamily * fam)
+{
+    size_t ndat = fam->ndat;
+    entry->key = LALMalloc(keylen * sizeof(*entry->key));
+    entry->pdat = LALMalloc(ndat * sizeof(*entry->pdat));
+    entry->mdat = LALMalloc(ndat * sizeof(*entry->mdat));
+    entry->rdat = LALMalloc(ndat * sizeof(*entry->rdat));
+    entry->kdat = LALMalloc(ndat * sizeof(*entry->kdat));
+    if (!entry->key || !entry->pdat || !entry->mdat || !entry->rdat
+        || !entry->kdat) {
+        family_cache_entry_clear(entry);
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+    memcpy(entry->key, key, keylen * sizeof(*entry->key));
+    memcpy(entry->pdat, fam->pdat, ndat * sizeof(*entry->pdat));
+    memcpy(entry->mdat, fam->mdat, ndat * sizeof(*entry->mdat));
+    memcpy(entry->rdat, fam->rdat, ndat * sizeof(*entry->rdat));
+    memcpy(entry->kdat, fam->kdat, ndat * sizeof(*entry->kdat));
+    entry->keylen = keylen;
+    entry->ndat = ndat;
+    return 0;
+}
+
+/* returns the entry with the given key, or NULL; the cache must be locked */
+static struct family_cache_entry * family_cache_find(
+    LALSimNeutronStarFamilyCache * cache, const double * key, size_t keylen)
+{
+    size_t i;
+    for (i = 0; i < cache->size; ++i) {
+        struct family_cache_entry * entry = &cache->entries[i];
+        if (entry->keylen == keylen
+            && memcmp(entry->key, key, keylen * sizeof(*key)) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Creates a cache of neutron star family tables.
+ * @details
+ * Constructing a neutron star family requires of order a hundred solutions
+ * of the TOV equations, which dominates the cost of any calculation that
+ * converts equation of state parameters into radii or tidal deformabilities.
+ * Samplers frequently revisit the same equation of state (e.g., when only
+ * the masses change between proposals), so the tables of recently
+ * constructed families can be kept in a cache and reused.
+ *
+ * The cache holds up to @a capacity tables, each identified by a key vector
+ * of doubles supplied by the caller (usually the parameters of the
+ * equation of state, together with something to distinguish different
+ * parameterisations).  When the cache is full the least recently used
+ * table is discarded.  The cache may be shared between threads.
+ *
+ * @param capacity Maximum number of families held in the cache.
+ * @return A pointer to the cache structure.
+ * @sa XLALCreateSimNeutronStarFamilyCached
+ */
+LALSimNeutronStarFamilyCache * XLALCreateSimNeutronStarFamilyCache(
+    size_t capacity)
+{
+    LALSimNeutronStarFamilyCache * cache;
+    XLAL_CHECK_NULL(capacity > 0, XLAL_EINVAL, "Cache capacity must be positive");
+    cache = LALCalloc(1, sizeof(*cache));
+    if (!cache)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    cache->entries = LALCalloc(capacity, sizeof(*cache->entries));
+    if (!cache->entries) {
+        LALFree(cache);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+    cache->capacity = capacity;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_init(&cache->mutex, NULL);
+#endif
+    return cache;
+}
+
+/**
+ * @brief Frees the memory associated with a neutron star family cache.
+ * @details
+ * Families previously returned by XLALCreateSimNeutronStarFamilyCached()
+ * are independent of the cache and remain valid.
+ * @param cache Pointer to the cache structure to be freed.
+ */
+void XLALDestroySimNeutronStarFamilyCache(LALSimNeutronStarFamilyCache * cache)
+{
+    if (cache) {
+        size_t i;
+        for (i = 0; i < cache->size; ++i)
+            family_cache_entry_clear(&cache->entries[i]);
+#ifdef LAL_PTHREAD_LOCK
+        pthread_mutex_destroy(&cache->mutex);
+#endif
+        LALFree(cache->entries);
+        LALFree(cache);
+    }
+    return;
+}
+
+/**
+ * @brief Creates a neutron star family, reusing cached tables if possible.
+ * @details
+ * If the cache holds tables for @a key then the family is constructed from
+ * them without solving the TOV equations; otherwise the family is computed
+ * with XLALCreateSimNeutronStarFamily() and its tables are added to the
+ * cache.  Either way the returned family is identical to the one that
+ * XLALCreateSimNeutronStarFamily() would produce, belongs to the caller,
+ * and must be freed with XLALDestroySimNeutronStarFamily().
+ *
+ * The caller is responsible for ensuring that equal keys correspond to
+ * equal equations of state.
+ *
+ * @param cache Pointer to the cache structure.
+ * @param key Vector of doubles identifying the equation of state.
+ * @param keylen Length of the key vector.
+ * @param eos Pointer to the Equation of State structure.
+ * @return A pointer to the neutron star family structure.
+ */
+LALSimNeutronStarFamily * XLALCreateSimNeutronStarFamilyCached(
+    LALSimNeutronStarFamilyCache * cache, const double * key, size_t keylen,
+    LALSimNeutronStarEOS * eos)
+{
+    LALSimNeutronStarFamily * fam = NULL;
+    struct family_cache_entry * entry;
+
+    XLAL_CHECK_NULL(cache, XLAL_EFAULT);
+    XLAL_CHECK_NULL(key && keylen > 0, XLAL_EINVAL, "Invalid cache key");
+    XLAL_CHECK_NULL(eos, XLAL_EFAULT);
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    entry = family_cache_find(cache, key, keylen);
+    if (entry) {
+        entry->used = ++cache->clock;
+        ++cache->hits;
+        fam = neutron_star_family_from_entry(entry);
+    }
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    if (entry) {
+        if (!fam)
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        return fam;
+    }
+
+    /* not found: solve without holding the lock */
+    fam = XLALCreateSimNeutronStarFamily(eos);
+    if (!fam)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    ++cache->misses;
+    /* another thread may have added the same key in the meantime */
+    if (!family_cache_find(cache, key, keylen)) {
+        if (cache->size < cache->capacity)
+            entry = &cache->entries[cache->size++];
+        else {
+            size_t i;
+            entry = &cache->entries[0];
+            for (i = 1; i < cache->size; ++i)
+                if (cache->entries[i].used < entry->used)
+                    entry = &cache->entries[i];
+            family_cache_entry_clear(entry);
+        }
+        if (family_cache_entry_set(entry, key, keylen, fam) < 0) {
+            /* keep the entries contiguous; failing to cache is not fatal */
+            *entry = cache->entries[--cache->size];
+            memset(&cache->entries[cache->size], 0, sizeof(*entry));
+            XLALClearErrno();
+        } else
+            entry->used = ++cache->clock;
+    }
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_unlock(&cache->mutex);
+#endif
 
     return fam;
 }
 
+/**
+ * @brief Returns the number of cache hits and misses.
+ * @param[out] hits Number of families constructed from cached tables.
+ * @param[out] misses Number of families that required a TOV solve.
+ * @param cache Pointer to the cache structure.
+ * @return Zero on success, or a negative value on failure.
+ */
+int XLALSimNeutronStarFamilyCacheStats(size_t * hits, size_t * misses,
+    LALSimNeutronStarFamilyCache * cache)
+{
+    XLAL_CHECK(cache, XLAL_EFAULT);
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_lock(&cache->mutex);
+#endif
+    if (hits)
+        *hits = cache->hits;
+    if (misses)
+        *misses = cache->misses;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_unlock(&cache->mutex);
+#endif
+    return 0;
+}
+
+/**
+ * @brief Creates neutron star families for several equations of state.
+ * @details
+ * The families are computed in parallel (when OpenMP is enabled).  Each
+ * element of @a eos must be a distinct equation of state structure since
+ * an equation of state cannot be evaluated by several threads at once.
+ * On failure no families are returned.
+ * @param[out] fam Array of @a n pointers to the neutron star families.
+ * @param eos Array of @a n pointers to the Equation of State structures.
+ * @param n Number of equations of state.
+ * @return Zero on success, or a negative value on failure.
+ */
+int XLALCreateSimNeutronStarFamilies(LALSimNeutronStarFamily ** fam,
+    LALSimNeutronStarEOS ** eos, size_t n)
+{
+    int failed = 0;
+    size_t i;
+
+    XLAL_CHECK(fam && eos, XLAL_EFAULT);
+
+    #pragma omp parallel for reduction(+:failed)
+    for (i = 0; i < n; ++i) {
+        fam[i] = XLALCreateSimNeutronStarFamily(eos[i]);
+        if (!fam[i])
+            ++failed;
+    }
+
+    if (failed) {
+        for (i = 0; i < n; ++i) {
+            XLALDestroySimNeutronStarFamily(fam[i]);
+            fam[i] = NULL;
+        }
+        XLAL_ERROR(XLAL_EFUNC, "Failed to create %d neutron star families", failed);
+    }
+
+    return 0;
+}
+
 /**
  * @brief Returns the minimum mass of a neutron star family.
  * @param fam Pointer to the neutron star family structure.
@@ -34,6 +34,27 @@
 #include <lal/LALSimNoise.h>
 
 
+/*
+ * Fill the n frequency bins of stilde with complex Gaussian deviates of
+ * standard deviation sigma[k] in each of the real and imaginary parts.  The
+ * unit deviates are drawn in one pass and scaled in a second, vectorizable,
+ * pass.  gsl_ran_gaussian_ziggurat(rng, sigma) is sigma times a unit
+ * deviate, so the result is identical to drawing bin by bin.
+ */
+static void XLALSimNoiseFill(COMPLEX16 *stilde, const double *sigma, size_t n, gsl_rng *rng)
+{
+	double *x = (double *)stilde;
+	size_t k;
+
+	for (k = 0; k < 2 * n; ++k)
+		x[k] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+	for (k = 0; k < n; ++k) {
+		x[2 * k] *= sigma[k];
+		x[2 * k + 1] *= sigma[k];
+	}
+	return;
+}
+
 /* 
  * This routine generates a single segment of data.  Note that this segment is
  * generated in the frequency domain and is inverse Fourier transformed into
@@ -44,13 +65,17 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
 	size_t k;
 	REAL8FFTPlan *plan;
 	COMPLEX16FrequencySeries *stilde;
+	REAL8Sequence *sigma;
 
 	plan = XLALCreateReverseREAL8FFTPlan(s->data->length, 0);
 	if (! plan)
 		XLAL_ERROR(XLAL_EFUNC);
 
 	stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &s->epoch, 0.0, 1.0/(s->data->length * s->deltaT), &lalDimensionlessUnit, s->data->length/2 + 1);
-	if (! stilde) {
+	sigma = XLALCreateREAL8Sequence(s->data->length/2 + 1);
+	if (! stilde || ! sigma) {
+		XLALDestroyCOMPLEX16FrequencySeries(stilde);
+		XLALDestroyREAL8Sequence(sigma);
 		XLALDestroyREAL8FFTPlan(plan);
 		XLAL_ERROR(XLAL_EFUNC);
 	}
@@ -59,20 +84,35 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
 	XLALUnitMultiply(&stilde->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
 	XLALUnitSqrt(&stilde->sampleUnits, &stilde->sampleUnits);
 
-	stilde->data->data[0] = 0.0;
-	for (k = 0; k < s->data->length/2 + 1; ++k) {
-		double sigma = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
-		stilde->data->data[k] = gsl_ran_gaussian_ziggurat(rng, sigma);
-		stilde->data->data[k] += I * gsl_ran_gaussian_ziggurat(rng, sigma);
-	}
+	for (k = 0; k < sigma->length; ++k)
+		sigma->data[k] = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
+	XLALSimNoiseFill(stilde->data->data, sigma->data, sigma->length, rng);
 
 	XLALREAL8FreqTimeFFT(s, stilde, plan);
 
+	XLALDestroyREAL8Sequence(sigma);
 	XLALDestroyCOMPLEX16FrequencySeries(stilde);
 	XLALDestroyREAL8FFTPlan(plan);
 	return 0;
 }
 
+/*
+ * Persistent state of a noise stream:  everything XLALSimNoise() derives
+ * from the length, stride and PSD on each call.
+ */
+struct tagLALSimNoiseStream {
+	size_t length;			/* segment length (samples) */
+	size_t stride;			/* stride (samples) */
+	double deltaF;			/* frequency resolution of the PSD */
+	int initialized;		/* non-zero once the first segment exists */
+	REAL8FFTPlan *plan;		/* reverse plan of the segment length */
+	COMPLEX16FrequencySeries *stilde; /* frequency-domain work space */
+	REAL8Sequence *sigma;		/* standard deviation of each bin */
+	REAL8Sequence *overlap;		/* old data in the overlap region */
+	REAL8Sequence *fadeout;		/* feathering window for old data */
+	REAL8Sequence *fadein;		/* feathering window for new data */
+};
+
 /**
  * @addtogroup LALSimNoise_c
  * @brief Routines to produce a continuous stream of simulated
@@ -139,6 +179,11 @@ static int XLALSimNoiseSegment(REAL8TimeSeries *s, REAL8FrequencySeries *psd, gs
  *   noise by generating two different realizations and feathering them
  *   together.
  *
+ * - Each call creates an FFT plan and work space and recomputes the bin
+ *   standard deviations from the PSD.  To generate long stretches of data
+ *   with a fixed stride and PSD, use XLALSimNoiseCreateStream() and
+ *   XLALSimNoiseStreamNext() instead, which produce the same output.
+ *
  * @warning Only the first stride points are valid.
  */
 int XLALSimNoise(
@@ -197,6 +242,194 @@ int XLALSimNoise(
 	return 0;
 }
 
+/**
+ * @brief Creates a stream object for generating sequential segments of
+ * noise with a fixed length, stride and PSD.
+ *
+ * The stream retains the FFT plan, the frequency-domain work space, the
+ * per-bin standard deviations derived from the PSD and the feathering
+ * window, so that successive calls to XLALSimNoiseStreamNext() do no
+ * allocation.  The PSD is copied and may be freed after this call.
+ *
+ * @sa XLALSimNoise() for the meaning of the stride.
+ */
+LALSimNoiseStream *XLALSimNoiseCreateStream(
+	size_t length,			/**< [in] segment length (samples) */
+	size_t stride,			/**< [in] stride (samples) */
+	const REAL8FrequencySeries *psd	/**< [in] power spectrum frequency series */
+)
+{
+	LALSimNoiseStream *stream;
+	size_t noverlap;
+	size_t j, k;
+
+	if (! psd)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (length == 0 || stride == 0 || stride > length || length/2 + 1 != psd->data->length || psd->deltaF <= 0.0)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	stream = XLALCalloc(1, sizeof(*stream));
+	if (! stream)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	stream->length = length;
+	stream->stride = stride;
+	stream->deltaF = psd->deltaF;
+
+	/* a stride of the full length feathers two independent realizations
+	 * together with full overlap */
+	noverlap = stride == length ? length : length - stride;
+
+	stream->plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	stream->stilde = XLALCreateCOMPLEX16FrequencySeries("STILDE", &psd->epoch, 0.0, psd->deltaF, &lalDimensionlessUnit, length/2 + 1);
+	stream->sigma = XLALCreateREAL8Sequence(length/2 + 1);
+	stream->overlap = XLALCreateREAL8Sequence(noverlap);
+	stream->fadeout = XLALCreateREAL8Sequence(noverlap);
+	stream->fadein = XLALCreateREAL8Sequence(noverlap);
+	if (! stream->plan || ! stream->stilde || ! stream->sigma || ! stream->overlap || ! stream->fadeout || ! stream->fadein) {
+		XLALSimNoiseDestroyStream(stream);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	/* correct units: [stilde] = sqrt([psd] * seconds) */
+	XLALUnitMultiply(&stream->stilde->sampleUnits, &psd->sampleUnits, &lalSecondUnit);
+	XLALUnitSqrt(&stream->stilde->sampleUnits, &stream->stilde->sampleUnits);
+
+	for (k = 0; k < stream->sigma->length; ++k)
+		stream->sigma->data[k] = 0.5 * sqrt(psd->data->data[k] / psd->deltaF);
+
+	for (j = 0; j < noverlap; ++j) {
+		stream->fadeout->data[j] = cos(LAL_PI*j/(2.0 * noverlap));
+		stream->fadein->data[j] = sin(LAL_PI*j/(2.0 * noverlap));
+	}
+
+	return stream;
+}
+
+/**
+ * @brief Destroys a noise stream object.
+ */
+void XLALSimNoiseDestroyStream(LALSimNoiseStream *stream)
+{
+	if (stream) {
+		XLALDestroyREAL8FFTPlan(stream->plan);
+		XLALDestroyCOMPLEX16FrequencySeries(stream->stilde);
+		XLALDestroyREAL8Sequence(stream->sigma);
+		XLALDestroyREAL8Sequence(stream->overlap);
+		XLALDestroyREAL8Sequence(stream->fadeout);
+		XLALDestroyREAL8Sequence(stream->fadein);
+		XLALFree(stream);
+	}
+	return;
+}
+
+/* generate one periodic segment into s using the stream's work space */
+static int XLALSimNoiseStreamSegment(LALSimNoiseStream *stream, REAL8TimeSeries *s, gsl_rng *rng)
+{
+	stream->stilde->epoch = s->epoch;
+	stream->stilde->deltaF = 1.0/(s->data->length * s->deltaT);
+	XLALSimNoiseFill(stream->stilde->data->data, stream->sigma->data, stream->sigma->length, rng);
+	if (XLALREAL8FreqTimeFFT(s, stream->stilde, stream->plan) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+/**
+ * @brief Generates the next segment of a noise stream.
+ *
+ * The first call initializes s with one (periodic) realization of noise,
+ * and subsequent calls advance s by the stride of the stream, exactly as
+ * calling XLALSimNoise() first with a stride of 0 and then with the
+ * stream's stride.  Given the same random number generator state the
+ * output is identical to that of XLALSimNoise().
+ *
+ * @warning Only the first stride points are valid.
+ */
+int XLALSimNoiseStreamNext(
+	LALSimNoiseStream *stream,	/**< [in/out] noise stream */
+	REAL8TimeSeries *s,		/**< [in/out] noise time series */
+	gsl_rng *rng			/**< [in] GSL random number generator */
+)
+{
+	size_t stride;
+	size_t j;
+
+	if (! stream || ! s || ! rng)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested time series */
+	if (s->data->length != stream->length
+			|| (size_t)floor(0.5 + 1.0/(s->deltaT * stream->deltaF)) != s->data->length)
+		XLAL_ERROR(XLAL_EINVAL);
+
+	if (! stream->initialized) { /* generate segment with no feathering */
+		if (XLALSimNoiseStreamSegment(stream, s, rng) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		stream->initialized = 1;
+		return 0;
+	}
+
+	stride = stream->stride;
+	if (stride == stream->length) {
+		/* will generate two independent noise realizations
+		 * and feather them together with full overlap */
+		if (XLALSimNoiseStreamSegment(stream, s, rng) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		stride = 0;
+	}
+
+	/* copy overlap region between the old and the new data to temporary storage */
+	memcpy(stream->overlap->data, s->data->data + stride, stream->overlap->length*sizeof(*stream->overlap->data));
+
+	/* generate the new data */
+	if (XLALSimNoiseStreamSegment(stream, s, rng) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* feather old data in overlap region with new data */
+	for (j = 0; j < stream->overlap->length; ++j)
+		s->data->data[j] = stream->fadeout->data[j]*stream->overlap->data[j] + stream->fadein->data[j]*s->data->data[j];
+
+	/* advance time */
+	XLALGPSAdd(&s->epoch, stride * s->deltaT);
+	return 0;
+}
+
+/**
+ * @brief Generates the next segment of several noise streams, e.g., one
+ * for each detector of a network.
+ *
+ * Equivalent to calling XLALSimNoiseStreamNext() on each stream in turn
+ * with the corresponding time series and random number generator, except
+ * that the streams are processed in parallel if OpenMP is enabled.  The
+ * random number generators must therefore be distinct.
+ */
+int XLALSimNoiseStreamNextNetwork(
+	LALSimNoiseStream **streams,	/**< [in/out] noise streams */
+	REAL8TimeSeries **s,		/**< [in/out] noise time series, one per stream */
+	gsl_rng **rngs,			/**< [in] GSL random number generators, one per stream */
+	size_t n			/**< [in] number of streams */
+)
+{
+	int failed = 0;
+	long i, j;
+
+	if (n && (! streams || ! s || ! rngs))
+		XLAL_ERROR(XLAL_EFAULT);
+	for (i = 0; i < (long) n; ++i)
+		for (j = 0; j < i; ++j)
+			if (rngs[j] == rngs[i] || streams[j] == streams[i])
+				XLAL_ERROR(XLAL_EINVAL, "streams and random number generators must be distinct");
+
+	#pragma omp parallel for reduction(+:failed)
+	for (i = 0; i < (long) n; ++i)
+		if (XLALSimNoiseStreamNext(streams[i], s[i], rngs[i]) < 0)
+			failed += 1;
+
+	if (failed)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
 /** @} */
 
 /*
@@ -70,6 +70,15 @@ SWIGLAL(FUNCTION_POINTER(aLIGOQuantumHighFrequency, XLALSimNoisePSDAdvVirgo,
 
 int XLALSimNoise(REAL8TimeSeries *s, size_t stride, REAL8FrequencySeries *psd, gsl_rng *rng);
 
+/** Opaque type of a stream of noise segments; see XLALSimNoiseCreateStream() */
+typedef struct tagLALSimNoiseStream LALSimNoiseStream;
+LALSimNoiseStream *XLALSimNoiseCreateStream(size_t length, size_t stride, const REAL8FrequencySeries *psd);
+void XLALSimNoiseDestroyStream(LALSimNoiseStream *stream);
+int XLALSimNoiseStreamNext(LALSimNoiseStream *stream, REAL8TimeSeries *s, gsl_rng *rng);
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALSimNoiseStreamNextNetwork(LALSimNoiseStream **streams, REAL8TimeSeries **s, gsl_rng **rngs, size_t n);
+#endif /* SWIG */
+
 
 /*
  * PSD GENERATION FUNCTIONS
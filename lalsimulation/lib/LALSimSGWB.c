@@ -20,6 +20,7 @@
 #include <complex.h>
 #include <math.h>
 #include <stdio.h>
+#include <gsl/gsl_errno.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_randist.h>
@@ -268,6 +269,10 @@ REAL8FrequencySeries *XLALSimSGWBOmegaGWPowerLawSpectrum(
  * - If stride = h->data->length then generate one segment of non-periodic
  *   noise by generating two different realizations and feathering them
  *   together.
+ * - Each call recomputes the overlap reduction functions and their Cholesky
+ *   factors at every frequency.  To generate long stretches of data with a
+ *   fixed stride and spectrum, use XLALSimSGWBCreateStream() and
+ *   XLALSimSGWBStreamNext() instead, which produce the same output.
  *
  * @warning Only the first stride points are valid.
  */
@@ -553,6 +558,334 @@ int XLALSimSGWBPowerLawSpectrum(
 	return 0;
 }
 
+/*
+ * Persistent state of an SGWB stream:  everything XLALSimSGWB() derives
+ * from the network, the segment length and the spectrum on each call.
+ * The lower triangles of the Cholesky factors of the correlation matrices
+ * are stored packed, with element (i, j) of every frequency bin
+ * contiguous so that the mixing vectorizes over frequency.
+ */
+struct tagLALSimSGWBStream {
+	size_t numDetectors;
+	size_t length;			/* segment length (samples) */
+	size_t stride;			/* stride (samples) */
+	double deltaT;			/* sample interval (s) */
+	int initialized;		/* non-zero once the first segment exists */
+	REAL8FFTPlan *plan;		/* reverse plan of the segment length */
+	COMPLEX16FrequencySeries **htilde; /* frequency-domain work space */
+	REAL8Sequence *sigma;		/* standard deviation of each bin */
+	REAL8Sequence *cholesky;	/* packed Cholesky factors */
+	REAL8Sequence *deviates;	/* unit deviates for one segment */
+	REAL8Sequence **overlap;	/* old data in the overlap region */
+	REAL8Sequence *fadeout;		/* feathering window for old data */
+	REAL8Sequence *fadein;		/* feathering window for new data */
+};
+
+/* offset in the packed Cholesky factors of element (i, j), j <= i */
+#define SGWB_PACKED_INDEX(i, j) ((i) * ((i) + 1) / 2 + (j))
+
+/*
+ * Cholesky factor of the correlation matrix of the network at frequency
+ * f, exactly as constructed by XLALSimSGWBSegment(), stored into packed
+ * element (i, j) of bin k.
+ */
+static int XLALSimSGWBStreamCholesky(LALSimSGWBStream *stream, const LALDetector *detectors, gsl_matrix *R, size_t k, double f)
+{
+	const size_t nbins = stream->length/2 + 1;
+	size_t i, j;
+
+	gsl_matrix_set_identity(R);
+	for (i = 0; i < stream->numDetectors; ++i)
+		for (j = i + 1; j < stream->numDetectors; ++j) {
+			double Rij = XLALSimSGWBOverlapReductionFunction(f, &detectors[i], &detectors[j]);
+			/* see XLALSimSGWBSegment() */
+			if (fabs(Rij - 1.0) < LAL_REAL4_EPS)
+				Rij = 1.0 - LAL_REAL4_EPS;
+			gsl_matrix_set(R, i, j, Rij);
+			gsl_matrix_set(R, j, i, Rij);
+		}
+	if (gsl_linalg_cholesky_decomp(R))
+		return -1;
+	for (i = 0; i < stream->numDetectors; ++i)
+		for (j = 0; j <= i; ++j)
+			stream->cholesky->data[SGWB_PACKED_INDEX(i, j) * nbins + k] = gsl_matrix_get(R, i, j);
+	return 0;
+}
+
+/**
+ * Creates a stream object for generating sequential segments of
+ * stochastic background signals for a network of detectors with a fixed
+ * segment length, stride and spectrum.
+ *
+ * The overlap reduction functions, the Cholesky factors of the correlation
+ * matrices and the standard deviation of each frequency bin are computed
+ * once, here, in parallel over frequency if OpenMP is enabled.  The stream
+ * also retains the FFT plan, the frequency-domain work space and the
+ * feathering window.  The detectors and the spectrum are not referenced
+ * after this call.
+ *
+ * @sa XLALSimSGWB() for the meaning of the stride.
+ */
+LALSimSGWBStream *XLALSimSGWBCreateStream(
+	const LALDetector *detectors,		/**< [in] array of detectors in network */
+	size_t numDetectors,			/**< [in] number of detectors in network */
+	size_t length,				/**< [in] segment length (samples) */
+	double deltaT,				/**< [in] sample interval (s) */
+	size_t stride,				/**< [in] stride (samples) */
+	const REAL8FrequencySeries *OmegaGW,	/**< [in] sgwb spectrum frequeny series */
+	double H0				/**< [in] Hubble's constant (s) */
+)
+{
+	gsl_error_handler_t *saveGSLErrorHandler;
+	LALSimSGWBStream *stream;
+	size_t noverlap;
+	double psdfac;
+	double deltaF;
+	size_t nbins;
+	size_t i, j;
+	long k;
+	int failed = 0;
+
+	if (! detectors || ! OmegaGW)
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if (numDetectors == 0 || length < 2 || stride == 0 || stride > length || ! (deltaT > 0.0))
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	/* make sure that the resolution of the frequency series is
+	 * commensurate with the requested time series */
+	if (length/2 + 1 != OmegaGW->data->length
+			|| (size_t)floor(0.5 + 1.0/(deltaT * OmegaGW->deltaF)) != length)
+		XLAL_ERROR_NULL(XLAL_EINVAL);
+
+	stream = XLALCalloc(1, sizeof(*stream));
+	if (! stream)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	stream->numDetectors = numDetectors;
+	stream->length = length;
+	stream->stride = stride;
+	stream->deltaT = deltaT;
+
+	/* a stride of the full length feathers two independent realizations
+	 * together with full overlap */
+	noverlap = stride == length ? length : length - stride;
+	nbins = length/2 + 1;
+	deltaF = 1.0 / (length * deltaT);
+
+	stream->plan = XLALCreateReverseREAL8FFTPlan(length, 0);
+	stream->htilde = XLALCalloc(numDetectors, sizeof(*stream->htilde));
+	stream->overlap = XLALCalloc(numDetectors, sizeof(*stream->overlap));
+	stream->sigma = XLALCreateREAL8Sequence(nbins);
+	stream->cholesky = XLALCreateREAL8Sequence(numDetectors * (numDetectors + 1) / 2 * nbins);
+	stream->deviates = XLALCreateREAL8Sequence(2 * numDetectors * nbins);
+	stream->fadeout = XLALCreateREAL8Sequence(noverlap);
+	stream->fadein = XLALCreateREAL8Sequence(noverlap);
+	if (! stream->plan || ! stream->htilde || ! stream->overlap || ! stream->sigma || ! stream->cholesky || ! stream->deviates || ! stream->fadeout || ! stream->fadein) {
+		XLALSimSGWBDestroyStream(stream);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+	for (i = 0; i < numDetectors; ++i) {
+		stream->htilde[i] = XLALCreateCOMPLEX16FrequencySeries("STILDE", &OmegaGW->epoch, 0.0, deltaF, &lalSecondUnit, nbins);
+		stream->overlap[i] = XLALCreateREAL8Sequence(noverlap);
+		if (! stream->htilde[i] || ! stream->overlap[i]) {
+			XLALSimSGWBDestroyStream(stream);
+			XLAL_ERROR_NULL(XLAL_EFUNC);
+		}
+	}
+
+	/* DC and Nyquist components are not generated */
+	memset(stream->sigma->data, 0, stream->sigma->length * sizeof(*stream->sigma->data));
+	memset(stream->cholesky->data, 0, stream->cholesky->length * sizeof(*stream->cholesky->data));
+
+	/* the GSL error handler is turned off while the matrices are
+	 * factored in parallel; failures are reported below */
+	psdfac = 0.3 * pow(H0 / LAL_PI, 2.0);
+	saveGSLErrorHandler = gsl_set_error_handler_off();
+	#pragma omp parallel reduction(+:failed)
+	{
+		gsl_matrix *R = gsl_matrix_alloc(numDetectors, numDetectors);
+		if (! R)
+			failed += 1;
+		#pragma omp for
+		for (k = 1; k < (long) (length/2); ++k) {
+			double f = k * deltaF;
+			stream->sigma->data[k] = 0.5 * sqrt(psdfac * OmegaGW->data->data[k] * pow(f, -3.0) / deltaF);
+			if (R && XLALSimSGWBStreamCholesky(stream, detectors, R, k, f) < 0)
+				failed += 1;
+		}
+		gsl_matrix_free(R);
+	}
+	gsl_set_error_handler(saveGSLErrorHandler);
+	if (failed) {
+		XLALSimSGWBDestroyStream(stream);
+		XLAL_ERROR_NULL(XLAL_EFAILED, "could not factor the correlation matrix of the network");
+	}
+
+	for (j = 0; j < noverlap; ++j) {
+		stream->fadeout->data[j] = cos(LAL_PI*j/(2.0 * noverlap));
+		stream->fadein->data[j] = sin(LAL_PI*j/(2.0 * noverlap));
+	}
+
+	return stream;
+}
+
+/**
+ * Destroys an SGWB stream object.
+ */
+void XLALSimSGWBDestroyStream(LALSimSGWBStream *stream)
+{
+	size_t i;
+	if (! stream)
+		return;
+	for (i = 0; i < stream->numDetectors; ++i) {
+		if (stream->htilde)
+			XLALDestroyCOMPLEX16FrequencySeries(stream->htilde[i]);
+		if (stream->overlap)
+			XLALDestroyREAL8Sequence(stream->overlap[i]);
+	}
+	XLALFree(stream->htilde);
+	XLALFree(stream->overlap);
+	XLALDestroyREAL8FFTPlan(stream->plan);
+	XLALDestroyREAL8Sequence(stream->sigma);
+	XLALDestroyREAL8Sequence(stream->cholesky);
+	XLALDestroyREAL8Sequence(stream->deviates);
+	XLALDestroyREAL8Sequence(stream->fadeout);
+	XLALDestroyREAL8Sequence(stream->fadein);
+	XLALFree(stream);
+	return;
+}
+
+/*
+ * Generate one periodic segment into h.  All the deviates are drawn first,
+ * in the order used by XLALSimSGWBSegment(), so the random number stream
+ * is consumed deterministically; the detectors are then mixed and
+ * transformed independently, in parallel if OpenMP is enabled.
+ */
+static int XLALSimSGWBStreamSegment(LALSimSGWBStream *stream, REAL8TimeSeries **h, gsl_rng *rng)
+{
+	const size_t numDetectors = stream->numDetectors;
+	const size_t nbins = stream->length/2 + 1;
+	const double *sigma = stream->sigma->data;
+	const double *x = stream->deviates->data;
+	int failed = 0;
+	size_t k;
+	long i;
+
+	/* deviates for bins 1 to length/2 - 1 (excluding DC and Nyquist) */
+	for (k = 2 * numDetectors; k < 2 * numDetectors * (stream->length/2); ++k)
+		stream->deviates->data[k] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+
+	#pragma omp parallel for reduction(+:failed)
+	for (i = 0; i < (long) numDetectors; ++i) {
+		COMPLEX16FrequencySeries *htilde = stream->htilde[i];
+		double *out = (double *)htilde->data->data;
+		size_t j, kk;
+
+		htilde->epoch = h[0]->epoch;
+		htilde->deltaF = 1.0 / (stream->length * h[0]->deltaT);
+		htilde->sampleUnits = lalSecondUnit;
+		XLALUnitMultiply(&htilde->sampleUnits, &htilde->sampleUnits, &h[i]->sampleUnits);
+		memset(out, 0, 2 * nbins * sizeof(*out));
+
+		/* lower-diagonal part of Cholesky decomposition creates the
+		 * correlations; accumulate over j in the same order as
+		 * XLALSimSGWBSegment() */
+		for (j = 0; j <= (size_t) i; ++j) {
+			const double *Rij = stream->cholesky->data + SGWB_PACKED_INDEX((size_t) i, j) * nbins;
+			for (kk = 1; kk < stream->length/2; ++kk) {
+				const double re = sigma[kk] * x[2 * (kk * numDetectors + j)];
+				const double im = sigma[kk] * x[2 * (kk * numDetectors + j) + 1];
+				out[2 * kk] += Rij[kk] * re;
+				out[2 * kk + 1] += Rij[kk] * im;
+			}
+		}
+
+		if (XLALREAL8FreqTimeFFT(h[i], htilde, stream->plan) < 0)
+			failed += 1;
+	}
+
+	if (failed)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+/**
+ * Generates the next segment of an SGWB stream.
+ *
+ * The first call initializes h by generating one (periodic) realization,
+ * and subsequent calls advance h by the stride of the stream, exactly as
+ * calling XLALSimSGWB() first with a stride of 0 and then with the
+ * stream's stride.  The deviates are drawn from rng in the same order, so
+ * given the same random number generator state the output is identical to
+ * that of XLALSimSGWB().
+ *
+ * @warning Only the first stride points are valid.
+ */
+int XLALSimSGWBStreamNext(
+	LALSimSGWBStream *stream,	/**< [in/out] sgwb stream */
+	REAL8TimeSeries **h,		/**< [in/out] array of sgwb timeseries for detector network */
+	gsl_rng *rng			/**< [in] GSL random number generator */
+)
+{
+	LIGOTimeGPS epoch;
+	size_t stride;
+	long i;
+
+	if (! stream || ! h || ! rng)
+		XLAL_ERROR(XLAL_EFAULT);
+
+	/* make sure all the lengths and other metadata are the same */
+	epoch = h[0]->epoch;
+	for (i = 0; i < (long) stream->numDetectors; ++i)
+		if (h[i]->data->length != stream->length
+				|| fabs(h[i]->deltaT - stream->deltaT) > LAL_REAL8_EPS
+				|| XLALGPSCmp(&epoch, &h[i]->epoch))
+			XLAL_ERROR(XLAL_EINVAL);
+
+	if (! stream->initialized) { /* generate segment with no feathering */
+		if (XLALSimSGWBStreamSegment(stream, h, rng) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		stream->initialized = 1;
+		return 0;
+	}
+
+	stride = stream->stride;
+	if (stride == stream->length) {
+		/* will generate two independent noise realizations
+		 * and feather them together with full overlap */
+		if (XLALSimSGWBStreamSegment(stream, h, rng) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		stride = 0;
+	}
+
+	/* copy overlap region between the old and the new data to temporary storage */
+	for (i = 0; i < (long) stream->numDetectors; ++i)
+		memcpy(stream->overlap[i]->data, h[i]->data->data + stride, stream->overlap[i]->length*sizeof(*stream->overlap[i]->data));
+
+	if (XLALSimSGWBStreamSegment(stream, h, rng) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	/* feather old data in overlap region with new data */
+	#pragma omp parallel for
+	for (i = 0; i < (long) stream->numDetectors; ++i) {
+		const double *x = stream->fadeout->data;
+		const double *y = stream->fadein->data;
+		const double *old = stream->overlap[i]->data;
+		double *data = h[i]->data->data;
+		size_t j;
+		for (j = 0; j < stream->overlap[i]->length; ++j)
+			data[j] = x[j]*old[j] + y[j]*data[j];
+	}
+
+	/* advance time */
+	for (i = 0; i < (long) stream->numDetectors; ++i)
+		XLALGPSAdd(&h[i]->epoch, stride * stream->deltaT);
+
+	return 0;
+}
+
+#undef SGWB_PACKED_INDEX
+
+
 /** @} */
 
 /*
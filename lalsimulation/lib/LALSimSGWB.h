@@ -69,6 +69,12 @@ int XLALSimSGWB(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDet
 int XLALSimSGWBFlatSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omega0, double flow, double H0, gsl_rng *rng);
 int XLALSimSGWBPowerLawSpectrum(REAL8TimeSeries **h, const LALDetector *detectors, size_t numDetectors, size_t stride, double Omegaref, double alpha, double fref, double flow, double H0, gsl_rng *rng);
 
+/** Opaque type of a stream of SGWB segments; see XLALSimSGWBCreateStream() */
+typedef struct tagLALSimSGWBStream LALSimSGWBStream;
+LALSimSGWBStream *XLALSimSGWBCreateStream(const LALDetector *detectors, size_t numDetectors, size_t length, double deltaT, size_t stride, const REAL8FrequencySeries *OmegaGW, double H0);
+void XLALSimSGWBDestroyStream(LALSimSGWBStream *stream);
+int XLALSimSGWBStreamNext(LALSimSGWBStream *stream, REAL8TimeSeries **h, gsl_rng *rng);
+
 #if 0
 { /* so that editors will match succeeding brace */
 #elif defined(__cplusplus)
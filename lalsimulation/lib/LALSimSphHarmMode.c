@@ -17,6 +17,7 @@
  *  MA  02110-1301  USA
  */
 
+#include <complex.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALSimSphHarmMode.h>
 #include <lal/SphericalHarmonics.h>
@@ -200,6 +201,306 @@ int XLALSimAddModeFD(
 }
 
 
+/*
+ * Mode summation engine.
+ *
+ * The harmonics are evaluated once for all modes, and the output is then
+ * processed in blocks of MODE_SUM_BLOCK samples, each block accumulating
+ * every mode in turn with the complex arithmetic split into real and
+ * imaginary parts so that the inner loops vectorise.  Blocks are shared
+ * between OpenMP threads if OpenMP is enabled.  Contributions are added
+ * to each sample in the order of the list of modes, so the result is the
+ * same as summing the modes one at a time with XLALSimAddMode().
+ */
+
+#define MODE_SUM_BLOCK 1024
+
+/* harmonics and data of the modes, gathered from a linked list */
+struct mode_sum {
+	size_t nmodes;
+	REAL8 *Yre;
+	REAL8 *Yim;
+	const REAL8 **data; /* interleaved real and imaginary parts */
+};
+
+static void mode_sum_free(struct mode_sum *sum)
+{
+	XLALFree(sum->Yre);
+	XLALFree(sum->Yim);
+	XLALFree(sum->data);
+}
+
+static int mode_sum_alloc(struct mode_sum *sum, size_t nmodes)
+{
+	sum->nmodes = nmodes;
+	sum->Yre = XLALMalloc(nmodes * sizeof(*sum->Yre));
+	sum->Yim = XLALMalloc(nmodes * sizeof(*sum->Yim));
+	sum->data = XLALMalloc(nmodes * sizeof(*sum->data));
+	if (!sum->Yre || !sum->Yim || !sum->data) {
+		mode_sum_free(sum);
+		XLAL_ERROR(XLAL_ENOMEM);
+	}
+	return 0;
+}
+
+static int mode_sum_init_td(struct mode_sum *sum, const REAL8TimeSeries *h, SphHarmTimeSeries *hlms, REAL8 theta, REAL8 phi)
+{
+	SphHarmTimeSeries *this;
+	size_t k = 0;
+
+	XLAL_CHECK(hlms, XLAL_EFAULT);
+	for (this = hlms; this; this = this->next) {
+		LAL_CHECK_VALID_SERIES(this->mode, XLAL_FAILURE);
+		LAL_CHECK_CONSISTENT_TIME_SERIES(h, this->mode, XLAL_FAILURE);
+		XLAL_CHECK(this->mode->data->length == h->data->length, XLAL_EBADLEN, "mode (%u,%d) has length %u but output has length %u", this->l, this->m, this->mode->data->length, h->data->length);
+		++k;
+	}
+	if (mode_sum_alloc(sum, k) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	for (k = 0, this = hlms; this; this = this->next, ++k) {
+		COMPLEX16 Y = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, this->m);
+		sum->Yre[k] = creal(Y);
+		sum->Yim[k] = cimag(Y);
+		sum->data[k] = (const REAL8 *)this->mode->data->data;
+	}
+	return 0;
+}
+
+static int mode_sum_init_fd(struct mode_sum *sum, const COMPLEX16FrequencySeries *h, SphHarmFrequencySeries *hlms, REAL8 theta, REAL8 phi)
+{
+	SphHarmFrequencySeries *this;
+	size_t k = 0;
+
+	XLAL_CHECK(hlms, XLAL_EFAULT);
+	for (this = hlms; this; this = this->next) {
+		LAL_CHECK_VALID_SERIES(this->mode, XLAL_FAILURE);
+		XLAL_CHECK(fabs(this->mode->deltaF - h->deltaF) <= LAL_REAL8_EPS, XLAL_EFREQ);
+		XLAL_CHECK((this->mode->data->length + 1) / 2 == h->data->length, XLAL_EBADLEN, "mode (%u,%d) has length %u, which does not cover the %u frequencies of the output", this->l, this->m, this->mode->data->length, h->data->length);
+		++k;
+	}
+	if (mode_sum_alloc(sum, k) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	for (k = 0, this = hlms; this; this = this->next, ++k) {
+		COMPLEX16 Y = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, this->m);
+		sum->Yre[k] = creal(Y);
+		sum->Yim[k] = cimag(Y);
+		sum->data[k] = (const REAL8 *)this->mode->data->data;
+	}
+	return 0;
+}
+
+/* hp - i hc = sum_lm Y_lm h_lm over samples [j0, j1) */
+static void mode_sum_td_block(const struct mode_sum *sum, REAL8 *hp, REAL8 *hc, size_t j0, size_t j1)
+{
+	size_t j, k;
+	for (k = 0; k < sum->nmodes; ++k) {
+		const REAL8 yr = sum->Yre[k];
+		const REAL8 yi = sum->Yim[k];
+		const REAL8 *h = sum->data[k];
+		for (j = j0; j < j1; ++j) {
+			const REAL8 hr = h[2 * j];
+			const REAL8 hi = h[2 * j + 1];
+			hp[j - j0] += yr * hr - yi * hi;
+			hc[j - j0] -= yr * hi + yi * hr;
+		}
+	}
+}
+
+/*
+ * The frequency-domain modes cover negative and positive frequencies, with
+ * zero frequency at offset = len - 1, where len is the number of output
+ * frequencies; the polarizations at positive frequency f_j are
+ *   hp = (Y h_lm(f_j) + [Y h_lm(-f_j)]*) / 2
+ *   hc = i (Y h_lm(f_j) - [Y h_lm(-f_j)]*) / 2
+ */
+static void mode_sum_fd_block(const struct mode_sum *sum, REAL8 *hp, REAL8 *hc, size_t len, size_t j0, size_t j1)
+{
+	const size_t offset = len - 1;
+	size_t j, k;
+	for (k = 0; k < sum->nmodes; ++k) {
+		const REAL8 yr = sum->Yre[k];
+		const REAL8 yi = sum->Yim[k];
+		const REAL8 *h = sum->data[k];
+		for (j = j0; j < j1; ++j) {
+			const REAL8 *a = h + 2 * (j + offset);
+			const REAL8 *c = h + 2 * (offset - j);
+			const REAL8 ar = yr * a[0] - yi * a[1];
+			const REAL8 ai = yr * a[1] + yi * a[0];
+			const REAL8 cr = yr * c[0] - yi * c[1];
+			const REAL8 ci = yr * c[1] + yi * c[0];
+			hp[2 * (j - j0)] += 0.5 * (ar + cr);
+			hp[2 * (j - j0) + 1] += 0.5 * (ai - ci);
+			hc[2 * (j - j0)] -= 0.5 * (ai + ci);
+			hc[2 * (j - j0) + 1] += 0.5 * (ar - cr);
+		}
+	}
+}
+
+/**
+ * Adds the sum of all modes in the list @p hlms, each multiplied by its
+ * spin -2 weighted spherical harmonic, to the polarizations:
+ * \f$h_+ - i h_\times \mathrel{+}= \sum_{lm} h_{lm} {}_{-2}Y_{lm}(\theta,\phi)\f$.
+ *
+ * The result is the same as calling XLALSimAddMode() with @c sym = 0 for
+ * each mode, but the harmonics are evaluated only once and the samples
+ * are processed in vectorised blocks, in parallel if OpenMP is enabled.
+ * All modes must have the same sampling and length as the polarizations.
+ */
+int XLALSimAddModesFromSphHarmTimeSeries(
+		REAL8TimeSeries *hplus,      /**< +-polarization waveform */
+		REAL8TimeSeries *hcross,     /**< x-polarization waveform */
+		SphHarmTimeSeries *hlms,     /**< linked list of modes */
+		REAL8 theta,                 /**< polar angle (rad) */
+		REAL8 phi                    /**< azimuthal angle (rad) */
+		)
+{
+	struct mode_sum sum;
+	size_t length, nblocks, b;
+
+	LAL_CHECK_VALID_SERIES(hplus, XLAL_FAILURE);
+	length = hplus->data->length;
+	nblocks = (length + MODE_SUM_BLOCK - 1) / MODE_SUM_BLOCK;
+	LAL_CHECK_VALID_SERIES(hcross, XLAL_FAILURE);
+	XLAL_CHECK(hcross->data->length == length, XLAL_EBADLEN);
+	if (mode_sum_init_td(&sum, hplus, hlms, theta, phi) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	#pragma omp parallel for
+	for (b = 0; b < nblocks; ++b) {
+		const size_t j0 = b * MODE_SUM_BLOCK;
+		const size_t j1 = j0 + MODE_SUM_BLOCK < length ? j0 + MODE_SUM_BLOCK : length;
+		mode_sum_td_block(&sum, hplus->data->data + j0, hcross->data->data + j0, j0, j1);
+	}
+
+	mode_sum_free(&sum);
+	return XLAL_SUCCESS;
+}
+
+/**
+ * Adds the detector response \f$F_+ h_+ + F_\times h_\times\f$ of the
+ * sum of the modes in @p hlms to the strain time series @p h, in a single
+ * pass without forming the polarizations.
+ *
+ * @sa XLALSimAddModesFromSphHarmTimeSeries()
+ */
+int XLALSimAddDetectorStrainFromSphHarmTimeSeries(
+		REAL8TimeSeries *h,          /**< detector strain */
+		SphHarmTimeSeries *hlms,     /**< linked list of modes */
+		REAL8 theta,                 /**< polar angle (rad) */
+		REAL8 phi,                   /**< azimuthal angle (rad) */
+		REAL8 Fplus,                 /**< +-polarization antenna response */
+		REAL8 Fcross                 /**< x-polarization antenna response */
+		)
+{
+	struct mode_sum sum;
+	size_t length, nblocks, b;
+
+	LAL_CHECK_VALID_SERIES(h, XLAL_FAILURE);
+	length = h->data->length;
+	nblocks = (length + MODE_SUM_BLOCK - 1) / MODE_SUM_BLOCK;
+	if (mode_sum_init_td(&sum, h, hlms, theta, phi) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	#pragma omp parallel for
+	for (b = 0; b < nblocks; ++b) {
+		REAL8 hp[MODE_SUM_BLOCK] = {0};
+		REAL8 hc[MODE_SUM_BLOCK] = {0};
+		const size_t j0 = b * MODE_SUM_BLOCK;
+		const size_t j1 = j0 + MODE_SUM_BLOCK < length ? j0 + MODE_SUM_BLOCK : length;
+		size_t j;
+		mode_sum_td_block(&sum, hp, hc, j0, j1);
+		for (j = j0; j < j1; ++j)
+			h->data->data[j] += Fplus * hp[j - j0] + Fcross * hc[j - j0];
+	}
+
+	mode_sum_free(&sum);
+	return XLAL_SUCCESS;
+}
+
+/**
+ * Adds the sum of all modes in the list @p hlms, each multiplied by its
+ * spin -2 weighted spherical harmonic, to the frequency-domain
+ * polarizations at positive frequencies.
+ *
+ * The modes must cover negative and positive frequencies, as returned by
+ * XLALSimInspiralChooseFDModes(), so that a mode of length \f$2N-1\f$
+ * contributes to polarizations of length \f$N\f$.  This is the sum
+ * performed by XLALSimInspiralPolarizationsFromSphHarmFrequencySeries(),
+ * with the harmonics evaluated once and the frequencies processed in
+ * vectorised blocks, in parallel if OpenMP is enabled.
+ */
+int XLALSimAddModesFromSphHarmFrequencySeries(
+		COMPLEX16FrequencySeries *hptilde, /**< +-polarization waveform */
+		COMPLEX16FrequencySeries *hctilde, /**< x-polarization waveform */
+		SphHarmFrequencySeries *hlms,      /**< linked list of modes */
+		REAL8 theta,                       /**< polar angle (rad) */
+		REAL8 phi                          /**< azimuthal angle (rad) */
+		)
+{
+	struct mode_sum sum;
+	size_t length, nblocks, b;
+
+	LAL_CHECK_VALID_SERIES(hptilde, XLAL_FAILURE);
+	length = hptilde->data->length;
+	nblocks = (length + MODE_SUM_BLOCK - 1) / MODE_SUM_BLOCK;
+	LAL_CHECK_VALID_SERIES(hctilde, XLAL_FAILURE);
+	XLAL_CHECK(hctilde->data->length == length, XLAL_EBADLEN);
+	if (mode_sum_init_fd(&sum, hptilde, hlms, theta, phi) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	#pragma omp parallel for
+	for (b = 0; b < nblocks; ++b) {
+		const size_t j0 = b * MODE_SUM_BLOCK;
+		const size_t j1 = j0 + MODE_SUM_BLOCK < length ? j0 + MODE_SUM_BLOCK : length;
+		mode_sum_fd_block(&sum, (REAL8 *)(hptilde->data->data + j0), (REAL8 *)(hctilde->data->data + j0), length, j0, j1);
+	}
+
+	mode_sum_free(&sum);
+	return XLAL_SUCCESS;
+}
+
+/**
+ * Adds the detector response \f$F_+ \tilde{h}_+ + F_\times \tilde{h}_\times\f$
+ * of the sum of the modes in @p hlms to the frequency-domain strain
+ * @p htilde, in a single pass without forming the polarizations.
+ *
+ * @sa XLALSimAddModesFromSphHarmFrequencySeries()
+ */
+int XLALSimAddDetectorStrainFromSphHarmFrequencySeries(
+		COMPLEX16FrequencySeries *htilde, /**< detector strain */
+		SphHarmFrequencySeries *hlms,     /**< linked list of modes */
+		REAL8 theta,                      /**< polar angle (rad) */
+		REAL8 phi,                        /**< azimuthal angle (rad) */
+		REAL8 Fplus,                      /**< +-polarization antenna response */
+		REAL8 Fcross                      /**< x-polarization antenna response */
+		)
+{
+	struct mode_sum sum;
+	size_t length, nblocks, b;
+
+	LAL_CHECK_VALID_SERIES(htilde, XLAL_FAILURE);
+	length = htilde->data->length;
+	nblocks = (length + MODE_SUM_BLOCK - 1) / MODE_SUM_BLOCK;
+	if (mode_sum_init_fd(&sum, htilde, hlms, theta, phi) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	#pragma omp parallel for
+	for (b = 0; b < nblocks; ++b) {
+		REAL8 hp[2 * MODE_SUM_BLOCK] = {0};
+		REAL8 hc[2 * MODE_SUM_BLOCK] = {0};
+		REAL8 *out = (REAL8 *)htilde->data->data;
+		const size_t j0 = b * MODE_SUM_BLOCK;
+		const size_t j1 = j0 + MODE_SUM_BLOCK < length ? j0 + MODE_SUM_BLOCK : length;
+		size_t j;
+		mode_sum_fd_block(&sum, hp, hc, length, j0, j1);
+		for (j = 2 * j0; j < 2 * j1; ++j)
+			out[j] += Fplus * hp[j - 2 * j0] + Fcross * hc[j - 2 * j0];
+	}
+
+	mode_sum_free(&sum);
+	return XLAL_SUCCESS;
+}
+
 /**
  * For all valid TimeSeries contained within hmode structure,
  * multiplies a mode h(l,m) by a spin-2 weighted spherical harmonic
@@ -36,7 +36,6 @@
 #include <lal/TimeDelay.h>
 #include <lal/SkyCoordinates.h>
 #include <lal/TimeSeries.h>
-#include <lal/TimeSeriesInterp.h>
 #include <lal/FrequencySeries.h>
 #include <lal/TimeFreqFFT.h>
 #include <lal/Window.h>
@@ -198,6 +197,55 @@ static void highfreq_kernel(double *cached_kernel, int kernel_length, double res
 };
 
 
+/*
+ * A block of output samples over which the geometric delay and the arm
+ * geometry are held fixed.  x0 is the real-valued index in the projected
+ * input of the time at the geocentre of the block's first sample.
+ */
+struct strain_block {
+	double x0;
+	struct highfreq_kernel_data xdata;
+	struct highfreq_kernel_data ydata;
+};
+
+
+/*
+ * Project one block of output samples.  Equivalent to evaluating
+ * interpolators of xsignal and ysignal at x0, x0 + 1, ..., but because
+ * the indexes differ by whole samples the residual, and so the kernels,
+ * are the same for all of them.  The data beyond the ends of the input
+ * are taken to be 0, as by XLALREAL8SequenceInterpEval().
+ */
+static void project_block(double *out, unsigned n, const double *xsignal, const double *ysignal, int length, const struct strain_block *block, int kernel_length, double *xkernel, double *ykernel)
+{
+	struct highfreq_kernel_data xdata = block->xdata;
+	struct highfreq_kernel_data ydata = block->ydata;
+	int start = lround(block->x0);
+	double residual = start - block->x0;
+	int j;
+
+	highfreq_kernel(xkernel, kernel_length, residual, &xdata);
+	highfreq_kernel(ykernel, kernel_length, residual, &ydata);
+
+	/* accumulate one tap at a time across the block so the inner loop
+	 * vectorizes.  each output sample still sums the taps in order.
+	 * the range of samples is clipped so that the data are only read
+	 * within the extent of the input */
+	start -= (kernel_length - 1) / 2;
+	memset(out, 0, n * sizeof(*out));
+	for(j = 0; j < kernel_length; j++) {
+		const double xk = xkernel[j];
+		const double yk = ykernel[j];
+		const long offset = (long) start + j;
+		const long imin = offset < 0 ? -offset : 0;
+		const long imax = length - offset < (long) n ? length - offset : (long) n;
+		long i;
+		for(i = imin; i < imax; i++)
+			out[i] += xk * xsignal[offset + i] + yk * ysignal[offset + i];
+	}
+}
+
+
 /**
  * @brief Transforms the waveform polarizations into a detector strain
  * @details
@@ -244,6 +292,13 @@ static void highfreq_kernel(double *cached_kernel, int kernel_length, double res
  * orientation error in these calculations, but one should be aware of the
  * periodic nature of the updates if extreme phase stability is required.
  * @n@n
+ * Because the delay is held fixed within each 250 ms interval, every
+ * output sample in the interval is offset from the input by the same
+ * fraction of a sample.  The interpolation kernels are therefore computed
+ * once per interval and applied as a FIR filter to the antenna-weighted
+ * input, and the intervals are processed in parallel if OpenMP is
+ * enabled.
+ * @n@n
  * The output time series is padded to capture the interpolation kernel
  * structure resulting from possible sharp edges at the start or end of the
  * input time series data.  Neglecting the padding for the interpolation
@@ -269,8 +324,9 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 	const unsigned det_resp_interval = round(0.25 / hplus->deltaT) < 1 ? 1 : round(0.25 / hplus->deltaT);
 	REAL8TimeSeries *xsignal = NULL;
 	REAL8TimeSeries *ysignal = NULL;
-	LALREAL8TimeSeriesInterp *xinterp = NULL;
-	LALREAL8TimeSeriesInterp *yinterp = NULL;
+	struct strain_block *blocks = NULL;
+	double *kernels = NULL;
+	unsigned nblocks;
 	struct highfreq_kernel_data xdata;
 	struct highfreq_kernel_data ydata;
 	double fxplus = XLAL_REAL8_FAIL_NAN;
@@ -362,14 +418,16 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 
 	xsignal = XLALCreateREAL8TimeSeries("xsignal", &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length);
 	ysignal = XLALCreateREAL8TimeSeries("ysignal", &hplus->epoch, hplus->f0, hplus->deltaT, &hplus->sampleUnits, (int) hplus->data->length);
+	if(!xsignal || !ysignal)
+		goto error;
 	for(i = 0; i < hplus->data->length; i++) {
-		t = hplus->epoch;
-		if(!XLALGPSAdd(&t, i * hplus->deltaT))
-			goto error;
 		/* Compute detector's response. Here the geometric delay
 		 * from geocenter is neglected since it is small compared
 		 * to the rotational period of the Earth */
 		if(!(i % det_resp_interval)) {
+			t = hplus->epoch;
+			if(!XLALGPSAdd(&t, i * hplus->deltaT))
+				goto error;
 			double armlen = XLAL_REAL8_FAIL_NAN;
 			double xcos = XLAL_REAL8_FAIL_NAN;
 			double ycos = XLAL_REAL8_FAIL_NAN;
@@ -381,64 +439,73 @@ REAL8TimeSeries *XLALSimDetectorStrainREAL8TimeSeries(
 			goto error;
 	}
 
-	/* initialize interpolators. */
+	/* geometric delay and highfreq_kernel_data for each block of
+	 * det_resp_interval output samples, in sequence so that errors can
+	 * be reported */
 
-	/* use filtering interpolators.  see TimeSeriesInterp.c for
-	 * meaning of welch_factor */
-	xdata.welch_factor = ydata.welch_factor = 1.0 / ((kernel_length - 1.) / 2. + 1.);
-	xinterp = XLALREAL8TimeSeriesInterpCreate(xsignal, kernel_length, highfreq_kernel, &xdata);
-	yinterp = XLALREAL8TimeSeriesInterpCreate(ysignal, kernel_length, highfreq_kernel, &ydata);
-	if(!xinterp || !yinterp)
+	nblocks = (h->data->length + det_resp_interval - 1) / det_resp_interval;
+	blocks = XLALMalloc(nblocks * sizeof(*blocks));
+	kernels = XLALMalloc(nblocks * 2 * kernel_length * sizeof(*kernels));
+	if(!blocks || !kernels)
 		goto error;
 
-	/* compute output sample by sample */
-	/* FIXME: Now xdata and ydata are not renewed until geometric delay
-	 * changes significantly. This can cause systematic errors. For
-	 * example, if the detector is on the North pole, xdata and ydata
-	 * are never renewed although armcos can be changing. */
+	/* see TimeSeriesInterp.c for meaning of welch_factor */
+	xdata.welch_factor = ydata.welch_factor = 1.0 / ((kernel_length - 1.) / 2. + 1.);
+
+	/* FIXME: xdata and ydata are held fixed for the duration of each
+	 * block.  This can cause systematic errors, e.g. if the detector is
+	 * on the North pole armcos changes while the geometric delay does
+	 * not. */
 
-	for(i = 0; i < h->data->length; i++) {
-		/* time of sample in detector */
+	for(i = 0; i < nblocks; i++) {
+		double armlen = XLAL_REAL8_FAIL_NAN;
+		/* time of first sample of block in detector */
 		t = h->epoch;
-		if(!XLALGPSAdd(&t, i * h->deltaT))
+		if(!XLALGPSAdd(&t, i * det_resp_interval * h->deltaT))
 			goto error;
-
-		/* geometric delay from geocentre and highfreq_kernel_data */
-		if(!(i % det_resp_interval)) {
-			geometric_delay = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
-			/* Compute highfreq_kernel_data */
-			double armlen = XLAL_REAL8_FAIL_NAN;
-			XLALComputeDetAMResponseParts(&armlen, &xdata.armcos, &ydata.armcos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
-			armlen /= LAL_C_SI * h->deltaT;
-			xdata.T = armlen;
-			ydata.T = armlen;
-		}
+		geometric_delay = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+		XLALComputeDetAMResponseParts(&armlen, &xdata.armcos, &ydata.armcos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
+		armlen /= LAL_C_SI * h->deltaT;
+		xdata.T = armlen;
+		ydata.T = armlen;
 		if(XLAL_IS_REAL8_FAIL_NAN(geometric_delay))
 			goto error;
 		if(XLAL_IS_REAL8_FAIL_NAN(xdata.T) || XLAL_IS_REAL8_FAIL_NAN(ydata.T) || XLAL_IS_REAL8_FAIL_NAN(xdata.armcos) || XLAL_IS_REAL8_FAIL_NAN(ydata.armcos))
 			goto error;
 
-		/* time of sample at geocentre */
-		if(!XLALGPSAdd(&t, geometric_delay))
+		/* real-valued index in xsignal and ysignal of the time at the
+		 * geocentre of the block's first sample */
+		blocks[i].x0 = (XLALGPSDiff(&h->epoch, &xsignal->epoch) + geometric_delay) / xsignal->deltaT + (double) i * det_resp_interval;
+		if(!isfinite(blocks[i].x0))
 			goto error;
+		blocks[i].xdata = xdata;
+		blocks[i].ydata = ydata;
+	}
 
-		/* evaluate linear combination of interpolators */
-		h->data->data[i] = XLALREAL8TimeSeriesInterpEval(xinterp, &t, 0) + XLALREAL8TimeSeriesInterpEval(yinterp, &t, 0);
-
-		if(XLAL_IS_REAL8_FAIL_NAN(h->data->data[i]))
-			goto error;
+	/* project each block.  the blocks are independent, and within a
+	 * block every output sample sees the same sub-sample residual so
+	 * the kernels are computed once and the inner product is a plain
+	 * FIR filter */
+
+	#pragma omp parallel for
+	for(i = 0; i < nblocks; i++) {
+		const unsigned j0 = i * det_resp_interval;
+		const unsigned j1 = j0 + det_resp_interval < h->data->length ? j0 + det_resp_interval : h->data->length;
+		double *xkernel = kernels + (size_t) i * 2 * kernel_length;
+		double *ykernel = xkernel + kernel_length;
+		project_block(h->data->data + j0, j1 - j0, xsignal->data->data, ysignal->data->data, xsignal->data->length, &blocks[i], kernel_length, xkernel, ykernel);
 	}
 
 	/* done */
-	XLALREAL8TimeSeriesInterpDestroy(xinterp);
-	XLALREAL8TimeSeriesInterpDestroy(yinterp);
+	XLALFree(blocks);
+	XLALFree(kernels);
 	XLALDestroyREAL8TimeSeries(xsignal);
 	XLALDestroyREAL8TimeSeries(ysignal);
 	return h;
 
 error:
-	XLALREAL8TimeSeriesInterpDestroy(xinterp);
-	XLALREAL8TimeSeriesInterpDestroy(yinterp);
+	XLALFree(blocks);
+	XLALFree(kernels);
 	XLALDestroyREAL8TimeSeries(xsignal);
 	XLALDestroyREAL8TimeSeries(ysignal);
 	XLALDestroyREAL8TimeSeries(h);
@@ -0,0 +1,147 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check that batched waveform generation agrees with generating the
+ * waveforms one at a time.
+ *
+ * TaylorF2 is generated in parallel when OpenMP is enabled, TaylorT4 one
+ * waveform after another; both must reproduce the single-waveform results
+ * exactly.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/LALSimInspiral.h>
+
+#define NBATCH 8
+
+static const char *const keys[] = { "mass1", "mass2" };
+
+/* component masses of the batch, one column per key */
+static void fill_table(REAL8 *values)
+{
+    size_t i;
+    for (i = 0; i < NBATCH; ++i) {
+        values[i] = (1.2 + 0.3 * i) * LAL_MSUN_SI;
+        values[NBATCH + i] = (1.1 + 0.1 * i) * LAL_MSUN_SI;
+    }
+    return;
+}
+
+static int check_series(const void *a, const void *b, size_t na, size_t nb, size_t size, const char *approx, size_t i)
+{
+    if (na != nb || memcmp(a, b, na * size)) {
+        fprintf(stderr, "FAIL: %s waveform %zu differs between batch and single generation\n", approx, i);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_fd(void)
+{
+    COMPLEX16FrequencySeries *hp[NBATCH] = { NULL }, *hc[NBATCH] = { NULL };
+    REAL8 values[2 * NBATCH];
+    LALSimInspiralGenerator *generator;
+    LALDict *common, **params;
+    int errors = 0;
+    size_t i;
+
+    common = XLALCreateDict();
+    XLALSimInspiralWaveformParamsInsertDistance(common, 1e6 * LAL_PC_SI);
+    XLALSimInspiralWaveformParamsInsertDeltaF(common, 1.0 / 16.0);
+    XLALSimInspiralWaveformParamsInsertF22Start(common, 30.0);
+    fill_table(values);
+    params = XLALSimInspiralCreateDictArrayFromTable(common, keys, values, 2, NBATCH);
+    generator = XLALSimInspiralChooseGenerator(TaylorF2, NULL);
+    XLAL_CHECK(params && generator, XLAL_EFUNC);
+
+    XLAL_CHECK(XLALSimInspiralGenerateFDWaveformBatch(hp, hc, params, NBATCH, generator) == XLAL_SUCCESS, XLAL_EFUNC);
+    for (i = 0; i < NBATCH; ++i) {
+        COMPLEX16FrequencySeries *hp1 = NULL, *hc1 = NULL;
+        XLAL_CHECK(XLALSimInspiralGenerateFDWaveform(&hp1, &hc1, params[i], generator) == XLAL_SUCCESS, XLAL_EFUNC);
+        errors += check_series(hp[i]->data->data, hp1->data->data, hp[i]->data->length, hp1->data->length, sizeof(*hp1->data->data), "TaylorF2", i);
+        errors += check_series(hc[i]->data->data, hc1->data->data, hc[i]->data->length, hc1->data->length, sizeof(*hc1->data->data), "TaylorF2", i);
+        XLALDestroyCOMPLEX16FrequencySeries(hp1);
+        XLALDestroyCOMPLEX16FrequencySeries(hc1);
+        XLALDestroyCOMPLEX16FrequencySeries(hp[i]);
+        XLALDestroyCOMPLEX16FrequencySeries(hc[i]);
+    }
+
+    XLALDestroySimInspiralGenerator(generator);
+    XLALSimInspiralDestroyDictArray(params, NBATCH);
+    XLALDestroyDict(common);
+    return errors;
+}
+
+static int test_td(void)
+{
+    REAL8TimeSeries *hp[NBATCH] = { NULL }, *hc[NBATCH] = { NULL };
+    REAL8 values[2 * NBATCH];
+    LALSimInspiralGenerator *generator;
+    LALDict *common, **params;
+    int errors = 0;
+    size_t i;
+
+    common = XLALCreateDict();
+    XLALSimInspiralWaveformParamsInsertDistance(common, 1e6 * LAL_PC_SI);
+    XLALSimInspiralWaveformParamsInsertDeltaT(common, 1.0 / 4096.0);
+    XLALSimInspiralWaveformParamsInsertF22Start(common, 40.0);
+    fill_table(values);
+    params = XLALSimInspiralCreateDictArrayFromTable(common, keys, values, 2, NBATCH);
+    generator = XLALSimInspiralChooseGenerator(TaylorT4, NULL);
+    XLAL_CHECK(params && generator, XLAL_EFUNC);
+
+    XLAL_CHECK(XLALSimInspiralGenerateTDWaveformBatch(hp, hc, params, NBATCH, generator) == XLAL_SUCCESS, XLAL_EFUNC);
+    for (i = 0; i < NBATCH; ++i) {
+        REAL8TimeSeries *hp1 = NULL, *hc1 = NULL;
+        XLAL_CHECK(XLALSimInspiralGenerateTDWaveform(&hp1, &hc1, params[i], generator) == XLAL_SUCCESS, XLAL_EFUNC);
+        errors += check_series(hp[i]->data->data, hp1->data->data, hp[i]->data->length, hp1->data->length, sizeof(*hp1->data->data), "TaylorT4", i);
+        errors += check_series(hc[i]->data->data, hc1->data->data, hc[i]->data->length, hc1->data->length, sizeof(*hc1->data->data), "TaylorT4", i);
+        XLALDestroyREAL8TimeSeries(hp1);
+        XLALDestroyREAL8TimeSeries(hc1);
+        XLALDestroyREAL8TimeSeries(hp[i]);
+        XLALDestroyREAL8TimeSeries(hc[i]);
+    }
+
+    XLALDestroySimInspiralGenerator(generator);
+    XLALSimInspiralDestroyDictArray(params, NBATCH);
+    XLALDestroyDict(common);
+    return errors;
+}
+
+int main(void)
+{
+    int fd_errors = test_fd();
+    int td_errors = test_td();
+
+    if (fd_errors || td_errors) {
+        fprintf(stderr, "FAIL: batched waveforms differ from single waveforms\n");
+        return 1;
+    }
+
+    LALCheckMemoryLeaks();
+    printf("PASS: batched waveforms agree with single waveforms\n");
+    return 0;
+}
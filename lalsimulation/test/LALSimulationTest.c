@@ -10,6 +10,7 @@
 #include <lal/TimeDelay.h>
 #include <lal/LALSimulation.h>
 #include <gsl/gsl_sf_trig.h>
+#include <gsl/gsl_sf_expint.h>
 
 static LIGOTimeGPS gps_zero = LIGOTIMEGPSZERO;
 
@@ -140,6 +141,100 @@ static void check_result(const REAL8TimeSeries *model, const REAL8TimeSeries *re
 }
 
 
+/* the interpolation kernel of XLALSimDetectorStrainREAL8TimeSeries(), see
+ * highfreq_kernel() in LALSimulation.c */
+static double strain_kernel(int k, double residual, double welch_factor, double T, double armcos)
+{
+	double x = k + residual;
+	double y = welch_factor * x;
+	double Si1, Si2, Si3;
+
+	if(fabs(y) >= 1.)
+		return 0.;
+	Si1 = gsl_sf_Si(LAL_PI * (x + T * armcos));
+	Si2 = gsl_sf_Si(LAL_PI * (x + T));
+	Si3 = gsl_sf_Si(LAL_PI * (x - T));
+	return ((Si2 - Si1) / (T * (1. - armcos)) + (Si1 - Si3) / (T * (1. + armcos))) * (1. - y * y) / LAL_TWOPI;
+}
+
+
+/* compute the strain in dst the way XLALSimDetectorStrainREAL8TimeSeries()
+ * did before it projected in blocks:  one sample at a time, computing the
+ * kernels for each sample's own residual.  the antenna response, delay and
+ * arm geometry are updated every 0.25 s, as in the library */
+static void compute_per_sample(REAL8TimeSeries *dst, const REAL8TimeSeries *hplus, const REAL8TimeSeries *hcross, REAL8 right_ascension, REAL8 declination, REAL8 psi, const LALDetector *detector)
+{
+	const double arm_length_samples = (detector->frDetector.xArmMidpoint + detector->frDetector.yArmMidpoint) / (LAL_C_SI * hplus->deltaT);
+	const int kernel_length = 67 + 48 * lround(2.0 * arm_length_samples);
+	const unsigned det_resp_interval = round(0.25 / hplus->deltaT) < 1 ? 1 : round(0.25 / hplus->deltaT);
+	const double welch_factor = 1.0 / ((kernel_length - 1.) / 2. + 1.);
+	REAL8TimeSeries *xsignal = copy_series(hplus);
+	REAL8TimeSeries *ysignal = copy_series(hplus);
+	double armlen, xcos, ycos, fxplus, fxcross, fyplus, fycross, delay = 0.;
+	unsigned i;
+	int k;
+
+	for(i = 0; i < hplus->data->length; i++) {
+		if(!(i % det_resp_interval)) {
+			LIGOTimeGPS t = hplus->epoch;
+			XLALGPSAdd(&t, i * hplus->deltaT);
+			XLALComputeDetAMResponseParts(&armlen, &xcos, &ycos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
+		}
+		xsignal->data->data[i] = fxplus * hplus->data->data[i] + fxcross * hcross->data->data[i];
+		ysignal->data->data[i] = fyplus * hplus->data->data[i] + fycross * hcross->data->data[i];
+	}
+
+	for(i = 0; i < dst->data->length; i++) {
+		double x, residual, xval = 0., yval = 0.;
+		int start;
+		if(!(i % det_resp_interval)) {
+			LIGOTimeGPS t = dst->epoch;
+			XLALGPSAdd(&t, i * dst->deltaT);
+			delay = -XLALTimeDelayFromEarthCenter(detector->location, right_ascension, declination, &t);
+			XLALComputeDetAMResponseParts(&armlen, &xcos, &ycos, &fxplus, &fyplus, &fxcross, &fycross, detector, right_ascension, declination, psi, XLALGreenwichMeanSiderealTime(&t));
+			armlen /= LAL_C_SI * dst->deltaT;
+		}
+		/* real-valued index of the sample's time at the geocentre */
+		x = (XLALGPSDiff(&dst->epoch, &hplus->epoch) + delay) / hplus->deltaT + i;
+		start = lround(x);
+		residual = start - x;
+		for(k = -(kernel_length - 1) / 2; k <= (kernel_length - 1) / 2; k++) {
+			int j = start + k;
+			if(j < 0 || j >= (int) hplus->data->length)
+				continue;
+			xval += strain_kernel(k, residual, welch_factor, armlen, xcos) * xsignal->data->data[j];
+			yval += strain_kernel(k, residual, welch_factor, armlen, ycos) * ysignal->data->data[j];
+		}
+		dst->data->data[i] = xval + yval;
+	}
+
+	XLALDestroyREAL8TimeSeries(xsignal);
+	XLALDestroyREAL8TimeSeries(ysignal);
+}
+
+
+/* the block-wise projection must agree with the per-sample projection.  the
+ * block kernels are computed for the residual of each block's first
+ * sample, which differs from that of later samples only by the rounding of
+ * the sample index, so the two agree to well within 1e-10 of the
+ * signal's peak */
+static void check_per_sample(const REAL8TimeSeries *hplus, const REAL8TimeSeries *hcross, REAL8 right_ascension, REAL8 declination, REAL8 psi, const LALDetector *detector)
+{
+	REAL8TimeSeries *dst = XLALSimDetectorStrainREAL8TimeSeries(hplus, hcross, right_ascension, declination, psi, detector);
+	REAL8TimeSeries *ref = copy_series(dst);
+	double min, max, peak;
+
+	compute_per_sample(ref, hplus, hcross, right_ascension, declination, psi, detector);
+	minmax(ref, &min, &max);
+	peak = fmax(fabs(min), fabs(max));
+	fprintf(stderr, "block-wise vs. per-sample projection into %s data: ", detector->frDetector.name);
+	check_result(ref, dst, 1e-10 * peak, -1e-10 * peak, 1e-10 * peak);
+
+	XLALDestroyREAL8TimeSeries(dst);
+	XLALDestroyREAL8TimeSeries(ref);
+}
+
+
 int main(void)
 {
 	REAL8TimeSeries *hplus, *hcross, *dst, *short_dst, *mdl;
@@ -168,6 +263,7 @@ int main(void)
 	compute_answer(mdl, hplus->epoch,  ampl, f, right_ascension, declination, psi, &detector);
 
 	check_result(mdl, short_dst, 0.0012, -0.0016, 0.0016);
+	check_per_sample(hplus, hcross, 1.2, -0.4, 0.3, &detector);
 
 	XLALDestroyREAL8TimeSeries(hplus);
 	XLALDestroyREAL8TimeSeries(hcross);
@@ -195,6 +291,7 @@ int main(void)
 	compute_answer(mdl, hplus->epoch,  ampl, f, right_ascension, declination, psi, &detector);
 
 	check_result(mdl, short_dst, 0.0004, -0.0006, 0.0006);
+	check_per_sample(hplus, hcross, 1.2, -0.4, 0.3, &detector);
 
 	XLALDestroyREAL8TimeSeries(hplus);
 	XLALDestroyREAL8TimeSeries(hcross);
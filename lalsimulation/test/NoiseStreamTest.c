@@ -0,0 +1,111 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check that a noise stream reproduces XLALSimNoise().
+ *
+ * XLALSimNoiseStreamNext() must give the same segments as XLALSimNoise(),
+ * bit for bit, when both are driven by random number generators with the
+ * same seed, for a stride shorter than the segment and for a stride of the
+ * full segment.  The PSD resolution is deliberately not exactly the
+ * inverse of the segment duration, which XLALSimNoise() allows.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gsl/gsl_rng.h>
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALSimNoise.h>
+
+#define SRATE 4096.0
+#define LENGTH 4096
+#define NSEGMENTS 6
+#define SEED 1234
+
+static int compare(const REAL8TimeSeries *a, const REAL8TimeSeries *b, size_t stride, int segment)
+{
+    if (XLALGPSCmp(&a->epoch, &b->epoch) || a->deltaT != b->deltaT || memcmp(a->data->data, b->data->data, a->data->length * sizeof(*a->data->data))) {
+        fprintf(stderr, "FAIL: stride %zu: segment %d of the stream differs from XLALSimNoise()\n", stride, segment);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_stride(const REAL8FrequencySeries *psd, size_t stride)
+{
+    const LIGOTimeGPS epoch = {1000000000, 0};
+    REAL8TimeSeries *s, *sref;
+    LALSimNoiseStream *stream;
+    gsl_rng *rng, *rngref;
+    int errors = 0;
+    int i;
+
+    s = XLALCreateREAL8TimeSeries("STRAIN", &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+    sref = XLALCreateREAL8TimeSeries("STRAIN", &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+    stream = XLALSimNoiseCreateStream(LENGTH, stride, psd);
+    XLAL_CHECK(s && sref && stream, XLAL_EFUNC);
+    rng = gsl_rng_alloc(gsl_rng_mt19937);
+    rngref = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, SEED);
+    gsl_rng_set(rngref, SEED);
+
+    for (i = 0; i < NSEGMENTS; ++i) {
+        XLAL_CHECK(XLALSimNoise(sref, i ? stride : 0, (REAL8FrequencySeries *) psd, rngref) == 0, XLAL_EFUNC);
+        XLAL_CHECK(XLALSimNoiseStreamNext(stream, s, rng) == 0, XLAL_EFUNC);
+        errors += compare(s, sref, stride, i);
+    }
+
+    gsl_rng_free(rng);
+    gsl_rng_free(rngref);
+    XLALSimNoiseDestroyStream(stream);
+    XLALDestroyREAL8TimeSeries(s);
+    XLALDestroyREAL8TimeSeries(sref);
+    return errors;
+}
+
+int main(void)
+{
+    const LIGOTimeGPS epoch = {0, 0};
+    REAL8FrequencySeries *psd;
+    int errors = 0;
+
+    /* within the tolerance of the resolution check, but not exactly
+     * 1/(LENGTH/SRATE) */
+    psd = XLALCreateREAL8FrequencySeries("PSD", &epoch, 0.0, (1.0 + 1e-9) * SRATE / LENGTH, &lalSecondUnit, LENGTH / 2 + 1);
+    XLAL_CHECK(psd, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimNoisePSD(psd, 10.0, XLALSimNoisePSDaLIGOZeroDetHighPower) == 0, XLAL_EFUNC);
+
+    errors += test_stride(psd, LENGTH / 4);
+    errors += test_stride(psd, LENGTH);
+
+    XLALDestroyREAL8FrequencySeries(psd);
+
+    if (errors) {
+        fprintf(stderr, "FAIL: noise stream differs from XLALSimNoise()\n");
+        return 1;
+    }
+
+    LALCheckMemoryLeaks();
+    printf("PASS: noise stream reproduces XLALSimNoise()\n");
+    return 0;
+}
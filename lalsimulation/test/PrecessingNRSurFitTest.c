@@ -0,0 +1,234 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check the PrecessingNRSur fits evaluated from shared monomials.
+ *
+ * The scalar and vector fits of NRSur7dq2 and NRSur7dq4 are evaluated from
+ * a table of monomials of the fit parameters that is computed once per
+ * point.  For synthetic fits using every allowed basis function order, the
+ * result must agree with a direct evaluation of
+ *      \sum_i c_i \prod_j y_j^{k_{i, j}}
+ * where y are the transformed fit parameters.  No surrogate data file is
+ * needed.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+
+#include "../lib/LALSimIMRPrecessingNRSur.c"
+
+#define N_COEFS 40
+#define VEC_DIM 3
+#define TOLERANCE 1e-12
+
+/* maximum basis function order of each fit parameter */
+static const long max_order[7] = {3, 2, 2, 2, 2, 2, 2};
+
+static const REAL8 points[][7] = {
+    {1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+    {1.7, 0.3, -0.2, 0.5, -0.6, 0.1, -0.4},
+    {3.9, -0.7, 0.4, -0.3, 0.2, 0.75, 0.55},
+};
+
+/* fit parameters of each surrogate, computed independently of the library */
+static void fit_params(REAL8 *y, const REAL8 *x, int version)
+{
+    int j;
+    for (j = 0; j < 7; j++)
+        y[j] = x[j];
+    if (version == 0) {
+        y[0] = NRSUR7DQ2_Q_FIT_OFFSET + NRSUR7DQ2_Q_FIT_SLOPE * x[0];
+    } else {
+        const REAL8 q = x[0];
+        const REAL8 eta = q / (1. + q) / (1. + q);
+        const REAL8 chi_wtAvg = (q * x[3] + x[6]) / (1. + q);
+        y[0] = NRSUR7DQ4_Q_FIT_OFFSET + NRSUR7DQ4_Q_FIT_SLOPE * log(q);
+        y[3] = (chi_wtAvg - 38. * eta / 113. * (x[3] + x[6])) / (1. - 76. * eta / 113.);
+        y[6] = (x[3] - x[6]) / 2.;
+    }
+}
+
+static REAL8 direct_term(const gsl_matrix_long *orders, size_t i, const REAL8 *y)
+{
+    REAL8 prod = 1.0;
+    int j;
+    for (j = 0; j < 7; j++)
+        prod *= pow(y[j], gsl_matrix_long_get(orders, i, j));
+    return prod;
+}
+
+static FitData *create_fit(int seed)
+{
+    FitData *data = XLALMalloc(sizeof(*data));
+    size_t i;
+    int j;
+    data->n_coefs = N_COEFS;
+    data->basisFunctionOrders = gsl_matrix_long_alloc(N_COEFS, 7);
+    data->coefs = gsl_vector_alloc(N_COEFS);
+    /* cycle through all orders, including the highest power of q */
+    for (i = 0; i < N_COEFS; i++) {
+        for (j = 0; j < 7; j++)
+            gsl_matrix_long_set(data->basisFunctionOrders, i, j, (i + 3 * j + seed) % (max_order[j] + 1));
+        gsl_vector_set(data->coefs, i, cos(1.3 * i + seed));
+    }
+    return data;
+}
+
+static void destroy_fit(FitData *data)
+{
+    gsl_matrix_long_free(data->basisFunctionOrders);
+    gsl_vector_free(data->coefs);
+    XLALFree(data);
+}
+
+static int compare(REAL8 value, REAL8 expected, const char *what, int version, size_t point)
+{
+    if (fabs(value - expected) > TOLERANCE * fmax(1.0, fabs(expected))) {
+        fprintf(stderr, "FAIL: %s of version %d at point %zu: got %.17g, expected %.17g\n", what, version, point, value, expected);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_scalar_fit(PrecessingNRSurData *sur_data)
+{
+    const int version = sur_data->PrecessingNRSurVersion;
+    FitData *data = create_fit(0);
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    REAL8 x[7], y[7];
+    int errors = 0;
+    size_t p, i;
+
+    for (p = 0; p < XLAL_NUM_ELEM(points); p++) {
+        REAL8 expected = 0.0;
+        memcpy(x, points[p], sizeof(x));
+        fit_params(y, x, version);
+        for (i = 0; i < N_COEFS; i++)
+            expected += gsl_vector_get(data->coefs, i) * direct_term(data->basisFunctionOrders, i, y);
+        XLAL_CHECK(PrecessingNRSur_fit_powers(x_powers, x, sur_data) == XLAL_SUCCESS, XLAL_EFUNC);
+        errors += compare(PrecessingNRSur_eval_fit_powers(data, x_powers), expected, "scalar fit from monomials", version, p);
+        errors += compare(PrecessingNRSur_eval_fit(data, x, sur_data), expected, "scalar fit", version, p);
+    }
+
+    destroy_fit(data);
+    return errors;
+}
+
+/* NRSur7dq2 vector fits assign each coefficient to a single component */
+static int test_vector_fit_dq2(PrecessingNRSurData *sur_data)
+{
+    FitData *fit = create_fit(1);
+    VectorFitData data;
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    REAL8 x[7], y[7], res[VEC_DIM], expected[VEC_DIM];
+    int errors = 0;
+    size_t p, i;
+    int k;
+
+    data.basisFunctionOrders = fit->basisFunctionOrders;
+    data.coefs = fit->coefs;
+    data.componentIndices = gsl_vector_long_alloc(N_COEFS);
+    data.n_coefs = N_COEFS;
+    data.vec_dim = VEC_DIM;
+    data.fit_data = NULL;
+    for (i = 0; i < N_COEFS; i++)
+        gsl_vector_long_set(data.componentIndices, i, (7 * i) % VEC_DIM);
+
+    for (p = 0; p < XLAL_NUM_ELEM(points); p++) {
+        memcpy(x, points[p], sizeof(x));
+        fit_params(y, x, 0);
+        for (k = 0; k < VEC_DIM; k++)
+            expected[k] = 0.0;
+        for (i = 0; i < N_COEFS; i++)
+            expected[gsl_vector_long_get(data.componentIndices, i)] += gsl_vector_get(data.coefs, i) * direct_term(data.basisFunctionOrders, i, y);
+        XLAL_CHECK(PrecessingNRSur_fit_powers(x_powers, x, sur_data) == XLAL_SUCCESS, XLAL_EFUNC);
+        PrecessingNRSur_eval_vector_fit(res, &data, x_powers, sur_data);
+        for (k = 0; k < VEC_DIM; k++)
+            errors += compare(res[k], expected[k], "vector fit", 0, p);
+    }
+
+    gsl_vector_long_free(data.componentIndices);
+    destroy_fit(fit);
+    return errors;
+}
+
+/* NRSur7dq4 vector fits are a scalar fit per component */
+static int test_vector_fit_dq4(PrecessingNRSurData *sur_data)
+{
+    FitData *fits[VEC_DIM];
+    VectorFitData data;
+    REAL8 x_powers[NRSUR_N_FIT_POWERS];
+    REAL8 x[7], y[7], res[VEC_DIM];
+    int errors = 0;
+    size_t p, i;
+    int k;
+
+    for (k = 0; k < VEC_DIM; k++)
+        fits[k] = create_fit(k + 2);
+    data.basisFunctionOrders = NULL;
+    data.coefs = NULL;
+    data.componentIndices = NULL;
+    data.n_coefs = 0;
+    data.vec_dim = VEC_DIM;
+    data.fit_data = fits;
+
+    for (p = 0; p < XLAL_NUM_ELEM(points); p++) {
+        memcpy(x, points[p], sizeof(x));
+        fit_params(y, x, 1);
+        XLAL_CHECK(PrecessingNRSur_fit_powers(x_powers, x, sur_data) == XLAL_SUCCESS, XLAL_EFUNC);
+        PrecessingNRSur_eval_vector_fit(res, &data, x_powers, sur_data);
+        for (k = 0; k < VEC_DIM; k++) {
+            REAL8 expected = 0.0;
+            for (i = 0; i < N_COEFS; i++)
+                expected += gsl_vector_get(fits[k]->coefs, i) * direct_term(fits[k]->basisFunctionOrders, i, y);
+            errors += compare(res[k], expected, "vector fit", 1, p);
+        }
+    }
+
+    for (k = 0; k < VEC_DIM; k++)
+        destroy_fit(fits[k]);
+    return errors;
+}
+
+int main(void)
+{
+    PrecessingNRSurData sur_data;
+    int errors = 0;
+
+    memset(&sur_data, 0, sizeof(sur_data));
+
+    sur_data.PrecessingNRSurVersion = 0;
+    errors += test_scalar_fit(&sur_data);
+    errors += test_vector_fit_dq2(&sur_data);
+
+    sur_data.PrecessingNRSurVersion = 1;
+    errors += test_scalar_fit(&sur_data);
+    errors += test_vector_fit_dq4(&sur_data);
+
+    if (errors) {
+        fprintf(stderr, "FAIL: PrecessingNRSur fits differ from direct evaluation\n");
+        return 1;
+    }
+
+    LALCheckMemoryLeaks();
+    printf("PASS: PrecessingNRSur fits from shared monomials\n");
+    return 0;
+}
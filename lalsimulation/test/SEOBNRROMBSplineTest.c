@@ -0,0 +1,161 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check the workspace-free B-spline evaluation of the SEOBNR ROMs
+ * against GSL.
+ *
+ * ROM_BSpline_Basis() must give the same nonzero cubic B-splines as
+ * gsl_bspline_eval_nonzero() for the knots gsl_bspline_knots() builds, and
+ * Interpolate_Coefficent_Tensor_Basis() the same tensor product spline as
+ * Interpolate_Coefficent_Tensor(), to within rounding, at points inside the
+ * domain, at breakpoints and at both end points.
+ */
+
+#ifdef __GNUC__
+#define UNUSED __attribute__ ((unused))
+#else
+#define UNUSED
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_bspline.h>
+#include <gsl/gsl_vector.h>
+#include <lal/LALStdlib.h>
+#include <lal/XLALError.h>
+#include <lal/LALSimInspiral.h>
+
+#include "../lib/LALSimIMRSEOBNRROMUtilities.c"
+
+#define NK 3              /* number of SVD modes */
+#define NPTS 41           /* evaluation points per dimension */
+#define TOLERANCE 1e-13   /* coefficients and basis functions are of order unity */
+
+/* non-uniform breakpoints, as in the ROM grids */
+static const double xbreak[] = { 0.01, 0.05, 0.1, 0.15, 0.2, 0.23, 0.25 };
+static const double ybreak[] = { -1.0, -0.6, -0.1, 0.3, 0.7, 0.99 };
+static const double zbreak[] = { -1.0, -0.4, 0.2, 0.6, 0.99 };
+
+static gsl_bspline_workspace *make_workspace(const double *breakpts, size_t nbreak)
+{
+    gsl_bspline_workspace *bw = gsl_bspline_alloc(4, nbreak);
+    gsl_vector_const_view b = gsl_vector_const_view_array(breakpts, nbreak);
+    gsl_bspline_knots(&b.vector, bw);
+    return bw;
+}
+
+/* points spanning the domain, including the breakpoints and end points */
+static double point(const double *breakpts, size_t nbreak, size_t i)
+{
+    const size_t l = nbreak - 1;
+    const size_t per = (NPTS - 1) / l;
+    if (i >= per * l)
+        return breakpts[l];
+    return breakpts[i / per] + (breakpts[i / per + 1] - breakpts[i / per]) * (double) (i % per) / per;
+}
+
+static int check_basis(const char *name, const double *breakpts, size_t nbreak, gsl_bspline_workspace *bw)
+{
+    gsl_vector *B = gsl_vector_alloc(4);
+    int errors = 0;
+    size_t i, m;
+
+    for (i = 0; i < NPTS; ++i) {
+        const double x = point(breakpts, nbreak, i);
+        ROMBSplineBasis basis;
+        size_t is, ie;
+        gsl_bspline_eval_nonzero(x, B, &is, &ie, bw);
+        if (ROM_BSpline_Basis(&basis, x, breakpts, nbreak) != XLAL_SUCCESS || basis.is != is) {
+            fprintf(stderr, "FAIL: %s: wrong first B-spline at %g\n", name, x);
+            ++errors;
+            continue;
+        }
+        for (m = 0; m < 4; ++m)
+            if (fabs(basis.B[m] - gsl_vector_get(B, m)) > TOLERANCE) {
+                fprintf(stderr, "FAIL: %s: B-spline %zu at %g is %.17g, GSL gives %.17g\n", name, is + m, x, basis.B[m], gsl_vector_get(B, m));
+                ++errors;
+            }
+    }
+
+    gsl_vector_free(B);
+    return errors;
+}
+
+int main(void)
+{
+    const size_t nbx = sizeof(xbreak) / sizeof(*xbreak);
+    const size_t nby = sizeof(ybreak) / sizeof(*ybreak);
+    const size_t nbz = sizeof(zbreak) / sizeof(*zbreak);
+    const int ncx = nbx + 2, ncy = nby + 2, ncz = nbz + 2;
+    const size_t N = (size_t) ncx * ncy * ncz;
+    gsl_bspline_workspace *bwx = make_workspace(xbreak, nbx);
+    gsl_bspline_workspace *bwy = make_workspace(ybreak, nby);
+    gsl_bspline_workspace *bwz = make_workspace(zbreak, nbz);
+    gsl_vector *cvec = gsl_vector_alloc(NK * N);
+    double maxdiff = 0;
+    int errors = 0;
+    size_t i, j, k, n;
+
+    errors += check_basis("eta", xbreak, nbx, bwx);
+    errors += check_basis("chi1", ybreak, nby, bwy);
+    errors += check_basis("chi2", zbreak, nbz, bwz);
+
+    for (i = 0; i < NK * N; ++i)
+        gsl_vector_set(cvec, i, sin(0.37 * i + 0.1) + 0.5 * cos(1.3 * i));
+
+    for (i = 0; i < NPTS; i += 3)
+        for (j = 0; j < NPTS; j += 2)
+            for (k = 0; k < NPTS; ++k) {
+                const double x = point(xbreak, nbx, i);
+                const double y = point(ybreak, nby, j);
+                const double z = point(zbreak, nbz, k);
+                ROMBSplineBasis bx, by, bz;
+                double c[NK];
+                XLAL_CHECK_MAIN(ROM_BSpline_Basis(&bx, x, xbreak, nbx) == XLAL_SUCCESS, XLAL_EFUNC);
+                XLAL_CHECK_MAIN(ROM_BSpline_Basis(&by, y, ybreak, nby) == XLAL_SUCCESS, XLAL_EFUNC);
+                XLAL_CHECK_MAIN(ROM_BSpline_Basis(&bz, z, zbreak, nbz) == XLAL_SUCCESS, XLAL_EFUNC);
+                XLAL_CHECK_MAIN(Interpolate_Coefficent_Tensor_Basis(c, cvec->data, NK, ncx, ncy, ncz, &bx, &by, &bz) == XLAL_SUCCESS, XLAL_EFUNC);
+                for (n = 0; n < NK; ++n) {
+                    gsl_vector v = gsl_vector_subvector(cvec, n * N, N).vector;
+                    const double expected = Interpolate_Coefficent_Tensor(&v, x, y, z, ncy, ncz, bwx, bwy, bwz);
+                    maxdiff = fmax(maxdiff, fabs(c[n] - expected));
+                }
+            }
+
+    printf("largest difference from GSL tensor interpolation: %g\n", maxdiff);
+    if (!(maxdiff <= TOLERANCE)) {
+        fprintf(stderr, "FAIL: tensor interpolation differs from GSL by more than %g\n", TOLERANCE);
+        ++errors;
+    }
+
+    gsl_vector_free(cvec);
+    gsl_bspline_free(bwx);
+    gsl_bspline_free(bwy);
+    gsl_bspline_free(bwz);
+
+    if (errors)
+        return 1;
+    LALCheckMemoryLeaks();
+    printf("PASS: B-spline evaluation agrees with GSL\n");
+    return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check that an SGWB stream reproduces XLALSimSGWB().
+ *
+ * XLALSimSGWBStreamNext() must give the same segments as XLALSimSGWB() for
+ * a network of three detectors, bit for bit, when both are driven by
+ * random number generators with the same seed, for a stride shorter than
+ * the segment and for a stride of the full segment.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <gsl/gsl_rng.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDetectors.h>
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALSimSGWB.h>
+
+#define NDET 3
+#define SRATE 1024.0
+#define LENGTH 4096
+#define NSEGMENTS 5
+#define SEED 4321
+
+static const double flow = 10.0;
+static const double Omega0 = 1e-6;
+static const double H0 = 0.72 * LAL_H0FAC_SI;
+
+static int test_stride(const LALDetector *detectors, const REAL8FrequencySeries *OmegaGW, size_t stride)
+{
+    const LIGOTimeGPS epoch = {1000000000, 0};
+    REAL8TimeSeries *h[NDET], *href[NDET];
+    LALSimSGWBStream *stream;
+    gsl_rng *rng, *rngref;
+    int errors = 0;
+    int i, n;
+
+    for (n = 0; n < NDET; ++n) {
+        h[n] = XLALCreateREAL8TimeSeries("STRAIN", &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+        href[n] = XLALCreateREAL8TimeSeries("STRAIN", &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, LENGTH);
+        XLAL_CHECK(h[n] && href[n], XLAL_EFUNC);
+    }
+    stream = XLALSimSGWBCreateStream(detectors, NDET, LENGTH, 1.0 / SRATE, stride, OmegaGW, H0);
+    XLAL_CHECK(stream, XLAL_EFUNC);
+    rng = gsl_rng_alloc(gsl_rng_mt19937);
+    rngref = gsl_rng_alloc(gsl_rng_mt19937);
+    gsl_rng_set(rng, SEED);
+    gsl_rng_set(rngref, SEED);
+
+    for (i = 0; i < NSEGMENTS; ++i) {
+        XLAL_CHECK(XLALSimSGWB(href, detectors, NDET, i ? stride : 0, OmegaGW, H0, rngref) == 0, XLAL_EFUNC);
+        XLAL_CHECK(XLALSimSGWBStreamNext(stream, h, rng) == 0, XLAL_EFUNC);
+        for (n = 0; n < NDET; ++n)
+            if (XLALGPSCmp(&h[n]->epoch, &href[n]->epoch) || h[n]->deltaT != href[n]->deltaT || memcmp(h[n]->data->data, href[n]->data->data, LENGTH * sizeof(*h[n]->data->data))) {
+                fprintf(stderr, "FAIL: stride %zu: segment %d for detector %s differs from XLALSimSGWB()\n", stride, i, detectors[n].frDetector.prefix);
+                ++errors;
+            }
+    }
+
+    gsl_rng_free(rng);
+    gsl_rng_free(rngref);
+    XLALSimSGWBDestroyStream(stream);
+    for (n = 0; n < NDET; ++n) {
+        XLALDestroyREAL8TimeSeries(h[n]);
+        XLALDestroyREAL8TimeSeries(href[n]);
+    }
+    return errors;
+}
+
+int main(void)
+{
+    const LALDetector detectors[NDET] = {
+        lalCachedDetectors[LAL_LHO_4K_DETECTOR],
+        lalCachedDetectors[LAL_LLO_4K_DETECTOR],
+        lalCachedDetectors[LAL_VIRGO_DETECTOR]
+    };
+    REAL8FrequencySeries *OmegaGW;
+    int errors = 0;
+
+    OmegaGW = XLALSimSGWBOmegaGWFlatSpectrum(Omega0, flow, SRATE / LENGTH, LENGTH / 2 + 1);
+    XLAL_CHECK(OmegaGW, XLAL_EFUNC);
+
+    errors += test_stride(detectors, OmegaGW, LENGTH / 2);
+    errors += test_stride(detectors, OmegaGW, LENGTH);
+
+    XLALDestroyREAL8FrequencySeries(OmegaGW);
+
+    if (errors) {
+        fprintf(stderr, "FAIL: SGWB stream differs from XLALSimSGWB()\n");
+        return 1;
+    }
+
+    LALCheckMemoryLeaks();
+    printf("PASS: SGWB stream reproduces XLALSimSGWB()\n");
+    return 0;
+}
@@ -0,0 +1,220 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *  MA  02110-1301  USA
+ */
+
+/**
+ * \file
+ *
+ * \brief Check the mode summation routines against summing the modes one
+ * at a time.
+ *
+ * XLALSimAddModesFromSphHarmTimeSeries() and
+ * XLALSimAddDetectorStrainFromSphHarmTimeSeries() are compared with
+ * XLALSimAddMode() applied to each mode in turn, and the frequency-domain
+ * routines with the per-mode loop they replaced.  The blocked sums only
+ * reorder the real arithmetic of each complex product, so results must
+ * agree to within a few units of rounding; the tolerance is 1e-13 of the
+ * largest value of each output.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <complex.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/SphericalHarmonics.h>
+#include <lal/LALSimSphHarmSeries.h>
+#include <lal/LALSimSphHarmMode.h>
+
+#define LENGTH 2500  /* not a multiple of the block size */
+#define TOLERANCE 1e-13
+
+static const REAL8 theta = 0.7, phi = 1.9, Fplus = 0.3, Fcross = -0.8;
+
+/* some smooth, distinct data for mode (l,m) at sample j */
+static COMPLEX16 mode_value(int l, int m, size_t j)
+{
+    REAL8 x = 1e-3 * j;
+    return (1.0 + 0.1 * l) * cexp(I * ((m + 0.5) * 40.0 * x + 0.3 * l)) * exp(-x) + 0.01 * m * I;
+}
+
+static REAL8 max_rel_diff_real(const REAL8 *a, const REAL8 *b, size_t n)
+{
+    REAL8 diff = 0, scale = 0;
+    size_t j;
+    for (j = 0; j < n; ++j) {
+        diff = fmax(diff, fabs(a[j] - b[j]));
+        scale = fmax(scale, fabs(b[j]));
+    }
+    return scale > 0 ? diff / scale : diff;
+}
+
+static REAL8 max_rel_diff_complex(const COMPLEX16 *a, const COMPLEX16 *b, size_t n)
+{
+    REAL8 diff = 0, scale = 0;
+    size_t j;
+    for (j = 0; j < n; ++j) {
+        diff = fmax(diff, cabs(a[j] - b[j]));
+        scale = fmax(scale, cabs(b[j]));
+    }
+    return scale > 0 ? diff / scale : diff;
+}
+
+static int report(const char *what, REAL8 diff)
+{
+    printf("%s: largest relative difference %g\n", what, diff);
+    if (!(diff <= TOLERANCE)) {
+        fprintf(stderr, "FAIL: %s differs from the per-mode sum by more than %g\n", what, TOLERANCE);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_td(void)
+{
+    const LIGOTimeGPS epoch = {0, 0};
+    const REAL8 deltaT = 1.0 / 4096.0;
+    SphHarmTimeSeries *hlms = NULL, *this;
+    REAL8TimeSeries *hp, *hc, *hpref, *hcref, *h, *href;
+    int errors = 0;
+    size_t j;
+    int l, m;
+
+    for (l = 2; l <= 4; ++l)
+        for (m = -l; m <= l; ++m) {
+            COMPLEX16TimeSeries *mode = XLALCreateCOMPLEX16TimeSeries("hlm", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+            XLAL_CHECK(mode, XLAL_EFUNC);
+            for (j = 0; j < LENGTH; ++j)
+                mode->data->data[j] = mode_value(l, m, j);
+            hlms = XLALSphHarmTimeSeriesAddMode(hlms, mode, l, m);
+            XLALDestroyCOMPLEX16TimeSeries(mode);
+            XLAL_CHECK(hlms, XLAL_EFUNC);
+        }
+
+    hp = XLALCreateREAL8TimeSeries("hplus", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    hc = XLALCreateREAL8TimeSeries("hcross", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    hpref = XLALCreateREAL8TimeSeries("hplus", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    hcref = XLALCreateREAL8TimeSeries("hcross", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    h = XLALCreateREAL8TimeSeries("strain", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    href = XLALCreateREAL8TimeSeries("strain", &epoch, 0, deltaT, &lalStrainUnit, LENGTH);
+    XLAL_CHECK(hp && hc && hpref && hcref && h && href, XLAL_EFUNC);
+    for (j = 0; j < LENGTH; ++j)
+        hp->data->data[j] = hc->data->data[j] = hpref->data->data[j] = hcref->data->data[j] = h->data->data[j] = 0;
+
+    for (this = hlms; this; this = this->next)
+        XLAL_CHECK(XLALSimAddMode(hpref, hcref, this->mode, theta, phi, this->l, this->m, 0) == XLAL_SUCCESS, XLAL_EFUNC);
+    for (j = 0; j < LENGTH; ++j)
+        href->data->data[j] = Fplus * hpref->data->data[j] + Fcross * hcref->data->data[j];
+
+    XLAL_CHECK(XLALSimAddModesFromSphHarmTimeSeries(hp, hc, hlms, theta, phi) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimAddDetectorStrainFromSphHarmTimeSeries(h, hlms, theta, phi, Fplus, Fcross) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    errors += report("time-domain hplus", max_rel_diff_real(hp->data->data, hpref->data->data, LENGTH));
+    errors += report("time-domain hcross", max_rel_diff_real(hc->data->data, hcref->data->data, LENGTH));
+    errors += report("time-domain strain", max_rel_diff_real(h->data->data, href->data->data, LENGTH));
+
+    XLALDestroyREAL8TimeSeries(hp);
+    XLALDestroyREAL8TimeSeries(hc);
+    XLALDestroyREAL8TimeSeries(hpref);
+    XLALDestroyREAL8TimeSeries(hcref);
+    XLALDestroyREAL8TimeSeries(h);
+    XLALDestroyREAL8TimeSeries(href);
+    XLALDestroySphHarmTimeSeries(hlms);
+    return errors;
+}
+
+static int test_fd(void)
+{
+    const LIGOTimeGPS epoch = {0, 0};
+    const REAL8 deltaF = 1.0 / 8.0;
+    const size_t len = LENGTH, offset = LENGTH - 1;
+    SphHarmFrequencySeries *hlms = NULL, *this;
+    COMPLEX16FrequencySeries *hp, *hc, *hpref, *hcref, *h, *href;
+    int errors = 0;
+    size_t j;
+    int l, m;
+
+    /* modes cover negative and positive frequencies */
+    for (l = 2; l <= 4; ++l)
+        for (m = -l; m <= l; ++m) {
+            COMPLEX16FrequencySeries *mode = XLALCreateCOMPLEX16FrequencySeries("hlm", &epoch, 0, deltaF, &lalStrainUnit, 2 * LENGTH - 1);
+            XLAL_CHECK(mode, XLAL_EFUNC);
+            for (j = 0; j < 2 * LENGTH - 1; ++j)
+                mode->data->data[j] = mode_value(l, m, j);
+            hlms = XLALSphHarmFrequencySeriesAddMode(hlms, mode, l, m);
+            XLALDestroyCOMPLEX16FrequencySeries(mode);
+            XLAL_CHECK(hlms, XLAL_EFUNC);
+        }
+
+    hp = XLALCreateCOMPLEX16FrequencySeries("hplus", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    hc = XLALCreateCOMPLEX16FrequencySeries("hcross", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    hpref = XLALCreateCOMPLEX16FrequencySeries("hplus", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    hcref = XLALCreateCOMPLEX16FrequencySeries("hcross", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    h = XLALCreateCOMPLEX16FrequencySeries("strain", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    href = XLALCreateCOMPLEX16FrequencySeries("strain", &epoch, 0, deltaF, &lalStrainUnit, LENGTH);
+    XLAL_CHECK(hp && hc && hpref && hcref && h && href, XLAL_EFUNC);
+    for (j = 0; j < LENGTH; ++j)
+        hp->data->data[j] = hc->data->data[j] = hpref->data->data[j] = hcref->data->data[j] = h->data->data[j] = 0;
+
+    /* the per-mode loop previously used by
+     * XLALSimInspiralPolarizationsFromSphHarmFrequencySeries() */
+    for (this = hlms; this; this = this->next) {
+        COMPLEX16 Ylm = XLALSpinWeightedSphericalHarmonic(theta, phi, -2, this->l, this->m);
+        COMPLEX16 Ylmstar = conj(Ylm);
+        for (j = 0; j < len; ++j) {
+            COMPLEX16 hlm = this->mode->data->data[j + offset];
+            COMPLEX16 hlm2 = conj(this->mode->data->data[len - 1 - j]);
+            hpref->data->data[j] += 0.5 * (hlm * Ylm + hlm2 * Ylmstar);
+            hcref->data->data[j] += 0.5 * I * (hlm * Ylm - hlm2 * Ylmstar);
+        }
+    }
+    for (j = 0; j < LENGTH; ++j)
+        href->data->data[j] = Fplus * hpref->data->data[j] + Fcross * hcref->data->data[j];
+
+    XLAL_CHECK(XLALSimAddModesFromSphHarmFrequencySeries(hp, hc, hlms, theta, phi) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK(XLALSimAddDetectorStrainFromSphHarmFrequencySeries(h, hlms, theta, phi, Fplus, Fcross) == XLAL_SUCCESS, XLAL_EFUNC);
+
+    errors += report("frequency-domain hplus", max_rel_diff_complex(hp->data->data, hpref->data->data, LENGTH));
+    errors += report("frequency-domain hcross", max_rel_diff_complex(hc->data->data, hcref->data->data, LENGTH));
+    errors += report("frequency-domain strain", max_rel_diff_complex(h->data->data, href->data->data, LENGTH));
+
+    XLALDestroyCOMPLEX16FrequencySeries(hp);
+    XLALDestroyCOMPLEX16FrequencySeries(hc);
+    XLALDestroyCOMPLEX16FrequencySeries(hpref);
+    XLALDestroyCOMPLEX16FrequencySeries(hcref);
+    XLALDestroyCOMPLEX16FrequencySeries(h);
+    XLALDestroyCOMPLEX16FrequencySeries(href);
+    XLALDestroySphHarmFrequencySeries(hlms);
+    return errors;
+}
+
+int main(void)
+{
+    int td_errors = test_td();
+    int fd_errors = test_fd();
+
+    if (td_errors || fd_errors) {
+        fprintf(stderr, "FAIL: mode sums differ from per-mode summation\n");
+        return 1;
+    }
+
+    LALCheckMemoryLeaks();
+    printf("PASS: mode sums agree with per-mode summation\n");
+    return 0;
+}